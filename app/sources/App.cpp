@@ -4,20 +4,52 @@
 #include <sstream>
 #include <string>
 #include <set>
+#include <memory>
+#include <cstdlib>
+#include <cstdio>
+#include <algorithm>
 #include <cxxopts.hpp>
 
 #include "Parser.hpp"
 #include "Config.hpp"
 #include "ConsoleColorizer.hpp"
 #include "FileHelper.hpp"
+#include "FingerprintStore.hpp"
+#include "BatchExecutor.hpp"
+#include "FileWatcher.hpp"
+#include "LibClangLoader.hpp"
+#include "OutputVerifier.hpp"
+#include "ResourceReport.hpp"
+#include "Trace.hpp"
+#include "HeaderPrefilter.hpp"
+#include "GenerationStamp.hpp"
+#include "DirectoryTree.hpp"
+#include "VersionInfo.h"
 
 const std::set<std::string> cppExtensions = { "hpp", "hxx", "hh" };
 
-App::App( std::ostream &cout, std::ostream &cerr )
-: m_cout(cout), m_cerr(cerr)
+App::App( std::ostream &cout, std::ostream &cerr, std::istream &cin )
+: m_cout(cout), m_cerr(cerr), m_cin(cin)
 {
 }
 
+App::~App()
+{
+}
+
+void App::PrintFingerprintDifferences( const FingerprintStore &fingerprints )
+{
+    static const char* changeNames[] = { "ADDED", "REMOVED", "CHANGED" };
+
+    for( const FingerprintStore::Difference &difference : fingerprints.GetDifferences() )
+    {
+        cerrColorizer.SetColor( ConsoleColorizer::Color::LIGHT_CYAN );
+        m_cerr << changeNames[ static_cast<int>( difference.change ) ] << ": ";
+        cerrColorizer.SetColor( ConsoleColorizer::Color::RESET );
+        m_cerr << "Function '" << difference.name << "' in '" << difference.inputFilepath << "'" << std::endl;
+    }
+}
+
 void App::PrintError( const char *msg )
 {
     cerrColorizer.SetColor( ConsoleColorizer::Color::LIGHT_RED );
@@ -38,6 +70,100 @@ std::string QuotifyOption( const std::string &option )
     }
 }
 
+std::vector<std::string> ReadSymbolsFile( const std::string &symbolsFilepath )
+{
+    std::ifstream symbolsFile( symbolsFilepath );
+    if( !symbolsFile.is_open() )
+    {
+        std::string errorMsg = "Symbols file '" + symbolsFilepath + "' could not be opened.";
+        throw std::runtime_error( errorMsg );
+    }
+
+    // Each line is expected to end with a symbol name, which allows using directly the output of "nm -u"
+    // (e.g. "                 U foo") or plain lists with one symbol name per line
+    std::vector<std::string> symbols;
+    std::string line;
+    while( std::getline( symbolsFile, line ) )
+    {
+        size_t endPos = line.find_last_not_of( " \t\r" );
+        if( endPos == std::string::npos )
+        {
+            continue;
+        }
+
+        size_t startPos = line.find_last_of( " \t", endPos );
+        startPos = ( startPos == std::string::npos ) ? 0 : ( startPos + 1 );
+        std::string symbol = line.substr( startPos, endPos + 1 - startPos );
+
+        // Skip object file headings (e.g. "foo.o:") and remove symbol versions (e.g. "foo@GLIBC_2.2.5")
+        if( symbol.back() == ':' )
+        {
+            continue;
+        }
+        symbol = symbol.substr( 0, symbol.find( '@' ) );
+
+        if( !symbol.empty() )
+        {
+            symbols.push_back( symbol );
+        }
+    }
+
+    if( symbols.empty() )
+    {
+        std::string errorMsg = "Symbols file '" + symbolsFilepath + "' does not contain any symbol.";
+        throw std::runtime_error( errorMsg );
+    }
+
+    return symbols;
+}
+
+void ParseShardOption( const std::string &shardOption, unsigned int &shardIndex, unsigned int &shardCount )
+{
+    // Expected format is "<index>/<count>", with the index starting at 1
+    std::istringstream shardStream( shardOption );
+    char separator = 0;
+    if( !( shardStream >> shardIndex >> separator >> shardCount ) || ( separator != '/' ) || !shardStream.eof() ||
+        ( shardIndex < 1 ) || ( shardIndex > shardCount ) )
+    {
+        std::string errorMsg = "Invalid shard '" + shardOption + "' (expected <index>/<count> with 1 <= index <= count).";
+        throw std::runtime_error( errorMsg );
+    }
+}
+
+std::vector<std::string> SelectShardInputs( const std::vector<std::string> &inputFilenames, unsigned int shardIndex,
+                                            unsigned int shardCount )
+{
+    // Each input is identified by a stable hash of its path, so that all workers agree on the assignment
+    // regardless of the order of the inputs in their command lines
+    std::vector<std::pair<uint64_t, std::string>> inputs;
+    for( const std::string &inputFilename : inputFilenames )
+    {
+        inputs.push_back( std::make_pair( FingerprintStore::CalculateFingerprint( inputFilename ), inputFilename ) );
+    }
+    std::sort( inputs.begin(), inputs.end() );
+    inputs.erase( std::unique( inputs.begin(), inputs.end() ), inputs.end() );
+
+    // Inputs are dealt to the shards in turn, so that the assignment only depends on the list of inputs shared by all
+    // the workers (and not e.g. on the fingerprints file of each worker, which only holds the inputs it processed)
+    std::set<std::string> selectedInputs;
+    for( size_t i = ( shardIndex - 1 ); i < inputs.size(); i += shardCount )
+    {
+        selectedInputs.insert( inputs[i].second );
+    }
+
+    // Keep the command line order, which determines for which input are mocked the functions declared in several inputs
+    std::vector<std::string> shardInputFilenames;
+    for( const std::string &inputFilename : inputFilenames )
+    {
+        if( selectedInputs.erase( inputFilename ) > 0 )
+        {
+            shardInputFilenames.push_back( inputFilename );
+        }
+    }
+
+    return shardInputFilenames;
+}
+
 std::string GetGenerationOptions( cxxopts::Options &options )
 {
     std::string ret;
@@ -52,6 +178,31 @@ std::string GetGenerationOptions( cxxopts::Options &options )
         ret += "-u ";
     }
 
+    if( options["profile"].as<bool>() )
+    {
+        ret += "--profile ";
+    }
+
+    if( options["pod-comparators"].as<bool>() )
+    {
+        ret += "--pod-comparators ";
+    }
+
+    if( options["record-replay"].as<bool>() )
+    {
+        ret += "--record-replay ";
+    }
+
+    if( options["single-file"].as<bool>() )
+    {
+        ret += "--single-file ";
+    }
+
+    if( options.count( "symbols" ) )
+    {
+        ret += "--symbols " + QuotifyOption( options["symbols"].as<std::string>() ) + " ";
+    }
+
     for( auto paramOverride : options["param-override"].as<std::vector<std::string>>() )
     {
         ret += "-p " + QuotifyOption( paramOverride ) + " ";
@@ -65,189 +216,1113 @@ std::string GetGenerationOptions( cxxopts::Options &options )
     return ret;
 }
 
-int App::Execute( int argc, const char* argv[] )
+bool InterpretAsCpp( const std::string &inputFilename, cxxopts::Options &options )
 {
-    int returnCode = 0;
+    bool interpretAsCpp = false;
+    if( options["cpp"].as<bool>() )
+    {
+        interpretAsCpp = true;
+    }
+    else
+    {
+        size_t extensionIndex = inputFilename.find_last_of(".");
+        if( extensionIndex != std::string::npos )
+        {
+            std::string fileExtension = inputFilename.substr( extensionIndex + 1 );
+            interpretAsCpp = ( cppExtensions.count( fileExtension ) > 0 );
+        }
+    }
 
-    cxxopts::Options options("CppUMockGen", "Mock generator for CppUTest");
+    return interpretAsCpp;
+}
 
-    options.add_options()
-        ( "i,input", "Input file", cxxopts::value<std::string>(), "<input>" )
-        ( "m,mock-output", "Mock output path", cxxopts::value<std::string>()->implicit_value(""), "<mock-output>" )
-        ( "e,expect-output", "Expectation output path", cxxopts::value<std::string>()->implicit_value(""), "<expect-output>" )
-        ( "x,cpp", "Force interpretation of the input file as C++", cxxopts::value<bool>(), "<force-cpp>" )
-        ( "u,underlying-typedef", "Use underlying typedef type", cxxopts::value<bool>(), "[<underlying-typedef>]" )
-        ( "I,include-path", "Include path", cxxopts::value<std::vector<std::string>>(), "<path>" )
-        ( "p,param-override", "Override parameter type", cxxopts::value<std::vector<std::string>>(), "<expr>" )
-        ( "t,type-override", "Override generic type", cxxopts::value<std::vector<std::string>>(), "<expr>" )
-        ( "h,help", "Print help" )
-        ( "y,extra-include", "Extra include file", cxxopts::value<std::vector<std::string>>(), "<path>" )
-        ( "l,cpp11", "Interpretation of the input file as C++11", cxxopts::value<bool>(), "<cpp11>" );
- 
-    options.positional_help( "<input>" );
-    options.parse_positional( std::vector<std::string> { "input" } );
+std::vector<std::string> App::FindInputsInTree( cxxopts::Options &options )
+{
+    std::string inputDirPath = options["input-dir"].as<std::string>();
+    if( !inputDirPath.empty() && !IsDirPath( inputDirPath ) )
+    {
+        inputDirPath += PATH_SEPARATOR;
+    }
 
-    try
+    std::vector<std::string> includeGlobs = options["include-glob"].as<std::vector<std::string>>();
+    if( includeGlobs.empty() )
     {
-        options.parse( argc, const_cast<char**&>(argv) );
+        includeGlobs = { "*.h", "*.hh", "*.hpp", "*.hxx" };
+    }
 
-        if( options.count("help") )
-        {
-            m_cerr << options.help();
-            return 0;
-        }
+    std::vector<std::string> inputFilenames;
+    for( const std::string &relativeFilepath : FindFilesInTree( inputDirPath, includeGlobs,
+                                                                options["exclude-glob"].as<std::vector<std::string>>() ) )
+    {
+        std::string inputFilename = inputDirPath + relativeFilepath;
+        size_t subdirLength = relativeFilepath.size() - GetFilenameFromPath( relativeFilepath ).size();
+        m_inputSubdirs[ inputFilename ] = relativeFilepath.substr( 0, subdirLength );
+        inputFilenames.push_back( inputFilename );
+    }
 
-        if( !options.count( "input" ) )
-        {
-            throw std::runtime_error( "No input file specified." );
-        }
+    if( inputFilenames.empty() )
+    {
+        std::string errorMsg = "No input file found in the input directory '" + inputDirPath + "'.";
+        throw std::runtime_error( errorMsg );
+    }
 
-        std::string inputFilename = options["input"].as<std::string>();
+    return inputFilenames;
+}
 
-        if( ( options.count( "mock-output" ) + options.count( "expect-output" ) ) == 0 )
-        {
-            throw std::runtime_error( "At least the mock generation option (-m) or the expectation generation option (-e) must be specified." );
-        }
+std::string App::GetIncludePath( const std::string &inputFilename ) const
+{
+    // Input files found in subdirectories of the input directory tree are included by their path relative to its root,
+    // so that headers with the same filename in different subdirectories are not mistaken for each other
+    std::string includePath;
+    std::map<std::string, std::string>::const_iterator inputSubdirIt = m_inputSubdirs.find( inputFilename );
+    if( ( inputSubdirIt != m_inputSubdirs.end() ) && !inputSubdirIt->second.empty() )
+    {
+        includePath = inputSubdirIt->second + GetFilenameFromPath( inputFilename );
+        std::replace( includePath.begin(), includePath.end(), PATH_SEPARATOR, '/' );
+    }
+
+    return includePath;
+}
+
+App::OutputFilepaths App::GetOutputFilepaths( const std::string &inputFilename, cxxopts::Options &options, bool checkWritable )
+{
+    OutputFilepaths outputFilepaths;
+
+    // Outputs of input files found in the input directory tree are placed in the same subdirectories of the output
+    // directories
+    std::string inputSubdir;
+    std::map<std::string, std::string>::const_iterator inputSubdirIt = m_inputSubdirs.find( inputFilename );
+    if( inputSubdirIt != m_inputSubdirs.end() )
+    {
+        inputSubdir = inputSubdirIt->second;
+    }
 
-        std::string mockOutputFilepath;
-        std::ofstream mockOutputFile;
-        if( options.count( "mock-output" ) )
+    // Output files are opened without truncating them to check early that they can be written (unless only their paths
+    // are needed), but they are only rewritten after generation if their contents change
+    if( options.count( "mock-output" ) )
+    {
+        outputFilepaths.mock = options["mock-output"].as<std::string>();
+        if( outputFilepaths.mock != "@" )
         {
-            mockOutputFilepath = options["mock-output"].as<std::string>();
-            if( mockOutputFilepath != "@" )
+            if( outputFilepaths.mock.empty() || IsDirPath(outputFilepaths.mock) )
             {
-                if( mockOutputFilepath.empty() || IsDirPath(mockOutputFilepath) )
+                outputFilepaths.mock += inputSubdir;
+                if( checkWritable && !inputSubdir.empty() )
                 {
-                    mockOutputFilepath += RemoveFilenameExtension( GetFilenameFromPath(inputFilename) ) + "_mock.cpp";
+                    CreateDirectories( outputFilepaths.mock );
                 }
-                mockOutputFile.open( mockOutputFilepath );
+                outputFilepaths.mock += RemoveFilenameExtension( GetFilenameFromPath(inputFilename) ) + "_mock.cpp";
+            }
+            if( checkWritable )
+            {
+                std::ofstream mockOutputFile( outputFilepaths.mock, std::ios::app );
                 if( !mockOutputFile.is_open() )
                 {
-                    std::string errorMsg = "Mock output file '" + mockOutputFilepath + "' could not be opened.";
+                    std::string errorMsg = "Mock output file '" + outputFilepaths.mock + "' could not be opened.";
                     throw std::runtime_error( errorMsg );
                 }
             }
         }
+    }
 
-        std::string expectHeaderOutputFilepath;
-        std::string expectImplOutputFilepath;
-        std::ofstream expectHeaderOutputFile;
-        std::ofstream expectImplOutputFile;
-        if( options.count( "expect-output" ) )
+    if( options.count( "expect-output" ) )
+    {
+        outputFilepaths.expectHeader = options["expect-output"].as<std::string>();
+        if( outputFilepaths.expectHeader != "@" )
         {
-            expectHeaderOutputFilepath = options["expect-output"].as<std::string>();
-            if( expectHeaderOutputFilepath != "@" )
+            if( outputFilepaths.expectHeader.empty() || IsDirPath(outputFilepaths.expectHeader) )
             {
-                if( expectHeaderOutputFilepath.empty() || IsDirPath(expectHeaderOutputFilepath) )
-                {
-                    std::string baseFilename = RemoveFilenameExtension( GetFilenameFromPath(inputFilename) );
-                    expectImplOutputFilepath = expectHeaderOutputFilepath + baseFilename + "_expect.cpp";
-                    expectHeaderOutputFilepath += baseFilename + "_expect.hpp";
-                }
-                else
+                outputFilepaths.expectHeader += inputSubdir;
+                if( checkWritable && !inputSubdir.empty() )
                 {
-                    std::string baseFilename = RemoveFilenameExtension( expectHeaderOutputFilepath );
-                    expectImplOutputFilepath = baseFilename + ".cpp";
-                    expectHeaderOutputFilepath = baseFilename + ".hpp";
+                    CreateDirectories( outputFilepaths.expectHeader );
                 }
+                std::string baseFilename = RemoveFilenameExtension( GetFilenameFromPath(inputFilename) );
+                outputFilepaths.expectImpl = outputFilepaths.expectHeader + baseFilename + "_expect.cpp";
+                outputFilepaths.expectHeader += baseFilename + "_expect.hpp";
+            }
+            else
+            {
+                std::string baseFilename = RemoveFilenameExtension( outputFilepaths.expectHeader );
+                outputFilepaths.expectImpl = baseFilename + ".cpp";
+                outputFilepaths.expectHeader = baseFilename + ".hpp";
+            }
 
-                expectHeaderOutputFile.open( expectHeaderOutputFilepath );
+            if( checkWritable )
+            {
+                std::ofstream expectHeaderOutputFile( outputFilepaths.expectHeader, std::ios::app );
                 if( !expectHeaderOutputFile.is_open() )
                 {
-                    std::string errorMsg = "Expectation header output file '" + expectHeaderOutputFilepath + "' could not be opened.";
+                    std::string errorMsg = "Expectation header output file '" + outputFilepaths.expectHeader + "' could not be opened.";
                     throw std::runtime_error( errorMsg );
                 }
 
-                expectImplOutputFile.open( expectImplOutputFilepath );
+                std::ofstream expectImplOutputFile( outputFilepaths.expectImpl, std::ios::app );
                 if( !expectImplOutputFile.is_open() )
                 {
-                    std::string errorMsg = "Expectation implementation output file '" + expectImplOutputFilepath + "' could not be opened.";
+                    std::string errorMsg = "Expectation implementation output file '" + outputFilepaths.expectImpl + "' could not be opened.";
                     throw std::runtime_error( errorMsg );
                 }
             }
         }
+    }
+
+    return outputFilepaths;
+}
+
+static bool PrefilterInput( const std::string &inputFilename, const std::string *inputContents, bool interpretAsCpp )
+{
+    TraceSpan span( "prefilter" );
+    span.AddArgument( "file", inputFilename );
+
+    std::string contents;
+    if( inputContents != nullptr )
+    {
+        contents = *inputContents;
+    }
+    else
+    {
+        std::ifstream inputFile( inputFilename );
+        if( !inputFile.is_open() )
+        {
+            // Let the parser report the error
+            return true;
+        }
+
+        std::stringstream inputFileContents;
+        inputFileContents << inputFile.rdbuf();
+        contents = inputFileContents.str();
+    }
+
+    return MayDeclareMockableFunctions( contents, interpretAsCpp );
+}
+
+bool App::ParseInput( const std::string &inputFilename, cxxopts::Options &options, const Config &config,
+                      const std::vector<std::string> &symbols, Parser::EmittedFunctions &emittedFunctions,
+                      Parser &parser, std::ostream &error, bool &skipped )
+{
+    skipped = false;
+
+    bool interpretAsCpp = InterpretAsCpp( inputFilename, options );
+
+    bool useCpp11 = false;
+    if( options["cpp11"].as<bool>() )
+    {
+        useCpp11 = true;
+    }
+
+    if( options["single-file"].as<bool>() )
+    {
+        parser.EnableSingleFileParse();
+    }
+
+    std::map<std::string, std::string>::const_iterator inputContents = m_inputContents.find( inputFilename );
+    if( inputContents != m_inputContents.end() )
+    {
+        parser.SetInputContents( inputContents->second );
+    }
 
-        bool interpretAsCpp = false;
-        if( options["cpp"].as<bool>() )
+    // In watch mode the inputs are always parsed, because the parser keeps track of the files to be watched
+    if( !options["no-prefilter"].as<bool>() && !options["watch"].as<bool>() &&
+        !PrefilterInput( inputFilename, ( inputContents != m_inputContents.end() ) ? &inputContents->second : nullptr,
+                         interpretAsCpp ) )
+    {
+        // When several input files are processed, those without functions (e.g. headers that only define types) are
+        // just skipped
+        skipped = m_skipInputsWithoutFunctions;
+        if( skipped )
         {
-            interpretAsCpp = true;
+            Parser::ReportNoMockableFunctions( "The input file '" + inputFilename + "'", !symbols.empty(), error, true );
         }
         else
         {
-            size_t extensionIndex = inputFilename.find_last_of(".");
-            if( extensionIndex != std::string::npos )
-            {
-                std::string fileExtension = inputFilename.substr( extensionIndex + 1 );
-                interpretAsCpp = ( cppExtensions.count( fileExtension ) > 0 );
-            }
+            Parser::ReportNoMockableFunctions( "The input file", !symbols.empty(), error );
         }
+        return false;
+    }
+
+    // The parse may still find that the input file does not contain any mockable function (e.g. when it only declares
+    // constructors or templates), which must give the same result as when the pre-filter rules it out
+    if( m_skipInputsWithoutFunctions )
+    {
+        parser.EnableSkipWithoutFunctions();
+    }
+
+    std::string includePath = GetIncludePath( inputFilename );
+    if( !includePath.empty() )
+    {
+        parser.SetIncludePath( includePath );
+    }
+
+    bool parsed = parser.Parse( inputFilename, config, interpretAsCpp, useCpp11, options["include-path"].as<std::vector<std::string>>(), 
+                                options["extra-include"].as<std::vector<std::string>>(), symbols, emittedFunctions, error );
+
+    skipped = !parsed && m_skipInputsWithoutFunctions && parser.IsSkipped();
+
+    return parsed;
+}
+
+static bool WriteOutputFile( const std::string &filepath, const std::string &contents )
+{
+    TraceSpan span( "write" );
+    span.AddArgument( "file", filepath );
+    span.AddArgument( "bytes", contents.size() );
+
+    bool written = WriteFileIfChanged( filepath, contents );
+
+    span.AddArgument( "written", written ? 1 : 0 );
+
+    return written;
+}
+
+bool App::VerifyOutputs( const std::string &inputFilename, const OutputFilepaths &outputFilepaths,
+                         const std::string &mock, const std::string &expectHeader, const std::string &expectImpl )
+{
+    // Outputs written to the console are given the names they would have in the directory of the input file
+    std::string baseFilename = RemoveFilenameExtension( GetFilenameFromPath( inputFilename ) );
+
+    std::vector<OutputVerifier::GeneratedFile> files;
+    if( !outputFilepaths.mock.empty() )
+    {
+        std::string filename = ( outputFilepaths.mock == "@" ) ? baseFilename + "_mock.cpp" :
+                                                                  GetFilenameFromPath( outputFilepaths.mock );
+        files.push_back( { filename, mock, true } );
+    }
+    if( !outputFilepaths.expectHeader.empty() )
+    {
+        std::string implFilename = ( outputFilepaths.expectHeader == "@" ) ? baseFilename + "_expect.cpp" :
+                                                                              GetFilenameFromPath( outputFilepaths.expectImpl );
+        files.push_back( { GetFilenameFromPath( outputFilepaths.expectHeader ), expectHeader, false } );
+        files.push_back( { implFilename, expectImpl, true } );
+    }
+
+    std::map<std::string, std::string>::const_iterator inputContents = m_inputContents.find( inputFilename );
+
+    TraceSpan span( "verification" );
+    span.AddArgument( "file", inputFilename );
+
+    if( !m_verifier->Verify( inputFilename, ( inputContents != m_inputContents.end() ) ? &inputContents->second : nullptr,
+                             files, m_cerr ) )
+    {
+        return false;
+    }
 
-        bool useCpp11 = false;
-        if( options["cpp11"].as<bool>() )
+    cerrColorizer.SetColor( ConsoleColorizer::Color::LIGHT_GREEN );
+    m_cerr << "SUCCESS: ";
+    cerrColorizer.SetColor( ConsoleColorizer::Color::RESET );
+    m_cerr << "Outputs generated for '" << inputFilename << "' verified" << std::endl;
+
+    return true;
+}
+
+bool App::GenerateOutputs( const std::string &inputFilename, const OutputFilepaths &outputFilepaths,
+                           cxxopts::Options &options, const Parser &parser, FingerprintStore *fingerprints )
+{
+    bool profiling = options["profile"].as<bool>();
+    bool podComparators = options["pod-comparators"].as<bool>();
+    bool recordReplay = options["record-replay"].as<bool>();
+
+    std::string genOpts = GetGenerationOptions( options );
+
+    if( fingerprints != nullptr )
+    {
+        parser.UpdateFingerprints( *fingerprints, genOpts, profiling, recordReplay );
+    }
+
+    if( m_resourceReport )
+    {
+        m_resourceReport->AddInput( inputFilename, parser.GetStatistics() );
+    }
+
+    std::ostringstream output;
+    std::ostringstream headerOutput;
+    std::ostringstream implOutput;
+
+    if( !outputFilepaths.mock.empty() )
+    {
         {
-            useCpp11 = true;
-        }
+            TraceSpan span( "emission" );
+            span.AddArgument( "file", inputFilename );
+            span.AddArgument( "output", "mock" );
 
-        Config config( options["underlying-typedef"].as<bool>(),
-                       options["param-override"].as<std::vector<std::string>>(),
-                       options["type-override"].as<std::vector<std::string>>() );
+            parser.GenerateMock( genOpts, profiling, recordReplay, output );
 
-        std::string genOpts = GetGenerationOptions( options );
+            span.AddArgument( "bytes", (uint64_t) output.tellp() );
+        }
 
-        Parser parser;
+        if( outputFilepaths.mock != "@" )
+        {
+            bool written = WriteOutputFile( outputFilepaths.mock, output.str() );
 
-        if( parser.Parse( inputFilename, config, interpretAsCpp, useCpp11, options["include-path"].as<std::vector<std::string>>(), 
-                         options["extra-include"].as<std::vector<std::string>>(),m_cerr ) )
+            cerrColorizer.SetColor( ConsoleColorizer::Color::LIGHT_GREEN );
+            m_cerr << "SUCCESS: ";
+            cerrColorizer.SetColor( ConsoleColorizer::Color::RESET );
+            m_cerr << "Mock generated into '" << outputFilepaths.mock << "'" << ( written ? "" : " (unchanged)" ) << std::endl;
+        }
+        else
         {
-            if( !mockOutputFilepath.empty() )
-            {
-                std::ostringstream output;
-                parser.GenerateMock( genOpts, output );
+            m_cout << output.str();
+        }
+    }
 
-                if( mockOutputFile.is_open() )
-                {
-                    mockOutputFile << output.str();
+    if( !outputFilepaths.expectHeader.empty() )
+    {
+        {
+            TraceSpan span( "emission" );
+            span.AddArgument( "file", inputFilename );
+            span.AddArgument( "output", "expectations" );
 
-                    cerrColorizer.SetColor( ConsoleColorizer::Color::LIGHT_GREEN );
-                    m_cerr << "SUCCESS: ";
-                    cerrColorizer.SetColor( ConsoleColorizer::Color::RESET );
-                    m_cerr << "Mock generated into '" << mockOutputFilepath << "'" << std::endl;
-                }
-                else
-                {
-                    m_cout << output.str();
-                }
-            }
+            parser.GenerateExpectationHeader( genOpts, podComparators, headerOutput );
+            parser.GenerateExpectationImpl( genOpts, outputFilepaths.expectHeader, profiling, podComparators, implOutput );
 
-            if( !expectHeaderOutputFilepath.empty() )
-            {
-                std::ostringstream headerOutput;
-                std::ostringstream implOutput;
-                parser.GenerateExpectationHeader( genOpts, headerOutput );
-                parser.GenerateExpectationImpl( genOpts, expectHeaderOutputFilepath, implOutput );
+            span.AddArgument( "bytes", (uint64_t) headerOutput.tellp() + (uint64_t) implOutput.tellp() );
+        }
 
-                if( expectHeaderOutputFile.is_open() )
-                {
-                    expectHeaderOutputFile << headerOutput.str();
-                    expectImplOutputFile << implOutput.str();
+        if( outputFilepaths.expectHeader != "@" )
+        {
+            bool written = WriteOutputFile( outputFilepaths.expectHeader, headerOutput.str() );
+            written = WriteOutputFile( outputFilepaths.expectImpl, implOutput.str() ) || written;
 
-                    cerrColorizer.SetColor( ConsoleColorizer::Color::LIGHT_GREEN );
-                    m_cerr << "SUCCESS: ";
-                    cerrColorizer.SetColor( ConsoleColorizer::Color::RESET );
-                    m_cerr << "Expectations generated into '" << expectHeaderOutputFilepath << "' and '" << expectImplOutputFilepath << "'" << std::endl;
-                }
-                else
-                {
-                    m_cout << headerOutput.str();
-                    m_cout << implOutput.str();
-                }
-            }
+            cerrColorizer.SetColor( ConsoleColorizer::Color::LIGHT_GREEN );
+            m_cerr << "SUCCESS: ";
+            cerrColorizer.SetColor( ConsoleColorizer::Color::RESET );
+            m_cerr << "Expectations generated into '" << outputFilepaths.expectHeader << "' and '" << outputFilepaths.expectImpl << "'" <<
+                      ( written ? "" : " (unchanged)" ) << std::endl;
         }
         else
         {
-            returnCode = 2;
-            std::string errorMsg = "Output could not be generated due to errors parsing the input file '" + inputFilename + "'.";
-            throw std::runtime_error( errorMsg );
+            m_cout << headerOutput.str();
+            m_cout << implOutput.str();
+        }
+    }
+
+    if( m_verifier )
+    {
+        return VerifyOutputs( inputFilename, outputFilepaths, output.str(), headerOutput.str(), implOutput.str() );
+    }
+
+    return true;
+}
+
+std::string App::GetStampFilepath( const std::string &inputFilename, const OutputFilepaths &outputFilepaths,
+                                  cxxopts::Options &options )
+{
+    // Outputs written to the console or generated from contents not read from disk are always regenerated, as well as
+    // in watch and umbrella modes, which keep or share the parsed translation units
+    if( !options["skip-unchanged"].as<bool>() || options["watch"].as<bool>() || options["umbrella"].as<bool>() ||
+        ( m_inputContents.count( inputFilename ) > 0 ) || ( outputFilepaths.mock == "@" ) ||
+        ( outputFilepaths.expectHeader == "@" ) )
+    {
+        return "";
+    }
+
+    return ( outputFilepaths.mock.empty() ? outputFilepaths.expectHeader : outputFilepaths.mock ) + ".stamp";
+}
+
+uint64_t App::CalculateOptionsFingerprint( const std::string &inputFilename, const OutputFilepaths &outputFilepaths,
+                                           cxxopts::Options &options, const std::vector<std::string> &symbols )
+{
+    std::ostringstream key;
+
+    key << PRODUCT_VERSION_MAJOR_MINOR_PATCH_STR << std::endl;
+    key << GetGenerationOptions( options ) << std::endl;
+    key << InterpretAsCpp( inputFilename, options ) << options["cpp11"].as<bool>() << options["verify"].as<bool>() << std::endl;
+
+    for( const std::string &includePath : options["include-path"].as<std::vector<std::string>>() )
+    {
+        key << "-I" << includePath << std::endl;
+    }
+
+    for( const std::string &extraInclude : options["extra-include"].as<std::vector<std::string>>() )
+    {
+        key << "-i" << extraInclude << std::endl;
+    }
+
+    // The symbols file is referenced by path in the generation options, so its contents have to be taken into account
+    for( const std::string &symbol : symbols )
+    {
+        key << "-s" << symbol << std::endl;
+    }
+
+    key << GetIncludePath( inputFilename ) << std::endl;
+    key << outputFilepaths.mock << std::endl;
+    key << outputFilepaths.expectHeader << std::endl;
+    key << outputFilepaths.expectImpl << std::endl;
+
+    return FingerprintStore::CalculateFingerprint( key.str() );
+}
+
+static uint64_t CalculateContextFingerprint( const Parser::EmittedFunctions &emittedFunctions )
+{
+    std::string ids;
+    for( const std::pair<const std::string, std::string> &emittedFunction : emittedFunctions )
+    {
+        ids += emittedFunction.first;
+        ids += '\n';
+    }
+
+    return FingerprintStore::CalculateFingerprint( ids );
+}
+
+bool App::SkipUnchangedInput( const std::string &inputFilename, const GenerationStamp &stamp, uint64_t contextFingerprint,
+                              Parser::EmittedFunctions &emittedFunctions )
+{
+    // Functions mocked for a previous input file are not mocked again, so the outputs also depend on them
+    if( stamp.GetContextFingerprint() != contextFingerprint )
+    {
+        return false;
+    }
+
+    for( const std::string &id : stamp.GetFunctions() )
+    {
+        emittedFunctions.insert( std::make_pair( id, inputFilename ) );
+    }
+
+    cerrColorizer.SetColor( ConsoleColorizer::Color::LIGHT_GREEN );
+    m_cerr << "SUCCESS: ";
+    cerrColorizer.SetColor( ConsoleColorizer::Color::RESET );
+    m_cerr << "Outputs for '" << inputFilename << "' are up to date" << std::endl;
+
+    return true;
+}
+
+void App::SaveGenerationStamp( const std::string &inputFilename, const std::string &stampFilepath,
+                               const OutputFilepaths &outputFilepaths, uint64_t optionsFingerprint,
+                               uint64_t contextFingerprint, const Parser &parser,
+                               const Parser::EmittedFunctions &emittedFunctions )
+{
+    GenerationStamp stamp( optionsFingerprint, contextFingerprint );
+
+    // A stamp that cannot be checked later must not be kept, otherwise the outputs could be considered up to date
+    bool complete = true;
+    for( const std::string &dependency : parser.GetDependencies() )
+    {
+        complete = complete && stamp.AddDependency( dependency );
+    }
+
+    for( const std::string &output : { outputFilepaths.mock, outputFilepaths.expectHeader, outputFilepaths.expectImpl } )
+    {
+        if( !output.empty() )
+        {
+            complete = complete && stamp.AddOutput( output );
+        }
+    }
+
+    if( !complete )
+    {
+        std::remove( stampFilepath.c_str() );
+        return;
+    }
+
+    for( const std::pair<const std::string, std::string> &emittedFunction : emittedFunctions )
+    {
+        if( emittedFunction.second == inputFilename )
+        {
+            stamp.AddFunction( emittedFunction.first );
+        }
+    }
+
+    stamp.Save( stampFilepath );
+}
+
+bool App::ProcessInput( const std::string &inputFilename, cxxopts::Options &options, const std::vector<std::string> &symbols,
+                        Parser::EmittedFunctions &emittedFunctions, FingerprintStore *fingerprints )
+{
+    OutputFilepaths outputFilepaths = GetOutputFilepaths( inputFilename, options );
+
+    Parser parser;
+
+    // The outputs are not regenerated if the stamp saved with them shows that nothing they depend on has changed
+    std::string stampFilepath = GetStampFilepath( inputFilename, outputFilepaths, options );
+    uint64_t optionsFingerprint = 0;
+    uint64_t contextFingerprint = 0;
+    if( !stampFilepath.empty() )
+    {
+        optionsFingerprint = CalculateOptionsFingerprint( inputFilename, outputFilepaths, options, symbols );
+        contextFingerprint = CalculateContextFingerprint( emittedFunctions );
+
+        GenerationStamp stamp;
+        if( stamp.Load( stampFilepath ) && stamp.IsUpToDate( optionsFingerprint ) &&
+            SkipUnchangedInput( inputFilename, stamp, contextFingerprint, emittedFunctions ) )
+        {
+            return true;
+        }
+
+        parser.EnableDependencyTracking();
+    }
+
+    Config config( options["underlying-typedef"].as<bool>(),
+                   options["param-override"].as<std::vector<std::string>>(),
+                   options["type-override"].as<std::vector<std::string>>() );
+
+    bool skipped;
+    if( !ParseInput( inputFilename, options, config, symbols, emittedFunctions, parser, m_cerr, skipped ) )
+    {
+        return skipped;
+    }
+
+    if( !GenerateOutputs( inputFilename, outputFilepaths, options, parser, fingerprints ) )
+    {
+        std::string errorMsg = "The outputs generated for the input file '" + inputFilename + "' do not compile.";
+        throw std::runtime_error( errorMsg );
+    }
+
+    if( !stampFilepath.empty() )
+    {
+        SaveGenerationStamp( inputFilename, stampFilepath, outputFilepaths, optionsFingerprint, contextFingerprint,
+                             parser, emittedFunctions );
+    }
+
+    return true;
+}
+
+void App::ProcessInputsConcurrently( const std::vector<std::string> &inputFilenames, cxxopts::Options &options,
+                                     const std::vector<std::string> &symbols, Parser::EmittedFunctions &emittedFunctions,
+                                     FingerprintStore *fingerprints, int &returnCode )
+{
+    struct Job
+    {
+        std::unique_ptr<Config> config;
+        Parser parser;
+        bool parsed;
+        bool skipped;
+        std::ostringstream error;
+        std::string stampFilepath;
+        uint64_t optionsFingerprint;
+        GenerationStamp stamp;
+        bool unchanged;
+    };
+
+    std::vector<Job> jobs( inputFilenames.size() );
+
+    uint64_t memoryBudget = 0;
+    if( options.count( "memory-budget" ) )
+    {
+        memoryBudget = static_cast<uint64_t>( options["memory-budget"].as<unsigned int>() ) * 1024 * 1024;
+    }
+
+    BatchExecutor executor( options["jobs"].as<unsigned int>(), memoryBudget, std::getenv( "MAKEFLAGS" ) );
+
+    // The memory used to parse each input file in the previous run is used to schedule the parsing
+    std::vector<uint64_t> memoryCosts;
+    if( fingerprints != nullptr )
+    {
+        for( const std::string &inputFilename : inputFilenames )
+        {
+            memoryCosts.push_back( fingerprints->GetPreviousMemoryUsage( inputFilename ) );
+        }
+    }
+
+    auto parseJob = [&]( size_t i, std::ostream &error )
+    {
+        Parser::EmittedFunctions inputEmittedFunctions;
+
+        if( !jobs[i].stampFilepath.empty() )
+        {
+            jobs[i].parser.EnableDependencyTracking();
+        }
+
+        jobs[i].config.reset( new Config( options["underlying-typedef"].as<bool>(),
+                                          options["param-override"].as<std::vector<std::string>>(),
+                                          options["type-override"].as<std::vector<std::string>>() ) );
+        jobs[i].parsed = ParseInput( inputFilenames[i], options, *jobs[i].config, symbols, inputEmittedFunctions,
+                                     jobs[i].parser, error, jobs[i].skipped );
+    };
+
+    // Input files are parsed concurrently, each one with its own table of emitted functions, while duplicate
+    // functions are removed and outputs are generated in the order of the input files
+    executor.Execute( inputFilenames.size(), memoryCosts,
+        [&]( size_t i )
+        {
+            OutputFilepaths outputFilepaths = GetOutputFilepaths( inputFilenames[i], options, false );
+
+            jobs[i].unchanged = false;
+            jobs[i].stampFilepath = GetStampFilepath( inputFilenames[i], outputFilepaths, options );
+            if( !jobs[i].stampFilepath.empty() )
+            {
+                jobs[i].optionsFingerprint = CalculateOptionsFingerprint( inputFilenames[i], outputFilepaths, options, symbols );
+                jobs[i].unchanged = jobs[i].stamp.Load( jobs[i].stampFilepath ) &&
+                                    jobs[i].stamp.IsUpToDate( jobs[i].optionsFingerprint );
+            }
+
+            // Whether the outputs of an unchanged input file can be kept is only known once the previous input files
+            // have been processed, so its parsing is deferred until then
+            if( !jobs[i].unchanged )
+            {
+                parseJob( i, jobs[i].error );
+            }
+        },
+        [&]( size_t i )
+        {
+            m_cerr << jobs[i].error.str();
+
+            OutputFilepaths outputFilepaths = GetOutputFilepaths( inputFilenames[i], options );
+
+            uint64_t contextFingerprint = CalculateContextFingerprint( emittedFunctions );
+            if( jobs[i].unchanged )
+            {
+                if( SkipUnchangedInput( inputFilenames[i], jobs[i].stamp, contextFingerprint, emittedFunctions ) )
+                {
+                    return;
+                }
+
+                parseJob( i, m_cerr );
+            }
+
+            // Input files left without functions once the emitted functions are removed are skipped too
+            if( jobs[i].parsed && !jobs[i].parser.RemoveEmittedFunctions( emittedFunctions, m_cerr ) )
+            {
+                jobs[i].parsed = false;
+                jobs[i].skipped = m_skipInputsWithoutFunctions && jobs[i].parser.IsSkipped();
+            }
+
+            if( jobs[i].skipped )
+            {
+                return;
+            }
+
+            if( !jobs[i].parsed )
+            {
+                returnCode = 2;
+                std::string errorMsg = "Output could not be generated due to errors parsing the input file '" + inputFilenames[i] + "'.";
+                throw std::runtime_error( errorMsg );
+            }
+
+            if( !GenerateOutputs( inputFilenames[i], outputFilepaths, options, jobs[i].parser, fingerprints ) )
+            {
+                std::string errorMsg = "The outputs generated for the input file '" + inputFilenames[i] + "' do not compile.";
+                throw std::runtime_error( errorMsg );
+            }
+
+            if( !jobs[i].stampFilepath.empty() )
+            {
+                SaveGenerationStamp( inputFilenames[i], jobs[i].stampFilepath, outputFilepaths, jobs[i].optionsFingerprint,
+                                     contextFingerprint, jobs[i].parser, emittedFunctions );
+            }
+
+            // Release the parsed functions as soon as possible
+            jobs[i].parser = Parser();
+        } );
+}
+
+void App::ProcessInputsUmbrella( const std::vector<std::string> &inputFilenames, cxxopts::Options &options,
+                                 const std::vector<std::string> &symbols, Parser::EmittedFunctions &emittedFunctions,
+                                 FingerprintStore *fingerprints, int &returnCode )
+{
+    Config config( options["underlying-typedef"].as<bool>(),
+                   options["param-override"].as<std::vector<std::string>>(),
+                   options["type-override"].as<std::vector<std::string>>() );
+
+    // C and C++ input files cannot be parsed in the same translation unit
+    for( bool interpretAsCpp : { false, true } )
+    {
+        std::vector<std::string> umbrellaInputFilenames;
+        std::vector<OutputFilepaths> outputFilepaths;
+        for( const std::string &inputFilename : inputFilenames )
+        {
+            if( InterpretAsCpp( inputFilename, options ) == interpretAsCpp )
+            {
+                umbrellaInputFilenames.push_back( inputFilename );
+                outputFilepaths.push_back( GetOutputFilepaths( inputFilename, options ) );
+            }
+        }
+
+        if( umbrellaInputFilenames.empty() )
+        {
+            continue;
+        }
+
+        std::vector<Parser> parsers( umbrellaInputFilenames.size() );
+        for( size_t i = 0; i < parsers.size(); i++ )
+        {
+            if( m_skipInputsWithoutFunctions )
+            {
+                parsers[i].EnableSkipWithoutFunctions();
+            }
+
+            std::string includePath = GetIncludePath( umbrellaInputFilenames[i] );
+            if( !includePath.empty() )
+            {
+                parsers[i].SetIncludePath( includePath );
+            }
+        }
+
+        if( !Parser::ParseUmbrella( umbrellaInputFilenames, config, interpretAsCpp, options["cpp11"].as<bool>(),
+                                    options["include-path"].as<std::vector<std::string>>(),
+                                    options["extra-include"].as<std::vector<std::string>>(), symbols, emittedFunctions,
+                                    parsers, m_cerr ) )
+        {
+            returnCode = 2;
+            throw std::runtime_error( "Output could not be generated due to errors parsing the input files." );
+        }
+
+        for( size_t i = 0; i < parsers.size(); i++ )
+        {
+            if( m_skipInputsWithoutFunctions && parsers[i].IsSkipped() )
+            {
+                continue;
+            }
+
+            if( !GenerateOutputs( umbrellaInputFilenames[i], outputFilepaths[i], options, parsers[i], fingerprints ) )
+            {
+                std::string errorMsg = "The outputs generated for the input file '" + umbrellaInputFilenames[i] + "' do not compile.";
+                throw std::runtime_error( errorMsg );
+            }
+        }
+    }
+}
+
+void App::WatchInputs( const std::vector<std::string> &inputFilenames, cxxopts::Options &options,
+                       const std::vector<std::string> &symbols, FingerprintStore *fingerprints )
+{
+    struct WatchedInput
+    {
+        OutputFilepaths outputFilepaths;
+        Parser parser;
+    };
+
+    std::vector<WatchedInput> inputs( inputFilenames.size() );
+
+    Config config( options["underlying-typedef"].as<bool>(),
+                   options["param-override"].as<std::vector<std::string>>(),
+                   options["type-override"].as<std::vector<std::string>>() );
+
+    // Functions declared in several input files are only mocked for the first one (in command line order)
+    Parser::EmittedFunctions emittedFunctions;
+
+    // Errors parsing the input files or verifying the outputs are reported, but they do not stop watching, because they
+    // are expected to be fixed in the next changes
+    for( size_t i = 0; i < inputFilenames.size(); i++ )
+    {
+        inputs[i].outputFilepaths = GetOutputFilepaths( inputFilenames[i], options );
+        inputs[i].parser.EnableReparse();
+
+        bool skipped;
+        if( ParseInput( inputFilenames[i], options, config, symbols, emittedFunctions, inputs[i].parser, m_cerr, skipped ) )
+        {
+            if( !GenerateOutputs( inputFilenames[i], inputs[i].outputFilepaths, options, inputs[i].parser, fingerprints ) )
+            {
+                std::string errorMsg = "The outputs generated for the input file '" + inputFilenames[i] + "' do not compile.";
+                PrintError( errorMsg.c_str() );
+            }
+        }
+        else if( !skipped )
+        {
+            std::string errorMsg = "Output could not be generated due to errors parsing the input file '" + inputFilenames[i] + "'.";
+            PrintError( errorMsg.c_str() );
+        }
+    }
+
+    if( fingerprints != nullptr )
+    {
+        PrintFingerprintDifferences( *fingerprints );
+        fingerprints->Save( options["fingerprints"].as<std::string>() );
+    }
+
+    if( m_resourceReport )
+    {
+        m_resourceReport->Save( options["resource-report"].as<std::string>() );
+    }
+
+    if( options.count( "trace" ) )
+    {
+        TraceRecorder::Save( options["trace"].as<std::string>() );
+        TraceRecorder::Stop();
+    }
+
+    FileWatcher watcher;
+    std::vector<std::string> changedFilepaths;
+    do
+    {
+        // The first input file that depends on the changed files and all the following ones are parsed again, reusing
+        // their translation units, because a function no longer declared by the changed input file must then be mocked
+        // for the next input file that declares it; the functions mocked for the previous input files are kept
+        std::set<std::string> changes( changedFilepaths.begin(), changedFilepaths.end() );
+        std::vector<std::string> watchedFilepaths;
+        size_t firstReparsedInput = inputFilenames.size();
+        for( size_t i = 0; i < inputFilenames.size(); i++ )
+        {
+            std::vector<std::string> dependencies = inputs[i].parser.GetDependencies();
+            if( ( i > firstReparsedInput ) ||
+                std::any_of( dependencies.begin(), dependencies.end(),
+                             [&]( const std::string &dependency ) { return changes.count( dependency ) > 0; } ) )
+            {
+                if( firstReparsedInput == inputFilenames.size() )
+                {
+                    firstReparsedInput = i;
+
+                    std::set<std::string> reparsedInputs( inputFilenames.begin() + i, inputFilenames.end() );
+                    for( Parser::EmittedFunctions::iterator it = emittedFunctions.begin(); it != emittedFunctions.end(); )
+                    {
+                        if( reparsedInputs.count( it->second ) > 0 )
+                        {
+                            it = emittedFunctions.erase( it );
+                        }
+                        else
+                        {
+                            ++it;
+                        }
+                    }
+                }
+
+                if( inputs[i].parser.Reparse( config, symbols, emittedFunctions, m_cerr ) )
+                {
+                    if( !GenerateOutputs( inputFilenames[i], inputs[i].outputFilepaths, options, inputs[i].parser, nullptr ) )
+                    {
+                        std::string errorMsg = "The outputs generated for the input file '" + inputFilenames[i] + "' do not compile.";
+                        PrintError( errorMsg.c_str() );
+                    }
+                }
+                else if( !m_skipInputsWithoutFunctions || !inputs[i].parser.IsSkipped() )
+                {
+                    std::string errorMsg = "Output could not be generated due to errors parsing the input file '" + inputFilenames[i] + "'.";
+                    PrintError( errorMsg.c_str() );
+                }
+
+                dependencies = inputs[i].parser.GetDependencies();
+            }
+
+            watchedFilepaths.insert( watchedFilepaths.end(), dependencies.begin(), dependencies.end() );
+        }
+
+        watcher.SetWatchedFiles( watchedFilepaths );
+    }
+    while( watcher.WaitForChanges( changedFilepaths ) );
+
+    throw std::runtime_error( "Changes to the input files could not be watched." );
+}
+
+int App::Execute( int argc, const char* argv[] )
+{
+    int returnCode = 0;
+
+    cxxopts::Options options("CppUMockGen", "Mock generator for CppUTest");
+
+    options.add_options()
+        ( "i,input", "Input file", cxxopts::value<std::vector<std::string>>(), "<input>" )
+        ( "input-dir", "Process the headers found in the directory tree, mirroring its layout in the output directories", cxxopts::value<std::string>(), "<dir>" )
+        ( "include-glob", "Only process the files in the input directory tree whose paths match the glob (by default *.h, *.hh, *.hpp and *.hxx)", cxxopts::value<std::vector<std::string>>(), "<glob>" )
+        ( "exclude-glob", "Skip the files and subdirectories in the input directory tree whose paths match the glob", cxxopts::value<std::vector<std::string>>(), "<glob>" )
+        ( "m,mock-output", "Mock output path", cxxopts::value<std::string>()->implicit_value(""), "<mock-output>" )
+        ( "e,expect-output", "Expectation output path", cxxopts::value<std::string>()->implicit_value(""), "<expect-output>" )
+        ( "x,cpp", "Force interpretation of the input file as C++", cxxopts::value<bool>(), "<force-cpp>" )
+        ( "u,underlying-typedef", "Use underlying typedef type", cxxopts::value<bool>(), "[<underlying-typedef>]" )
+        ( "I,include-path", "Include path", cxxopts::value<std::vector<std::string>>(), "<path>" )
+        ( "p,param-override", "Override parameter type", cxxopts::value<std::vector<std::string>>(), "<expr>" )
+        ( "t,type-override", "Override generic type", cxxopts::value<std::vector<std::string>>(), "<expr>" )
+        ( "h,help", "Print help" )
+        ( "y,extra-include", "Extra include file", cxxopts::value<std::vector<std::string>>(), "<path>" )
+        ( "l,cpp11", "Interpretation of the input file as C++11", cxxopts::value<bool>(), "<cpp11>" )
+        ( "profile", "Instrument mocks and expectations with call-count profiling", cxxopts::value<bool>() )
+        ( "pod-comparators", "Generate memcmp based comparators and copiers for POD record types", cxxopts::value<bool>() )
+        ( "record-replay", "Generate record (real function wrapper) and replay paths for C mocks", cxxopts::value<bool>() )
+        ( "symbols", "Only mock the functions whose symbols are listed in the file (e.g. output of nm -u)", cxxopts::value<std::string>(), "<file>" )
+        ( "fingerprints", "Report functions added, removed or changed since the run that saved the fingerprints file", cxxopts::value<std::string>(), "<file>" )
+        ( "shard", "Only process the inputs assigned to the given shard (e.g. 2/4)", cxxopts::value<std::string>(), "<index>/<count>" )
+        ( "j,jobs", "Parse input files concurrently using up to the given number of jobs (0 = number of hardware threads)", cxxopts::value<unsigned int>(), "<count>" )
+        ( "memory-budget", "Limit the memory expected to be used by concurrent parses (requires --jobs and --fingerprints)", cxxopts::value<unsigned int>(), "<MiB>" )
+        ( "watch", "Keep regenerating the outputs when the input files or the files included by them change", cxxopts::value<bool>() )
+        ( "umbrella", "Parse all the input files in a single translation unit", cxxopts::value<bool>() )
+        ( "single-file", "Parse only the input files, without expanding the files included by them", cxxopts::value<bool>() )
+        ( "stdin-name", "Virtual name of the input file read from the standard input (input '-'), by default 'stdin.h'", cxxopts::value<std::string>(), "<name>" )
+        ( "libclang", "Path of the libclang shared library to be used, instead of the one found at build time", cxxopts::value<std::string>(), "<path>" )
+        ( "verify", "Compile the generated outputs in memory to check that they are valid", cxxopts::value<bool>() )
+        ( "resource-report", "Write the memory used by libclang and the process to parse each input file (CSV, or JSON if the extension is .json)", cxxopts::value<std::string>(), "<file>" )
+        ( "trace", "Write the timeline of the processing of each input file in Chrome trace event format (JSON)", cxxopts::value<std::string>(), "<file>" )
+        ( "no-prefilter", "Parse the input files even if a quick scan finds that they cannot declare any mockable function", cxxopts::value<bool>() )
+        ( "skip-unchanged", "Skip regenerating the outputs of the input files whose tokens, included files and options did not change since the previous run", cxxopts::value<bool>() );
+ 
+    options.positional_help( "<input>..." );
+    options.parse_positional( std::vector<std::string> { "input" } );
+
+    try
+    {
+        options.parse( argc, const_cast<char**&>(argv) );
+
+        if( options.count("help") )
+        {
+            m_cerr << options.help();
+            return 0;
+        }
+
+        if( !options.count( "input" ) && !options.count( "input-dir" ) )
+        {
+            throw std::runtime_error( "No input file specified." );
+        }
+
+        if( ( options.count( "mock-output" ) + options.count( "expect-output" ) ) == 0 )
+        {
+            throw std::runtime_error( "At least the mock generation option (-m) or the expectation generation option (-e) must be specified." );
+        }
+
+        std::vector<std::string> inputFilenames = options["input"].as<std::vector<std::string>>();
+
+        // The input file '-' is read from the standard input, and is given a virtual name that is used to name the
+        // outputs and to include it from them
+        std::vector<std::string>::iterator stdinInput = std::find( inputFilenames.begin(), inputFilenames.end(), "-" );
+        if( stdinInput != inputFilenames.end() )
+        {
+            if( std::count( inputFilenames.begin(), inputFilenames.end(), "-" ) > 1 )
+            {
+                throw std::runtime_error( "The standard input (-) can only be specified once as input file." );
+            }
+
+            if( options["watch"].as<bool>() || options["umbrella"].as<bool>() )
+            {
+                throw std::runtime_error( "The standard input (-) cannot be used as input file with the watch option (--watch) or the umbrella option (--umbrella)." );
+            }
+
+            *stdinInput = options.count( "stdin-name" ) ? options["stdin-name"].as<std::string>() : "stdin.h";
+
+            std::ostringstream stdinContents;
+            stdinContents << m_cin.rdbuf();
+            m_inputContents[ *stdinInput ] = stdinContents.str();
+        }
+
+        if( options.count( "input-dir" ) )
+        {
+            // The layout of the input directory tree is mirrored into the output directories
+            for( const char *outputOption : { "mock-output", "expect-output" } )
+            {
+                if( options.count( outputOption ) )
+                {
+                    std::string outputPath = options[outputOption].as<std::string>();
+                    if( ( outputPath != "@" ) && !outputPath.empty() && !IsDirPath( outputPath ) )
+                    {
+                        throw std::runtime_error( "When an input directory is specified, output paths must be directories." );
+                    }
+                }
+            }
+
+            std::vector<std::string> treeInputFilenames = FindInputsInTree( options );
+            inputFilenames.insert( inputFilenames.end(), treeInputFilenames.begin(), treeInputFilenames.end() );
+        }
+
+        m_skipInputsWithoutFunctions = ( inputFilenames.size() > 1 ) || options.count( "input-dir" );
+
+        if( inputFilenames.size() > 1 )
+        {
+            // Output filenames must be derived from each input filename
+            for( const char *outputOption : { "mock-output", "expect-output" } )
+            {
+                if( options.count( outputOption ) )
+                {
+                    std::string outputPath = options[outputOption].as<std::string>();
+                    if( ( outputPath != "@" ) && !outputPath.empty() && !IsDirPath( outputPath ) )
+                    {
+                        throw std::runtime_error( "When multiple input files are specified, output paths must be directories." );
+                    }
+                }
+            }
+        }
+
+        if( options.count( "memory-budget" ) && !options.count( "jobs" ) )
+        {
+            throw std::runtime_error( "The memory budget option (--memory-budget) requires the jobs option (-j)." );
+        }
+
+        if( options["watch"].as<bool>() && options.count( "jobs" ) )
+        {
+            throw std::runtime_error( "The watch option (--watch) cannot be used with the jobs option (-j)." );
+        }
+
+        if( options["umbrella"].as<bool>() && ( options.count( "jobs" ) || options["watch"].as<bool>() ) )
+        {
+            throw std::runtime_error( "The umbrella option (--umbrella) cannot be used with the jobs option (-j) or the watch option (--watch)." );
+        }
+
+        if( options["umbrella"].as<bool>() && options["single-file"].as<bool>() )
+        {
+            throw std::runtime_error( "The umbrella option (--umbrella) cannot be used with the single file option (--single-file)." );
+        }
+
+        if( options.count( "libclang" ) )
+        {
+            SetLibClangPath( options["libclang"].as<std::string>() );
+        }
+
+        if( options["verify"].as<bool>() )
+        {
+            m_verifier.reset( new OutputVerifier( options["include-path"].as<std::vector<std::string>>(),
+                                                  options["extra-include"].as<std::vector<std::string>>() ) );
+        }
+
+        if( options.count( "resource-report" ) )
+        {
+            m_resourceReport.reset( new ResourceReport() );
+        }
+
+        if( options.count( "trace" ) )
+        {
+            TraceRecorder::Start();
+        }
+
+        std::vector<std::string> symbols;
+        if( options.count( "symbols" ) )
+        {
+            symbols = ReadSymbolsFile( options["symbols"].as<std::string>() );
+        }
+
+        // Functions declared in several input files are only mocked for the first one (in command line order)
+        Parser::EmittedFunctions emittedFunctions;
+
+        FingerprintStore fingerprints;
+        if( options.count( "fingerprints" ) )
+        {
+            fingerprints.Load( options["fingerprints"].as<std::string>() );
+        }
+
+        if( options.count( "shard" ) )
+        {
+            unsigned int shardIndex;
+            unsigned int shardCount;
+            ParseShardOption( options["shard"].as<std::string>(), shardIndex, shardCount );
+            inputFilenames = SelectShardInputs( inputFilenames, shardIndex, shardCount );
+        }
+
+        if( options["watch"].as<bool>() )
+        {
+            WatchInputs( inputFilenames, options, symbols, ( options.count( "fingerprints" ) ? &fingerprints : nullptr ) );
+        }
+        else if( options["umbrella"].as<bool>() )
+        {
+            ProcessInputsUmbrella( inputFilenames, options, symbols, emittedFunctions,
+                                   ( options.count( "fingerprints" ) ? &fingerprints : nullptr ), returnCode );
+        }
+        else if( options.count( "jobs" ) )
+        {
+            ProcessInputsConcurrently( inputFilenames, options, symbols, emittedFunctions,
+                                       ( options.count( "fingerprints" ) ? &fingerprints : nullptr ), returnCode );
+        }
+        else
+        {
+            for( const std::string &inputFilename : inputFilenames )
+            {
+                if( !ProcessInput( inputFilename, options, symbols, emittedFunctions,
+                                   ( options.count( "fingerprints" ) ? &fingerprints : nullptr ) ) )
+                {
+                    returnCode = 2;
+                    std::string errorMsg = "Output could not be generated due to errors parsing the input file '" + inputFilename + "'.";
+                    throw std::runtime_error( errorMsg );
+                }
+            }
+        }
+
+        if( options.count( "fingerprints" ) )
+        {
+            PrintFingerprintDifferences( fingerprints );
+            fingerprints.Save( options["fingerprints"].as<std::string>() );
+        }
+
+        if( m_resourceReport )
+        {
+            m_resourceReport->Save( options["resource-report"].as<std::string>() );
+        }
+
+        if( options.count( "trace" ) )
+        {
+            TraceRecorder::Save( options["trace"].as<std::string>() );
+            TraceRecorder::Stop();
         }
     }
     catch(std::exception &e)
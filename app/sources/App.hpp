@@ -1,20 +1,99 @@
 #ifndef CPPUMOCKGEN_APP_HPP_
 #define CPPUMOCKGEN_APP_HPP_
 
-#include <ostream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include "Parser.hpp"
+
+namespace cxxopts
+{
+    class Options;
+}
+
+class FingerprintStore;
+class Config;
+class OutputVerifier;
+class ResourceReport;
+class GenerationStamp;
 
 class App
 {
 public:
-    App( std::ostream &cout, std::ostream &cerr );
+    App( std::ostream &cout, std::ostream &cerr, std::istream &cin = std::cin );
+
+    ~App();
 
     int Execute( int argc, const char* argv[] );
 
 private:
     void PrintError( const char *msg );
+    void PrintFingerprintDifferences( const FingerprintStore &fingerprints );
+
+    struct OutputFilepaths
+    {
+        std::string mock;
+        std::string expectHeader;
+        std::string expectImpl;
+    };
+
+    std::vector<std::string> FindInputsInTree( cxxopts::Options &options );
+
+    std::string GetIncludePath( const std::string &inputFilename ) const;
+
+    OutputFilepaths GetOutputFilepaths( const std::string &inputFilename, cxxopts::Options &options, bool checkWritable = true );
+
+    std::string GetStampFilepath( const std::string &inputFilename, const OutputFilepaths &outputFilepaths,
+                                  cxxopts::Options &options );
+
+    uint64_t CalculateOptionsFingerprint( const std::string &inputFilename, const OutputFilepaths &outputFilepaths,
+                                          cxxopts::Options &options, const std::vector<std::string> &symbols );
+
+    bool SkipUnchangedInput( const std::string &inputFilename, const GenerationStamp &stamp, uint64_t contextFingerprint,
+                             Parser::EmittedFunctions &emittedFunctions );
+
+    void SaveGenerationStamp( const std::string &inputFilename, const std::string &stampFilepath,
+                              const OutputFilepaths &outputFilepaths, uint64_t optionsFingerprint,
+                              uint64_t contextFingerprint, const Parser &parser,
+                              const Parser::EmittedFunctions &emittedFunctions );
+
+    bool ParseInput( const std::string &inputFilename, cxxopts::Options &options, const Config &config,
+                     const std::vector<std::string> &symbols, Parser::EmittedFunctions &emittedFunctions,
+                     Parser &parser, std::ostream &error, bool &skipped );
+
+    bool GenerateOutputs( const std::string &inputFilename, const OutputFilepaths &outputFilepaths,
+                          cxxopts::Options &options, const Parser &parser, FingerprintStore *fingerprints );
+
+    bool VerifyOutputs( const std::string &inputFilename, const OutputFilepaths &outputFilepaths,
+                        const std::string &mock, const std::string &expectHeader, const std::string &expectImpl );
+
+    bool ProcessInput( const std::string &inputFilename, cxxopts::Options &options, const std::vector<std::string> &symbols,
+                       Parser::EmittedFunctions &emittedFunctions, FingerprintStore *fingerprints );
+
+    void ProcessInputsConcurrently( const std::vector<std::string> &inputFilenames, cxxopts::Options &options,
+                                    const std::vector<std::string> &symbols, Parser::EmittedFunctions &emittedFunctions,
+                                    FingerprintStore *fingerprints, int &returnCode );
+
+    void ProcessInputsUmbrella( const std::vector<std::string> &inputFilenames, cxxopts::Options &options,
+                                const std::vector<std::string> &symbols, Parser::EmittedFunctions &emittedFunctions,
+                                FingerprintStore *fingerprints, int &returnCode );
+
+    void WatchInputs( const std::vector<std::string> &inputFilenames, cxxopts::Options &options,
+                      const std::vector<std::string> &symbols, FingerprintStore *fingerprints );
 
     std::ostream &m_cout;
     std::ostream &m_cerr;
+    std::istream &m_cin;
+
+    std::map<std::string, std::string> m_inputContents; // Contents of the input files not read from disk, by name
+    std::map<std::string, std::string> m_inputSubdirs;  // Subdirectories of the input files found in the input directory tree, by name
+    bool m_skipInputsWithoutFunctions = false;          // Input files ruled out by the pre-filter are skipped instead of failing
+    std::unique_ptr<OutputVerifier> m_verifier;         // Only created if the outputs have to be verified
+    std::unique_ptr<ResourceReport> m_resourceReport;   // Only created if the resource usage has to be reported
 };
 
 #endif // header guard
@@ -0,0 +1,387 @@
+#include "BatchExecutor.hpp"
+
+#include <sstream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <condition_variable>
+#include <exception>
+#include <cstdio>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+// Period to check if the implicit job slot has been released while waiting for a slot from the jobserver
+static const unsigned int SLOT_POLL_PERIOD_MS = 100;
+
+BatchExecutor::BatchExecutor( unsigned int maxJobs, uint64_t memoryBudget, const char *makeFlags )
+: m_maxJobs( maxJobs ), m_memoryBudget( memoryBudget ), m_implicitSlotFree( true )
+#ifdef WIN32
+, m_jobServerSemaphore( NULL )
+#else
+, m_jobServerReadFd( -1 ), m_jobServerWriteFd( -1 ), m_jobServerFdsOwned( false )
+#endif
+{
+    if( m_maxJobs == 0 )
+    {
+        m_maxJobs = std::max( std::thread::hardware_concurrency(), 1u );
+    }
+
+    // The jobserver is passed as "--jobserver-auth=<auth>" (or "--jobserver-fds=<auth>" by make versions older
+    // than 4.2) in MAKEFLAGS, where the last occurrence takes precedence
+    std::string jobServerAuth;
+    if( makeFlags != nullptr )
+    {
+        std::istringstream makeFlagsStream( makeFlags );
+        std::string flag;
+        while( makeFlagsStream >> flag )
+        {
+            for( const char *prefix : { "--jobserver-auth=", "--jobserver-fds=" } )
+            {
+                if( flag.compare( 0, std::string( prefix ).size(), prefix ) == 0 )
+                {
+                    jobServerAuth = flag.substr( std::string( prefix ).size() );
+                }
+            }
+        }
+    }
+
+    if( !jobServerAuth.empty() )
+    {
+        ConnectJobServer( jobServerAuth );
+    }
+}
+
+BatchExecutor::~BatchExecutor()
+{
+#ifdef WIN32
+    if( m_jobServerSemaphore != NULL )
+    {
+        CloseHandle( m_jobServerSemaphore );
+    }
+#else
+    if( m_jobServerFdsOwned )
+    {
+        close( m_jobServerReadFd );
+    }
+#endif
+}
+
+#ifdef WIN32
+
+void BatchExecutor::ConnectJobServer( const std::string &auth )
+{
+    // On Windows the jobserver is a named semaphore
+    m_jobServerSemaphore = OpenSemaphoreA( SEMAPHORE_ALL_ACCESS, FALSE, auth.c_str() );
+}
+
+bool BatchExecutor::IsUsingJobServer() const
+{
+    return ( m_jobServerSemaphore != NULL );
+}
+
+int BatchExecutor::AcquireSlot()
+{
+    while( true )
+    {
+        {
+            std::lock_guard<std::mutex> lock( m_slotMutex );
+            if( m_implicitSlotFree )
+            {
+                m_implicitSlotFree = false;
+                return IMPLICIT_SLOT;
+            }
+        }
+
+        if( WaitForSingleObject( m_jobServerSemaphore, SLOT_POLL_PERIOD_MS ) == WAIT_OBJECT_0 )
+        {
+            return 0;
+        }
+    }
+}
+
+void BatchExecutor::ReleaseSlot( int slot )
+{
+    if( slot == IMPLICIT_SLOT )
+    {
+        std::lock_guard<std::mutex> lock( m_slotMutex );
+        m_implicitSlotFree = true;
+    }
+    else
+    {
+        ReleaseSemaphore( m_jobServerSemaphore, 1, NULL );
+    }
+}
+
+#else
+
+void BatchExecutor::ConnectJobServer( const std::string &auth )
+{
+    static const std::string FIFO_PREFIX = "fifo:";
+
+    if( auth.compare( 0, FIFO_PREFIX.size(), FIFO_PREFIX ) == 0 )
+    {
+        // Since make 4.4 the jobserver may be a named pipe, that must be opened by each client
+        int fd = open( auth.substr( FIFO_PREFIX.size() ).c_str(), O_RDWR | O_CLOEXEC | O_NONBLOCK );
+        if( fd >= 0 )
+        {
+            m_jobServerReadFd = fd;
+            m_jobServerWriteFd = fd;
+            m_jobServerFdsOwned = true;
+        }
+    }
+    else
+    {
+        // Otherwise the jobserver is an anonymous pipe inherited from make, whose descriptors are only valid if
+        // make considered this a recursive invocation (i.e. the recipe is prefixed with '+' or uses $(MAKE))
+        int readFd;
+        int writeFd;
+        if( ( std::sscanf( auth.c_str(), "%d,%d", &readFd, &writeFd ) == 2 ) && ( readFd >= 0 ) && ( writeFd >= 0 ) &&
+            ( fcntl( readFd, F_GETFD ) != -1 ) && ( fcntl( writeFd, F_GETFD ) != -1 ) )
+        {
+            m_jobServerReadFd = readFd;
+            m_jobServerWriteFd = writeFd;
+        }
+    }
+}
+
+bool BatchExecutor::IsUsingJobServer() const
+{
+    return ( m_jobServerReadFd >= 0 );
+}
+
+int BatchExecutor::AcquireSlot()
+{
+    while( true )
+    {
+        {
+            std::lock_guard<std::mutex> lock( m_slotMutex );
+            if( m_implicitSlotFree )
+            {
+                m_implicitSlotFree = false;
+                return IMPLICIT_SLOT;
+            }
+        }
+
+        struct pollfd pollFd = { m_jobServerReadFd, POLLIN, 0 };
+        int pollResult = poll( &pollFd, 1, SLOT_POLL_PERIOD_MS );
+        if( ( pollResult > 0 ) && ( pollFd.revents & POLLIN ) )
+        {
+            // Another client may take the token first, in which case read fails (non-blocking) or waits for the next one
+            unsigned char token;
+            if( read( m_jobServerReadFd, &token, 1 ) == 1 )
+            {
+                return token;
+            }
+        }
+        else if( pollResult > 0 )
+        {
+            // The jobserver has been closed, only the implicit slot remains available
+            std::this_thread::sleep_for( std::chrono::milliseconds( SLOT_POLL_PERIOD_MS ) );
+        }
+    }
+}
+
+void BatchExecutor::ReleaseSlot( int slot )
+{
+    if( slot == IMPLICIT_SLOT )
+    {
+        std::lock_guard<std::mutex> lock( m_slotMutex );
+        m_implicitSlotFree = true;
+    }
+    else
+    {
+        // The same token must be returned to the jobserver
+        unsigned char token = static_cast<unsigned char>( slot );
+        while( ( write( m_jobServerWriteFd, &token, 1 ) < 0 ) && ( ( errno == EINTR ) || ( errno == EAGAIN ) ) )
+        {
+        }
+    }
+}
+
+#endif
+
+unsigned int BatchExecutor::GetMaxJobs() const
+{
+    return m_maxJobs;
+}
+
+uint64_t BatchExecutor::GetMemoryBudget() const
+{
+    return m_memoryBudget;
+}
+
+void BatchExecutor::Execute( size_t jobCount, const std::vector<uint64_t> &jobMemoryCosts,
+                             const std::function<void(size_t)> &parallelStep,
+                             const std::function<void(size_t)> &orderedStep )
+{
+    // Jobs with unknown cost are estimated to cost the average of the known costs
+    std::vector<uint64_t> costs( jobCount, 0 );
+    uint64_t knownCostsSum = 0;
+    uint64_t knownCostsCount = 0;
+    for( size_t i = 0; ( i < jobCount ) && ( i < jobMemoryCosts.size() ); i++ )
+    {
+        costs[i] = jobMemoryCosts[i];
+        if( costs[i] > 0 )
+        {
+            knownCostsSum += costs[i];
+            knownCostsCount++;
+        }
+    }
+    for( uint64_t &cost : costs )
+    {
+        if( ( cost == 0 ) && ( knownCostsCount > 0 ) )
+        {
+            cost = knownCostsSum / knownCostsCount;
+        }
+    }
+
+    // The largest jobs are started first, so that they do not delay the end of the batch
+    std::vector<size_t> pendingJobs;
+    for( size_t i = 0; i < jobCount; i++ )
+    {
+        pendingJobs.push_back( i );
+    }
+    std::stable_sort( pendingJobs.begin(), pendingJobs.end(),
+                      [&]( size_t a, size_t b ) { return costs[a] > costs[b]; } );
+
+    std::mutex mutex;
+    std::condition_variable jobFinished;
+    std::vector<bool> finishedJobs( jobCount, false );
+    uint64_t reservedMemory = 0;
+    size_t runningJobs = 0;
+    size_t nextOrderedJob = 0;
+    bool executingOrderedSteps = false;
+    size_t failedJob = jobCount;
+    std::exception_ptr failure;
+
+    // Jobs after a failed one are discarded, the lock must be held
+    auto fail = [&]( size_t job, std::exception_ptr exception )
+    {
+        if( job < failedJob )
+        {
+            failedJob = job;
+            failure = exception;
+        }
+    };
+
+    auto worker = [&]()
+    {
+        std::unique_lock<std::mutex> lock( mutex );
+
+        while( true )
+        {
+            // Start the largest pending job that fits in the memory budget, or any job if none is running, so that
+            // jobs exceeding the budget are executed alone
+            pendingJobs.erase( std::remove_if( pendingJobs.begin(), pendingJobs.end(), [&]( size_t job ) { return job > failedJob; } ),
+                               pendingJobs.end() );
+            if( pendingJobs.empty() )
+            {
+                return;
+            }
+
+            std::vector<size_t>::iterator pendingJob = pendingJobs.begin();
+            if( ( m_memoryBudget > 0 ) && ( runningJobs > 0 ) )
+            {
+                pendingJob = std::find_if( pendingJobs.begin(), pendingJobs.end(),
+                                           [&]( size_t job ) { return ( reservedMemory + costs[job] ) <= m_memoryBudget; } );
+            }
+            if( pendingJob == pendingJobs.end() )
+            {
+                jobFinished.wait( lock );
+                continue;
+            }
+
+            size_t job = *pendingJob;
+            pendingJobs.erase( pendingJob );
+            reservedMemory += costs[job];
+            runningJobs++;
+
+            lock.unlock();
+
+            std::exception_ptr exception;
+            int slot = IsUsingJobServer() ? AcquireSlot() : IMPLICIT_SLOT;
+            try
+            {
+                parallelStep( job );
+            }
+            catch( ... )
+            {
+                exception = std::current_exception();
+            }
+            if( IsUsingJobServer() )
+            {
+                ReleaseSlot( slot );
+            }
+
+            lock.lock();
+
+            reservedMemory -= costs[job];
+            runningJobs--;
+            jobFinished.notify_all();
+
+            if( exception )
+            {
+                fail( job, exception );
+                continue;
+            }
+
+            finishedJobs[job] = true;
+
+            // Ordered steps are executed by one worker at a time, for as many consecutive jobs as are finished
+            if( executingOrderedSteps )
+            {
+                continue;
+            }
+            executingOrderedSteps = true;
+            while( ( nextOrderedJob < failedJob ) && finishedJobs[nextOrderedJob] )
+            {
+                size_t orderedJob = nextOrderedJob;
+
+                lock.unlock();
+                try
+                {
+                    orderedStep( orderedJob );
+                    exception = nullptr;
+                }
+                catch( ... )
+                {
+                    exception = std::current_exception();
+                }
+                lock.lock();
+
+                if( exception )
+                {
+                    fail( orderedJob, exception );
+                }
+                else
+                {
+                    nextOrderedJob++;
+                }
+            }
+            executingOrderedSteps = false;
+        }
+    };
+
+    size_t threadCount = std::min<size_t>( m_maxJobs, jobCount );
+    std::vector<std::thread> threads;
+    for( size_t i = 1; i < threadCount; i++ )
+    {
+        threads.push_back( std::thread( worker ) );
+    }
+    worker();
+    for( std::thread &thread : threads )
+    {
+        thread.join();
+    }
+
+    if( failure )
+    {
+        std::rethrow_exception( failure );
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef CPPUMOCKGEN_BATCHEXECUTOR_HPP_
+#define CPPUMOCKGEN_BATCHEXECUTOR_HPP_
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include <mutex>
+
+#ifdef WIN32
+#include "windows.h"
+#endif
+
+/**
+ * Executor of batches of jobs on several threads.
+ *
+ * When running inside a GNU make build with a jobserver, the number of jobs running concurrently is limited by the
+ * job slots obtained from the jobserver (besides the implicit one owned by the process), otherwise it is limited
+ * by the maximum number of jobs given.
+ */
+class BatchExecutor
+{
+public:
+    /**
+     * Constructor.
+     *
+     * @param maxJobs [in] Maximum number of jobs to run concurrently, or 0 to use the number of hardware threads
+     * @param memoryBudget [in] Maximum memory (in bytes) that the jobs running concurrently are expected to use, or 0
+     *                          if not limited
+     * @param makeFlags [in] Contents of the MAKEFLAGS environment variable, or @c nullptr if it is not defined
+     */
+    BatchExecutor( unsigned int maxJobs, uint64_t memoryBudget, const char *makeFlags );
+
+    ~BatchExecutor();
+
+    /**
+     * Indicates if the number of concurrent jobs is limited by a GNU make jobserver.
+     */
+    bool IsUsingJobServer() const;
+
+    /**
+     * Returns the maximum number of jobs that can run concurrently.
+     */
+    unsigned int GetMaxJobs() const;
+
+    /**
+     * Returns the maximum memory (in bytes) that the jobs running concurrently are expected to use, or 0 if not limited.
+     */
+    uint64_t GetMemoryBudget() const;
+
+    /**
+     * Executes a batch of jobs.
+     *
+     * The parallel steps of the jobs are executed concurrently, each one holding a job slot, starting with the jobs
+     * with the largest memory cost, and as long as the memory cost of the running jobs does not exceed the memory
+     * budget. The ordered step of each job is executed after its parallel step, and after the ordered steps of all the
+     * previous jobs, so that ordered steps are executed one at a time in the order of the jobs.
+     *
+     * If any step throws an exception, the following jobs are discarded, and the exception of the first failed job is
+     * rethrown once all the running steps have finished.
+     *
+     * @param jobCount [in] Number of jobs
+     * @param jobMemoryCosts [in] Expected memory cost (in bytes) of each job, where 0 or missing costs are estimated
+     *                            as the average of the known ones
+     * @param parallelStep [in] Function executing the parallel step of the job with the given index
+     * @param orderedStep [in] Function executing the ordered step of the job with the given index
+     */
+    void Execute( size_t jobCount, const std::vector<uint64_t> &jobMemoryCosts,
+                  const std::function<void(size_t)> &parallelStep,
+                  const std::function<void(size_t)> &orderedStep );
+
+private:
+    static const int IMPLICIT_SLOT = -1;
+
+    void ConnectJobServer( const std::string &auth );
+    int AcquireSlot();
+    void ReleaseSlot( int slot );
+
+    unsigned int m_maxJobs;
+    uint64_t m_memoryBudget;
+    bool m_implicitSlotFree;
+    std::mutex m_slotMutex;
+
+#ifdef WIN32
+    HANDLE m_jobServerSemaphore;
+#else
+    int m_jobServerReadFd;
+    int m_jobServerWriteFd;
+    bool m_jobServerFdsOwned;
+#endif
+};
+
+#endif // header guard
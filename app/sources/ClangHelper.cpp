@@ -1,5 +1,7 @@
 #include "ClangHelper.hpp"
 
+#include <set>
+
 std::ostream& operator<<( std::ostream& stream, const CXString& cxstr )
 {
     stream << clang_getCString(cxstr);
@@ -64,7 +66,12 @@ std::string getQualifiedName( const CXCursor &cursor )
 
 std::string getBareTypeSpelling( const CXType &type )
 {
-    std::string fullName = toString( clang_getTypeSpelling( (CXType &)type ) );
+    return getBareTypeSpelling( toString( clang_getTypeSpelling( (CXType &)type ) ) );
+}
+
+std::string getBareTypeSpelling( const std::string &typeSpelling )
+{
+    std::string fullName = typeSpelling;
 
     size_t sepIdx = fullName.find_last_of( ' ' );
 
@@ -91,3 +98,54 @@ std::string getBareTypeSpelling( const CXType &type )
 
     return className;
 }
+
+std::string getSpelledTypeExpr( const CXCursor &cursor )
+{
+    static const std::set<std::string> nonTypeKeywords = { "extern", "static", "inline", "virtual", "explicit", "friend" };
+
+    CXTranslationUnit tu = clang_Cursor_getTranslationUnit( cursor );
+    CXSourceLocation nameLocation = clang_getCursorLocation( cursor );
+
+    CXToken *tokens;
+    unsigned int numTokens;
+    clang_tokenize( tu, clang_getCursorExtent( cursor ), &tokens, &numTokens );
+
+    std::string ret;
+    bool lastIsWord = false;
+    for( unsigned int i = 0; i < numTokens; i++ )
+    {
+        CXTokenKind tokenKind = clang_getTokenKind( tokens[i] );
+        std::string tokenSpelling = toString( clang_getTokenSpelling( tu, tokens[i] ) );
+
+        // The type ends at the name of the declaration (or where it would be for unnamed parameters), and storage class,
+        // function specifiers and linkage specifications (e.g. extern "C") are not part of it
+        if( clang_equalLocations( clang_getTokenLocation( tu, tokens[i] ), nameLocation ) ||
+            ( ( tokenKind == CXToken_Punctuation ) &&
+              ( ( tokenSpelling == "=" ) || ( tokenSpelling == "(" ) || ( tokenSpelling == "[" ) ) ) )
+        {
+            break;
+        }
+        else if( ( tokenKind == CXToken_Comment ) || ( ( tokenKind == CXToken_Literal ) && ( tokenSpelling[0] == '"' ) ) ||
+                 ( ( tokenKind == CXToken_Keyword ) && ( nonTypeKeywords.count( tokenSpelling ) > 0 ) ) )
+        {
+            continue;
+        }
+
+        // Spaces are placed as libclang does in type spellings (e.g. "const ns::Type<int, char> *const")
+        bool isWord = ( tokenKind != CXToken_Punctuation );
+        bool isDeclarator = ( tokenSpelling == "*" ) || ( tokenSpelling == "&" ) || ( tokenSpelling == "&&" );
+        if( !ret.empty() &&
+            ( ( lastIsWord && isWord ) || ( ret.back() == ',' ) ||
+              ( isDeclarator && ( ret.back() != '*' ) && ( ret.back() != '&' ) ) ) )
+        {
+            ret += " ";
+        }
+
+        ret += tokenSpelling;
+        lastIsWord = isWord;
+    }
+
+    clang_disposeTokens( tu, tokens, numTokens );
+
+    return ret;
+}
@@ -65,4 +65,22 @@ std::string getQualifiedName( const CXCursor &cursor );
  */
 std::string getBareTypeSpelling( const CXType &type );
 
+/**
+ * Returns the spelling of a type removing modifiers (const, volatile, pointer, etc.).
+ *
+ * @param typeSpelling [in] Spelling of a type
+ * @return A string with the spelling of the bare type
+ */
+std::string getBareTypeSpelling( const std::string &typeSpelling );
+
+/**
+ * Returns the spelling of the type of a declaration as written in the source code (i.e., the tokens before the name
+ * of the declaration, excluding storage class and function specifiers), which may differ from the spelling of the
+ * type of the cursor if the type could not be resolved.
+ *
+ * @param cursor [in] A cursor for a function or parameter declaration
+ * @return A string with the spelling of the type (of the return type for functions)
+ */
+std::string getSpelledTypeExpr( const CXCursor &cursor );
+
 #endif // header guard
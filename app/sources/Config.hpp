@@ -19,6 +19,12 @@ enum class MockedType
     ConstPointer,
     Output,
     Skip,
+    // Types below are only used internally, they cannot be given in overrides
+    LongLong,
+    UnsignedLongLong,
+    OfType,
+    OutputOfType,
+    Void,
 };
 
 /**
@@ -0,0 +1,262 @@
+#include "DirectoryTree.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifdef WIN32
+#include <windows.h>
+#include <direct.h>
+#else
+#include <dirent.h>
+#endif
+
+#include "FileHelper.hpp"
+
+static bool IsSeparator( char c )
+{
+    return ( c == '/' ) || ( c == PATH_SEPARATOR );
+}
+
+static bool MatchGlobAt( const char *pattern, const char *path )
+{
+    while( *pattern != '\0' )
+    {
+        if( ( pattern[0] == '*' ) && ( pattern[1] == '*' ) )
+        {
+            pattern += 2;
+
+            // '**/' also matches no directory at all
+            if( IsSeparator( *pattern ) && MatchGlobAt( pattern + 1, path ) )
+            {
+                return true;
+            }
+
+            for( ; ; path++ )
+            {
+                if( MatchGlobAt( pattern, path ) )
+                {
+                    return true;
+                }
+                if( *path == '\0' )
+                {
+                    return false;
+                }
+            }
+        }
+        else if( *pattern == '*' )
+        {
+            pattern++;
+
+            for( ; ; path++ )
+            {
+                if( MatchGlobAt( pattern, path ) )
+                {
+                    return true;
+                }
+                if( ( *path == '\0' ) || IsSeparator( *path ) )
+                {
+                    return false;
+                }
+            }
+        }
+        else if( *path == '\0' )
+        {
+            return false;
+        }
+        else if( *pattern == '?' )
+        {
+            if( IsSeparator( *path ) )
+            {
+                return false;
+            }
+        }
+        else if( IsSeparator( *pattern ) )
+        {
+            if( !IsSeparator( *path ) )
+            {
+                return false;
+            }
+        }
+        else if( *pattern != *path )
+        {
+            return false;
+        }
+
+        pattern++;
+        path++;
+    }
+
+    return ( *path == '\0' );
+}
+
+bool MatchGlob( const std::string &pattern, const std::string &path )
+{
+    if( std::find_if( pattern.begin(), pattern.end(), IsSeparator ) == pattern.end() )
+    {
+        std::string::const_reverse_iterator sep = std::find_if( path.rbegin(), path.rend(), IsSeparator );
+        return MatchGlobAt( pattern.c_str(), path.c_str() + ( path.rend() - sep ) );
+    }
+    else
+    {
+        return MatchGlobAt( pattern.c_str(), path.c_str() );
+    }
+}
+
+static bool MatchAnyGlob( const std::vector<std::string> &globs, const std::string &path )
+{
+    return std::any_of( globs.begin(), globs.end(), [&path]( const std::string &glob ) { return MatchGlob( glob, path ); } );
+}
+
+struct DirectoryEntry
+{
+    std::string name;
+    bool isDirectory;
+};
+
+static bool ListDirectory( const std::string &dirPath, std::vector<DirectoryEntry> &entries )
+{
+#ifdef WIN32
+    WIN32_FIND_DATAA data;
+    HANDLE handle = FindFirstFileA( ( dirPath + "*" ).c_str(), &data );
+    if( handle == INVALID_HANDLE_VALUE )
+    {
+        return false;
+    }
+
+    do
+    {
+        std::string name = data.cFileName;
+        if( ( name != "." ) && ( name != ".." ) )
+        {
+            bool isDirectory = ( ( data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY ) != 0 );
+            if( !isDirectory || ( ( data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT ) == 0 ) )
+            {
+                entries.push_back( { name, isDirectory } );
+            }
+        }
+    } while( FindNextFileA( handle, &data ) );
+
+    FindClose( handle );
+#else
+    DIR *dir = opendir( dirPath.empty() ? "." : dirPath.c_str() );
+    if( dir == nullptr )
+    {
+        return false;
+    }
+
+    for( struct dirent *entry = readdir( dir ); entry != nullptr; entry = readdir( dir ) )
+    {
+        std::string name = entry->d_name;
+        if( ( name == "." ) || ( name == ".." ) )
+        {
+            continue;
+        }
+
+        struct stat status;
+        if( lstat( ( dirPath + name ).c_str(), &status ) != 0 )
+        {
+            continue;
+        }
+
+        if( S_ISLNK( status.st_mode ) )
+        {
+            // Symbolic links to files are followed
+            if( ( stat( ( dirPath + name ).c_str(), &status ) != 0 ) || !S_ISREG( status.st_mode ) )
+            {
+                continue;
+            }
+        }
+
+        if( S_ISDIR( status.st_mode ) || S_ISREG( status.st_mode ) )
+        {
+            entries.push_back( { name, S_ISDIR( status.st_mode ) } );
+        }
+    }
+
+    closedir( dir );
+#endif
+
+    return true;
+}
+
+static void FindFilesInSubdirectory( const std::string &rootPath, const std::string &subdirPath,
+                                     const std::vector<std::string> &includeGlobs,
+                                     const std::vector<std::string> &excludeGlobs, std::vector<std::string> &files )
+{
+    std::vector<DirectoryEntry> entries;
+    if( !ListDirectory( rootPath + subdirPath, entries ) && subdirPath.empty() )
+    {
+        std::string errorMsg = "Input directory '" + rootPath + "' could not be read.";
+        throw std::runtime_error( errorMsg );
+    }
+
+    for( const DirectoryEntry &entry : entries )
+    {
+        std::string path = subdirPath + entry.name;
+        if( MatchAnyGlob( excludeGlobs, path ) )
+        {
+            continue;
+        }
+
+        if( entry.isDirectory )
+        {
+            FindFilesInSubdirectory( rootPath, path + PATH_SEPARATOR, includeGlobs, excludeGlobs, files );
+        }
+        else if( MatchAnyGlob( includeGlobs, path ) )
+        {
+            files.push_back( path );
+        }
+    }
+}
+
+std::vector<std::string> FindFilesInTree( const std::string &dirPath, const std::vector<std::string> &includeGlobs,
+                                          const std::vector<std::string> &excludeGlobs )
+{
+    std::string rootPath = dirPath;
+    if( !rootPath.empty() && !IsSeparator( rootPath.back() ) )
+    {
+        rootPath += PATH_SEPARATOR;
+    }
+
+    std::vector<std::string> files;
+    FindFilesInSubdirectory( rootPath, "", includeGlobs, excludeGlobs, files );
+
+    // The order of the entries in a directory is not specified, but the inputs must be processed in a stable order
+    std::sort( files.begin(), files.end() );
+
+    return files;
+}
+
+static bool IsDirectory( const std::string &dirPath )
+{
+    struct stat status;
+    return ( stat( dirPath.c_str(), &status ) == 0 ) && ( ( status.st_mode & S_IFMT ) == S_IFDIR );
+}
+
+void CreateDirectories( const std::string &dirPath )
+{
+    // Each prefix of the path ending before a separator is a directory to be created, except the root
+    for( size_t pos = 0; pos <= dirPath.size(); pos++ )
+    {
+        if( ( ( pos == dirPath.size() ) || IsSeparator( dirPath[pos] ) ) && ( pos > 0 ) && !IsSeparator( dirPath[pos - 1] ) )
+        {
+            std::string parentPath = dirPath.substr( 0, pos );
+            if( !IsDirectory( parentPath ) )
+            {
+#ifdef WIN32
+                _mkdir( parentPath.c_str() );
+#else
+                mkdir( parentPath.c_str(), 0777 );
+#endif
+            }
+        }
+    }
+
+    if( !dirPath.empty() && !IsDirectory( dirPath ) )
+    {
+        std::string errorMsg = "Directory '" + dirPath + "' could not be created.";
+        throw std::runtime_error( errorMsg );
+    }
+}
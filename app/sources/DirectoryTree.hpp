@@ -0,0 +1,45 @@
+#ifndef CPPUMOCKGEN_DIRECTORYTREE_HPP_
+#define CPPUMOCKGEN_DIRECTORYTREE_HPP_
+
+#include <string>
+#include <vector>
+
+/**
+ * Checks whether a path matches a glob pattern.
+ *
+ * In the pattern, '*' matches any sequence of characters except path separators, '?' matches any single character
+ * except path separators, and '**' matches any sequence of characters including path separators ('**' followed by
+ * a separator also matches no directory at all). Patterns without separators are matched against the filename only.
+ * Both '/' and the native path separator are accepted as separators, in the pattern and in the path.
+ *
+ * @param pattern [in] Glob pattern
+ * @param path [in] Path to be checked
+ * @return @c true if the path matches the pattern, @c false otherwise
+ */
+bool MatchGlob( const std::string &pattern, const std::string &path );
+
+/**
+ * Finds the files in a directory tree whose paths relative to its root match any of the include globs and none of the
+ * exclude globs (see MatchGlob()).
+ *
+ * Subdirectories whose relative paths match any of the exclude globs are not searched. Symbolic links to directories
+ * are not followed, to avoid cycles.
+ *
+ * @param dirPath [in] Path of the root directory
+ * @param includeGlobs [in] Globs of the files to be found
+ * @param excludeGlobs [in] Globs of the files or subdirectories to be skipped
+ * @return Paths of the files found relative to the root directory, in lexicographical order
+ * @throws std::runtime_error if the root directory cannot be read
+ */
+std::vector<std::string> FindFilesInTree( const std::string &dirPath, const std::vector<std::string> &includeGlobs,
+                                          const std::vector<std::string> &excludeGlobs );
+
+/**
+ * Creates a directory, along with its parent directories that do not exist.
+ *
+ * @param dirPath [in] Path of the directory
+ * @throws std::runtime_error if the directory cannot be created
+ */
+void CreateDirectories( const std::string &dirPath );
+
+#endif // header guard
@@ -1,32 +1,88 @@
-#include "FileHelper.hpp"
-
-std::string GetFilenameFromPath( const std::string& filepath )
-{
-    size_t sepPos = filepath.rfind( PATH_SEPARATOR );
-    if( sepPos == std::string::npos )
-    {
-        return filepath;
-    }
-    else
-    {
-        return filepath.substr( sepPos + 1 );
-    }
-}
-
-std::string RemoveFilenameExtension( const std::string &filepath )
-{
-    size_t sepPos = filepath.find(".");
-    if( sepPos == std::string::npos )
-    {
-        return filepath;
-    }
-    else
-    {
-        return filepath.substr( 0, sepPos );
-    }
-}
-
-bool IsDirPath( const std::string& path )
-{
-    return ( !path.empty() && ( path.back() == PATH_SEPARATOR ) );
-}
+#include "FileHelper.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <cstdio>
+
+std::string GetFilenameFromPath( const std::string& filepath )
+{
+    size_t sepPos = filepath.rfind( PATH_SEPARATOR );
+    if( sepPos == std::string::npos )
+    {
+        return filepath;
+    }
+    else
+    {
+        return filepath.substr( sepPos + 1 );
+    }
+}
+
+std::string RemoveFilenameExtension( const std::string &filepath )
+{
+    size_t sepPos = filepath.find(".");
+    if( sepPos == std::string::npos )
+    {
+        return filepath;
+    }
+    else
+    {
+        return filepath.substr( 0, sepPos );
+    }
+}
+
+bool IsDirPath( const std::string& path )
+{
+    return ( !path.empty() && ( path.back() == PATH_SEPARATOR ) );
+}
+
+bool WriteFileIfChanged( const std::string &filepath, const std::string &contents )
+{
+    std::ifstream inputFile( filepath );
+    if( inputFile.is_open() )
+    {
+        std::ostringstream currentContents;
+        currentContents << inputFile.rdbuf();
+        inputFile.close();
+
+        if( currentContents.str() == contents )
+        {
+            return false;
+        }
+    }
+
+    std::ofstream outputFile( filepath );
+    if( !outputFile.is_open() )
+    {
+        std::string errorMsg = "Output file '" + filepath + "' could not be written.";
+        throw std::runtime_error( errorMsg );
+    }
+    outputFile << contents;
+
+    return true;
+}
+
+std::string EscapeJson( const std::string &text )
+{
+    std::string ret;
+    for( char c : text )
+    {
+        if( ( c == '"' ) || ( c == '\\' ) )
+        {
+            ret += '\\';
+            ret += c;
+        }
+        else if( static_cast<unsigned char>( c ) < 0x20 )
+        {
+            // Control characters are not allowed in JSON strings
+            char buffer[8];
+            snprintf( buffer, sizeof(buffer), "\\u%04X", static_cast<unsigned int>( c ) );
+            ret += buffer;
+        }
+        else
+        {
+            ret += c;
+        }
+    }
+    return ret;
+}
@@ -1,18 +1,24 @@
-#ifndef CPPUMOCKGEN_FILEHELPER_HPP_
-#define CPPUMOCKGEN_FILEHELPER_HPP_
-
-#include <string>
-
-#ifdef WIN32
-#define PATH_SEPARATOR '\\'
-#else
-#define PATH_SEPARATOR '/'
-#endif
-
-std::string GetFilenameFromPath( const std::string& filepath );
-
-std::string RemoveFilenameExtension( const std::string &filepath );
-
-bool IsDirPath( const std::string &path );
-
-#endif // header guard
+#ifndef CPPUMOCKGEN_FILEHELPER_HPP_
+#define CPPUMOCKGEN_FILEHELPER_HPP_
+
+#include <string>
+
+#ifdef WIN32
+#define PATH_SEPARATOR '\\'
+#else
+#define PATH_SEPARATOR '/'
+#endif
+
+std::string GetFilenameFromPath( const std::string& filepath );
+
+std::string RemoveFilenameExtension( const std::string &filepath );
+
+bool IsDirPath( const std::string &path );
+
+// Returns false without writing if the file already has the given contents, to preserve its modification time
+bool WriteFileIfChanged( const std::string &filepath, const std::string &contents );
+
+// Escapes the text to be written inside a JSON string literal (e.g. file paths in reports)
+std::string EscapeJson( const std::string &text );
+
+#endif // header guard
@@ -0,0 +1,188 @@
+#include "FileWatcher.hpp"
+
+#include <chrono>
+#include <thread>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+// Period to check the watched files when inotify is not available
+static const unsigned int POLL_PERIOD_MS = 200;
+
+// Period without further changes after which changes are reported
+static const unsigned int SETTLE_PERIOD_MS = 50;
+
+bool FileWatcher::FileStatus::operator!=( const FileStatus &other ) const
+{
+    return ( exists != other.exists ) || ( modificationTime != other.modificationTime ) || ( size != other.size );
+}
+
+FileWatcher::FileWatcher()
+{
+#ifdef __linux__
+    m_inotifyFd = inotify_init1( IN_CLOEXEC );
+#endif
+}
+
+FileWatcher::~FileWatcher()
+{
+#ifdef __linux__
+    if( m_inotifyFd >= 0 )
+    {
+        close( m_inotifyFd );
+    }
+#endif
+}
+
+FileWatcher::FileStatus FileWatcher::GetFileStatus( const std::string &filepath )
+{
+    FileStatus status = { false, 0, 0 };
+
+    struct stat fileStat;
+    if( stat( filepath.c_str(), &fileStat ) == 0 )
+    {
+        status.exists = true;
+        status.modificationTime = fileStat.st_mtime;
+        status.size = fileStat.st_size;
+    }
+
+    return status;
+}
+
+void FileWatcher::SetWatchedFiles( const std::vector<std::string> &filepaths )
+{
+    m_watchedFiles.clear();
+    for( const std::string &filepath : filepaths )
+    {
+        m_watchedFiles[filepath] = GetFileStatus( filepath );
+    }
+
+#ifdef __linux__
+    if( m_inotifyFd >= 0 )
+    {
+        for( const std::map<int, std::map<std::string, std::string>>::value_type &watchedDir : m_watchedDirs )
+        {
+            inotify_rm_watch( m_inotifyFd, watchedDir.first );
+        }
+        m_watchedDirs.clear();
+
+        for( const std::string &filepath : filepaths )
+        {
+            size_t separatorPos = filepath.find_last_of( '/' );
+            std::string dirPath = ( separatorPos == std::string::npos ) ? "." :
+                                  ( separatorPos == 0 ) ? "/" : filepath.substr( 0, separatorPos );
+            std::string filename = ( separatorPos == std::string::npos ) ? filepath : filepath.substr( separatorPos + 1 );
+
+            // The same watch descriptor is returned for a directory already watched
+            int watchDescriptor = inotify_add_watch( m_inotifyFd, dirPath.c_str(),
+                                                     IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE );
+            if( watchDescriptor >= 0 )
+            {
+                m_watchedDirs[watchDescriptor][filename] = filepath;
+            }
+        }
+    }
+#endif
+}
+
+void FileWatcher::PollChanges( std::set<std::string> &changedFilepaths )
+{
+    for( std::map<std::string, FileStatus>::value_type &watchedFile : m_watchedFiles )
+    {
+        FileStatus status = GetFileStatus( watchedFile.first );
+        if( status != watchedFile.second )
+        {
+            watchedFile.second = status;
+            changedFilepaths.insert( watchedFile.first );
+        }
+    }
+}
+
+#ifdef __linux__
+
+bool FileWatcher::ReadEvents( std::set<std::string> &changedFilepaths )
+{
+    alignas( struct inotify_event ) char buffer[4096];
+
+    ssize_t length = read( m_inotifyFd, buffer, sizeof( buffer ) );
+    if( length < 0 )
+    {
+        return ( errno == EINTR ) || ( errno == EAGAIN );
+    }
+
+    for( ssize_t offset = 0; offset < length; )
+    {
+        const struct inotify_event *event = reinterpret_cast<const struct inotify_event*>( buffer + offset );
+        offset += sizeof( struct inotify_event ) + event->len;
+
+        std::map<int, std::map<std::string, std::string>>::const_iterator watchedDir = m_watchedDirs.find( event->wd );
+        if( ( event->len > 0 ) && ( watchedDir != m_watchedDirs.end() ) )
+        {
+            std::map<std::string, std::string>::const_iterator watchedFile = watchedDir->second.find( event->name );
+            if( watchedFile != watchedDir->second.end() )
+            {
+                changedFilepaths.insert( watchedFile->second );
+            }
+        }
+    }
+
+    return true;
+}
+
+#endif
+
+bool FileWatcher::WaitForChanges( std::vector<std::string> &changedFilepaths )
+{
+    std::set<std::string> changes;
+
+#ifdef __linux__
+    if( m_inotifyFd >= 0 )
+    {
+        // Wait indefinitely for the first change, and then until no more changes are notified during the settle period
+        int timeout = -1;
+        while( true )
+        {
+            struct pollfd pollFd = { m_inotifyFd, POLLIN, 0 };
+            int pollResult = poll( &pollFd, 1, timeout );
+            if( pollResult == 0 )
+            {
+                break;
+            }
+            else if( ( pollResult < 0 ) && ( errno != EINTR ) )
+            {
+                return false;
+            }
+            else if( ( pollResult > 0 ) && !ReadEvents( changes ) )
+            {
+                return false;
+            }
+
+            if( !changes.empty() )
+            {
+                timeout = SETTLE_PERIOD_MS;
+            }
+        }
+
+        changedFilepaths.assign( changes.begin(), changes.end() );
+        return true;
+    }
+#endif
+
+    while( changes.empty() )
+    {
+        std::this_thread::sleep_for( std::chrono::milliseconds( POLL_PERIOD_MS ) );
+        PollChanges( changes );
+    }
+
+    std::this_thread::sleep_for( std::chrono::milliseconds( SETTLE_PERIOD_MS ) );
+    PollChanges( changes );
+
+    changedFilepaths.assign( changes.begin(), changes.end() );
+    return true;
+}
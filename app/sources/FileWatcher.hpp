@@ -0,0 +1,65 @@
+#ifndef CPPUMOCKGEN_FILEWATCHER_HPP_
+#define CPPUMOCKGEN_FILEWATCHER_HPP_
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <ctime>
+
+/**
+ * Watcher of changes to a set of files.
+ *
+ * On Linux changes are notified by inotify, watching the directories that contain the files so that files replaced
+ * by editors (i.e. written to a temporary file and then renamed) are detected, otherwise the modification time and
+ * size of the files are polled periodically.
+ */
+class FileWatcher
+{
+public:
+    FileWatcher();
+
+    ~FileWatcher();
+
+    /**
+     * Sets the files to be watched, replacing the files watched previously.
+     *
+     * @param filepaths [in] Paths of the files to be watched
+     */
+    void SetWatchedFiles( const std::vector<std::string> &filepaths );
+
+    /**
+     * Waits until any of the watched files is changed, created or deleted.
+     *
+     * Changes notified in quick succession (e.g. when an editor saves several files) are reported together.
+     *
+     * @param changedFilepaths [out] Paths of the files changed, as they were passed to SetWatchedFiles()
+     * @return @c false if changes cannot be watched anymore, @c true otherwise
+     */
+    bool WaitForChanges( std::vector<std::string> &changedFilepaths );
+
+private:
+    struct FileStatus
+    {
+        bool exists;
+        std::time_t modificationTime;
+        long long size;
+
+        bool operator!=( const FileStatus &other ) const;
+    };
+
+    static FileStatus GetFileStatus( const std::string &filepath );
+
+    void PollChanges( std::set<std::string> &changedFilepaths );
+
+    std::map<std::string, FileStatus> m_watchedFiles;
+
+#ifdef __linux__
+    bool ReadEvents( std::set<std::string> &changedFilepaths );
+
+    int m_inotifyFd;
+    std::map<int, std::map<std::string, std::string>> m_watchedDirs; // Watched files in each directory, by name
+#endif
+};
+
+#endif // header guard
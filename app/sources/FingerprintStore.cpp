@@ -0,0 +1,471 @@
+#include "FingerprintStore.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <stdexcept>
+#include <algorithm>
+#include <cctype>
+
+static const char FIELD_SEPARATOR = '\t';
+static const std::string MEMORY_USAGE_TAG = std::string( "memory" ) + FIELD_SEPARATOR;
+
+void FingerprintStore::Load( const std::string &filepath )
+{
+    m_previous.clear();
+    m_previousMemoryUsage.clear();
+
+    std::ifstream file( filepath );
+    if( !file.is_open() )
+    {
+        return;
+    }
+
+    // Each line has the format: <fingerprint> TAB <input file path> TAB <function id> TAB <function name>
+    // or, for the memory used to parse an input file: memory TAB <input file path> TAB <bytes>
+    std::string line;
+    while( std::getline( file, line ) )
+    {
+        std::istringstream lineStream( line );
+        std::string fingerprint;
+        Entry entry;
+
+        if( line.compare( 0, MEMORY_USAGE_TAG.size(), MEMORY_USAGE_TAG ) == 0 )
+        {
+            std::string inputFilepath;
+            uint64_t memoryUsage;
+            if( std::getline( lineStream.ignore( MEMORY_USAGE_TAG.size() ), inputFilepath, FIELD_SEPARATOR ) &&
+                ( lineStream >> memoryUsage ) )
+            {
+                m_previousMemoryUsage[ inputFilepath ] = memoryUsage;
+            }
+        }
+        else if( std::getline( lineStream, fingerprint, FIELD_SEPARATOR ) &&
+            std::getline( lineStream, entry.inputFilepath, FIELD_SEPARATOR ) &&
+            std::getline( lineStream, entry.id, FIELD_SEPARATOR ) &&
+            std::getline( lineStream, entry.name ) &&
+            ( fingerprint.size() == 16 ) &&
+            ( fingerprint.find_first_not_of( "0123456789abcdef" ) == std::string::npos ) )
+        {
+            entry.fingerprint = std::stoull( fingerprint, nullptr, 16 );
+            m_previous[ std::make_pair( entry.inputFilepath, entry.id ) ] = entry;
+        }
+    }
+}
+
+void FingerprintStore::Save( const std::string &filepath ) const
+{
+    EntryMap entries = m_current;
+    for( const EntryMap::value_type &previous : m_previous )
+    {
+        if( m_processedInputs.count( previous.second.inputFilepath ) == 0 )
+        {
+            entries.insert( previous );
+        }
+    }
+
+    std::ofstream file( filepath );
+    if( !file.is_open() )
+    {
+        std::string errorMsg = "Fingerprints file '" + filepath + "' could not be opened.";
+        throw std::runtime_error( errorMsg );
+    }
+
+    std::map<std::string, uint64_t> memoryUsages = m_currentMemoryUsage;
+    for( const std::map<std::string, uint64_t>::value_type &previous : m_previousMemoryUsage )
+    {
+        if( m_processedInputs.count( previous.first ) == 0 )
+        {
+            memoryUsages.insert( previous );
+        }
+    }
+
+    for( const std::map<std::string, uint64_t>::value_type &memoryUsage : memoryUsages )
+    {
+        file << MEMORY_USAGE_TAG << memoryUsage.first << FIELD_SEPARATOR << memoryUsage.second << std::endl;
+    }
+
+    for( const EntryMap::value_type &entry : entries )
+    {
+        file << std::hex << std::setw( 16 ) << std::setfill( '0' ) << entry.second.fingerprint << std::dec << FIELD_SEPARATOR <<
+                entry.second.inputFilepath << FIELD_SEPARATOR << entry.second.id << FIELD_SEPARATOR << entry.second.name << std::endl;
+    }
+}
+
+void FingerprintStore::AddInput( const std::string &inputFilepath, uint64_t memoryUsage )
+{
+    m_processedInputs.insert( inputFilepath );
+    if( memoryUsage > 0 )
+    {
+        m_currentMemoryUsage[ inputFilepath ] = memoryUsage;
+    }
+}
+
+void FingerprintStore::Update( const std::string &inputFilepath, const std::string &id, const std::string &name,
+                               const std::string &generatedCode )
+{
+    Entry entry = { CalculateFingerprint( generatedCode ), inputFilepath, id, name };
+    m_current[ std::make_pair( inputFilepath, id ) ] = entry;
+    m_processedInputs.insert( inputFilepath );
+}
+
+std::vector<FingerprintStore::Difference> FingerprintStore::GetDifferences() const
+{
+    std::vector<Difference> differences;
+
+    for( const EntryMap::value_type &current : m_current )
+    {
+        EntryMap::const_iterator previous = m_previous.find( current.first );
+        if( previous == m_previous.end() )
+        {
+            differences.push_back( { Change::Added, current.second.name, current.second.inputFilepath } );
+        }
+        else if( previous->second.fingerprint != current.second.fingerprint )
+        {
+            differences.push_back( { Change::Changed, current.second.name, current.second.inputFilepath } );
+        }
+    }
+
+    for( const EntryMap::value_type &previous : m_previous )
+    {
+        if( ( m_processedInputs.count( previous.second.inputFilepath ) > 0 ) && ( m_current.count( previous.first ) == 0 ) )
+        {
+            differences.push_back( { Change::Removed, previous.second.name, previous.second.inputFilepath } );
+        }
+    }
+
+    return differences;
+}
+
+uint64_t FingerprintStore::GetPreviousMemoryUsage( const std::string &inputFilepath ) const
+{
+    std::map<std::string, uint64_t>::const_iterator it = m_previousMemoryUsage.find( inputFilepath );
+    return ( it != m_previousMemoryUsage.end() ) ? it->second : 0;
+}
+
+uint64_t FingerprintStore::CalculateFingerprint( const std::string &text )
+{
+    uint64_t hash = 14695981039346656037ull;
+    for( char c : text )
+    {
+        hash = ( hash ^ static_cast<unsigned char>( c ) ) * 1099511628211ull;
+    }
+    return hash;
+}
+
+enum class CharClass : unsigned char
+{
+    Punctuation,
+    Word,
+    Space,
+    NewLine,
+    Slash,
+    Quote,
+    Backslash,
+    Hash
+};
+
+/*
+ * Classification of the characters of a source, so that the scanner can dispatch each character and skip runs of
+ * characters of the same class with a single table lookup per character.
+ */
+struct CharClassTable
+{
+    CharClassTable()
+    {
+        for( unsigned int c = 0; c < 256; c++ )
+        {
+            if( std::isalnum( c ) || ( c == '_' ) || ( c == '$' ) || ( c >= 0x80 ) )
+            {
+                classes[c] = CharClass::Word;
+            }
+            else
+            {
+                classes[c] = CharClass::Punctuation;
+            }
+        }
+
+        classes[(unsigned char) ' '] = CharClass::Space;
+        classes[(unsigned char) '\t'] = CharClass::Space;
+        classes[(unsigned char) '\r'] = CharClass::Space;
+        classes[(unsigned char) '\f'] = CharClass::Space;
+        classes[(unsigned char) '\v'] = CharClass::Space;
+        classes[(unsigned char) '\n'] = CharClass::NewLine;
+        classes[(unsigned char) '/'] = CharClass::Slash;
+        classes[(unsigned char) '"'] = CharClass::Quote;
+        classes[(unsigned char) '\''] = CharClass::Quote;
+        classes[(unsigned char) '\\'] = CharClass::Backslash;
+        classes[(unsigned char) '#'] = CharClass::Hash;
+    }
+
+    CharClass operator[]( char c ) const
+    {
+        return classes[(unsigned char) c];
+    }
+
+    CharClass classes[256];
+};
+
+static const CharClassTable charClasses;
+
+/*
+ * Scanner of a C/C++ source that hashes its tokens, skipping comments and the whitespace that is not needed to
+ * separate them.
+ */
+class TokenHasher
+{
+public:
+    TokenHasher( const std::string &source )
+    : m_pos( source.data() ), m_end( source.data() + source.size() )
+    {}
+
+    uint64_t Calculate()
+    {
+        while( m_pos < m_end )
+        {
+            switch( charClasses[*m_pos] )
+            {
+                case CharClass::Space:
+                    m_pendingSpace = true;
+                    m_pos++;
+                    break;
+
+                case CharClass::NewLine:
+                    // Preprocessor directives end at the end of the line
+                    if( m_inDirective )
+                    {
+                        HashRaw( '\n' );
+                        m_last = '\n';
+                        m_pendingSpace = false;
+                        m_inDirective = false;
+                    }
+                    else
+                    {
+                        m_pendingSpace = true;
+                    }
+                    m_lineStart = true;
+                    m_pos++;
+                    break;
+
+                case CharClass::Backslash:
+                    ScanBackslash();
+                    break;
+
+                case CharClass::Slash:
+                    ScanSlash();
+                    break;
+
+                case CharClass::Quote:
+                    ScanQuote();
+                    break;
+
+                case CharClass::Hash:
+                    m_inDirective = m_inDirective || m_lineStart;
+                    HashToken( m_pos, m_pos + 1 );
+                    m_pos++;
+                    break;
+
+                case CharClass::Word:
+                    ScanWord();
+                    break;
+
+                default:
+                    HashToken( m_pos, m_pos + 1 );
+                    m_pos++;
+                    break;
+            }
+        }
+
+        return m_hash;
+    }
+
+private:
+    static bool IsWordLike( char c )
+    {
+        CharClass charClass = charClasses[c];
+        return ( charClass == CharClass::Word ) || ( charClass == CharClass::Quote );
+    }
+
+    // Returns whether two adjacent characters would be merged into the same token (or comment) if not separated
+    static bool AreMergeable( char c1, char c2 )
+    {
+        static const std::string MERGEABLE_PUNCTUATION = "+-*/%&|^<>=!:.#";
+
+        return ( IsWordLike( c1 ) && IsWordLike( c2 ) ) ||
+               ( ( MERGEABLE_PUNCTUATION.find( c1 ) != std::string::npos ) &&
+                 ( MERGEABLE_PUNCTUATION.find( c2 ) != std::string::npos ) );
+    }
+
+    void HashRaw( char c )
+    {
+        m_hash = ( m_hash ^ static_cast<unsigned char>( c ) ) * 1099511628211ull;
+    }
+
+    void HashRaw( const char *begin, const char *end )
+    {
+        uint64_t hash = m_hash;
+        for( const char *c = begin; c < end; c++ )
+        {
+            hash = ( hash ^ static_cast<unsigned char>( *c ) ) * 1099511628211ull;
+        }
+        m_hash = hash;
+    }
+
+    // Returns whether whitespace between two adjacent characters is significant inside a preprocessor directive, where
+    // it tells apart the definition of an object-like macro (e.g. "#define F (x)") from a function-like one
+    static bool IsDirectiveSpaceSignificant( char c1, char c2 )
+    {
+        return IsWordLike( c1 ) && ( c2 == '(' );
+    }
+
+    // Hashes a token, preceded by a separator if it was preceded by whitespace that keeps it apart from the previous one
+    void HashToken( const char *begin, const char *end )
+    {
+        if( m_pendingSpace && ( m_last != '\0' ) && ( m_last != '\n' ) &&
+            ( AreMergeable( m_last, *begin ) || ( m_inDirective && IsDirectiveSpaceSignificant( m_last, *begin ) ) ) )
+        {
+            HashRaw( ' ' );
+        }
+
+        HashRaw( begin, end );
+
+        m_last = *( end - 1 );
+        m_pendingSpace = false;
+        m_lineStart = false;
+    }
+
+    void ScanWord()
+    {
+        const char *begin = m_pos;
+        bool isNumber = std::isdigit( static_cast<unsigned char>( *begin ) ) != 0;
+
+        while( ( m_pos < m_end ) && ( charClasses[*m_pos] == CharClass::Word ) )
+        {
+            m_pos++;
+
+            // Digit separators (e.g. 1'000)
+            if( isNumber && ( m_pos + 1 < m_end ) && ( *m_pos == '\'' ) && ( charClasses[m_pos[1]] == CharClass::Word ) )
+            {
+                m_pos++;
+            }
+        }
+
+        HashToken( begin, m_pos );
+
+        m_lastWord = begin;
+        m_lastWordLength = m_pos - begin;
+    }
+
+    void ScanBackslash()
+    {
+        // Line splices are removed
+        if( ( m_pos + 1 < m_end ) && ( m_pos[1] == '\n' ) )
+        {
+            m_pos += 2;
+        }
+        else if( ( m_pos + 2 < m_end ) && ( m_pos[1] == '\r' ) && ( m_pos[2] == '\n' ) )
+        {
+            m_pos += 3;
+        }
+        else
+        {
+            HashToken( m_pos, m_pos + 1 );
+            m_pos++;
+        }
+    }
+
+    void ScanSlash()
+    {
+        char next = ( m_pos + 1 < m_end ) ? m_pos[1] : '\0';
+
+        if( next == '/' )
+        {
+            // Line comment, which ends at the end of the line unless it's spliced
+            m_pos += 2;
+            while( ( m_pos < m_end ) && ( ( *m_pos != '\n' ) || ( m_pos[-1] == '\\' ) ||
+                                          ( ( m_pos[-1] == '\r' ) && ( m_pos[-2] == '\\' ) ) ) )
+            {
+                m_pos++;
+            }
+            m_pendingSpace = true;
+        }
+        else if( next == '*' )
+        {
+            // Block comment
+            m_pos += 2;
+            while( ( m_pos + 1 < m_end ) && ( ( m_pos[0] != '*' ) || ( m_pos[1] != '/' ) ) )
+            {
+                m_pos++;
+            }
+            m_pos = std::min( m_pos + 2, m_end );
+            m_pendingSpace = true;
+        }
+        else
+        {
+            HashToken( m_pos, m_pos + 1 );
+            m_pos++;
+        }
+    }
+
+    bool IsRawStringPrefix() const
+    {
+        static const char* PREFIXES[] = { "R", "LR", "uR", "UR", "u8R" };
+
+        if( ( m_last != 'R' ) || ( m_lastWord + m_lastWordLength != m_pos ) )
+        {
+            return false;
+        }
+
+        for( const char *prefix : PREFIXES )
+        {
+            if( std::string( m_lastWord, m_lastWordLength ) == prefix )
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void ScanQuote()
+    {
+        const char *begin = m_pos;
+        const char quote = *m_pos;
+
+        if( ( quote == '"' ) && IsRawStringPrefix() )
+        {
+            // Raw string literal, which ends at the closing delimiter
+            const char *openPos = std::find( m_pos, m_end, '(' );
+            std::string terminator = ")" + std::string( m_pos + 1, openPos ) + "\"";
+            const char *endPos = std::search( openPos, m_end, terminator.begin(), terminator.end() );
+            m_pos = ( endPos == m_end ) ? m_end : ( endPos + terminator.size() );
+        }
+        else
+        {
+            m_pos++;
+            while( ( m_pos < m_end ) && ( *m_pos != quote ) && ( *m_pos != '\n' ) )
+            {
+                // A backslash at the end of a truncated literal does not escape anything
+                m_pos += ( ( *m_pos == '\\' ) && ( m_pos + 1 < m_end ) ) ? 2 : 1;
+            }
+            m_pos = std::min( m_pos + 1, m_end );
+        }
+
+        // Literals are hashed verbatim, including their whitespace
+        HashToken( begin, m_pos );
+    }
+
+    const char *m_pos;
+    const char *m_end;
+    uint64_t m_hash = 14695981039346656037ull;
+    char m_last = '\0';
+    bool m_pendingSpace = false;
+    bool m_lineStart = true;
+    bool m_inDirective = false;
+    const char *m_lastWord = nullptr;
+    size_t m_lastWordLength = 0;
+};
+
+uint64_t FingerprintStore::CalculateTokenFingerprint( const std::string &source )
+{
+    return TokenHasher( source ).Calculate();
+}
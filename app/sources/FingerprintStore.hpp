@@ -0,0 +1,120 @@
+#ifndef CPPUMOCKGEN_FINGERPRINTSTORE_HPP_
+#define CPPUMOCKGEN_FINGERPRINTSTORE_HPP_
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <cstdint>
+
+/**
+ * Store of per-function fingerprints of the generated code, persisted between runs to detect which
+ * functions have been added, removed or changed.
+ */
+class FingerprintStore
+{
+public:
+    /**
+     * Kind of difference of a function with respect to the previous run.
+     */
+    enum class Change
+    {
+        Added,
+        Removed,
+        Changed
+    };
+
+    /**
+     * Difference of a function with respect to the previous run.
+     */
+    struct Difference
+    {
+        Change change;
+        std::string name;
+        std::string inputFilepath;
+    };
+
+    /**
+     * Loads the fingerprints stored by a previous run.
+     *
+     * A non-existing file is considered equivalent to an empty one (i.e. first run), and malformed lines are ignored.
+     *
+     * @param filepath [in] Path of the fingerprints file
+     */
+    void Load( const std::string &filepath );
+
+    /**
+     * Saves the fingerprints of the current run, along with the fingerprints from the previous run for input files that
+     * have not been processed in the current run.
+     *
+     * @param filepath [in] Path of the fingerprints file
+     */
+    void Save( const std::string &filepath ) const;
+
+    /**
+     * Registers that an input file has been processed in the current run, so that functions from the previous run
+     * that are not registered again for it are considered removed.
+     *
+     * @param inputFilepath [in] Path of the input file
+     * @param memoryUsage [in] Memory (in bytes) used to parse the input file, or 0 if unknown
+     */
+    void AddInput( const std::string &inputFilepath, uint64_t memoryUsage );
+
+    /**
+     * Registers the generated code for a function in the current run.
+     *
+     * @param inputFilepath [in] Path of the input file where the function is declared
+     * @param id [in] Unique identifier of the function (e.g. its USR)
+     * @param name [in] Human readable name of the function
+     * @param generatedCode [in] Code generated for the function, from which the fingerprint is calculated
+     */
+    void Update( const std::string &inputFilepath, const std::string &id, const std::string &name,
+                 const std::string &generatedCode );
+
+    /**
+     * Returns the differences of the current run with respect to the previous run, for the input files processed
+     * in the current run.
+     */
+    std::vector<Difference> GetDifferences() const;
+
+    /**
+     * Returns the memory (in bytes) used to parse an input file in the previous run, or 0 if unknown.
+     *
+     * @param inputFilepath [in] Path of the input file
+     */
+    uint64_t GetPreviousMemoryUsage( const std::string &inputFilepath ) const;
+
+    /**
+     * Calculates the fingerprint (64-bit FNV-1a hash) of a text.
+     */
+    static uint64_t CalculateFingerprint( const std::string &text );
+
+    /**
+     * Calculates the fingerprint (64-bit FNV-1a hash) of the tokens of a C/C++ source, which does not change when only
+     * comments or whitespace are changed.
+     *
+     * Whitespace is only taken into account where it separates tokens that would otherwise be merged, and at the end
+     * of preprocessor directives.
+     */
+    static uint64_t CalculateTokenFingerprint( const std::string &source );
+
+private:
+    struct Entry
+    {
+        uint64_t fingerprint;
+        std::string inputFilepath;
+        std::string id;
+        std::string name;
+    };
+
+    // Entries are indexed by input file path and function id, to get a stable ordering in the fingerprints file
+    typedef std::map<std::pair<std::string, std::string>, Entry> EntryMap;
+
+    EntryMap m_previous;
+    EntryMap m_current;
+    std::set<std::string> m_processedInputs;
+    std::map<std::string, uint64_t> m_previousMemoryUsage;
+    std::map<std::string, uint64_t> m_currentMemoryUsage;
+};
+
+#endif // header guard
@@ -3,204 +3,205 @@
 #include <stdexcept>
 #include <sstream>
 #include <string>
+#include <cstdio>
+#include <cstdint>
 
 #include "ClangHelper.hpp"
 
 //*************************************************************************************************
 //
-//                                             RETURN PROCESSING
+//                                       UNRESOLVED TYPES PROCESSING
 //
 //*************************************************************************************************
 
-class Function::Return
+// When parsing only the input file (without expanding the files included by it), types declared in the files not
+// included cannot be resolved, and libclang replaces them by int in the (invalid) declarations that use them
+static bool IsUnresolvedType( const CXCursor &cursor, const CXType &type, std::string &typeExpr )
 {
-public:
-    virtual ~Return() {}
-
-    void SetOriginalType( const std::string &type )
+    if( clang_isInvalidDeclaration( cursor ) )
     {
-        m_originalType = type;
-    }
-
-    void MockRetExprPrepend( const std::string &expr )
-    {
-        m_mockRetExprFront.insert( 0, expr );
-    }
+        CXType bareType = type;
+        while( ( bareType.kind == CXType_Pointer ) || ( bareType.kind == CXType_LValueReference ) ||
+               ( bareType.kind == CXType_RValueReference ) )
+        {
+            bareType = clang_getPointeeType( bareType );
+        }
 
-    void MockRetExprAppend( const std::string &expr )
-    {
-        m_mockRetExprBack.append( expr );
-    }
+        std::string spelledTypeExpr = getSpelledTypeExpr( cursor );
+        std::istringstream spelledTypeTokens( spelledTypeExpr );
+        bool spellsInt = false;
+        std::string token;
+        while( spelledTypeTokens >> token )
+        {
+            spellsInt = spellsInt || ( token == "int" );
+        }
 
-    std::string GetMockSignature()
-    {
-        return m_originalType;
+        if( ( bareType.kind == CXType_Int ) && !spelledTypeExpr.empty() && !spellsInt )
+        {
+            typeExpr = spelledTypeExpr;
+            return true;
+        }
     }
 
-    virtual std::string GetMockBodyFront() const = 0;
-
-    virtual std::string GetMockBodyBack() const = 0;
-
-protected:
-    std::string m_originalType;
-    std::string m_mockRetExprFront;
-    std::string m_mockRetExprBack;
-};
+    return false;
+}
 
-class ReturnVoid : public Function::Return
+// Checks if the type pointed / referenced by the declarator found at position @p declaratorPos is const qualified
+static bool IsUnresolvedPointeeConst( const std::string &typeExpr, size_t declaratorPos )
 {
-public:
-    virtual ~ReturnVoid() {};
-
-    virtual std::string GetMockBodyFront() const override
+    std::string pointeeTypeExpr = typeExpr.substr( 0, declaratorPos );
+    size_t pointeeDeclaratorPos = pointeeTypeExpr.find_last_of( "*&" );
+    if( pointeeDeclaratorPos != std::string::npos )
     {
-        return "";
+        pointeeTypeExpr = pointeeTypeExpr.substr( pointeeDeclaratorPos + 1 );
     }
 
-    virtual std::string GetMockBodyBack() const override
+    std::istringstream pointeeTypeTokens( pointeeTypeExpr );
+    std::string token;
+    while( pointeeTypeTokens >> token )
     {
-        return "";
-    }
-};
-
-class ReturnStandard : public Function::Return
-{
-public:
-    virtual ~ReturnStandard() {};
-
-    virtual std::string GetMockBodyFront() const override
-    {
-        return "return " + m_mockRetExprFront;
+        if( token == "const" )
+        {
+            return true;
+        }
     }
 
-    virtual std::string GetMockBodyBack() const override
-    {
-        return GetMockCall() + m_mockRetExprBack;
-    }
+    return false;
+}
 
-    virtual std::string GetMockCall() const = 0;
-};
+//*************************************************************************************************
+//
+//                                             MOCKED TYPES
+//
+//*************************************************************************************************
 
-class ReturnBool : public ReturnStandard
+// How values of a mocked type are passed to and returned from CppUMock
+struct MockedTypeDescriptor
 {
-public:
-    virtual ~ReturnBool() {};
-
-    virtual std::string GetMockCall() const override
-    {
-        return ".returnBoolValue()";
-    }
+    const char *mockCall;       // Call used to pass an argument to the actual call (nullptr if not passed)
+    const char *expectCall;     // Call used to pass an argument to the expected call (nullptr if not passed)
+    const char *returnCall;     // Call used to get the return value of the actual call (nullptr if nothing returned)
+    const char *traceType;      // Type used to record the value in traces (nullptr if it cannot be recorded)
+    bool passesExposedType;     // The exposed type name is passed before the argument name
+    bool passesOutputSize;      // The size of the output argument is passed to the expected call
 };
 
-class ReturnInt : public ReturnStandard
+// Indexed by MockedType
+static constexpr MockedTypeDescriptor mockedTypeDescriptors[] =
 {
-public:
-    virtual ~ReturnInt() {};
-
-    virtual std::string GetMockCall() const override
-    {
-        return ".returnIntValue()";
-    }
+    /* Bool             */ { ".withBoolParameter(", ".withBoolParameter(", ".returnBoolValue()", "bool", false, false },
+    /* Int              */ { ".withIntParameter(", ".withIntParameter(", ".returnIntValue()", "int", false, false },
+    /* UnsignedInt      */ { ".withUnsignedIntParameter(", ".withUnsignedIntParameter(", ".returnUnsignedIntValue()",
+                             "unsigned int", false, false },
+    /* Long             */ { ".withLongIntParameter(", ".withLongIntParameter(", ".returnLongIntValue()", "long", false, false },
+    /* UnsignedLong     */ { ".withUnsignedLongIntParameter(", ".withUnsignedLongIntParameter(", ".returnUnsignedLongIntValue()",
+                             "unsigned long", false, false },
+    /* Double           */ { ".withDoubleParameter(", ".withDoubleParameter(", ".returnDoubleValue()", "double", false, false },
+    /* String           */ { ".withStringParameter(", ".withStringParameter(", ".returnStringValue()", nullptr, false, false },
+    /* Pointer          */ { ".withPointerParameter(", ".withPointerParameter(", ".returnPointerValue()", nullptr, false, false },
+    /* ConstPointer     */ { ".withConstPointerParameter(", ".withConstPointerParameter(", ".returnConstPointerValue()",
+                             nullptr, false, false },
+    /* Output           */ { ".withOutputParameter(", ".withOutputParameterReturning(", nullptr, nullptr, false, true },
+    /* Skip             */ { nullptr, nullptr, nullptr, nullptr, false, false },
+    /* LongLong         */ { ".withLongLongIntParameter(", ".withLongLongIntParameter(", ".returnLongLongIntValue()",
+                             "long long", false, false },
+    /* UnsignedLongLong */ { ".withUnsignedLongLongIntParameter(", ".withUnsignedLongLongIntParameter(",
+                             ".returnUnsignedLongLongIntValue()", "unsigned long long", false, false },
+    /* OfType           */ { ".withParameterOfType(", ".withParameterOfType(", nullptr, nullptr, true, false },
+    /* OutputOfType     */ { ".withOutputParameterOfType(", ".withOutputParameterOfTypeReturning(", nullptr, nullptr,
+                             true, false },
+    /* Void             */ { nullptr, nullptr, nullptr, "void", false, false },
 };
 
-class ReturnUnsignedInt : public ReturnStandard
-{
-public:
-    virtual ~ReturnUnsignedInt() {};
-
-    virtual std::string GetMockCall() const override
-    {
-        return ".returnUnsignedIntValue()";
-    }
-};
+static_assert( ( sizeof( mockedTypeDescriptors ) / sizeof( mockedTypeDescriptors[0] ) ) == ( static_cast<size_t>( MockedType::Void ) + 1 ),
+               "There must be a descriptor for each mocked type" );
 
-class ReturnLong : public ReturnStandard
+static const MockedTypeDescriptor& GetDescriptor( MockedType type )
 {
-public:
-    virtual ~ReturnLong() {};
-
-    virtual std::string GetMockCall() const override
-    {
-        return ".returnLongIntValue()";
-    }
-};
+    return mockedTypeDescriptors[ static_cast<size_t>( type ) ];
+}
 
-class ReturnUnsignedLong : public ReturnStandard
+// Appends the declaration of the argument in the signature of the mock or the expectation
+static void AppendSignature( std::string &output, const Function::Argument &argument, bool mock )
 {
-public:
-    virtual ~ReturnUnsignedLong() {};
+    output += argument.originalType;
 
-    virtual std::string GetMockCall() const override
+    if( argument.type != MockedType::Skip )
     {
-        return ".returnUnsignedLongIntValue()";
-    }
-};
+        output += ' ';
+        output += argument.name;
 
-class ReturnUnsignedLongLong : public ReturnStandard
-{
-public:
-    virtual ~ReturnUnsignedLongLong() {};
-
-    virtual std::string GetMockCall() const override
-    {
-        return ".returnUnsignedLongLongIntValue()";
+        if( !mock && GetDescriptor( argument.type ).passesOutputSize )
+        {
+            output += ", size_t __sizeof_";
+            output += argument.name;
+        }
     }
-};
+}
 
-class ReturnLongLong : public ReturnStandard
+// Appends the expression that passes the argument to CppUMock
+static void AppendMockArgExpr( std::string &output, const Function::Argument &argument )
 {
-public:
-    virtual ~ReturnLongLong() {};
+    output += argument.mockExprFront;
+    output += argument.name;
+    output += argument.mockExprBack;
+}
 
-    virtual std::string GetMockCall() const override
+// Appends the call that passes the argument to the actual call (mock) or to the expected call (expectation)
+static void AppendCall( std::string &output, const Function::Argument &argument, bool mock )
+{
+    const MockedTypeDescriptor &descriptor = GetDescriptor( argument.type );
+    const char *call = mock ? descriptor.mockCall : descriptor.expectCall;
+    if( call == nullptr )
     {
-        return ".returnLongLongIntValue()";
+        return;
     }
-};
 
-class ReturnDouble : public ReturnStandard
-{
-public:
-    virtual ~ReturnDouble() {};
+    output += call;
 
-    virtual std::string GetMockCall() const override
+    if( descriptor.passesExposedType )
     {
-        return ".returnDoubleValue()";
+        output += '"';
+        output += argument.exposedType;
+        output += "\", ";
     }
-};
 
-class ReturnString : public ReturnStandard
-{
-public:
-    virtual ~ReturnString() {};
+    output += '"';
+    output += argument.name;
+    output += "\", ";
+    AppendMockArgExpr( output, argument );
 
-    virtual std::string GetMockCall() const override
+    if( !mock && descriptor.passesOutputSize )
     {
-        return ".returnStringValue()";
+        output += ", __sizeof_";
+        output += argument.name;
     }
-};
 
-class ReturnConstPointer : public ReturnStandard
+    output += ')';
+}
+
+static const char* GetTraceType( const Function::Argument &argument )
 {
-public:
-    virtual ~ReturnConstPointer() {};
+    const char *traceType = GetDescriptor( argument.type ).traceType;
+    return ( traceType != nullptr ) ? traceType : "";
+}
 
-    virtual std::string GetMockCall() const override
-    {
-        return ".returnConstPointerValue()";
-    }
-};
+static const char* GetTraceType( const Function::Return &ret )
+{
+    const char *traceType = GetDescriptor( ret.type ).traceType;
+    return ( ( traceType != nullptr ) && ret.traceable ) ? traceType : "";
+}
 
-class ReturnPointer : public ReturnStandard
+static std::string GetMockRetExpr( const Function::Return &ret, const std::string &value )
 {
-public:
-    virtual ~ReturnPointer() {};
+    return ret.mockExprFront + value + ret.mockExprBack;
+}
 
-    virtual std::string GetMockCall() const override
-    {
-        return ".returnPointerValue()";
-    }
-};
+//*************************************************************************************************
+//
+//                                             RETURN PROCESSING
+//
+//*************************************************************************************************
 
 class ReturnParser
 {
@@ -209,27 +210,30 @@ public:
     : m_config( config )
     {}
 
-    Function::Return* Process( const std::string funcName, const CXType &returnType );
+    Function::Return Process( const std::string funcName, const CXCursor &cursor );
 
 private:
-    Function::Return* ProcessOverride( const Config::OverrideSpec *override );
-    Function::Return* ProcessType( const CXType &returnType, bool inheritConst, bool enableCast );
-    Function::Return* ProcessTypePointer( const CXType & returnType, bool enableCast );
-    Function::Return* ProcessTypeRVReference( const CXType & returnType );
-    Function::Return* ProcessTypeTypedef( const CXType & returnType, bool inheritConst );
+    Function::Return ProcessOverride( const Config::OverrideSpec *override );
+    Function::Return ProcessUnresolvedType( const std::string &typeExpr );
+    Function::Return ProcessType( const CXType &returnType, bool inheritConst, bool enableCast );
+    Function::Return ProcessTypePointer( const CXType & returnType, bool enableCast );
+    Function::Return ProcessTypeRVReference( const CXType & returnType );
+    Function::Return ProcessTypeTypedef( const CXType & returnType, bool inheritConst );
 
     const Config &m_config;
 };
 
-Function::Return* ReturnParser::Process( const std::string funcName, const CXType &returnType )
+Function::Return ReturnParser::Process( const std::string funcName, const CXCursor &cursor )
 {
-    Function::Return *ret;
+    Function::Return ret;
 
+    const CXType returnType = clang_getCursorResultType( cursor );
     std::string typeExpr = toString( clang_getTypeSpelling( returnType ) );
+    bool isUnresolved = IsUnresolvedType( cursor, returnType, typeExpr );
 
     if( returnType.kind == CXType_Void )
     {
-        ret = new ReturnVoid;
+        ret.type = MockedType::Void;
     }
     else
     {
@@ -244,7 +248,11 @@ Function::Return* ReturnParser::Process( const std::string funcName, const CXTyp
             override = m_config.GetTypeOverride( overrideKey );
         }
 
-        if( override == NULL )
+        if( ( override == NULL ) && isUnresolved )
+        {
+            ret = ProcessUnresolvedType( typeExpr );
+        }
+        else if( override == NULL )
         {
             ret = ProcessType( returnType, false, true );
         }
@@ -254,80 +262,94 @@ Function::Return* ReturnParser::Process( const std::string funcName, const CXTyp
         }
     }
 
-    ret->SetOriginalType( typeExpr );
+    ret.originalType = typeExpr;
 
     return ret;
 }
 
-Function::Return* ReturnParser::ProcessOverride( const Config::OverrideSpec *override )
+Function::Return ReturnParser::ProcessOverride( const Config::OverrideSpec *override )
 {
-    Function::Return *ret;
+    Function::Return ret;
     MockedType overrideType = override->GetType();
 
-    switch( overrideType )
+// LCOV_EXCL_START
+    if( GetDescriptor( overrideType ).returnCall == nullptr )
     {
-        case MockedType::Bool:
-            ret = new ReturnBool;
-            break;
-
-        case MockedType::Int:
-            ret = new ReturnInt;
-            break;
+        throw std::runtime_error( "<INTERNAL ERROR> Unsupported mocked return type override" );
+    }
+// LCOV_EXCL_STOP
 
-        case MockedType::UnsignedInt:
-            ret = new ReturnUnsignedInt;
-            break;
+    ret.type = overrideType;
 
-        case MockedType::Long:
-            ret = new ReturnLong;
-            break;
+    ret.mockExprFront = override->GetExprModFront();
+    ret.mockExprBack = override->GetExprModBack();
 
-        case MockedType::UnsignedLong:
-            ret = new ReturnUnsignedLong;
-            break;
+    // The value returned by the real function can't be converted back to the overridden mocked type
+    ret.traceable = false;
 
-        case MockedType::Double:
-            ret = new ReturnDouble;
-            break;
+    return ret;
+}
 
-        case MockedType::String:
-            ret = new ReturnString;
-            break;
+Function::Return ReturnParser::ProcessUnresolvedType( const std::string &typeExpr )
+{
+    Function::Return ret;
 
-        case MockedType::Pointer:
-            ret = new ReturnPointer;
-            break;
+    // Unresolved types are assumed to be records, which are returned by the mock as pointers
+    size_t declaratorPos = typeExpr.find_last_of( "*&" );
+    if( declaratorPos == std::string::npos )
+    {
+        // Dereference and cast mock return pointer to proper pointer type
+        ret.type = MockedType::ConstPointer;
+        ret.mockExprFront.insert( 0, "* static_cast<const " + typeExpr + " *>( " );
+        ret.mockExprBack += " )";
+    }
+    else
+    {
+        if( IsUnresolvedPointeeConst( typeExpr, declaratorPos ) )
+        {
+            ret.type = MockedType::ConstPointer;
+        }
+        else
+        {
+            ret.type = MockedType::Pointer;
+        }
 
-        case MockedType::ConstPointer:
-            ret = new ReturnConstPointer;
-            break;
+        // Cast mock return pointer to proper pointer type
+        bool isRVReference = ( typeExpr.compare( declaratorPos - 1, 2, "&&" ) == 0 );
+        std::string pointeeTypeExpr = typeExpr.substr( 0, typeExpr.find_last_not_of( ' ', declaratorPos - ( isRVReference ? 2 : 1 ) ) + 1 );
+        ret.mockExprFront.insert( 0, "static_cast<" + pointeeTypeExpr + " *>( " );
+        ret.mockExprBack += " )";
 
-// LCOV_EXCL_START
-        default:
-            throw std::runtime_error( "<INTERNAL ERROR> Unsupported mocked return type override" );
-// LCOV_EXCL_STOP
+        if( isRVReference )
+        {
+            // Dereference mock return pointer
+            ret.mockExprFront.insert( 0, "std::move( * " );
+            ret.mockExprBack += " )";
+        }
+        else if( typeExpr[declaratorPos] == '&' )
+        {
+            // Dereference mock return pointer
+            ret.mockExprFront.insert( 0, "* " );
+        }
     }
 
-    ret->MockRetExprPrepend( override->GetExprModFront() );
-    ret->MockRetExprAppend( override->GetExprModBack() );
-
     return ret;
 }
 
-Function::Return* ReturnParser::ProcessType( const CXType &returnType, bool inheritConst, bool enableCast )
+Function::Return ReturnParser::ProcessType( const CXType &returnType, bool inheritConst, bool enableCast )
 {
-    Function::Return *ret;
+    Function::Return ret;
 
     bool needsCast = false;
 
     switch( returnType.kind )
     {
         case CXType_Bool:
-            ret = new ReturnBool;
+            ret.type = MockedType::Bool;
             break;
 
         case CXType_Int:
-            ret = new ReturnInt;
+            ret.type = MockedType::Int;
             break;
 
         case CXType_Char_S:
@@ -336,11 +358,11 @@ Function::Return* ReturnParser::ProcessType( const CXType &returnType, bool inhe
         case CXType_WChar:
         case CXType_Enum:
             needsCast = true;
-            ret = new ReturnInt;
+            ret.type = MockedType::Int;
             break;
 
         case CXType_UInt:
-            ret = new ReturnUnsignedInt;
+            ret.type = MockedType::UnsignedInt;
             break;
 
         case CXType_Char_U:
@@ -348,37 +370,37 @@ Function::Return* ReturnParser::ProcessType( const CXType &returnType, bool inhe
         case CXType_UShort:
         case CXType_Char16:
             needsCast = true;
-            ret = new ReturnUnsignedInt;
+            ret.type = MockedType::UnsignedInt;
             break;
 
         case CXType_Long:
-            ret = new ReturnLong;
+            ret.type = MockedType::Long;
             break;
 
         case CXType_ULong:
-            ret = new ReturnUnsignedLong;
+            ret.type = MockedType::UnsignedLong;
             break;
 
         case CXType_LongLong:
-            ret = new ReturnLongLong;
+            ret.type = MockedType::LongLong;
             break;
 
         case CXType_ULongLong:
-            ret = new ReturnUnsignedLongLong;
+            ret.type = MockedType::UnsignedLongLong;
             break;
 
         case CXType_Char32:
             needsCast = true;
-            ret = new ReturnUnsignedLong;
+            ret.type = MockedType::UnsignedLong;
             break;
 
         case CXType_Double:
-            ret = new ReturnDouble;
+            ret.type = MockedType::Double;
             break;
 
         case CXType_Float:
             needsCast = true;
-            ret = new ReturnDouble;
+            ret.type = MockedType::Double;
             break;
 
         case CXType_Pointer:
@@ -390,11 +412,11 @@ Function::Return* ReturnParser::ProcessType( const CXType &returnType, bool inhe
         case CXType_Record:
         case CXType_Unexposed: // Template classes are processed as "Unexposed" kind
             // Dereference and cast mock return pointer to proper pointer type
-            ret = new ReturnConstPointer;
+            ret.type = MockedType::ConstPointer;
             if( enableCast )
             {
-                ret->MockRetExprPrepend( "* static_cast<const " + clang_getTypeSpelling( returnType ) + " *>( " );
-                ret->MockRetExprAppend( " )" );
+                ret.mockExprFront.insert( 0, "* static_cast<const " + clang_getTypeSpelling( returnType ) + " *>( " );
+                ret.mockExprBack += " )";
             }
             break;
 
@@ -415,16 +437,16 @@ Function::Return* ReturnParser::ProcessType( const CXType &returnType, bool inhe
 
     if( needsCast && enableCast )
     {
-        ret->MockRetExprPrepend( "static_cast<" + clang_getTypeSpelling( returnType ) + ">( " );
-        ret->MockRetExprAppend( " )" );
+        ret.mockExprFront.insert( 0, "static_cast<" + clang_getTypeSpelling( returnType ) + ">( " );
+        ret.mockExprBack += " )";
     }
 
     return ret;
 }
 
-Function::Return* ReturnParser::ProcessTypePointer( const CXType &returnType, bool enableCast )
+Function::Return ReturnParser::ProcessTypePointer( const CXType &returnType, bool enableCast )
 {
-    Function::Return *ret;
+    Function::Return ret;
 
     const CXType pointeeType = clang_getPointeeType( returnType );
     bool isPointeeConst = clang_isConstQualifiedType( pointeeType );
@@ -433,7 +455,7 @@ Function::Return* ReturnParser::ProcessTypePointer( const CXType &returnType, bo
         ( pointeeType.kind == CXType_Char_S ) &&
         isPointeeConst )
     {
-        ret = new ReturnString;
+        ret.type = MockedType::String;
     }
     else
     {
@@ -443,39 +465,39 @@ Function::Return* ReturnParser::ProcessTypePointer( const CXType &returnType, bo
 
         if( isPointeeConst || isUnderlyingPointeeConst )
         {
-            ret = new ReturnConstPointer;
+            ret.type = MockedType::ConstPointer;
         }
         else
         {
-            ret = new ReturnPointer;
+            ret.type = MockedType::Pointer;
         }
 
         if( enableCast && ( pointeeType.kind != CXType_Void ) )
         {
             // Cast mock return pointer to proper pointer type
-            ret->MockRetExprPrepend( "static_cast<" + clang_getTypeSpelling( pointeeType ) + " *>( " );
-            ret->MockRetExprAppend( " )" );
+            ret.mockExprFront.insert( 0, "static_cast<" + clang_getTypeSpelling( pointeeType ) + " *>( " );
+            ret.mockExprBack += " )";
         }
     }
 
     if( returnType.kind == CXType_LValueReference )
     {
         // Dereference mock return pointer
-        ret->MockRetExprPrepend( "* " );
+        ret.mockExprFront.insert( 0, "* " );
     }
     else if( returnType.kind == CXType_RValueReference )
     {
         // Dereference mock return pointer
-        ret->MockRetExprPrepend( "std::move( * " );
-        ret->MockRetExprAppend( " )" );
+        ret.mockExprFront.insert( 0, "std::move( * " );
+        ret.mockExprBack += " )";
     }
 
     return ret;
 }
 
-Function::Return* ReturnParser::ProcessTypeTypedef( const CXType &returnType, bool inheritConst )
+Function::Return ReturnParser::ProcessTypeTypedef( const CXType &returnType, bool inheritConst )
 {
-    Function::Return *ret;
+    Function::Return ret;
 
     const CXType underlyingType = clang_getCanonicalType( returnType );
 
@@ -496,14 +518,14 @@ Function::Return* ReturnParser::ProcessTypeTypedef( const CXType &returnType, bo
         ( underlyingType.kind == CXType_Unexposed ) )
     {
         // Dereference mock return pointer
-        ret->MockRetExprPrepend( "* static_cast<const " + clang_getTypeSpelling( returnType ) + " *>( " );
-        ret->MockRetExprAppend( " )" );
+        ret.mockExprFront.insert( 0, "* static_cast<const " + clang_getTypeSpelling( returnType ) + " *>( " );
+        ret.mockExprBack += " )";
     }
     else
     {
         // Just cast
-        ret->MockRetExprPrepend( "static_cast<" + clang_getTypeSpelling( returnType ) + ">( " );
-        ret->MockRetExprAppend( " )" );
+        ret.mockExprFront.insert( 0, "static_cast<" + clang_getTypeSpelling( returnType ) + ">( " );
+        ret.mockExprBack += " )";
     }
 
     return ret;
@@ -517,277 +539,96 @@ Function::Return* ReturnParser::ProcessTypeTypedef( const CXType &returnType, bo
 //*************************************************************************************************
 
 
-class Function::Argument
-{
-public:
-    virtual ~Argument() {}
-
-    void SetName( const std::string &name )
-    {
-        m_name = name;
-    }
-
-    void SetOriginalType( const std::string &type )
-    {
-        m_originalType = type;
-    }
-
-    void MockArgExprPrepend( const std::string &expr )
-    {
-        m_mockArgExprFront.insert( 0, expr );
-    }
-
-    void MockArgExprAppend( const std::string &expr )
-    {
-        m_mockArgExprBack.append( expr );
-    }
+static bool IsMemComparableRecord( const CXType &type );
 
-    virtual std::string GetSignature(bool mock) const = 0;
-
-    virtual std::string GetBody(bool mock) const = 0;
-
-protected:
-    std::string m_name;
-    std::string m_originalType;
-    std::string m_mockArgExprFront;
-    std::string m_mockArgExprBack;
-};
-
-class ArgumentSkip : public Function::Argument
+static bool IsMemComparableField( const CXType &type )
 {
-public:
-    virtual ~ArgumentSkip() {}
+    const CXType canonicalType = clang_getCanonicalType( type );
 
-    virtual std::string GetSignature(bool) const override
+    switch( canonicalType.kind )
     {
-        return m_originalType;
-    }
-
-    virtual std::string GetBody(bool) const override
-    {
-        return "";
-    }
-};
-
-class ArgumentStandard : public Function::Argument
-{
-public:
-    virtual ~ArgumentStandard() {}
-
-    virtual std::string GetSignature(bool) const override
-    {
-        return m_originalType + " " + m_name;
-    }
-
-    virtual std::string GetBody(bool mock) const override
-    {
-        return GetCallFront(mock) + "\"" + m_name + "\", " + m_mockArgExprFront + m_name + m_mockArgExprBack + GetCallBack(mock);
-    }
-
-    virtual std::string GetCallFront(bool mock) const = 0;
-
-    virtual std::string GetCallBack(bool) const
-    {
-        return ")";
-    }
-};
-
-class ArgumentBool : public ArgumentStandard
-{
-public:
-    virtual ~ArgumentBool() {}
-
-    virtual std::string GetCallFront(bool) const override
-    {
-        return ".withBoolParameter(";
-    }
-};
-
-class ArgumentInt : public ArgumentStandard
-{
-public:
-    virtual ~ArgumentInt() {}
-
-    virtual std::string GetCallFront(bool) const override
-    {
-        return ".withIntParameter(";
-    }
-};
-
-class ArgumentUnsignedInt : public ArgumentStandard
-{
-public:
-    virtual ~ArgumentUnsignedInt() {}
-
-    virtual std::string GetCallFront(bool) const override
-    {
-        return ".withUnsignedIntParameter(";
-    }
-};
-
-class ArgumentLong : public ArgumentStandard
-{
-public:
-    virtual ~ArgumentLong() {}
-
-    virtual std::string GetCallFront(bool) const override
-    {
-        return ".withLongIntParameter(";
-    }
-};
-
-class ArgumentLongLong : public ArgumentStandard
-{
-public:
-    virtual ~ArgumentLongLong() {}
-
-    virtual std::string GetCallFront(bool) const override
-    {
-        return ".withLongLongIntParameter(";
-    }
-};
-
-class ArgumentUnsignedLongLong : public ArgumentStandard
-{
-public:
-    virtual ~ArgumentUnsignedLongLong() {}
-
-    virtual std::string GetCallFront(bool) const override
-    {
-        return ".withUnsignedLongLongIntParameter(";
-    }
-};
-class ArgumentUnsignedLong : public ArgumentStandard
-{
-public:
-    virtual ~ArgumentUnsignedLong() {}
+        case CXType_Bool:
+        case CXType_Char_S:
+        case CXType_SChar:
+        case CXType_Char_U:
+        case CXType_UChar:
+        case CXType_WChar:
+        case CXType_Char16:
+        case CXType_Char32:
+        case CXType_Short:
+        case CXType_UShort:
+        case CXType_Int:
+        case CXType_UInt:
+        case CXType_Long:
+        case CXType_ULong:
+        case CXType_LongLong:
+        case CXType_ULongLong:
+        case CXType_Enum:
+        case CXType_Pointer:
+            return true;
 
-    virtual std::string GetCallFront(bool) const override
-    {
-        return ".withUnsignedLongIntParameter(";
-    }
-};
+        case CXType_ConstantArray:
+            return IsMemComparableField( clang_getArrayElementType( canonicalType ) );
 
-class ArgumentDouble : public ArgumentStandard
-{
-public:
-    virtual ~ArgumentDouble() {}
+        case CXType_Record:
+            return IsMemComparableRecord( canonicalType );
 
-    virtual std::string GetCallFront(bool) const override
-    {
-        return ".withDoubleParameter(";
+        default:
+            // Floating point values are not bitwise comparable (e.g. +0.0 == -0.0), and other kinds of
+            // fields (references, incomplete arrays, etc.) cannot be copied or compared as raw memory
+            return false;
     }
-};
+}
 
-class ArgumentString : public ArgumentStandard
+/**
+ * Returns whether objects of the record type @p type can be compared with memcmp and copied with memcpy,
+ * i.e. the record is a POD without bitfields, unions, floating point fields nor padding bytes.
+ */
+static bool IsMemComparableRecord( const CXType &type )
 {
-public:
-    virtual ~ArgumentString() {}
+    const CXType canonicalType = clang_getCanonicalType( type );
 
-    virtual std::string GetCallFront(bool) const override
+    if( ( canonicalType.kind != CXType_Record ) || !clang_isPODType( canonicalType ) ||
+        ( clang_getCursorKind( clang_getTypeDeclaration( canonicalType ) ) == CXCursor_UnionDecl ) )
     {
-        return ".withStringParameter(";
+        return false;
     }
-};
-
-class ArgumentPointer : public ArgumentStandard
-{
-public:
-    virtual ~ArgumentPointer() {}
 
-    virtual std::string GetCallFront(bool) const override
+    long long recordSize = clang_Type_getSizeOf( canonicalType );
+    if( recordSize <= 0 )
     {
-        return ".withPointerParameter(";
+        // Incomplete or dependent type
+        return false;
     }
-};
 
-class ArgumentConstPointer : public ArgumentStandard
-{
-public:
-    virtual ~ArgumentConstPointer() {}
-
-    virtual std::string GetCallFront(bool) const override
+    struct FieldsData
     {
-        return ".withConstPointerParameter(";
-    }
-};
+        long long size;
+        bool valid;
+    };
 
-class ArgumentOutput : public ArgumentStandard
-{
-public:
-    virtual ~ArgumentOutput() {}
+    FieldsData fieldsData = { 0, true };
 
-    virtual std::string GetSignature(bool mock) const override
-    {
-        std::string ret = m_originalType + " " + m_name;
-        if( !mock )
+    clang_Type_visitFields( canonicalType,
+        []( CXCursor cursor, CXClientData clientData )
         {
-            ret += ", size_t __sizeof_" + m_name;
-        }
-        return ret;
-    }
+            FieldsData *fieldsData = (FieldsData*) clientData;
+            const CXType fieldType = clang_getCursorType( cursor );
 
-    virtual std::string GetCallFront(bool mock) const override
-    {
-        if( mock )
-        {
-            return ".withOutputParameter(";
-        }
-        else
-        {
-            return ".withOutputParameterReturning(";
-        }
-    }
-
-    virtual std::string GetCallBack(bool mock) const
-    {
-        if( mock )
-        {
-            return ")";
-        }
-        else
-        {
-            return ", __sizeof_" + m_name + ")";
-        }
-    }
-};
-
-class ArgumentOfType : public ArgumentStandard
-{
-public:
-    virtual ~ArgumentOfType() {}
-
-    virtual std::string GetCallFront(bool) const override
-    {
-        return ".withParameterOfType(\"" + m_exposedType + "\", ";
-    }
-
-    void SetExposedType( const std::string &type )
-    {
-        m_exposedType = type;
-    }
-
-protected:
-    std::string m_exposedType;
-};
+            if( clang_Cursor_isBitField( cursor ) || !IsMemComparableField( fieldType ) )
+            {
+                fieldsData->valid = false;
+                return CXVisit_Break;
+            }
 
-class ArgumentOutputOfType : public ArgumentOfType
-{
-public:
-    virtual ~ArgumentOutputOfType() {}
+            fieldsData->size += clang_Type_getSizeOf( fieldType );
+            return CXVisit_Continue;
+        },
+        (CXClientData) &fieldsData );
 
-    virtual std::string GetCallFront(bool mock) const override
-    {
-        if( mock )
-        {
-            return ".withOutputParameterOfType(\"" + m_exposedType + "\", ";
-        }
-        else
-        {
-            return ".withOutputParameterOfTypeReturning(\"" + m_exposedType + "\", ";
-        }
-    }
-};
+    // If the fields do not fill the whole record, there are padding bytes with indeterminate values
+    return fieldsData.valid && ( fieldsData.size == recordSize );
+}
 
 class ArgumentParser
 {
@@ -796,26 +637,28 @@ public:
     : m_config( config )
     {}
 
-    Function::Argument* Process( const std::string funcName, const CXCursor &arg, int argNum );
+    Function::Argument Process( const std::string funcName, const CXCursor &arg, int argNum );
 
 private:
-    Function::Argument* ProcessOverride( const Config::OverrideSpec *override );
-    Function::Argument* ProcessType( const CXType &argType, const CXType &origArgType, bool inheritConst );
-    Function::Argument* ProcessTypePointer( const CXType &argType, const CXType &origArgType );
-    Function::Argument* ProcessTypeRVReference( const CXType &argType, const CXType &origArgType );
-    Function::Argument* ProcessTypeTypedef( const CXType &argType, const CXType &origArgType, bool inheritConst );
-    Function::Argument* ProcessTypeRecord( const CXType &argType, const CXType &origArgType, bool inheritConst, bool isPointee );
+    Function::Argument ProcessOverride( const Config::OverrideSpec *override );
+    Function::Argument ProcessUnresolvedType( const std::string &typeExpr );
+    Function::Argument ProcessType( const CXType &argType, const CXType &origArgType, bool inheritConst );
+    Function::Argument ProcessTypePointer( const CXType &argType, const CXType &origArgType );
+    Function::Argument ProcessTypeRVReference( const CXType &argType, const CXType &origArgType );
+    Function::Argument ProcessTypeTypedef( const CXType &argType, const CXType &origArgType, bool inheritConst );
+    Function::Argument ProcessTypeRecord( const CXType &argType, const CXType &origArgType, bool inheritConst, bool isPointee );
 
     const Config &m_config;
 };
 
-Function::Argument* ArgumentParser::Process( const std::string funcName, const CXCursor &arg, int argNum )
+Function::Argument ArgumentParser::Process( const std::string funcName, const CXCursor &arg, int argNum )
 {
-    Function::Argument *ret;
+    Function::Argument ret;
 
     // Get argument type
     const CXType argType = clang_getCursorType( arg );
     std::string typeExpr = toString( clang_getTypeSpelling( argType ) );
+    bool isUnresolved = IsUnresolvedType( arg, argType, typeExpr );
 
     // Get argument name
     std::string argName = toString( clang_getCursorSpelling( arg ) );
@@ -837,7 +680,11 @@ Function::Argument* ArgumentParser::Process( const std::string funcName, const C
         override = m_config.GetTypeOverride( overrideKey );
     }
 
-    if( override == NULL )
+    if( ( override == NULL ) && isUnresolved )
+    {
+        ret = ProcessUnresolvedType( typeExpr );
+    }
+    else if( override == NULL )
     {
         ret = ProcessType( argType, argType, false );
     }
@@ -846,86 +693,76 @@ Function::Argument* ArgumentParser::Process( const std::string funcName, const C
         ret = ProcessOverride( override );
     }
 
-    ret->SetName( argName );
-    ret->SetOriginalType( typeExpr );
+    ret.name = argName;
+    ret.originalType = typeExpr;
 
     return ret;
 }
 
-Function::Argument* ArgumentParser::ProcessOverride( const Config::OverrideSpec *override )
+Function::Argument ArgumentParser::ProcessOverride( const Config::OverrideSpec *override )
 {
-    Function::Argument *ret;
+    Function::Argument ret;
     MockedType overrideType = override->GetType();
 
-    switch( overrideType )
+// LCOV_EXCL_START
+    if( ( GetDescriptor( overrideType ).mockCall == nullptr ) && ( overrideType != MockedType::Skip ) )
     {
-        case MockedType::Bool:
-            ret = new ArgumentBool;
-            break;
-
-        case MockedType::Int:
-            ret = new ArgumentInt;
-            break;
-
-        case MockedType::UnsignedInt:
-            ret = new ArgumentUnsignedInt;
-            break;
-
-        case MockedType::Long:
-            ret = new ArgumentLong;
-            break;
-
-        case MockedType::UnsignedLong:
-            ret = new ArgumentUnsignedLong;
-            break;
-
-        case MockedType::Double:
-            ret = new ArgumentDouble;
-            break;
-
-        case MockedType::String:
-            ret = new ArgumentString;
-            break;
+        throw std::runtime_error( "<INTERNAL ERROR> Unsupported mocked argument type override" );
+    }
+// LCOV_EXCL_STOP
 
-        case MockedType::Pointer:
-            ret = new ArgumentPointer;
-            break;
+    ret.type = overrideType;
 
-        case MockedType::ConstPointer:
-            ret = new ArgumentConstPointer;
-            break;
+    if( overrideType != MockedType::Skip )
+    {
+        ret.mockExprFront = override->GetExprModFront();
+        ret.mockExprBack = override->GetExprModBack();
+    }
 
-        case MockedType::Output:
-            ret = new ArgumentOutput;
-            break;
+    return ret;
+}
 
-        case MockedType::Skip:
-            ret = new ArgumentSkip;
-            break;
+Function::Argument ArgumentParser::ProcessUnresolvedType( const std::string &typeExpr )
+{
+    Function::Argument ret;
 
-// LCOV_EXCL_START
-        default:
-            throw std::runtime_error( "<INTERNAL ERROR> Unsupported mocked argument type override" );
-// LCOV_EXCL_STOP
+    // Unresolved types are assumed to be records, but since they may be incomplete, pointers and references to them
+    // are mocked as opaque pointers
+    size_t declaratorPos = typeExpr.find_last_of( "*&" );
+    if( declaratorPos == std::string::npos )
+    {
+        ret.type = MockedType::OfType;
+        ret.exposedType = getBareTypeSpelling( typeExpr );
+        ret.mockExprFront.insert( 0, "&" );
     }
-
-    if( overrideType != MockedType::Skip )
+    else
     {
-        ret->MockArgExprPrepend( override->GetExprModFront() );
-        ret->MockArgExprAppend( override->GetExprModBack() );
+        if( IsUnresolvedPointeeConst( typeExpr, declaratorPos ) )
+        {
+            ret.type = MockedType::ConstPointer;
+        }
+        else
+        {
+            ret.type = MockedType::Pointer;
+        }
+
+        if( typeExpr[declaratorPos] == '&' )
+        {
+            ret.mockExprFront.insert( 0, "&" );
+        }
     }
 
     return ret;
 }
 
-Function::Argument* ArgumentParser::ProcessType( const CXType &argType, const CXType &origArgType, bool inheritConst )
+Function::Argument ArgumentParser::ProcessType( const CXType &argType, const CXType &origArgType, bool inheritConst )
 {
-    Function::Argument *ret;
+    Function::Argument ret;
 
     switch( argType.kind )
     {
         case CXType_Bool:
-            ret = new ArgumentBool;
+            ret.type = MockedType::Bool;
             break;
 
         case CXType_Char_S:
@@ -933,13 +770,13 @@ Function::Argument* ArgumentParser::ProcessType( const CXType &argType, const CX
         case CXType_Int:
         case CXType_Short:
         case CXType_WChar:
-            ret = new ArgumentInt;
+            ret.type = MockedType::Int;
             break;
 
         case CXType_Enum:
-            ret = new ArgumentInt;
-            ret->MockArgExprPrepend( "static_cast<int>(" );
-            ret->MockArgExprAppend( ")" );
+            ret.type = MockedType::Int;
+            ret.mockExprFront.insert( 0, "static_cast<int>(" );
+            ret.mockExprBack += ")";
             break;
 
         case CXType_Char_U:
@@ -947,29 +784,29 @@ Function::Argument* ArgumentParser::ProcessType( const CXType &argType, const CX
         case CXType_UInt:
         case CXType_UShort:
         case CXType_Char16:
-            ret = new ArgumentUnsignedInt;
+            ret.type = MockedType::UnsignedInt;
             break;
 
         case CXType_Long:
-            ret = new ArgumentLong;
+            ret.type = MockedType::Long;
             break;
 
         case CXType_LongLong:
-            ret = new ArgumentLongLong;
+            ret.type = MockedType::LongLong;
             break;
 
         case CXType_ULongLong:
-            ret = new ArgumentUnsignedLongLong;
+            ret.type = MockedType::UnsignedLongLong;
             break;
 
         case CXType_ULong:
         case CXType_Char32:
-            ret = new ArgumentUnsignedLong;
+            ret.type = MockedType::UnsignedLong;
             break;
 
         case CXType_Float:
         case CXType_Double:
-            ret = new ArgumentDouble;
+            ret.type = MockedType::Double;
             break;
 
         case CXType_Pointer:
@@ -988,7 +825,7 @@ Function::Argument* ArgumentParser::ProcessType( const CXType &argType, const CX
         case CXType_Record:
         case CXType_Unexposed: // Template classes are processed as "Unexposed" kind
             ret = ProcessTypeRecord( argType, origArgType, inheritConst, false );
-            ret->MockArgExprPrepend("&");
+            ret.mockExprFront.insert( 0, "&" );
             break;
 
         case CXType_Elaborated:
@@ -1006,9 +843,9 @@ Function::Argument* ArgumentParser::ProcessType( const CXType &argType, const CX
     return ret;
 }
 
-Function::Argument* ArgumentParser::ProcessTypePointer( const CXType &argType, const CXType &origArgType )
+Function::Argument ArgumentParser::ProcessTypePointer( const CXType &argType, const CXType &origArgType )
 {
-    Function::Argument *ret;
+    Function::Argument ret;
 
     const CXType pointeeType = clang_getPointeeType( argType );
     bool isPointeeConst = clang_isConstQualifiedType( pointeeType );
@@ -1017,7 +854,7 @@ Function::Argument* ArgumentParser::ProcessTypePointer( const CXType &argType, c
         ( pointeeType.kind == CXType_Char_S ) &&
         isPointeeConst )
     {
-        ret = new ArgumentString;
+        ret.type = MockedType::String;
     }
     else
     {
@@ -1035,7 +872,7 @@ Function::Argument* ArgumentParser::ProcessTypePointer( const CXType &argType, c
                     break;
 
                 default:
-                    ret = new ArgumentConstPointer;
+                    ret.type = MockedType::ConstPointer;
                     break;
             }
         }
@@ -1047,7 +884,7 @@ Function::Argument* ArgumentParser::ProcessTypePointer( const CXType &argType, c
                 case CXType_Pointer:
                 case CXType_LValueReference:
                 case CXType_RValueReference:
-                    ret = new ArgumentPointer;
+                    ret.type = MockedType::Pointer;
                     break;
 
                 case CXType_Record:
@@ -1056,7 +893,7 @@ Function::Argument* ArgumentParser::ProcessTypePointer( const CXType &argType, c
                     break;
 
                 default:
-                    ret = new ArgumentOutput;
+                    ret.type = MockedType::Output;
                     break;
             }
         }
@@ -1064,15 +901,15 @@ Function::Argument* ArgumentParser::ProcessTypePointer( const CXType &argType, c
 
     if( argType.kind != CXType_Pointer )
     {
-        ret->MockArgExprPrepend("&");
+        ret.mockExprFront.insert( 0, "&" );
     }
 
     return ret;
 }
 
-Function::Argument* ArgumentParser::ProcessTypeRVReference( const CXType &argType, const CXType &origArgType )
+Function::Argument ArgumentParser::ProcessTypeRVReference( const CXType &argType, const CXType &origArgType )
 {
-    Function::Argument *ret;
+    Function::Argument ret;
 
     CXType pointeeType = clang_getPointeeType( argType );
 
@@ -1096,9 +933,9 @@ Function::Argument* ArgumentParser::ProcessTypeRVReference( const CXType &argTyp
     return ret;
 }
 
-Function::Argument* ArgumentParser::ProcessTypeTypedef( const CXType &argType, const CXType &origArgType, bool inheritConst )
+Function::Argument ArgumentParser::ProcessTypeTypedef( const CXType &argType, const CXType &origArgType, bool inheritConst )
 {
-    Function::Argument *ret;
+    Function::Argument ret;
 
     const CXType underlyingType = clang_getCanonicalType( argType );
 
@@ -1113,20 +950,20 @@ Function::Argument* ArgumentParser::ProcessTypeTypedef( const CXType &argType, c
             ( pointeeType.kind == CXType_Char_S ) &&
             isPointeeConst )
         {
-            ret = new ArgumentString;
+            ret.type = MockedType::String;
         }
         else if( isPointeeConst )
         {
-            ret = new ArgumentConstPointer;
+            ret.type = MockedType::ConstPointer;
         }
         else
         {
-            ret = new ArgumentPointer;
+            ret.type = MockedType::Pointer;
         }
 
         if( underlyingType.kind != CXType_Pointer )
         {
-            ret->MockArgExprPrepend("&");
+            ret.mockExprFront.insert( 0, "&" );
         }
     }
     else
@@ -1138,20 +975,21 @@ Function::Argument* ArgumentParser::ProcessTypeTypedef( const CXType &argType, c
     return ret;
 }
 
-Function::Argument* ArgumentParser::ProcessTypeRecord( const CXType &argType, const CXType &origArgType, bool inheritConst, bool isPointee )
+Function::Argument ArgumentParser::ProcessTypeRecord( const CXType &argType, const CXType &origArgType, bool inheritConst, bool isPointee )
 {
-    ArgumentOfType *ret;
+    Function::Argument ret;
 
     bool isConst = clang_isConstQualifiedType( argType ) || inheritConst;
     if( !isPointee || isConst )
     {
-        ret = new ArgumentOfType;
+        ret.type = MockedType::OfType;
     }
     else
     {
-        ret = new ArgumentOutputOfType;
+        ret.type = MockedType::OutputOfType;
     }
-    ret->SetExposedType( getBareTypeSpelling( m_config.UseUnderlyingTypedefType() ? argType : origArgType ) );
+    ret.exposedType = getBareTypeSpelling( m_config.UseUnderlyingTypedefType() ? argType : origArgType );
+    ret.isPod = IsMemComparableRecord( argType );
 
     return ret;
 }
@@ -1200,15 +1038,15 @@ bool Function::Parse( const CXCursor &cursor, const Config &config )
         m_isConst = ( IsMethod() && clang_CXXMethod_isConst(cursor) );
 
         // Get & process function return type
-        const CXType returnType = clang_getCursorResultType( cursor );
-        m_return = std::unique_ptr<Return>( returnParser.Process( m_functionName, returnType ) );
+        m_return = returnParser.Process( m_functionName, cursor );
 
         // Process arguments
         int numArgs = clang_Cursor_getNumArguments( cursor );
+        m_arguments.reserve( numArgs );
         for( int i = 0; i < numArgs; i++ )
         {
             const CXCursor arg = clang_Cursor_getArgument( cursor, i );
-            m_arguments.push_back( std::unique_ptr<Argument>( argumentParser.Process( m_functionName, arg, i ) ) );
+            m_arguments.push_back( argumentParser.Process( m_functionName, arg, i ) );
         }
 
         return true;
@@ -1219,7 +1057,138 @@ bool Function::Parse( const CXCursor &cursor, const Config &config )
     }
 }
 
-std::string Function::GenerateMock() const
+void Function::GetPodRecordTypes( std::set<std::string> &types ) const
+{
+    for( const Argument &argument : m_arguments )
+    {
+        if( GetDescriptor( argument.type ).passesExposedType && argument.isPod )
+        {
+            types.insert( argument.exposedType );
+        }
+    }
+}
+
+static std::string GenerateProfilingPrologue( const std::string &functionName, const char *kind )
+{
+    return "    static cppumockgen::profiling::Entry cppumockgen_profile_entry( \"" + functionName + "\", \"" + kind + "\" );\n"
+           "    cppumockgen::profiling::Scope cppumockgen_profile_scope( cppumockgen_profile_entry );\n";
+}
+
+bool Function::IsTraceable() const
+{
+    if( IsMethod() || ( m_functionName.find( "::" ) != std::string::npos ) || ( *GetTraceType( m_return ) == '\0' ) )
+    {
+        return false;
+    }
+
+    for( const Argument &argument : m_arguments )
+    {
+        if( *GetTraceType( argument ) == '\0' )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static std::string GetTraceId( const std::string &functionName )
+{
+    // FNV-1a hash of the function name, used to tag the records of the function in the trace
+    uint32_t hash = 2166136261u;
+    for( char c : functionName )
+    {
+        hash = ( hash ^ static_cast<unsigned char>( c ) ) * 16777619u;
+    }
+
+    char buffer[16];
+    snprintf( buffer, sizeof(buffer), "0x%08Xu", hash );
+    return buffer;
+}
+
+std::string Function::GenerateTraceRecord( const std::string &parameters ) const
+{
+    const std::string &returnType = m_return.originalType;
+    std::string traceType = GetTraceType( m_return );
+    std::string callArguments;
+
+    std::string body = "    cppumockgen::trace::Record cppumockgen_trace_record( " + GetTraceId( m_functionName ) + " );\n";
+
+    for( size_t i = 0; i < m_arguments.size(); i++ )
+    {
+        if( i > 0 )
+        {
+            callArguments += ", ";
+        }
+
+        callArguments += m_arguments[i].name;
+
+        body += "    cppumockgen_trace_record.Put<";
+        body += GetTraceType( m_arguments[i] );
+        body += ">( ";
+        AppendMockArgExpr( body, m_arguments[i] );
+        body += " );\n";
+    }
+
+    if( traceType == "void" )
+    {
+        body += "    __real_" + m_functionName + "(" + callArguments + ");\n";
+        body += "    cppumockgen_trace_record.Commit();\n";
+    }
+    else
+    {
+        body += "    " + returnType + " cppumockgen_trace_ret = __real_" + m_functionName + "(" + callArguments + ");\n";
+        body += "    cppumockgen_trace_record.Put<" + traceType + ">( cppumockgen_trace_ret );\n";
+        body += "    cppumockgen_trace_record.Commit();\n";
+        body += "    return cppumockgen_trace_ret;\n";
+    }
+
+    return "extern \"C\" " + returnType + " __real_" + m_functionName + "(" + parameters + ");\n" +
+           "extern \"C\" " + returnType + " __wrap_" + m_functionName + "(" + parameters + ")\n{\n" + body + "}\n";
+}
+
+std::string Function::GenerateTraceReplay() const
+{
+    std::string traceType = GetTraceType( m_return );
+    std::string payloadSize;
+
+    std::string checks;
+    for( const Argument &argument : m_arguments )
+    {
+        payloadSize += ( payloadSize.empty() ? "sizeof(" : " + sizeof(" );
+        payloadSize += GetTraceType( argument );
+        payloadSize += ")";
+
+        checks += "        cppumockgen_trace_cursor.Check<";
+        checks += GetTraceType( argument );
+        checks += ">( \"" + argument.name + "\", ";
+        AppendMockArgExpr( checks, argument );
+        checks += " );\n";
+    }
+
+    std::string ret;
+    if( traceType == "void" )
+    {
+        ret = "        return;\n";
+    }
+    else
+    {
+        payloadSize += ( payloadSize.empty() ? "" : " + " ) + ( "sizeof(" + traceType + ")" );
+
+        ret = "        return " + GetMockRetExpr( m_return, "cppumockgen_trace_cursor.Get<" + traceType + ">()" ) + ";\n";
+    }
+
+    if( payloadSize.empty() )
+    {
+        payloadSize = "0";
+    }
+
+    return "    if( cppumockgen::trace::Replaying() )\n    {\n"
+           "        cppumockgen::trace::Cursor cppumockgen_trace_cursor( " + GetTraceId( m_functionName ) + ", \"" + m_functionName + "\", " +
+           payloadSize + " );\n" + checks + ret + "    }\n";
+}
+
+std::string Function::GenerateMock( bool profiling, bool recordReplay ) const
 {
 // LCOV_EXCL_START
     if( m_functionName.empty() )
@@ -1228,9 +1197,11 @@ std::string Function::GenerateMock() const
     }
 // LCOV_EXCL_STOP
 
-    std::string signature = m_return->GetMockSignature() + " " + m_functionName + "(";
+    bool returnsValue = ( m_return.type != MockedType::Void );
+
+    std::string parameters;
 
-    std::string body = m_return->GetMockBodyFront() + "mock().actualCall(\"" + m_functionName + "\")";
+    std::string body = ( returnsValue ? "return " + m_return.mockExprFront : "" ) + "mock().actualCall(\"" + m_functionName + "\")";
 
     if( IsMethod() )
     {
@@ -1241,24 +1212,55 @@ std::string Function::GenerateMock() const
     {
         if( i > 0 )
         {
-            signature += ", ";
+            parameters += ", ";
         }
 
-        signature += m_arguments[i]->GetSignature(true);
+        AppendSignature( parameters, m_arguments[i], true );
 
-        body += m_arguments[i]->GetBody(true);
+        AppendCall( body, m_arguments[i], true );
     }
 
-    signature += ")";
+    std::string signature = m_return.originalType + " " + m_functionName + "(" + parameters + ")";
 
     if( m_isConst )
     {
         signature += " const";
     }
 
-    body += m_return->GetMockBodyBack();
+    if( returnsValue )
+    {
+        body += GetDescriptor( m_return.type ).returnCall;
+        body += m_return.mockExprBack;
+    }
+
+    std::string prologue;
+    if( profiling )
+    {
+        prologue = GenerateProfilingPrologue( m_functionName, "mock" );
+    }
 
-    return signature + "\n{\n    " + body + ";\n}\n";
+    bool traced = recordReplay && IsTraceable();
+
+    if( traced )
+    {
+        prologue += GenerateTraceReplay();
+    }
+
+    std::string mock = signature + "\n{\n" + prologue + "    " + body + ";\n}\n";
+
+    if( traced )
+    {
+        // When recording, the mock is replaced by a wrapper for the real function (to be linked using
+        // the GNU linker option --wrap=<function>) that records the calls into the trace
+        mock = "#ifdef CPPUMOCKGEN_RECORD\n" + GenerateTraceRecord( parameters ) + "#else\n" + mock + "#endif\n";
+    }
+    else if( recordReplay )
+    {
+        // When recording, the real function is linked, so its mock must not be defined
+        mock = "#ifndef CPPUMOCKGEN_RECORD\n" + mock + "#endif\n";
+    }
+
+    return mock;
 }
 
 static std::string namespaceSeparator = "::";
@@ -1287,7 +1289,7 @@ static std::vector<std::string> GetNamespaceDecomposition( const std::string &qu
     return ret;
 }
 
-std::string Function::GenerateExpectation( bool proto ) const
+std::string Function::GenerateExpectation( bool proto, bool profiling ) const
 {
 // LCOV_EXCL_START
     if( m_functionName.empty() )
@@ -1307,8 +1309,8 @@ std::string Function::GenerateExpectation( bool proto ) const
     ret += "\n";
 
     // Function processing
-    ret += GenerateExpectation( proto, namespaces[namespaces.size()-1], true );
-    ret += GenerateExpectation( proto, namespaces[namespaces.size()-1], false );
+    ret += GenerateExpectation( proto, profiling, namespaces[namespaces.size()-1], true );
+    ret += GenerateExpectation( proto, profiling, namespaces[namespaces.size()-1], false );
 
     // Namespace closing
     for( size_t i = 0; i < (namespaces.size() - 1); i++ )
@@ -1320,7 +1322,7 @@ std::string Function::GenerateExpectation( bool proto ) const
     return ret;
 }
 
-std::string Function::GenerateExpectation( bool proto, std::string functionName, bool oneCall ) const
+std::string Function::GenerateExpectation( bool proto, bool profiling, std::string functionName, bool oneCall ) const
 {
     std::string ret = "MockExpectedCall& " + functionName + "(";
 
@@ -1363,11 +1365,11 @@ std::string Function::GenerateExpectation( bool proto, std::string functionName,
             ret += ", ";
         }
 
-        ret += m_arguments[i]->GetSignature(false);
+        AppendSignature( ret, m_arguments[i], false );
 
         if( !proto )
         {
-            body += m_arguments[i]->GetBody(false);
+            AppendCall( body, m_arguments[i], false );
         }
     }
 
@@ -1377,7 +1379,13 @@ std::string Function::GenerateExpectation( bool proto, std::string functionName,
     }
     else
     {
-        ret += ")\n{\n    " + body + ";\n}\n";
+        std::string prologue;
+        if( profiling )
+        {
+            prologue = GenerateProfilingPrologue( m_functionName, ( oneCall ? "expectOneCall" : "expectNCalls" ) );
+        }
+
+        ret += ")\n{\n" + prologue + "    " + body + ";\n}\n";
     }
 
     return ret;
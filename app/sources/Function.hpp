@@ -4,7 +4,7 @@
 #include <clang-c/Index.h>
 #include <string>
 #include <vector>
-#include <memory>
+#include <set>
 #include "Config.hpp"
 
 /**
@@ -34,20 +34,55 @@ public:
     /**
      * Generates a mock for the function.
      *
+     * @param profiling [in] Instrument the mock to count its calls and accumulate its execution time
+     * @param recordReplay [in] Generate also the record path (wrapper for the real function) and the replay
+     *                          path (serving returns from a trace) if the function arguments and return allow it
      * @return String containing the generated mock
      */
-    std::string GenerateMock() const;
+    std::string GenerateMock( bool profiling, bool recordReplay ) const;
 
     /**
      * Generates an expectation function prototype or implementation for the function.
      *
      * @param proto [in] Generate function prototype if @c true, or function implementation otherwise.
+     * @param profiling [in] Instrument the implementation to count its calls and accumulate its execution time
      * @return String containing the generated expectation function prototype
      */
-    std::string GenerateExpectation( bool proto ) const;
+    std::string GenerateExpectation( bool proto, bool profiling ) const;
 
-    class Argument;
-    class Return;
+    /**
+     * Collects the names of the record types passed as parameters to the function that are plain old data
+     * without padding, and therefore can be compared and copied as raw memory.
+     *
+     * @param types [in/out] Set where the exposed type names will be inserted
+     */
+    void GetPodRecordTypes( std::set<std::string> &types ) const;
+
+    /**
+     * Mocked return value of a function.
+     */
+    struct Return
+    {
+        MockedType type = MockedType::Void;
+        std::string originalType;   // Type as declared in the function
+        std::string mockExprFront;  // Expression modifier applied to the value returned by CppUMock (before it)
+        std::string mockExprBack;   // Expression modifier applied to the value returned by CppUMock (after it)
+        bool traceable = true;      // Whether the value returned by the real function can be recorded in traces
+    };
+
+    /**
+     * Mocked argument of a function.
+     */
+    struct Argument
+    {
+        MockedType type = MockedType::Skip;
+        std::string name;
+        std::string originalType;   // Type as declared in the function
+        std::string exposedType;    // Type name passed to CppUMock for parameters of type (OfType, OutputOfType)
+        std::string mockExprFront;  // Expression modifier applied to the argument passed to CppUMock (before it)
+        std::string mockExprBack;   // Expression modifier applied to the argument passed to CppUMock (after it)
+        bool isPod = false;         // Whether the record type can be compared and copied as raw memory
+    };
 
 protected:
     /**
@@ -63,11 +98,20 @@ protected:
         return false;
     }
 
-    std::string GenerateExpectation( bool proto, std::string functionName, bool oneCall ) const;
+    std::string GenerateExpectation( bool proto, bool profiling, std::string functionName, bool oneCall ) const;
+
+    /**
+     * Returns whether the calls to the function can be recorded into and replayed from a trace, i.e. it's a free
+     * function whose arguments and return value are all passed by value as scalars.
+     */
+    bool IsTraceable() const;
+
+    std::string GenerateTraceRecord( const std::string &parameters ) const;
+    std::string GenerateTraceReplay() const;
 
     std::string m_functionName;
-    std::unique_ptr<Return> m_return;
-    std::vector<std::unique_ptr<Argument>> m_arguments;
+    Return m_return;
+    std::vector<Argument> m_arguments;
     bool m_isConst;
 };
 
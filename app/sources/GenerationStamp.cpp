@@ -0,0 +1,225 @@
+#include "GenerationStamp.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <stdexcept>
+
+#include "FingerprintStore.hpp"
+
+static const char FIELD_SEPARATOR = '\t';
+static const std::string OPTIONS_TAG = "options";
+static const std::string CONTEXT_TAG = "context";
+static const std::string DEPENDENCY_TAG = "dependency";
+static const std::string OUTPUT_TAG = "output";
+static const std::string FUNCTION_TAG = "function";
+
+static bool ReadFile( const std::string &filepath, std::string &contents )
+{
+    std::ifstream file( filepath, std::ios::binary );
+    if( !file.is_open() )
+    {
+        return false;
+    }
+
+    std::ostringstream fileContents;
+    fileContents << file.rdbuf();
+    contents = fileContents.str();
+    return true;
+}
+
+static bool ParseFingerprint( const std::string &text, uint64_t &fingerprint )
+{
+    if( ( text.size() != 16 ) || ( text.find_first_not_of( "0123456789abcdef" ) != std::string::npos ) )
+    {
+        return false;
+    }
+
+    fingerprint = std::stoull( text, nullptr, 16 );
+    return true;
+}
+
+static std::string FormatFingerprint( uint64_t fingerprint )
+{
+    std::ostringstream text;
+    text << std::hex << std::setw( 16 ) << std::setfill( '0' ) << fingerprint;
+    return text.str();
+}
+
+GenerationStamp::GenerationStamp( uint64_t optionsFingerprint, uint64_t contextFingerprint )
+: m_optionsFingerprint( optionsFingerprint ), m_contextFingerprint( contextFingerprint )
+{
+}
+
+bool GenerationStamp::Load( const std::string &filepath )
+{
+    m_dependencies.clear();
+    m_outputs.clear();
+    m_functions.clear();
+
+    std::ifstream file( filepath );
+    if( !file.is_open() )
+    {
+        return false;
+    }
+
+    // Each line has the format: <tag> TAB <value> [TAB <file path>]
+    bool hasOptions = false;
+    bool hasContext = false;
+    std::string line;
+    while( std::getline( file, line ) )
+    {
+        std::istringstream lineStream( line );
+        std::string tag;
+        std::string value;
+        if( !std::getline( lineStream, tag, FIELD_SEPARATOR ) || !std::getline( lineStream, value, FIELD_SEPARATOR ) )
+        {
+            return false;
+        }
+
+        if( tag == FUNCTION_TAG )
+        {
+            m_functions.push_back( value );
+            continue;
+        }
+
+        uint64_t fingerprint;
+        if( !ParseFingerprint( value, fingerprint ) )
+        {
+            return false;
+        }
+
+        if( tag == OPTIONS_TAG )
+        {
+            m_optionsFingerprint = fingerprint;
+            hasOptions = true;
+        }
+        else if( tag == CONTEXT_TAG )
+        {
+            m_contextFingerprint = fingerprint;
+            hasContext = true;
+        }
+        else
+        {
+            FileEntry entry = { fingerprint, "" };
+            if( !std::getline( lineStream, entry.filepath ) )
+            {
+                return false;
+            }
+
+            if( tag == DEPENDENCY_TAG )
+            {
+                m_dependencies.push_back( entry );
+            }
+            else if( tag == OUTPUT_TAG )
+            {
+                m_outputs.push_back( entry );
+            }
+            else
+            {
+                return false;
+            }
+        }
+    }
+
+    return hasOptions && hasContext && !m_dependencies.empty();
+}
+
+void GenerationStamp::Save( const std::string &filepath ) const
+{
+    std::ofstream file( filepath );
+    if( !file.is_open() )
+    {
+        std::string errorMsg = "Stamp file '" + filepath + "' could not be opened.";
+        throw std::runtime_error( errorMsg );
+    }
+
+    file << OPTIONS_TAG << FIELD_SEPARATOR << FormatFingerprint( m_optionsFingerprint ) << std::endl;
+    file << CONTEXT_TAG << FIELD_SEPARATOR << FormatFingerprint( m_contextFingerprint ) << std::endl;
+
+    for( const FileEntry &dependency : m_dependencies )
+    {
+        file << DEPENDENCY_TAG << FIELD_SEPARATOR << FormatFingerprint( dependency.fingerprint ) << FIELD_SEPARATOR <<
+                dependency.filepath << std::endl;
+    }
+
+    for( const FileEntry &output : m_outputs )
+    {
+        file << OUTPUT_TAG << FIELD_SEPARATOR << FormatFingerprint( output.fingerprint ) << FIELD_SEPARATOR <<
+                output.filepath << std::endl;
+    }
+
+    for( const std::string &function : m_functions )
+    {
+        file << FUNCTION_TAG << FIELD_SEPARATOR << function << std::endl;
+    }
+}
+
+bool GenerationStamp::AddDependency( const std::string &filepath )
+{
+    std::string contents;
+    if( !ReadFile( filepath, contents ) )
+    {
+        return false;
+    }
+
+    m_dependencies.push_back( { FingerprintStore::CalculateTokenFingerprint( contents ), filepath } );
+    return true;
+}
+
+bool GenerationStamp::AddOutput( const std::string &filepath )
+{
+    std::string contents;
+    if( !ReadFile( filepath, contents ) )
+    {
+        return false;
+    }
+
+    m_outputs.push_back( { FingerprintStore::CalculateFingerprint( contents ), filepath } );
+    return true;
+}
+
+void GenerationStamp::AddFunction( const std::string &id )
+{
+    m_functions.push_back( id );
+}
+
+bool GenerationStamp::IsUpToDate( uint64_t optionsFingerprint ) const
+{
+    if( optionsFingerprint != m_optionsFingerprint )
+    {
+        return false;
+    }
+
+    std::string contents;
+
+    for( const FileEntry &output : m_outputs )
+    {
+        if( !ReadFile( output.filepath, contents ) ||
+            ( FingerprintStore::CalculateFingerprint( contents ) != output.fingerprint ) )
+        {
+            return false;
+        }
+    }
+
+    for( const FileEntry &dependency : m_dependencies )
+    {
+        if( !ReadFile( dependency.filepath, contents ) ||
+            ( FingerprintStore::CalculateTokenFingerprint( contents ) != dependency.fingerprint ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+uint64_t GenerationStamp::GetContextFingerprint() const
+{
+    return m_contextFingerprint;
+}
+
+const std::vector<std::string>& GenerationStamp::GetFunctions() const
+{
+    return m_functions;
+}
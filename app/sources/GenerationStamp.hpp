@@ -0,0 +1,98 @@
+#ifndef CPPUMOCKGEN_GENERATIONSTAMP_HPP_
+#define CPPUMOCKGEN_GENERATIONSTAMP_HPP_
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/**
+ * Stamp of the generation of the outputs for an input file, persisted next to the outputs to skip regenerating them
+ * in later runs while neither the input file, the files included by it, the options nor the outputs have changed.
+ *
+ * Input files and the files included by them are compared by their token fingerprints, so that changes to comments or
+ * whitespace alone do not trigger a regeneration.
+ */
+class GenerationStamp
+{
+public:
+    /**
+     * Constructs a GenerationStamp object.
+     *
+     * @param optionsFingerprint [in] Fingerprint of the options that affect the generated outputs
+     * @param contextFingerprint [in] Fingerprint of the context of the generation (e.g. the functions already mocked
+     *                                for other input files)
+     */
+    GenerationStamp( uint64_t optionsFingerprint = 0, uint64_t contextFingerprint = 0 );
+
+    /**
+     * Loads the stamp saved by a previous run.
+     *
+     * @param filepath [in] Path of the stamp file
+     * @return @c false if the file does not exist or is malformed, @c true otherwise
+     */
+    bool Load( const std::string &filepath );
+
+    /**
+     * Saves the stamp.
+     *
+     * @param filepath [in] Path of the stamp file
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void Save( const std::string &filepath ) const;
+
+    /**
+     * Registers a file whose contents were used to generate the outputs (i.e. the input file or a file included by it).
+     *
+     * @param filepath [in] Path of the file
+     * @return @c false if the file cannot be read, @c true otherwise
+     */
+    bool AddDependency( const std::string &filepath );
+
+    /**
+     * Registers an output file, once it has been written.
+     *
+     * @param filepath [in] Path of the file
+     * @return @c false if the file cannot be read, @c true otherwise
+     */
+    bool AddOutput( const std::string &filepath );
+
+    /**
+     * Registers a function mocked in the outputs.
+     *
+     * @param id [in] Unique identifier of the function (e.g. its USR)
+     */
+    void AddFunction( const std::string &id );
+
+    /**
+     * Checks whether the files of a loaded stamp are up to date, i.e. it was saved with the given options, its
+     * dependencies have the same tokens as when it was saved, and its outputs have not been modified since then.
+     *
+     * @param optionsFingerprint [in] Fingerprint of the current options
+     */
+    bool IsUpToDate( uint64_t optionsFingerprint ) const;
+
+    /**
+     * Returns the fingerprint of the context of the generation.
+     */
+    uint64_t GetContextFingerprint() const;
+
+    /**
+     * Returns the identifiers of the functions mocked in the outputs.
+     */
+    const std::vector<std::string>& GetFunctions() const;
+
+private:
+    struct FileEntry
+    {
+        uint64_t fingerprint;
+        std::string filepath;
+    };
+
+    uint64_t m_optionsFingerprint;
+    uint64_t m_contextFingerprint;
+    std::vector<FileEntry> m_dependencies;
+    std::vector<FileEntry> m_outputs;
+    std::vector<std::string> m_functions;
+};
+
+#endif // header guard
@@ -0,0 +1,64 @@
+#include "Generator.hpp"
+
+#include <sstream>
+
+#include "FileHelper.hpp"
+
+Generator::Generator( const Options &options )
+: m_options( options ),
+  m_config( options.useUnderlyingTypedefType, options.paramOverrideOptions, options.typeOverrideOptions )
+{
+}
+
+Generator::Output Generator::Generate( const Input &input )
+{
+    Output output;
+    std::ostringstream diagnostics;
+
+    Parser parser;
+
+    if( m_options.singleFileParse )
+    {
+        parser.EnableSingleFileParse();
+    }
+
+    if( input.hasContents )
+    {
+        parser.SetInputContents( input.contents );
+    }
+
+    output.success = parser.Parse( input.filepath, m_config, m_options.interpretAsCpp, m_options.useCpp11,
+                                   m_options.includePaths, m_options.includeFiles, m_options.symbols,
+                                   m_emittedFunctions, diagnostics );
+
+    if( output.success )
+    {
+        std::string expectHeaderFilepath = input.expectHeaderFilepath;
+        if( expectHeaderFilepath.empty() )
+        {
+            expectHeaderFilepath = RemoveFilenameExtension( GetFilenameFromPath( input.filepath ) ) + "_expect.hpp";
+        }
+
+        std::ostringstream mockOutput;
+        std::ostringstream expectHeaderOutput;
+        std::ostringstream expectImplOutput;
+
+        parser.GenerateMock( m_options.generationOptions, m_options.profiling, m_options.recordReplay, mockOutput );
+        parser.GenerateExpectationHeader( m_options.generationOptions, m_options.podComparators, expectHeaderOutput );
+        parser.GenerateExpectationImpl( m_options.generationOptions, expectHeaderFilepath, m_options.profiling,
+                                        m_options.podComparators, expectImplOutput );
+
+        output.mock = mockOutput.str();
+        output.expectHeader = expectHeaderOutput.str();
+        output.expectImpl = expectImplOutput.str();
+    }
+
+    output.diagnostics = diagnostics.str();
+
+    return output;
+}
+
+void Generator::ForgetEmittedFunctions()
+{
+    m_emittedFunctions.clear();
+}
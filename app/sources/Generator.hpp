@@ -0,0 +1,95 @@
+#ifndef CPPUMOCKGEN_GENERATOR_HPP_
+#define CPPUMOCKGEN_GENERATOR_HPP_
+
+#include <string>
+#include <vector>
+
+#include "Config.hpp"
+#include "Parser.hpp"
+
+/**
+ * In-process API to generate mocks and expectation functions for C/C++ headers, without the command line tool.
+ *
+ * A generator is configured once with the parse, override and generation options, and can then be used to generate
+ * the outputs for any number of headers, which are returned in memory together with the diagnostics issued.
+ * As the command line tool does for its input files, functions already mocked for a header are not mocked again
+ * for the headers processed later by the same generator (see ForgetEmittedFunctions()).
+ *
+ * Generators are not thread-safe, but several generators can be used concurrently from different threads.
+ */
+class Generator
+{
+public:
+    /**
+     * Options used to parse the headers and to generate their outputs.
+     */
+    struct Options
+    {
+        bool interpretAsCpp = false;                    ///< Interpret the headers as C++ (otherwise as C)
+        bool useCpp11 = false;                          ///< Interpret the headers as C++11
+        bool singleFileParse = false;                   ///< Parse only the headers, without expanding their includes
+        std::vector<std::string> includePaths;          ///< Paths to search for included header files
+        std::vector<std::string> includeFiles;          ///< Files included before each header
+        std::vector<std::string> symbols;               ///< (Mangled) symbols of the functions to mock, or empty for all
+        bool useUnderlyingTypedefType = false;          ///< Use the underlying type of typedefs to identify types
+        std::vector<std::string> paramOverrideOptions;  ///< Specific parameter / return type overrides (as -p)
+        std::vector<std::string> typeOverrideOptions;   ///< Generic parameter / return type overrides (as -t)
+        bool profiling = false;                         ///< Instrument mocks and expectations with profiling
+        bool podComparators = false;                    ///< Generate comparators and copiers for POD record types
+        bool recordReplay = false;                      ///< Generate record and replay paths for C mocks
+        std::string generationOptions;                  ///< Options written in the outputs to regenerate them
+    };
+
+    /**
+     * Header to be processed.
+     */
+    struct Input
+    {
+        std::string filepath;              ///< Path of the header (virtual path if contents are given)
+        bool hasContents = false;          ///< Indicates that the contents of the header are given in @c contents
+        std::string contents;              ///< Contents of the header, used instead of reading it from disk
+        std::string expectHeaderFilepath;  ///< Path of the expectations header included by the implementation,
+                                           ///< by default "<header name without extension>_expect.hpp"
+    };
+
+    /**
+     * Outputs generated for a header.
+     */
+    struct Output
+    {
+        bool success = false;        ///< Indicates that the header could be parsed and the outputs were generated
+        std::string mock;            ///< Mocks implementation
+        std::string expectHeader;    ///< Expectation functions header
+        std::string expectImpl;      ///< Expectation functions implementation
+        std::string diagnostics;     ///< Errors and warnings issued while parsing the header
+    };
+
+    /**
+     * Constructs a Generator object.
+     *
+     * @param options [in] Options used to parse the headers and to generate their outputs
+     * @throws std::runtime_error if the override options are not valid
+     */
+    explicit Generator( const Options &options );
+
+    /**
+     * Generates the mocks and expectation functions for a header.
+     *
+     * @param input [in] Header to be processed
+     * @return Outputs generated for the header, which are empty if it could not be parsed
+     */
+    Output Generate( const Input &input );
+
+    /**
+     * Forgets the functions mocked for the headers processed previously, so that they are mocked again if they are
+     * declared in the headers processed later.
+     */
+    void ForgetEmittedFunctions();
+
+private:
+    Options m_options;
+    Config m_config;
+    Parser::EmittedFunctions m_emittedFunctions;
+};
+
+#endif // header guard
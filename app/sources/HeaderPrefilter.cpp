@@ -0,0 +1,737 @@
+#include "HeaderPrefilter.hpp"
+
+#include <vector>
+#include <set>
+#include <map>
+#include <cctype>
+
+/*
+ * The header is first split into tokens, discarding comments, string/character literals (replaced by a '"' token),
+ * numbers (replaced by a '0' token) and preprocessor directives, from which the object-like macro definitions are
+ * recorded. Then the tokens are grouped into top-level statements, and each statement is checked for something that
+ * could declare a function: a parenthesized group not preceded by an initializer, or a name that expands to or is an
+ * alias of something with parentheses.
+ */
+
+static const char PAREN_GROUP[] = "()";
+static const char BRACE_GROUP[] = "{}";
+
+static bool IsIdentifierStart( char c )
+{
+    return std::isalpha( (unsigned char) c ) || ( c == '_' ) || ( c == '$' );
+}
+
+static bool IsIdentifierChar( char c )
+{
+    return std::isalnum( (unsigned char) c ) || ( c == '_' ) || ( c == '$' );
+}
+
+static bool IsIdentifier( const std::string &token )
+{
+    return !token.empty() && IsIdentifierStart( token[0] );
+}
+
+static bool IsNewLine( const std::string &text, size_t pos )
+{
+    return ( text[pos] == '\n' ) || ( ( text[pos] == '\r' ) && ( pos + 1 < text.size() ) && ( text[pos + 1] == '\n' ) );
+}
+
+// Returns the position after the string or character literal whose opening quote is located at pos
+static size_t SkipQuotedLiteral( const std::string &text, size_t pos )
+{
+    const char quote = text[pos];
+
+    pos++;
+    while( pos < text.size() )
+    {
+        if( text[pos] == '\\' )
+        {
+            pos += 2;
+        }
+        else if( text[pos] == quote )
+        {
+            return pos + 1;
+        }
+        else if( text[pos] == '\n' )
+        {
+            // Unterminated literal
+            return pos;
+        }
+        else
+        {
+            pos++;
+        }
+    }
+
+    return text.size();
+}
+
+// Returns the position after the raw string literal whose opening quote is located at pos
+static size_t SkipRawStringLiteral( const std::string &text, size_t pos )
+{
+    size_t openPos = text.find( '(', pos + 1 );
+    if( openPos == std::string::npos )
+    {
+        return text.size();
+    }
+
+    std::string terminator = ")" + text.substr( pos + 1, openPos - pos - 1 ) + "\"";
+    size_t endPos = text.find( terminator, openPos + 1 );
+    return ( endPos == std::string::npos ) ? text.size() : ( endPos + terminator.size() );
+}
+
+// Returns the position after the number that starts at pos
+static size_t SkipNumber( const std::string &text, size_t pos, bool interpretAsCpp )
+{
+    pos++;
+    while( pos < text.size() )
+    {
+        char c = text[pos];
+        char prev = text[pos - 1];
+        if( IsIdentifierChar( c ) || ( c == '.' ) ||
+            ( ( ( c == '+' ) || ( c == '-' ) ) && ( ( prev == 'e' ) || ( prev == 'E' ) || ( prev == 'p' ) || ( prev == 'P' ) ) ) ||
+            ( interpretAsCpp && ( c == '\'' ) && ( pos + 1 < text.size() ) && std::isalnum( (unsigned char) text[pos + 1] ) ) )
+        {
+            pos++;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    return pos;
+}
+
+// Reads the preprocessor directive starting at pos, joining continued lines and removing comments
+static size_t ReadDirective( const std::string &text, size_t pos, std::string &directive )
+{
+    while( ( pos < text.size() ) && !IsNewLine( text, pos ) )
+    {
+        char c = text[pos];
+        char next = ( pos + 1 < text.size() ) ? text[pos + 1] : '\0';
+
+        if( ( c == '\\' ) && ( pos + 1 < text.size() ) && IsNewLine( text, pos + 1 ) )
+        {
+            pos += ( next == '\n' ) ? 2 : 3;
+        }
+        else if( ( c == '/' ) && ( next == '/' ) )
+        {
+            while( ( pos < text.size() ) && !IsNewLine( text, pos ) )
+            {
+                pos++;
+            }
+        }
+        else if( ( c == '/' ) && ( next == '*' ) )
+        {
+            size_t endPos = text.find( "*/", pos + 2 );
+            pos = ( endPos == std::string::npos ) ? text.size() : ( endPos + 2 );
+            directive += ' ';
+        }
+        else if( ( c == '"' ) || ( c == '\'' ) )
+        {
+            size_t endPos = SkipQuotedLiteral( text, pos );
+            directive.append( text, pos, endPos - pos );
+            pos = endPos;
+        }
+        else
+        {
+            directive += c;
+            pos++;
+        }
+    }
+
+    return pos;
+}
+
+// Records the name and body of the directive if it defines an object-like macro
+static void RecordMacro( const std::string &directive, std::map<std::string, std::string> &objectMacros )
+{
+    static const char WHITESPACE[] = " \t\r\f\v";
+    static const std::string DEFINE = "define";
+
+    size_t pos = directive.find_first_not_of( WHITESPACE, 1 );
+    if( ( pos == std::string::npos ) || ( directive.compare( pos, DEFINE.size(), DEFINE ) != 0 ) )
+    {
+        return;
+    }
+
+    pos += DEFINE.size();
+    size_t nameStart = directive.find_first_not_of( WHITESPACE, pos );
+    if( ( nameStart == std::string::npos ) || ( nameStart == pos ) )
+    {
+        return;
+    }
+
+    size_t nameEnd = nameStart;
+    while( ( nameEnd < directive.size() ) && IsIdentifierChar( directive[nameEnd] ) )
+    {
+        nameEnd++;
+    }
+
+    // Function-like macros can only be used followed by parentheses, which will be found when scanning the statements
+    if( ( nameEnd > nameStart ) && ( ( nameEnd == directive.size() ) || ( directive[nameEnd] != '(' ) ) )
+    {
+        objectMacros[ directive.substr( nameStart, nameEnd - nameStart ) ] = directive.substr( nameEnd );
+    }
+}
+
+static std::vector<std::string> Tokenize( const std::string &text, bool interpretAsCpp,
+                                          std::map<std::string, std::string> &objectMacros )
+{
+    std::vector<std::string> tokens;
+
+    bool lineStart = true;
+    size_t pos = 0;
+    while( pos < text.size() )
+    {
+        char c = text[pos];
+        char next = ( pos + 1 < text.size() ) ? text[pos + 1] : '\0';
+
+        if( c == '\n' )
+        {
+            lineStart = true;
+            pos++;
+        }
+        else if( std::isspace( (unsigned char) c ) )
+        {
+            pos++;
+        }
+        else if( ( c == '/' ) && ( next == '/' ) )
+        {
+            pos = text.find( '\n', pos );
+            pos = ( pos == std::string::npos ) ? text.size() : pos;
+        }
+        else if( ( c == '/' ) && ( next == '*' ) )
+        {
+            pos = text.find( "*/", pos + 2 );
+            pos = ( pos == std::string::npos ) ? text.size() : ( pos + 2 );
+        }
+        else if( ( c == '#' ) && lineStart )
+        {
+            std::string directive;
+            pos = ReadDirective( text, pos, directive );
+            RecordMacro( directive, objectMacros );
+        }
+        else
+        {
+            lineStart = false;
+
+            if( ( c == '"' ) || ( c == '\'' ) )
+            {
+                pos = SkipQuotedLiteral( text, pos );
+                tokens.push_back( "\"" );
+            }
+            else if( IsIdentifierStart( c ) )
+            {
+                size_t endPos = pos;
+                while( ( endPos < text.size() ) && IsIdentifierChar( text[endPos] ) )
+                {
+                    endPos++;
+                }
+
+                std::string identifier = text.substr( pos, endPos - pos );
+                if( interpretAsCpp && ( endPos < text.size() ) && ( text[endPos] == '"' ) &&
+                    ( ( identifier == "R" ) || ( identifier == "LR" ) || ( identifier == "uR" ) ||
+                      ( identifier == "UR" ) || ( identifier == "u8R" ) ) )
+                {
+                    pos = SkipRawStringLiteral( text, endPos );
+                    tokens.push_back( "\"" );
+                }
+                else
+                {
+                    pos = endPos;
+                    tokens.push_back( identifier );
+                }
+            }
+            else if( std::isdigit( (unsigned char) c ) || ( ( c == '.' ) && std::isdigit( (unsigned char) next ) ) )
+            {
+                pos = SkipNumber( text, pos, interpretAsCpp );
+                tokens.push_back( "0" );
+            }
+            else
+            {
+                tokens.push_back( std::string( 1, c ) );
+                pos++;
+            }
+        }
+    }
+
+    return tokens;
+}
+
+// Returns the names of the object-like macros whose expansion contains parentheses, directly or through other macros
+static std::set<std::string> GetParenthesizedMacros( const std::map<std::string, std::string> &objectMacros,
+                                                     bool interpretAsCpp )
+{
+    std::set<std::string> parenNames;
+
+    std::map<std::string, std::vector<std::string>> macroTokens;
+    for( const std::pair<const std::string, std::string> &macro : objectMacros )
+    {
+        std::map<std::string, std::string> unused;
+        macroTokens[ macro.first ] = Tokenize( macro.second, interpretAsCpp, unused );
+
+        if( macro.second.find( '(' ) != std::string::npos )
+        {
+            parenNames.insert( macro.first );
+        }
+    }
+
+    bool changed = true;
+    while( changed )
+    {
+        changed = false;
+        for( const std::pair<const std::string, std::vector<std::string>> &macro : macroTokens )
+        {
+            if( parenNames.count( macro.first ) == 0 )
+            {
+                for( const std::string &token : macro.second )
+                {
+                    if( parenNames.count( token ) > 0 )
+                    {
+                        parenNames.insert( macro.first );
+                        changed = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    return parenNames;
+}
+
+// Keywords followed by parentheses that do not declare a function
+static bool IsParenthesizedKeyword( const std::string &token )
+{
+    static const std::set<std::string> KEYWORDS = {
+        "__attribute__", "__attribute", "__declspec", "alignas", "_Alignas", "asm", "__asm", "__asm__",
+        "decltype", "typeof", "__typeof", "__typeof__", "sizeof", "alignof", "_Alignof", "__alignof__",
+        "noexcept", "throw", "_Pragma", "__pragma", "static_assert", "_Static_assert" };
+
+    return ( KEYWORDS.count( token ) > 0 );
+}
+
+/*
+ * Scanner of the statements contained in a sequence of tokens.
+ */
+class StatementScanner
+{
+public:
+    StatementScanner( const std::vector<std::string> &tokens, const std::set<std::string> &parenNames, bool interpretAsCpp )
+    : m_tokens( tokens ), m_parenNames( parenNames ), m_interpretAsCpp( interpretAsCpp )
+    {}
+
+    // Scans the statements in the current scope, until the scope is closed (if nested) or the tokens are exhausted
+    bool ScanScope( bool nested )
+    {
+        while( m_pos < m_tokens.size() )
+        {
+            const std::string &token = m_tokens[m_pos];
+
+            if( token == ";" )
+            {
+                m_pos++;
+                if( EndStatement() )
+                {
+                    return true;
+                }
+            }
+            else if( token == "}" )
+            {
+                m_pos++;
+                if( EndStatement() )
+                {
+                    return true;
+                }
+                else if( nested )
+                {
+                    return false;
+                }
+            }
+            else if( token == "{" )
+            {
+                if( ScanBraces() )
+                {
+                    return true;
+                }
+            }
+            else if( token == "(" )
+            {
+                if( m_statement.empty() || !IsParenthesizedKeyword( m_statement.back() ) )
+                {
+                    if( !Contains( PAREN_GROUP ) )
+                    {
+                        m_firstGroupPos = m_pos;
+                    }
+                    m_statement.push_back( PAREN_GROUP );
+                }
+                else
+                {
+                    // The keyword is replaced by a neutral token
+                    m_statement.back() = "0";
+                }
+                SkipGroup( "(", ")" );
+            }
+            else if( token == "[" )
+            {
+                m_statement.push_back( "[]" );
+                SkipGroup( "[", "]" );
+            }
+            else if( ( token == "<" ) && ( m_statement.size() == 1 ) && ( m_statement[0] == "template" ) )
+            {
+                // Template parameters may have default values
+                m_statement.push_back( "<>" );
+                SkipTemplateParameters();
+            }
+            else
+            {
+                m_statement.push_back( token );
+                m_pos++;
+            }
+        }
+
+        return EndStatement();
+    }
+
+private:
+    bool Contains( const std::string &token ) const
+    {
+        for( const std::string &statementToken : m_statement )
+        {
+            if( statementToken == token )
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool HasInitializer() const
+    {
+        return Contains( "=" ) && !Contains( "operator" );
+    }
+
+    bool IsRecord() const
+    {
+        for( const std::string &statementToken : m_statement )
+        {
+            if( statementToken == PAREN_GROUP )
+            {
+                return false;
+            }
+            else if( ( statementToken == "struct" ) || ( statementToken == "union" ) ||
+                     ( m_interpretAsCpp && ( statementToken == "class" ) ) )
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool HasConstructorInitializers() const
+    {
+        bool afterParenGroup = false;
+        for( const std::string &statementToken : m_statement )
+        {
+            if( statementToken == PAREN_GROUP )
+            {
+                afterParenGroup = true;
+            }
+            else if( afterParenGroup && ( statementToken == ":" ) )
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Handles the braces at the current position, after the tokens already in the statement
+    bool ScanBraces()
+    {
+        if( HasInitializer() || Contains( "enum" ) )
+        {
+            // Initializer or enumerator list
+            m_statement.push_back( BRACE_GROUP );
+            SkipGroup( "{", "}" );
+        }
+        else if( Contains( "namespace" ) ||
+                 ( ( m_statement.size() == 2 ) && ( m_statement[0] == "extern" ) && ( m_statement[1] == "\"" ) ) )
+        {
+            // Namespaces and linkage specifications just contain more declarations
+            m_pos++;
+            ResetStatement();
+            if( ScanScope( true ) )
+            {
+                return true;
+            }
+        }
+        else if( IsRecord() )
+        {
+            if( m_interpretAsCpp )
+            {
+                // Classes may declare methods
+                m_pos++;
+                std::vector<std::string> statement;
+                size_t firstGroupPos = m_firstGroupPos;
+                statement.swap( m_statement );
+                if( ScanScope( true ) )
+                {
+                    return true;
+                }
+                m_statement.swap( statement );
+                m_firstGroupPos = firstGroupPos;
+            }
+            else
+            {
+                SkipGroup( "{", "}" );
+            }
+            m_statement.push_back( BRACE_GROUP );
+        }
+        else if( Contains( PAREN_GROUP ) )
+        {
+            size_t size = m_statement.size();
+            if( IsIdentifier( m_statement.back() ) && ( size > 1 ) &&
+                ( ( m_statement[size - 2] == "," ) || ( m_statement[size - 2] == ":" ) ) )
+            {
+                if( !HasConstructorInitializers() )
+                {
+                    // Brace-initialized declarator following other declarators, which may declare a function
+                    return true;
+                }
+
+                // Brace-initialized member in a constructor initializer list
+                m_statement.push_back( BRACE_GROUP );
+                SkipGroup( "{", "}" );
+            }
+            else
+            {
+                // Function definition, which is not mockable
+                SkipGroup( "{", "}" );
+                ResetStatement();
+            }
+        }
+        else
+        {
+            // Unknown block, its contents are scanned as declarations to be on the safe side
+            m_pos++;
+            std::vector<std::string> statement;
+            size_t firstGroupPos = m_firstGroupPos;
+            statement.swap( m_statement );
+            if( ScanScope( true ) )
+            {
+                return true;
+            }
+            m_statement.swap( statement );
+            m_firstGroupPos = firstGroupPos;
+            m_statement.push_back( BRACE_GROUP );
+        }
+
+        return false;
+    }
+
+    // Returns whether the finished statement may declare a function, and prepares for the next one
+    bool EndStatement()
+    {
+        bool mayDeclareFunction = false;
+
+        if( m_statement.empty() )
+        {
+            // Nothing to check
+        }
+        else if( m_statement[0] == "typedef" )
+        {
+            RecordTypeAlias();
+        }
+        else if( m_statement[0] == "using" )
+        {
+            if( ( m_statement.size() > 2 ) && ( m_statement[2] == "=" ) && HasParentheses( 3 ) )
+            {
+                m_parenNames.insert( m_statement[1] );
+            }
+        }
+        else
+        {
+            // Initializers are skipped up to the next declarator, which may declare a function
+            bool isOperator = Contains( "operator" );
+            bool inInitializer = false;
+            for( const std::string &token : m_statement )
+            {
+                if( inInitializer )
+                {
+                    inInitializer = ( token != "," );
+                }
+                else if( ( token == "=" ) && !isOperator )
+                {
+                    inInitializer = true;
+                }
+                else if( ( token == PAREN_GROUP ) || ( m_parenNames.count( token ) > 0 ) )
+                {
+                    mayDeclareFunction = true;
+                    break;
+                }
+            }
+        }
+
+        ResetStatement();
+
+        return mayDeclareFunction;
+    }
+
+    // Records the name defined by a typedef of a function type, which can be used to declare functions (unlike
+    // function pointer types)
+    void RecordTypeAlias()
+    {
+        if( !HasParentheses( 1 ) )
+        {
+            return;
+        }
+
+        std::string name;
+        for( size_t i = 1; i < m_statement.size(); i++ )
+        {
+            if( m_statement[i] == PAREN_GROUP )
+            {
+                if( ( i + 1 < m_statement.size() ) && ( ( m_statement[i + 1] == PAREN_GROUP ) || ( m_statement[i + 1] == "[]" ) ) )
+                {
+                    // Parenthesized declarator, e.g. "(*name)(...)" or "(name)(...)"
+                    bool isPointer = false;
+                    name = GetDeclaratorName( isPointer );
+                    if( isPointer )
+                    {
+                        return;
+                    }
+                }
+                else if( IsIdentifier( m_statement[i - 1] ) )
+                {
+                    // Function type, e.g. "name(...)"
+                    name = m_statement[i - 1];
+                }
+                break;
+            }
+        }
+        for( size_t i = m_statement.size(); name.empty() && ( i > 1 ); i-- )
+        {
+            if( IsIdentifier( m_statement[i - 1] ) )
+            {
+                // Alias of another function type
+                name = m_statement[i - 1];
+            }
+        }
+
+        if( !name.empty() )
+        {
+            m_parenNames.insert( name );
+        }
+    }
+
+    bool HasParentheses( size_t start ) const
+    {
+        for( size_t i = start; i < m_statement.size(); i++ )
+        {
+            if( ( m_statement[i] == PAREN_GROUP ) || ( m_parenNames.count( m_statement[i] ) > 0 ) )
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Returns the name declared inside the first parenthesized group of the statement
+    std::string GetDeclaratorName( bool &isPointer ) const
+    {
+        std::string name;
+        isPointer = false;
+        for( size_t i = m_firstGroupPos + 1; i < m_tokens.size(); i++ )
+        {
+            const std::string &token = m_tokens[i];
+            if( ( token == ")" ) || ( token == "(" ) || ( token == "[" ) || ( token == ";" ) )
+            {
+                break;
+            }
+            else if( ( token == "*" ) || ( token == "^" ) || ( token == "&" ) )
+            {
+                isPointer = true;
+            }
+            else if( IsIdentifier( token ) )
+            {
+                name = token;
+            }
+        }
+        return name;
+    }
+
+    void ResetStatement()
+    {
+        m_statement.clear();
+        m_firstGroupPos = 0;
+    }
+
+    // Skips the group opened at the current position up to its closing token
+    void SkipGroup( const char *open, const char *close )
+    {
+        unsigned int depth = 0;
+        while( m_pos < m_tokens.size() )
+        {
+            const std::string &token = m_tokens[m_pos];
+            m_pos++;
+
+            if( token == open )
+            {
+                depth++;
+            }
+            else if( ( token == close ) && ( --depth == 0 ) )
+            {
+                break;
+            }
+        }
+    }
+
+    void SkipTemplateParameters()
+    {
+        unsigned int depth = 0;
+        while( m_pos < m_tokens.size() )
+        {
+            const std::string &token = m_tokens[m_pos];
+
+            if( token == "(" )
+            {
+                SkipGroup( "(", ")" );
+                continue;
+            }
+            else if( ( token == ";" ) || ( token == "{" ) || ( token == "}" ) )
+            {
+                break;
+            }
+
+            m_pos++;
+
+            if( token == "<" )
+            {
+                depth++;
+            }
+            else if( ( token == ">" ) && ( --depth == 0 ) )
+            {
+                break;
+            }
+        }
+    }
+
+    const std::vector<std::string> &m_tokens;
+    std::set<std::string> m_parenNames;
+    bool m_interpretAsCpp;
+    size_t m_pos = 0;
+    std::vector<std::string> m_statement;
+    size_t m_firstGroupPos = 0;
+};
+
+bool MayDeclareMockableFunctions( const std::string &contents, bool interpretAsCpp )
+{
+    std::map<std::string, std::string> objectMacros;
+    std::vector<std::string> tokens = Tokenize( contents, interpretAsCpp, objectMacros );
+
+    StatementScanner scanner( tokens, GetParenthesizedMacros( objectMacros, interpretAsCpp ), interpretAsCpp );
+
+    return scanner.ScanScope( false );
+}
@@ -0,0 +1,21 @@
+#ifndef CPPUMOCKGEN_HEADERPREFILTER_HPP_
+#define CPPUMOCKGEN_HEADERPREFILTER_HPP_
+
+#include <string>
+
+/**
+ * Checks with a quick lexical scan, without parsing it with libclang, whether a header may declare any function
+ * that could be mocked.
+ *
+ * The scan is conservative: it only rules out headers whose declarations (once comments, literals and preprocessor
+ * directives are discarded) cannot be function declarations, i.e. headers that only define macros, types, enumerations,
+ * variables or inline functions. Object-like macros defined in the header itself that expand to something with
+ * parentheses are considered to possibly declare functions.
+ *
+ * @param contents [in] Contents of the header
+ * @param interpretAsCpp [in] Interpret the header as C++ (otherwise as C)
+ * @return @c false if the header cannot declare any mockable function, @c true otherwise
+ */
+bool MayDeclareMockableFunctions( const std::string &contents, bool interpretAsCpp );
+
+#endif // header guard
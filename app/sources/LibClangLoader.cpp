@@ -0,0 +1,246 @@
+#include "LibClangLoader.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+
+#include <clang-c/Index.h>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+#ifndef CPPUMOCKGEN_LIBCLANG_PATH
+#if defined(WIN32)
+#define CPPUMOCKGEN_LIBCLANG_PATH "libclang.dll"
+#elif defined(__APPLE__)
+#define CPPUMOCKGEN_LIBCLANG_PATH "libclang.dylib"
+#else
+#define CPPUMOCKGEN_LIBCLANG_PATH "libclang.so"
+#endif
+#endif
+
+/*===========================================================================
+ *                       USED LIBCLANG FUNCTIONS
+ *===========================================================================*/
+
+/*
+ * Functions used from libclang, given as (return type, name, parameters, arguments).
+ *
+ * Any new libclang function used by CppUMockGen must be added to this list, otherwise linking will fail.
+ */
+#define LIBCLANG_FUNCTIONS( F ) \
+    F( CXIndex, clang_createIndex, (int excludeDeclarationsFromPCH, int displayDiagnostics), (excludeDeclarationsFromPCH, displayDiagnostics) ) \
+    F( void, clang_disposeIndex, (CXIndex index), (index) ) \
+    F( CXString, clang_getClangVersion, (void), () ) \
+    F( CXErrorCode, clang_parseTranslationUnit2, (CXIndex CIdx, const char *source_filename, const char *const *command_line_args, int num_command_line_args, CXUnsavedFile *unsaved_files, unsigned num_unsaved_files, unsigned options, CXTranslationUnit *out_TU), (CIdx, source_filename, command_line_args, num_command_line_args, unsaved_files, num_unsaved_files, options, out_TU) ) \
+    F( void, clang_disposeTranslationUnit, (CXTranslationUnit tu), (tu) ) \
+    F( unsigned, clang_defaultReparseOptions, (CXTranslationUnit tu), (tu) ) \
+    F( int, clang_reparseTranslationUnit, (CXTranslationUnit tu, unsigned num_unsaved_files, CXUnsavedFile *unsaved_files, unsigned options), (tu, num_unsaved_files, unsaved_files, options) ) \
+    F( CXTUResourceUsage, clang_getCXTUResourceUsage, (CXTranslationUnit tu), (tu) ) \
+    F( void, clang_disposeCXTUResourceUsage, (CXTUResourceUsage usage), (usage) ) \
+    F( unsigned, clang_defaultSaveOptions, (CXTranslationUnit tu), (tu) ) \
+    F( int, clang_saveTranslationUnit, (CXTranslationUnit tu, const char *file_name, unsigned options), (tu, file_name, options) ) \
+    F( unsigned, clang_getNumDiagnostics, (CXTranslationUnit tu), (tu) ) \
+    F( CXDiagnostic, clang_getDiagnostic, (CXTranslationUnit tu, unsigned index), (tu, index) ) \
+    F( void, clang_disposeDiagnostic, (CXDiagnostic diagnostic), (diagnostic) ) \
+    F( enum CXDiagnosticSeverity, clang_getDiagnosticSeverity, (CXDiagnostic diagnostic), (diagnostic) ) \
+    F( CXSourceLocation, clang_getDiagnosticLocation, (CXDiagnostic diagnostic), (diagnostic) ) \
+    F( CXString, clang_formatDiagnostic, (CXDiagnostic diagnostic, unsigned options), (diagnostic, options) ) \
+    F( unsigned, clang_defaultDiagnosticDisplayOptions, (void), () ) \
+    F( const char *, clang_getCString, (CXString string), (string) ) \
+    F( void, clang_disposeString, (CXString string), (string) ) \
+    F( CXCursor, clang_getTranslationUnitCursor, (CXTranslationUnit tu), (tu) ) \
+    F( unsigned, clang_visitChildren, (CXCursor parent, CXCursorVisitor visitor, CXClientData client_data), (parent, visitor, client_data) ) \
+    F( enum CXCursorKind, clang_getCursorKind, (CXCursor cursor), (cursor) ) \
+    F( int, clang_Cursor_isNull, (CXCursor cursor), (cursor) ) \
+    F( unsigned, clang_equalCursors, (CXCursor cursor1, CXCursor cursor2), (cursor1, cursor2) ) \
+    F( unsigned, clang_isDeclaration, (enum CXCursorKind kind), (kind) ) \
+    F( unsigned, clang_isInvalidDeclaration, (CXCursor cursor), (cursor) ) \
+    F( CXSourceLocation, clang_getCursorLocation, (CXCursor cursor), (cursor) ) \
+    F( CXSourceRange, clang_getCursorExtent, (CXCursor cursor), (cursor) ) \
+    F( CXString, clang_getCursorSpelling, (CXCursor cursor), (cursor) ) \
+    F( CXString, clang_getCursorDisplayName, (CXCursor cursor), (cursor) ) \
+    F( CXString, clang_getCursorUSR, (CXCursor cursor), (cursor) ) \
+    F( CXString, clang_Cursor_getMangling, (CXCursor cursor), (cursor) ) \
+    F( CXType, clang_getCursorType, (CXCursor cursor), (cursor) ) \
+    F( CXType, clang_getCursorResultType, (CXCursor cursor), (cursor) ) \
+    F( CXCursor, clang_getCursorSemanticParent, (CXCursor cursor), (cursor) ) \
+    F( CXCursor, clang_getCursorLexicalParent, (CXCursor cursor), (cursor) ) \
+    F( CXCursor, clang_getCursorDefinition, (CXCursor cursor), (cursor) ) \
+    F( CXCursor, clang_getCanonicalCursor, (CXCursor cursor), (cursor) ) \
+    F( CXTranslationUnit, clang_Cursor_getTranslationUnit, (CXCursor cursor), (cursor) ) \
+    F( int, clang_Cursor_getNumArguments, (CXCursor cursor), (cursor) ) \
+    F( CXCursor, clang_Cursor_getArgument, (CXCursor cursor, unsigned i), (cursor, i) ) \
+    F( unsigned, clang_Cursor_isBitField, (CXCursor cursor), (cursor) ) \
+    F( enum CX_CXXAccessSpecifier, clang_getCXXAccessSpecifier, (CXCursor cursor), (cursor) ) \
+    F( unsigned, clang_CXXMethod_isConst, (CXCursor cursor), (cursor) ) \
+    F( unsigned, clang_CXXMethod_isPureVirtual, (CXCursor cursor), (cursor) ) \
+    F( unsigned, clang_CXXMethod_isVirtual, (CXCursor cursor), (cursor) ) \
+    F( CXType, clang_getCanonicalType, (CXType type), (type) ) \
+    F( unsigned, clang_isConstQualifiedType, (CXType type), (type) ) \
+    F( unsigned, clang_isPODType, (CXType type), (type) ) \
+    F( CXType, clang_getPointeeType, (CXType type), (type) ) \
+    F( CXCursor, clang_getTypeDeclaration, (CXType type), (type) ) \
+    F( CXString, clang_getTypeKindSpelling, (enum CXTypeKind kind), (kind) ) \
+    F( CXString, clang_getTypeSpelling, (CXType type), (type) ) \
+    F( CXType, clang_getArrayElementType, (CXType type), (type) ) \
+    F( CXType, clang_Type_getNamedType, (CXType type), (type) ) \
+    F( long long, clang_Type_getSizeOf, (CXType type), (type) ) \
+    F( unsigned, clang_Type_visitFields, (CXType type, CXFieldVisitor visitor, CXClientData client_data), (type, visitor, client_data) ) \
+    F( CXSourceLocation, clang_getNullLocation, (void), () ) \
+    F( unsigned, clang_equalLocations, (CXSourceLocation location1, CXSourceLocation location2), (location1, location2) ) \
+    F( CXSourceLocation, clang_getLocationForOffset, (CXTranslationUnit tu, CXFile file, unsigned offset), (tu, file, offset) ) \
+    F( int, clang_Location_isInSystemHeader, (CXSourceLocation location), (location) ) \
+    F( void, clang_getFileLocation, (CXSourceLocation location, CXFile *file, unsigned *line, unsigned *column, unsigned *offset), (location, file, line, column, offset) ) \
+    F( CXSourceRange, clang_getRange, (CXSourceLocation begin, CXSourceLocation end), (begin, end) ) \
+    F( CXSourceLocation, clang_getRangeStart, (CXSourceRange range), (range) ) \
+    F( CXSourceLocation, clang_getRangeEnd, (CXSourceRange range), (range) ) \
+    F( CXFile, clang_getFile, (CXTranslationUnit tu, const char *file_name), (tu, file_name) ) \
+    F( CXString, clang_getFileName, (CXFile file), (file) ) \
+    F( int, clang_getFileUniqueID, (CXFile file, CXFileUniqueID *outID), (file, outID) ) \
+    F( const char *, clang_getFileContents, (CXTranslationUnit tu, CXFile file, size_t *size), (tu, file, size) ) \
+    F( void, clang_getInclusions, (CXTranslationUnit tu, CXInclusionVisitor visitor, CXClientData client_data), (tu, visitor, client_data) ) \
+    F( void, clang_tokenize, (CXTranslationUnit tu, CXSourceRange range, CXToken **tokens, unsigned *numTokens), (tu, range, tokens, numTokens) ) \
+    F( void, clang_annotateTokens, (CXTranslationUnit tu, CXToken *tokens, unsigned numTokens, CXCursor *cursors), (tu, tokens, numTokens, cursors) ) \
+    F( void, clang_disposeTokens, (CXTranslationUnit tu, CXToken *tokens, unsigned numTokens), (tu, tokens, numTokens) ) \
+    F( CXTokenKind, clang_getTokenKind, (CXToken token), (token) ) \
+    F( CXString, clang_getTokenSpelling, (CXTranslationUnit tu, CXToken token), (tu, token) ) \
+    F( CXSourceLocation, clang_getTokenLocation, (CXTranslationUnit tu, CXToken token), (tu, token) )
+
+/*===========================================================================
+ *                        LIBRARY LOADING
+ *===========================================================================*/
+
+struct LibClangFunctions
+{
+#define DECLARE_FUNCTION_POINTER( ret, name, params, args ) decltype( &::name ) name;
+    LIBCLANG_FUNCTIONS( DECLARE_FUNCTION_POINTER )
+#undef DECLARE_FUNCTION_POINTER
+};
+
+static std::mutex s_loadMutex;
+static std::string s_libraryPath = CPPUMOCKGEN_LIBCLANG_PATH;
+static LibClangFunctions s_loadedFunctions;
+static std::atomic<const LibClangFunctions*> s_functions( nullptr );
+
+#ifdef WIN32
+typedef HMODULE LibraryHandle;
+
+static LibraryHandle OpenLibrary( const std::string &libraryPath, std::string &error )
+{
+    LibraryHandle handle = LoadLibraryA( libraryPath.c_str() );
+    if( handle == NULL )
+    {
+        error = "error code " + std::to_string( GetLastError() );
+    }
+    return handle;
+}
+
+static void* GetLibrarySymbol( LibraryHandle handle, const char *name )
+{
+    return reinterpret_cast<void*>( GetProcAddress( handle, name ) );
+}
+
+static void CloseLibrary( LibraryHandle handle )
+{
+    FreeLibrary( handle );
+}
+#else
+typedef void* LibraryHandle;
+
+static LibraryHandle OpenLibrary( const std::string &libraryPath, std::string &error )
+{
+    // Symbols are resolved locally, so that lookups return the library functions instead of the forwarders below
+    LibraryHandle handle = dlopen( libraryPath.c_str(), RTLD_NOW | RTLD_LOCAL );
+    if( handle == NULL )
+    {
+        error = dlerror();
+    }
+    return handle;
+}
+
+static void* GetLibrarySymbol( LibraryHandle handle, const char *name )
+{
+    return dlsym( handle, name );
+}
+
+static void CloseLibrary( LibraryHandle handle )
+{
+    dlclose( handle );
+}
+#endif
+
+void SetLibClangPath( const std::string &libraryPath )
+{
+    std::lock_guard<std::mutex> lock( s_loadMutex );
+
+    s_libraryPath = libraryPath;
+}
+
+void LoadLibClang()
+{
+    std::lock_guard<std::mutex> lock( s_loadMutex );
+
+    if( s_functions.load() != nullptr )
+    {
+        return;
+    }
+
+    std::string error;
+    LibraryHandle handle = OpenLibrary( s_libraryPath, error );
+    if( handle == NULL )
+    {
+        throw std::runtime_error( "libclang could not be loaded from '" + s_libraryPath + "' (" + error + ")." );
+    }
+
+    const char *missingFunction = nullptr;
+
+#define RESOLVE_FUNCTION( ret, name, params, args ) \
+    s_loadedFunctions.name = reinterpret_cast<decltype( &::name )>( GetLibrarySymbol( handle, #name ) ); \
+    if( ( s_loadedFunctions.name == nullptr ) && ( missingFunction == nullptr ) ) \
+    { \
+        missingFunction = #name; \
+    }
+    LIBCLANG_FUNCTIONS( RESOLVE_FUNCTION )
+#undef RESOLVE_FUNCTION
+
+    if( missingFunction != nullptr )
+    {
+        CloseLibrary( handle );
+        throw std::runtime_error( std::string( "Function '" ) + missingFunction + "' not found in '" + s_libraryPath +
+                                  "' (it is not libclang, or its version is older than required)." );
+    }
+
+    // The library is never unloaded, as functions returned by it may be in use until the process exits
+    s_functions.store( &s_loadedFunctions );
+}
+
+static const LibClangFunctions& GetFunctions()
+{
+    const LibClangFunctions *functions = s_functions.load();
+    if( functions == nullptr )
+    {
+        LoadLibClang();
+        functions = s_functions.load();
+    }
+    return *functions;
+}
+
+/*===========================================================================
+ *                         FUNCTION FORWARDERS
+ *===========================================================================*/
+
+/*
+ * Definitions of the libclang functions used, which forward the calls to the functions resolved from the loaded
+ * library.
+ */
+
+extern "C"
+{
+#define DEFINE_FORWARDER( ret, name, params, args ) ret name params { return GetFunctions().name args; }
+    LIBCLANG_FUNCTIONS( DEFINE_FORWARDER )
+#undef DEFINE_FORWARDER
+}
@@ -0,0 +1,31 @@
+#ifndef CPPUMOCKGEN_LIBCLANGLOADER_HPP_
+#define CPPUMOCKGEN_LIBCLANGLOADER_HPP_
+
+#include <string>
+
+/*
+ * libclang is not linked to CppUMockGen, but loaded on demand the first time any of its functions is called (see
+ * LibClangLoader.cpp), so that runs which do not parse anything (e.g. help, option errors or empty shards) do not pay
+ * for loading it.
+ */
+
+/**
+ * Sets the path of the libclang shared library to be loaded, instead of the one found at build time.
+ *
+ * Has no effect if libclang has already been loaded.
+ *
+ * @param libraryPath [in] Path of the libclang shared library
+ */
+void SetLibClangPath( const std::string &libraryPath );
+
+/**
+ * Loads libclang and resolves the functions used from it, if not already loaded.
+ *
+ * It is not necessary to call this function explicitly, but it can be used to check that libclang can be loaded
+ * before starting to parse.
+ *
+ * @throws std::runtime_error if the library cannot be loaded or any of the functions used is missing from it
+ */
+void LoadLibClang();
+
+#endif // header guard
@@ -0,0 +1,374 @@
+#include "OutputVerifier.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <stdexcept>
+#include <cstdio>
+#include <cstdlib>
+#include <clang-c/Index.h>
+
+#ifdef WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+#include "ClangHelper.hpp"
+#include "ConsoleColorizer.hpp"
+#include "FileHelper.hpp"
+#include "FingerprintStore.hpp"
+
+static const char PREFIX_FILENAME[] = "CppUMockGen_verify_prefix.hpp";
+static const char PREFIX_CONTENTS[] =
+        "#include <CppUTest/TestHarness.h>\n"
+        "#include <CppUTestExt/MockSupport.h>\n";
+
+static std::string GetTempDirPath()
+{
+    for( const char *variable : { "TMPDIR", "TEMP", "TMP" } )
+    {
+        const char *value = std::getenv( variable );
+        if( ( value != nullptr ) && ( *value != 0 ) )
+        {
+            return value;
+        }
+    }
+
+#ifdef WIN32
+    return ".";
+#else
+    return "/tmp";
+#endif
+}
+
+static std::string GetDirPath( const std::string &filepath )
+{
+    size_t separatorPos = filepath.find_last_of( "/\\" );
+    return ( separatorPos == std::string::npos ) ? "" : filepath.substr( 0, separatorPos + 1 );
+}
+
+static CXTranslationUnit ParseCode( CXIndex index, const std::string &filepath, const std::vector<std::string> &clangOpts,
+                                    std::vector<CXUnsavedFile> &unsavedFiles, unsigned int options )
+{
+    std::vector<const char*> clangOptPtrs;
+    for( const std::string &clangOpt : clangOpts )
+    {
+        clangOptPtrs.push_back( clangOpt.c_str() );
+    }
+
+    CXTranslationUnit tu;
+    CXErrorCode tuError = clang_parseTranslationUnit2( index, filepath.c_str(), clangOptPtrs.data(), (int) clangOptPtrs.size(),
+                                                       unsavedFiles.data(), (unsigned int) unsavedFiles.size(), options, &tu );
+
+    return ( tuError == CXError_Success ) ? tu : nullptr;
+}
+
+static unsigned int CountErrors( CXTranslationUnit tu, std::string *firstError = nullptr )
+{
+    unsigned int numErrors = 0;
+
+    unsigned int numDiags = clang_getNumDiagnostics( tu );
+    for( unsigned int i = 0; i < numDiags; i++ )
+    {
+        CXDiagnostic diag = clang_getDiagnostic( tu, i );
+        if( clang_getDiagnosticSeverity( diag ) >= CXDiagnostic_Error )
+        {
+            if( ( numErrors == 0 ) && ( firstError != nullptr ) )
+            {
+                *firstError = toString( clang_formatDiagnostic( diag, clang_defaultDiagnosticDisplayOptions() ) );
+            }
+            numErrors++;
+        }
+        clang_disposeDiagnostic( diag );
+    }
+
+    return numErrors;
+}
+
+/*===========================================================================
+ *                    DIAGNOSTICS MAPPING TO FUNCTIONS
+ *===========================================================================*/
+
+static std::string GetQualifiedFunctionName( CXCursor cursor )
+{
+    std::string name = toString( clang_getCursorDisplayName( cursor ) );
+
+    CXCursor parent = clang_getCursorSemanticParent( cursor );
+    while( !clang_Cursor_isNull( parent ) && ( clang_getCursorKind( parent ) != CXCursor_TranslationUnit ) )
+    {
+        name = toString( clang_getCursorSpelling( parent ) ) + "::" + name;
+        parent = clang_getCursorSemanticParent( parent );
+    }
+
+    // Expectation functions are declared in the "expect" namespace, taking additional parameters, therefore only the
+    // qualified name of the function for which they were generated is kept
+    static const std::string EXPECT_NAMESPACE = "expect::";
+    if( name.compare( 0, EXPECT_NAMESPACE.size(), EXPECT_NAMESPACE ) == 0 )
+    {
+        name = name.substr( EXPECT_NAMESPACE.size() );
+        name = name.substr( 0, name.find( '(' ) );
+    }
+
+    return name;
+}
+
+struct FunctionSearch
+{
+    CXFile file;
+    unsigned int offset;
+    std::string functionName;
+};
+
+static CXChildVisitResult FindEnclosingFunction( CXCursor cursor, CXCursor, CXClientData clientData )
+{
+    FunctionSearch *search = (FunctionSearch*) clientData;
+
+    switch( clang_getCursorKind( cursor ) )
+    {
+        case CXCursor_Namespace:
+        case CXCursor_ClassDecl:
+        case CXCursor_StructDecl:
+        case CXCursor_LinkageSpec:
+            return CXChildVisit_Recurse;
+
+        case CXCursor_FunctionDecl:
+        case CXCursor_CXXMethod:
+        case CXCursor_Constructor:
+        case CXCursor_Destructor:
+        case CXCursor_FunctionTemplate:
+        {
+            CXSourceRange extent = clang_getCursorExtent( cursor );
+            CXFile startFile;
+            unsigned int startOffset;
+            unsigned int endOffset;
+            clang_getFileLocation( clang_getRangeStart( extent ), &startFile, nullptr, nullptr, &startOffset );
+            clang_getFileLocation( clang_getRangeEnd( extent ), nullptr, nullptr, nullptr, &endOffset );
+
+            if( ( startFile == search->file ) && ( search->offset >= startOffset ) && ( search->offset <= endOffset ) )
+            {
+                search->functionName = GetQualifiedFunctionName( cursor );
+                return CXChildVisit_Break;
+            }
+            return CXChildVisit_Continue;
+        }
+
+        default:
+            return CXChildVisit_Continue;
+    }
+}
+
+// Returns the name of the function for which the code at the diagnostic location was generated, if any
+static std::string GetDiagnosticFunction( CXTranslationUnit tu, CXDiagnostic diag )
+{
+    FunctionSearch search = { nullptr, 0, "" };
+    clang_getFileLocation( clang_getDiagnosticLocation( diag ), &search.file, nullptr, nullptr, &search.offset );
+
+    if( search.file != nullptr )
+    {
+        clang_visitChildren( clang_getTranslationUnitCursor( tu ), FindEnclosingFunction, &search );
+    }
+
+    return search.functionName;
+}
+
+/*===========================================================================
+ *                          OUTPUT VERIFIER
+ *===========================================================================*/
+
+OutputVerifier::OutputVerifier( const std::vector<std::string> &includePaths, const std::vector<std::string> &includeFiles )
+: m_includeFiles( includeFiles )
+{
+    // Generated code is always C++, even for C input files
+    m_clangOpts = { "-xc++", "-std=c++11" };
+
+    for( const std::string &includePath : includePaths )
+    {
+        m_clangOpts.push_back( "-I" + includePath );
+    }
+
+    const char *cpputestHome = std::getenv( "CPPUTEST_HOME" );
+    if( cpputestHome != nullptr )
+    {
+        m_clangOpts.push_back( "-I" + std::string( cpputestHome ) + PATH_SEPARATOR + "include" );
+    }
+}
+
+OutputVerifier::~OutputVerifier()
+{
+    if( m_index != nullptr )
+    {
+        clang_disposeIndex( m_index );
+    }
+}
+
+void OutputVerifier::PreparePrefix()
+{
+    m_prefixPrepared = true;
+    m_index = clang_createIndex( 0, 0 );
+
+    // The precompiled prefix depends on the compilation options and on the libclang version
+    std::string prefixKey = toString( clang_getClangVersion() );
+    for( const std::string &clangOpt : m_clangOpts )
+    {
+        prefixKey += "\n" + clangOpt;
+    }
+    std::ostringstream pchPath;
+    pchPath << GetTempDirPath() << PATH_SEPARATOR << "CppUMockGen_verify_" << std::hex << std::setw( 16 ) <<
+               std::setfill( '0' ) << FingerprintStore::CalculateFingerprint( prefixKey ) << ".pch";
+    m_pchPath = pchPath.str();
+
+    std::vector<CXUnsavedFile> unsavedFiles;
+
+    // A cached precompiled prefix is reused if it is still valid (i.e. the CppUTest headers have not changed)
+    if( std::ifstream( m_pchPath ).good() )
+    {
+        std::vector<std::string> checkOpts = m_clangOpts;
+        checkOpts.push_back( "-include-pch" );
+        checkOpts.push_back( m_pchPath );
+
+        unsavedFiles.push_back( { "CppUMockGen_verify_check.cpp", "", 0 } );
+        CXTranslationUnit tu = ParseCode( m_index, "CppUMockGen_verify_check.cpp", checkOpts, unsavedFiles,
+                                          CXTranslationUnit_None );
+        if( tu != nullptr )
+        {
+            bool valid = ( CountErrors( tu ) == 0 );
+            clang_disposeTranslationUnit( tu );
+            if( valid )
+            {
+                return;
+            }
+        }
+    }
+
+    unsavedFiles.assign( 1, { PREFIX_FILENAME, PREFIX_CONTENTS, (unsigned long) ( sizeof( PREFIX_CONTENTS ) - 1 ) } );
+    CXTranslationUnit tu = ParseCode( m_index, PREFIX_FILENAME, m_clangOpts, unsavedFiles,
+                                      CXTranslationUnit_Incomplete | CXTranslationUnit_ForSerialization );
+
+    std::string firstError;
+    if( ( tu == nullptr ) || ( CountErrors( tu, &firstError ) > 0 ) )
+    {
+        if( tu != nullptr )
+        {
+            clang_disposeTranslationUnit( tu );
+        }
+        throw std::runtime_error( "The CppUTest headers needed to verify the outputs could not be compiled (pass their "
+                                  "path with -I or define CPPUTEST_HOME): " + firstError );
+    }
+
+    // The precompiled prefix is written to a temporary file first, so that concurrent runs never read a partial one
+    std::string tempPchPath = m_pchPath + "." + std::to_string( getpid() );
+    if( clang_saveTranslationUnit( tu, tempPchPath.c_str(), clang_defaultSaveOptions( tu ) ) == CXSaveError_None )
+    {
+        std::remove( m_pchPath.c_str() );
+        if( std::rename( tempPchPath.c_str(), m_pchPath.c_str() ) != 0 )
+        {
+            m_pchPath.clear();
+        }
+    }
+    else
+    {
+        m_pchPath.clear();
+    }
+    std::remove( tempPchPath.c_str() );
+
+    clang_disposeTranslationUnit( tu );
+}
+
+bool OutputVerifier::Verify( const std::string &inputFilepath, const std::string *inputContents,
+                             const std::vector<GeneratedFile> &files, std::ostream &error )
+{
+    if( !m_prefixPrepared )
+    {
+        PreparePrefix();
+    }
+
+    // Generated files are located in the directory of the input file, so that it is found when they include it
+    std::string dirPath = GetDirPath( inputFilepath );
+    std::vector<std::string> filepaths;
+    std::vector<CXUnsavedFile> unsavedFiles;
+    for( const GeneratedFile &file : files )
+    {
+        filepaths.push_back( dirPath + file.filename );
+    }
+    for( size_t i = 0; i < files.size(); i++ )
+    {
+        unsavedFiles.push_back( { filepaths[i].c_str(), files[i].contents.c_str(), (unsigned long) files[i].contents.size() } );
+    }
+    if( inputContents != nullptr )
+    {
+        unsavedFiles.push_back( { inputFilepath.c_str(), inputContents->c_str(), (unsigned long) inputContents->size() } );
+    }
+
+    // If the prefix could not be precompiled, the CppUTest headers are just parsed along with each generated file
+    std::vector<std::string> clangOpts = m_clangOpts;
+    if( !m_pchPath.empty() )
+    {
+        clangOpts.push_back( "-include-pch" );
+        clangOpts.push_back( m_pchPath );
+    }
+    for( const std::string &includeFile : m_includeFiles )
+    {
+        clangOpts.push_back( "-include" + includeFile );
+    }
+
+    bool success = true;
+
+    for( size_t i = 0; i < files.size(); i++ )
+    {
+        if( !files[i].compiled )
+        {
+            continue;
+        }
+
+        CXTranslationUnit tu = ParseCode( (CXIndex) m_index, filepaths[i], clangOpts, unsavedFiles, CXTranslationUnit_None );
+// LCOV_EXCL_START
+        if( tu == nullptr )
+        {
+            cerrColorizer.SetColor( ConsoleColorizer::Color::LIGHT_RED );
+            error << "VERIFY ERROR: ";
+            cerrColorizer.SetColor( ConsoleColorizer::Color::RESET );
+            error << "Unable to compile the generated file '" << files[i].filename << "'." << std::endl;
+            success = false;
+            continue;
+        }
+// LCOV_EXCL_STOP
+
+        unsigned int numDiags = clang_getNumDiagnostics( tu );
+        for( unsigned int j = 0; j < numDiags; j++ )
+        {
+            CXDiagnostic diag = clang_getDiagnostic( tu, j );
+
+            CXDiagnosticSeverity diagSeverity = clang_getDiagnosticSeverity( diag );
+            if( diagSeverity >= CXDiagnostic_Warning )
+            {
+                if( diagSeverity >= CXDiagnostic_Error )
+                {
+                    success = false;
+                    cerrColorizer.SetColor( ConsoleColorizer::Color::LIGHT_RED );
+                    error << "VERIFY ERROR: ";
+                }
+                else
+                {
+                    cerrColorizer.SetColor( ConsoleColorizer::Color::YELLOW );
+                    error << "VERIFY WARNING: ";
+                }
+                cerrColorizer.SetColor( ConsoleColorizer::Color::RESET );
+                error << clang_formatDiagnostic( diag, clang_defaultDiagnosticDisplayOptions() ) << std::endl;
+
+                std::string functionName = GetDiagnosticFunction( tu, diag );
+                if( !functionName.empty() )
+                {
+                    error << "    (in the code generated for function '" << functionName << "')" << std::endl;
+                }
+            }
+
+            clang_disposeDiagnostic( diag );
+        }
+
+        clang_disposeTranslationUnit( tu );
+    }
+
+    return success;
+}
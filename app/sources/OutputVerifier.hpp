@@ -0,0 +1,65 @@
+#ifndef CPPUMOCKGEN_OUTPUTVERIFIER_HPP_
+#define CPPUMOCKGEN_OUTPUTVERIFIER_HPP_
+
+#include <string>
+#include <vector>
+#include <ostream>
+
+/**
+ * Verifier that the generated outputs compile, which compiles them in memory with libclang.
+ *
+ * The CppUTest/CppUMock headers included by the outputs are precompiled the first time that they are needed, and the
+ * precompiled header is cached in the temporary directory to be reused by later runs while it is still valid.
+ */
+class OutputVerifier
+{
+public:
+    /**
+     * Generated file to be verified.
+     */
+    struct GeneratedFile
+    {
+        std::string filename;   ///< Name of the file, which is located in the directory of the input file
+        std::string contents;   ///< Contents of the file
+        bool compiled;          ///< Compile the file (otherwise it is only available to be included by other files)
+    };
+
+    /**
+     * Constructs an OutputVerifier object.
+     *
+     * The CppUTest headers are searched in @p includePaths and, if the CPPUTEST_HOME environment variable is
+     * defined, in its include directory.
+     *
+     * @param includePaths [in] List of paths to search for included header files
+     * @param includeFiles [in] List of files included before the input files
+     */
+    OutputVerifier( const std::vector<std::string> &includePaths, const std::vector<std::string> &includeFiles );
+
+    ~OutputVerifier();
+
+    /**
+     * Compiles the files generated for an input file.
+     *
+     * Diagnostics are reported indicating the function for which the offending code was generated.
+     *
+     * @param inputFilepath [in] Path of the input file
+     * @param inputContents [in] Contents of the input file if it is not read from disk, otherwise @c nullptr
+     * @param files [in] Generated files
+     * @param error [out] Stream where errors will be written
+     * @return @c true if all the compiled files compile without errors, @c false otherwise
+     * @throws std::runtime_error if the CppUTest headers cannot be compiled (e.g. they are not found)
+     */
+    bool Verify( const std::string &inputFilepath, const std::string *inputContents,
+                 const std::vector<GeneratedFile> &files, std::ostream &error );
+
+private:
+    void PreparePrefix();
+
+    std::vector<std::string> m_clangOpts;
+    std::vector<std::string> m_includeFiles;
+    void *m_index = nullptr;
+    std::string m_pchPath;
+    bool m_prefixPrepared = false;
+};
+
+#endif // header guard
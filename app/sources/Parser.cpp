@@ -2,6 +2,9 @@
 
 #include <iostream>
 #include <fstream>
+#include <set>
+#include <unordered_set>
+#include <cctype>
 #include <clang-c/Index.h>
 
 #include "Config.hpp"
@@ -10,135 +13,282 @@
 #include "ClangHelper.hpp"
 #include "ConsoleColorizer.hpp"
 #include "FileHelper.hpp"
+#include "FingerprintStore.hpp"
+#include "Trace.hpp"
 #include "VersionInfo.h"
 
+// Input file to which the functions declared in a file of the translation unit are routed
+struct ParseTarget
+{
+    const std::string &inputFilepath;
+    std::vector<std::unique_ptr<const Function>> &functions;
+    std::vector<std::pair<std::string, std::string>> &functionIds;
+    unsigned int duplicateCount;
+};
+
+// Routing table from the files of the translation unit to the input files
+struct ParseTargetMap
+{
+    std::vector<CXFile> files;
+    std::map<std::tuple<unsigned long long, unsigned long long, unsigned long long>, ParseTarget*> targetsByFileId;
+};
+
 struct ParseData
 {
     const Config& config;
-    std::vector<std::unique_ptr<const Function>> &functions;
+    const ParseTargetMap &targets;
+    ParseTarget *target;
+    const std::unordered_set<std::string> &symbols;
+    Parser::EmittedFunctions &emittedFunctions;
+    std::ostream &error;
 };
 
-void Parse( CXTranslationUnit tu, const Config &config, std::vector<std::unique_ptr<const Function>> &functions )
+static bool AddParseTarget( CXTranslationUnit tu, const std::string &filepath, ParseTarget &target, ParseTargetMap &targets )
 {
-    ParseData parseData = { config, functions };
+    CXFileUniqueID fileId;
+    CXFile file = clang_getFile( tu, filepath.c_str() );
+    if( ( file == nullptr ) || ( clang_getFileUniqueID( file, &fileId ) != 0 ) )
+    {
+        return false;
+    }
 
-    CXCursor tuCursor = clang_getTranslationUnitCursor(tu);
-    clang_visitChildren(
-        tuCursor,
-        []( CXCursor cursor, CXCursor parent, CXClientData clientData )
-        {
-            ParseData *parseData = (ParseData*) clientData;
-            if( clang_Location_isFromMainFile( clang_getCursorLocation( cursor ) ) != 0 )
-            {
-                CXCursorKind cursorKind = clang_getCursorKind( cursor );
-                if( cursorKind == CXCursor_FunctionDecl )
-                {
-                    Function *function = new Function;
-                    if( function->Parse( cursor, parseData->config ) )
-                    {
-                        parseData->functions.push_back( std::unique_ptr<const Function>(function) );
-                    }
-                    else
-                    {
-                        delete function;
-                    }
-                    return CXChildVisit_Continue;
-                }
-                else if( cursorKind == CXCursor_CXXMethod )
-                {
-                    Method *method = new Method;
-                    if( method->Parse( cursor, parseData->config ) )
-                    {
-                        parseData->functions.push_back( std::unique_ptr<const Function>(method) );
-                    }
-                    else
-                    {
-                        delete method;
-                    }
-                    return CXChildVisit_Continue;
-                }
-                else
-                {
-                    return CXChildVisit_Recurse;
-                }
-            }
-            else
-            {
-                return CXChildVisit_Continue;
-            }
-        },
-        (CXClientData) &parseData );
+    targets.files.push_back( file );
+    targets.targetsByFileId[ std::make_tuple( fileId.data[0], fileId.data[1], fileId.data[2] ) ] = &target;
+    return true;
 }
 
-bool Parser::Parse( const std::string &inputFilepath, const Config &config, bool interpretAsCpp, bool useCpp11,
-                    const std::vector<std::string> &includePaths, const std::vector<std::string> &includeFiles, 
-                    std::ostream &error )
+static ParseTarget* FindParseTarget( const CXCursor &cursor, const ParseTargetMap &targets )
 {
-    m_inputFilepath = inputFilepath;
-    m_interpretAsCpp = interpretAsCpp;
+    CXFile file;
+    CXFileUniqueID fileId;
+    clang_getFileLocation( clang_getCursorLocation( cursor ), &file, nullptr, nullptr, nullptr );
+    if( ( file == nullptr ) || ( clang_getFileUniqueID( file, &fileId ) != 0 ) )
+    {
+        return nullptr;
+    }
 
-    CXIndex index = clang_createIndex( 0, 0 );
+    auto it = targets.targetsByFileId.find( std::make_tuple( fileId.data[0], fileId.data[1], fileId.data[2] ) );
+    return ( it != targets.targetsByFileId.end() ) ? it->second : nullptr;
+}
 
-    std::vector<const char*> clangOpts;
-    if( interpretAsCpp )
+// Checks if the target platform decorated the mangled name of the function with a leading underscore, either to the
+// name of a C function or to the Itanium mangled name of a C++ function
+static bool IsDecoratedSymbol( const CXCursor &cursor, const std::string &mangledName )
+{
+    return ( mangledName == "_" + toString( clang_getCursorSpelling( cursor ) ) ) ||
+           ( mangledName.compare( 0, 3, "__Z" ) == 0 );
+}
+
+static bool IsSelectedSymbol( const CXCursor &cursor, const std::unordered_set<std::string> &symbols )
+{
+    if( symbols.empty() )
     {
-        clangOpts.push_back( "-xc++" );
+        return true;
     }
 
-    if( interpretAsCpp )
+    std::string mangledName = toString( clang_Cursor_getMangling( cursor ) );
+    if( symbols.count( mangledName ) > 0 )
     {
-        clangOpts.push_back( "-std=c++11" );
+        return true;
     }
 
-    std::vector<std::string> includeFileOptions;
-
-    for( const std::string &includeFile : includeFiles )
+    // Symbols are decorated with a leading underscore on some platforms (e.g. Mach-O), so that symbols listed on
+    // platforms that decorate them and on platforms that do not can be used interchangeably
+    if( IsDecoratedSymbol( cursor, mangledName ) )
     {
-        includeFileOptions.push_back( "-include" + includeFile );
-        clangOpts.push_back( includeFileOptions.back().c_str() );
-        std::cout << includeFile << std::endl;
+        return symbols.count( mangledName.substr( 1 ) ) > 0;
     }
+    else
+    {
+        return symbols.count( "_" + mangledName ) > 0;
+    }
+}
 
-    std::vector<std::string> includePathOptions;
+static bool IsAlreadyEmitted( const CXCursor &cursor, ParseData &parseData )
+{
+    std::string usr = toString( clang_getCursorUSR( cursor ) );
 
-    for( const std::string &includePath : includePaths )
+    Parser::EmittedFunctions::const_iterator it = parseData.emittedFunctions.find( usr );
+    if( it == parseData.emittedFunctions.end() )
     {
-        // Option strings must be stored in a vector, otherwise C strings would not be valid
-        includePathOptions.push_back( "-I" + includePath );
-        clangOpts.push_back( includePathOptions.back().c_str() );    
+        return false;
     }
-    
-    CXTranslationUnit tu;
-    // Note: Use of CXTranslationUnit_SkipFunctionBodies is not allowed, otherwise libclang
-    // will not detect properly methods defined inline (which must not be mocked).
-    CXErrorCode tuError = clang_parseTranslationUnit2( index, inputFilepath.c_str(),
-                                                       clangOpts.data(), (int) clangOpts.size(),
-                                                       nullptr, 0,
-                                                       CXTranslationUnit_None,
-                                                       &tu );
-    if( tuError != CXError_Success )
+
+    // Redeclarations in the same input file are silently skipped, only duplicates across input files are reported
+    if( it->second != parseData.target->inputFilepath )
     {
-        cerrColorizer.SetColor( ConsoleColorizer::Color::LIGHT_RED );
-        error << "INPUT ERROR: ";
+        parseData.target->duplicateCount++;
+
+        cerrColorizer.SetColor( ConsoleColorizer::Color::YELLOW );
+        parseData.error << "INPUT WARNING: ";
         cerrColorizer.SetColor( ConsoleColorizer::Color::RESET );
+        parseData.error << "Function '" << toString( clang_getCursorDisplayName( cursor ) ) << "' declared in '" <<
+                           parseData.target->inputFilepath << "' has already been mocked for '" << it->second << "'." << std::endl;
+    }
 
-        // Check if file exists
-        std::ifstream inputFile( inputFilepath.c_str() );
-        if( !inputFile.good() )
+    return true;
+}
+
+static void AddFunction( const CXCursor &cursor, ParseData &parseData, Function *function )
+{
+    parseData.target->functions.push_back( std::unique_ptr<const Function>(function) );
+
+    std::string usr = toString( clang_getCursorUSR( cursor ) );
+    parseData.target->functionIds.push_back( std::make_pair( usr, toString( clang_getCursorDisplayName( cursor ) ) ) );
+    if( !usr.empty() )
+    {
+        parseData.emittedFunctions[usr] = parseData.target->inputFilepath;
+    }
+}
+
+static CXChildVisitResult VisitCursor( CXCursor cursor, CXCursor parent, CXClientData clientData )
+{
+    ParseData *parseData = (ParseData*) clientData;
+
+    // Only declarations located in the input files are processed, each one for the input file where it is located
+    parseData->target = FindParseTarget( cursor, parseData->targets );
+    if( parseData->target != nullptr )
+    {
+        CXCursorKind cursorKind = clang_getCursorKind( cursor );
+        if( ( ( cursorKind == CXCursor_FunctionDecl ) || ( cursorKind == CXCursor_CXXMethod ) ) &&
+            ( !IsSelectedSymbol( cursor, parseData->symbols ) || IsAlreadyEmitted( cursor, *parseData ) ) )
         {
-            error << "Input file '" << inputFilepath.c_str() << "' does not exist." << std::endl;
+            return CXChildVisit_Continue;
+        }
+        else if( cursorKind == CXCursor_FunctionDecl )
+        {
+            TraceSpan span( "type processing" );
+            if( span.IsActive() )
+            {
+                span.AddArgument( "function", toString( clang_getCursorDisplayName( cursor ) ) );
+            }
+
+            Function *function = new Function;
+            if( function->Parse( cursor, parseData->config ) )
+            {
+                AddFunction( cursor, *parseData, function );
+            }
+            else
+            {
+                delete function;
+            }
+            return CXChildVisit_Continue;
+        }
+        else if( cursorKind == CXCursor_CXXMethod )
+        {
+            TraceSpan span( "type processing" );
+            if( span.IsActive() )
+            {
+                span.AddArgument( "function", toString( clang_getCursorDisplayName( cursor ) ) );
+            }
+
+            Method *method = new Method;
+            if( method->Parse( cursor, parseData->config ) )
+            {
+                AddFunction( cursor, *parseData, method );
+            }
+            else
+            {
+                delete method;
+            }
+            return CXChildVisit_Continue;
         }
-// LCOV_EXCL_START
         else
         {
-            error << "Unable to parse input file (Error code = " << tuError << ")." << std::endl;
+            return CXChildVisit_Recurse;
         }
-// LCOV_EXCL_STOP
+    }
+    else
+    {
+        return CXChildVisit_Continue;
+    }
+}
 
-        clang_disposeIndex( index );
+static bool GetTopLevelDeclarations( CXTranslationUnit tu, CXFile file, std::vector<CXCursor> &declarations )
+{
+    // The file is tokenized up to its end as it was parsed (i.e. including in-memory contents)
+    size_t fileSize;
+    if( clang_getFileContents( tu, file, &fileSize ) == nullptr )
+    {
+        return false;
+    }
+
+    CXSourceLocation fileStart = clang_getLocationForOffset( tu, file, 0 );
+    CXSourceLocation fileEnd = clang_getLocationForOffset( tu, file, (unsigned int) fileSize );
+    if( clang_equalLocations( fileStart, clang_getNullLocation() ) ||
+        clang_equalLocations( fileEnd, clang_getNullLocation() ) )
+    {
         return false;
     }
 
+    CXToken *tokens;
+    unsigned int numTokens;
+    clang_tokenize( tu, clang_getRange( fileStart, fileEnd ), &tokens, &numTokens );
+
+    // Annotating the tokens only traverses the declarations overlapping the file, and some token of each declaration
+    // (e.g. its name) is annotated with the declaration itself or with a nested declaration
+    std::vector<CXCursor> tokenCursors( numTokens );
+    clang_annotateTokens( tu, tokens, numTokens, tokenCursors.data() );
+    clang_disposeTokens( tu, tokens, numTokens );
+
+    for( const CXCursor &tokenCursor : tokenCursors )
+    {
+        if( !clang_isDeclaration( clang_getCursorKind( tokenCursor ) ) )
+        {
+            continue;
+        }
+
+        CXCursor declaration = tokenCursor;
+        CXCursor lexicalParent = clang_getCursorLexicalParent( declaration );
+        while( !clang_Cursor_isNull( lexicalParent ) && ( clang_getCursorKind( lexicalParent ) != CXCursor_TranslationUnit ) )
+        {
+            declaration = lexicalParent;
+            lexicalParent = clang_getCursorLexicalParent( declaration );
+        }
+
+        // Tokens of the same declaration are consecutive
+        if( !clang_Cursor_isNull( lexicalParent ) &&
+            ( declarations.empty() || !clang_equalCursors( declarations.back(), declaration ) ) )
+        {
+            declarations.push_back( declaration );
+        }
+    }
+
+    return true;
+}
+
+void Parse( CXTranslationUnit tu, const Config &config, const std::unordered_set<std::string> &symbols,
+            Parser::EmittedFunctions &emittedFunctions, std::ostream &error, const ParseTargetMap &targets )
+{
+    ParseData parseData = { config, targets, nullptr, symbols, emittedFunctions, error };
+
+    CXCursor tuCursor = clang_getTranslationUnitCursor(tu);
+
+    // The traversal starts directly from the declarations located in the input files, instead of visiting all the
+    // declarations of the translation unit (most of which are usually located in included files)
+    std::vector<CXCursor> declarations;
+    for( CXFile file : targets.files )
+    {
+        if( !GetTopLevelDeclarations( tu, file, declarations ) )
+        {
+            clang_visitChildren( tuCursor, VisitCursor, (CXClientData) &parseData );
+            return;
+        }
+    }
+
+    for( const CXCursor &declaration : declarations )
+    {
+        if( VisitCursor( declaration, tuCursor, (CXClientData) &parseData ) == CXChildVisit_Recurse )
+        {
+            clang_visitChildren( declaration, VisitCursor, (CXClientData) &parseData );
+        }
+    }
+}
+
+static unsigned int ReportDiagnostics( CXTranslationUnit tu, bool errorsAsWarnings, std::ostream &error )
+{
+    TraceSpan span( "diagnostics" );
+
     unsigned int numDiags = clang_getNumDiagnostics(tu);
     unsigned int numErrors = 0;
     if( numDiags > 0 )
@@ -148,6 +298,10 @@ bool Parser::Parse( const std::string &inputFilepath, const Config &config, bool
             CXDiagnostic diag = clang_getDiagnostic( tu, i );
 
             CXDiagnosticSeverity diagSeverity = clang_getDiagnosticSeverity( diag );
+            if( errorsAsWarnings && ( diagSeverity >= CXDiagnosticSeverity::CXDiagnostic_Error ) )
+            {
+                diagSeverity = CXDiagnosticSeverity::CXDiagnostic_Warning;
+            }
 
             switch( diagSeverity )
             {
@@ -176,34 +330,550 @@ bool Parser::Parse( const std::string &inputFilepath, const Config &config, bool
         }
     }
 
-    if( numErrors == 0 )
+    span.AddArgument( "diagnostics", numDiags );
+    span.AddArgument( "errors", numErrors );
+
+    return numErrors;
+}
+
+void Parser::ReportNoMockableFunctions( const std::string &inputFileDescription, bool symbolsListed, std::ostream &error,
+                                        bool skipped )
+{
+    if( skipped )
+    {
+        cerrColorizer.SetColor( ConsoleColorizer::Color::YELLOW );
+        error << "INPUT WARNING: ";
+    }
+    else
+    {
+        cerrColorizer.SetColor( ConsoleColorizer::Color::LIGHT_RED );
+        error << "INPUT ERROR: ";
+    }
+    cerrColorizer.SetColor( ConsoleColorizer::Color::RESET );
+
+    error << inputFileDescription << " does not contain any mockable function";
+    if( symbolsListed )
+    {
+        error << " referenced in the symbols list";
+    }
+    error << ( skipped ? ", it has been skipped." : "." ) << std::endl;
+}
+
+static void CollectMemoryUsage( CXTranslationUnit tu, Parser::Statistics &statistics )
+{
+    statistics.memoryUsage = 0;
+    statistics.astMemoryUsage = 0;
+    statistics.identifiersMemoryUsage = 0;
+    statistics.preprocessorMemoryUsage = 0;
+    statistics.sourceManagerMemoryUsage = 0;
+
+    CXTUResourceUsage resourceUsage = clang_getCXTUResourceUsage( tu );
+    for( unsigned int i = 0; i < resourceUsage.numEntries; i++ )
     {
-        ::Parse( tu, config, m_functions );
+        const CXTUResourceUsageEntry &entry = resourceUsage.entries[i];
 
-        if( m_functions.size() == 0 )
+        statistics.memoryUsage += entry.amount;
+
+        switch( entry.kind )
         {
-            cerrColorizer.SetColor( ConsoleColorizer::Color::LIGHT_RED );
-            error << "INPUT ERROR: ";
-            cerrColorizer.SetColor( ConsoleColorizer::Color::RESET );
-            error << "The input file does not contain any mockable function." << std::endl;
+            case CXTUResourceUsage_AST:
+            case CXTUResourceUsage_AST_SideTables:
+                statistics.astMemoryUsage += entry.amount;
+                break;
+
+            case CXTUResourceUsage_Identifiers:
+            case CXTUResourceUsage_Selectors:
+                statistics.identifiersMemoryUsage += entry.amount;
+                break;
+
+            case CXTUResourceUsage_Preprocessor:
+            case CXTUResourceUsage_PreprocessingRecord:
+            case CXTUResourceUsage_Preprocessor_HeaderSearch:
+                statistics.preprocessorMemoryUsage += entry.amount;
+                break;
+
+            case CXTUResourceUsage_SourceManagerContentCache:
+            case CXTUResourceUsage_SourceManager_Membuffer_Malloc:
+            case CXTUResourceUsage_SourceManager_Membuffer_MMap:
+            case CXTUResourceUsage_SourceManager_DataStructures:
+                statistics.sourceManagerMemoryUsage += entry.amount;
+                break;
+
+            default:
+                // Other kinds (e.g. completion results) are only accounted in the total
+                break;
         }
     }
+    clang_disposeCXTUResourceUsage( resourceUsage );
+}
+
+static std::vector<std::string> GetClangOptions( bool interpretAsCpp, const std::vector<std::string> &includePaths,
+                                                 const std::vector<std::string> &includeFiles )
+{
+    std::vector<std::string> clangOpts;
+
+    if( interpretAsCpp )
+    {
+        clangOpts.push_back( "-xc++" );
+    }
+
+    if( interpretAsCpp )
+    {
+        clangOpts.push_back( "-std=c++11" );
+    }
+
+    for( const std::string &includeFile : includeFiles )
+    {
+        clangOpts.push_back( "-include" + includeFile );
+        std::cout << includeFile << std::endl;
+    }
+
+    for( const std::string &includePath : includePaths )
+    {
+        clangOpts.push_back( "-I" + includePath );
+    }
+
+    return clangOpts;
+}
+
+struct Parser::TranslationUnit
+{
+    CXIndex index;
+    CXTranslationUnit tu;
+
+    ~TranslationUnit()
+    {
+        clang_disposeTranslationUnit( tu );
+        clang_disposeIndex( index );
+    }
+};
+
+void Parser::EnableReparse()
+{
+    m_reparseEnabled = true;
+}
+
+void Parser::EnableDependencyTracking()
+{
+    m_dependencyTrackingEnabled = true;
+}
+
+void Parser::EnableSingleFileParse()
+{
+    m_singleFileParse = true;
+}
+
+void Parser::EnableSkipWithoutFunctions()
+{
+    m_skipWithoutFunctions = true;
+}
+
+void Parser::ReportNoMockableFunctions( std::ostream &error )
+{
+    // Skipped input files are named, because they do not stop the processing of the other input files
+    m_skipped = m_skipWithoutFunctions;
+    if( m_skipped )
+    {
+        ReportNoMockableFunctions( "The input file '" + m_inputFilepath + "'", m_symbolsListed, error, true );
+    }
+    else
+    {
+        ReportNoMockableFunctions( "The input file", m_symbolsListed, error );
+    }
+}
+
+void Parser::SetInputContents( const std::string &contents )
+{
+    m_hasInputContents = true;
+    m_inputContents = contents;
+}
+
+void Parser::SetIncludePath( const std::string &includePath )
+{
+    m_includePath = includePath;
+}
+
+bool Parser::Parse( const std::string &inputFilepath, const Config &config, bool interpretAsCpp, bool useCpp11,
+                    const std::vector<std::string> &includePaths, const std::vector<std::string> &includeFiles, 
+                    const std::vector<std::string> &symbols, EmittedFunctions &emittedFunctions, std::ostream &error )
+{
+    m_inputFilepath = inputFilepath;
+    m_interpretAsCpp = interpretAsCpp;
+    m_translationUnit.reset();
+
+    // Option strings must be stored, otherwise C strings would not be valid when reparsing
+    m_clangOpts = GetClangOptions( interpretAsCpp, includePaths, includeFiles );
+
+    if( !CreateTranslationUnit( error ) )
+    {
+        return false;
+    }
+
+    return ProcessTranslationUnit( config, symbols, emittedFunctions, error );
+}
+
+bool Parser::ParseUmbrella( const std::vector<std::string> &inputFilepaths, const Config &config, bool interpretAsCpp,
+                            bool useCpp11, const std::vector<std::string> &includePaths,
+                            const std::vector<std::string> &includeFiles, const std::vector<std::string> &symbols,
+                            EmittedFunctions &emittedFunctions, std::vector<Parser> &parsers, std::ostream &error )
+{
+    // The umbrella file is not written to disk, and it is located in the current directory so that the paths of the
+    // input files are resolved as when parsing them separately
+    static const std::string UMBRELLA_FILEPATH = "CppUMockGen_umbrella.h";
+
+    std::string umbrellaContents;
+    for( size_t i = 0; i < inputFilepaths.size(); i++ )
+    {
+        umbrellaContents += "#include \"" + inputFilepaths[i] + "\"\n";
+
+        parsers[i].m_inputFilepath = inputFilepaths[i];
+        parsers[i].m_interpretAsCpp = interpretAsCpp;
+        parsers[i].m_symbolsListed = !symbols.empty();
+        parsers[i].m_functions.clear();
+        parsers[i].m_functionIds.clear();
+        parsers[i].m_statistics = Statistics();
+        parsers[i].m_skipped = false;
+        parsers[i].m_dependencies.assign( 1, inputFilepaths[i] );
+        parsers[i].m_translationUnit.reset();
+    }
+
+    CXUnsavedFile umbrellaFile = { UMBRELLA_FILEPATH.c_str(), umbrellaContents.c_str(), (unsigned long) umbrellaContents.size() };
+
+    std::vector<std::string> clangOptStrings = GetClangOptions( interpretAsCpp, includePaths, includeFiles );
+    std::vector<const char*> clangOpts;
+    for( const std::string &clangOpt : clangOptStrings )
+    {
+        clangOpts.push_back( clangOpt.c_str() );
+    }
+
+    CXIndex index = clang_createIndex( 0, 0 );
+
+    CXTranslationUnit tu;
+    CXErrorCode tuError;
+    {
+        TraceSpan span( "parse" );
+        span.AddArgument( "file", UMBRELLA_FILEPATH );
+        span.AddArgument( "inputs", inputFilepaths.size() );
+
+        tuError = clang_parseTranslationUnit2( index, UMBRELLA_FILEPATH.c_str(),
+                                               clangOpts.data(), (int) clangOpts.size(),
+                                               &umbrellaFile, 1,
+                                               CXTranslationUnit_None,
+                                               &tu );
+    }
+// LCOV_EXCL_START
+    if( tuError != CXError_Success )
+    {
+        cerrColorizer.SetColor( ConsoleColorizer::Color::LIGHT_RED );
+        error << "INPUT ERROR: ";
+        cerrColorizer.SetColor( ConsoleColorizer::Color::RESET );
+        error << "Unable to parse input files (Error code = " << tuError << ")." << std::endl;
+
+        clang_disposeIndex( index );
+        return false;
+    }
+// LCOV_EXCL_STOP
+
+    // Missing input files are reported as errors by the umbrella file inclusions
+    bool success = ( ReportDiagnostics( tu, false, error ) == 0 );
+    if( success )
+    {
+        std::unordered_set<std::string> selectedSymbols( symbols.begin(), symbols.end() );
+
+        std::vector<ParseTarget> targets;
+        ParseTargetMap targetMap;
+        targets.reserve( parsers.size() );
+        for( size_t i = 0; i < inputFilepaths.size(); i++ )
+        {
+            targets.push_back( { parsers[i].m_inputFilepath, parsers[i].m_functions, parsers[i].m_functionIds, 0 } );
+            AddParseTarget( tu, inputFilepaths[i], targets[i], targetMap );
+        }
+
+        TraceSpan span( "traversal" );
+        span.AddArgument( "file", UMBRELLA_FILEPATH );
+
+        ::Parse( tu, config, selectedSymbols, emittedFunctions, error, targetMap );
+
+        size_t functionCount = 0;
+        for( size_t i = 0; i < inputFilepaths.size(); i++ )
+        {
+            // An input file whose functions have all been mocked already for other input files is not an error, and
+            // an input file without functions only makes the whole parse fail if it cannot be skipped
+            if( ( parsers[i].m_functions.size() == 0 ) && ( targets[i].duplicateCount == 0 ) )
+            {
+                parsers[i].m_skipped = parsers[i].m_skipWithoutFunctions;
+                ReportNoMockableFunctions( "The input file '" + inputFilepaths[i] + "'", !symbols.empty(), error,
+                                           parsers[i].m_skipped );
+                if( !parsers[i].m_skipped )
+                {
+                    success = false;
+                }
+            }
+
+            parsers[i].m_statistics.functionCount = parsers[i].m_functions.size();
+            functionCount += parsers[i].m_functions.size();
+        }
+
+        span.AddArgument( "functions", functionCount );
+    }
 
     clang_disposeTranslationUnit( tu );
     clang_disposeIndex( index );
 
-    return (numErrors == 0) && (m_functions.size() > 0);
+    return success;
+}
+
+bool Parser::Reparse( const Config &config, const std::vector<std::string> &symbols, EmittedFunctions &emittedFunctions,
+                      std::ostream &error )
+{
+    CXUnsavedFile inputFile = { m_inputFilepath.c_str(), m_inputContents.data(), (unsigned long) m_inputContents.size() };
+
+    std::chrono::steady_clock::time_point parseStart = std::chrono::steady_clock::now();
+
+    {
+        TraceSpan span( "reparse" );
+        span.AddArgument( "file", m_inputFilepath );
+
+        // If the translation unit could not be kept or reparsed (which invalidates it), it must be parsed from scratch
+        if( !m_translationUnit ||
+            ( clang_reparseTranslationUnit( m_translationUnit->tu, ( m_hasInputContents ? 1 : 0 ),
+                                            ( m_hasInputContents ? &inputFile : nullptr ),
+                                            clang_defaultReparseOptions( m_translationUnit->tu ) ) != 0 ) )
+        {
+            m_translationUnit.reset();
+            if( !CreateTranslationUnit( error ) )
+            {
+                return false;
+            }
+        }
+    }
+
+    m_statistics.parseDuration = std::chrono::steady_clock::now() - parseStart;
+
+    return ProcessTranslationUnit( config, symbols, emittedFunctions, error );
+}
+
+std::vector<std::string> Parser::GetDependencies() const
+{
+    return m_dependencies;
+}
+
+const Parser::Statistics& Parser::GetStatistics() const
+{
+    return m_statistics;
+}
+
+bool Parser::IsSkipped() const
+{
+    return m_skipped;
+}
+
+bool Parser::CreateTranslationUnit( std::ostream &error )
+{
+    TraceSpan span( "parse" );
+    span.AddArgument( "file", m_inputFilepath );
+
+    m_functions.clear();
+    m_functionIds.clear();
+    m_statistics = Statistics();
+    m_skipped = false;
+    m_dependencies.assign( 1, m_inputFilepath );
+
+    CXIndex index = clang_createIndex( 0, 0 );
+
+    std::vector<const char*> clangOpts;
+    for( const std::string &clangOpt : m_clangOpts )
+    {
+        clangOpts.push_back( clangOpt.c_str() );
+    }
+
+    // When the translation unit is going to be reparsed, the headers included at the beginning of the input file are
+    // precompiled, so that they are only parsed again if they change
+    unsigned int tuOptions = m_reparseEnabled ? CXTranslationUnit_PrecompiledPreamble : CXTranslationUnit_None;
+
+    // In single file mode the included files are not expanded, and the parse keeps going after errors (which are
+    // expected due to the declarations missing from the included files)
+    if( m_singleFileParse )
+    {
+        tuOptions |= CXTranslationUnit_SingleFileParse | CXTranslationUnit_KeepGoing;
+    }
+
+    CXUnsavedFile inputFile = { m_inputFilepath.c_str(), m_inputContents.data(), (unsigned long) m_inputContents.size() };
+
+    std::chrono::steady_clock::time_point parseStart = std::chrono::steady_clock::now();
+
+    CXTranslationUnit tu;
+    // Note: Use of CXTranslationUnit_SkipFunctionBodies is not allowed, otherwise libclang
+    // will not detect properly methods defined inline (which must not be mocked).
+    CXErrorCode tuError = clang_parseTranslationUnit2( index, m_inputFilepath.c_str(),
+                                                       clangOpts.data(), (int) clangOpts.size(),
+                                                       ( m_hasInputContents ? &inputFile : nullptr ),
+                                                       ( m_hasInputContents ? 1 : 0 ),
+                                                       tuOptions,
+                                                       &tu );
+
+    m_statistics.parseDuration = std::chrono::steady_clock::now() - parseStart;
+    if( tuError != CXError_Success )
+    {
+        cerrColorizer.SetColor( ConsoleColorizer::Color::LIGHT_RED );
+        error << "INPUT ERROR: ";
+        cerrColorizer.SetColor( ConsoleColorizer::Color::RESET );
+
+        // Check if file exists
+        std::ifstream inputFileStream( m_inputFilepath.c_str() );
+        if( !m_hasInputContents && !inputFileStream.good() )
+        {
+            error << "Input file '" << m_inputFilepath.c_str() << "' does not exist." << std::endl;
+        }
+// LCOV_EXCL_START
+        else
+        {
+            error << "Unable to parse input file (Error code = " << tuError << ")." << std::endl;
+        }
+// LCOV_EXCL_STOP
+
+        clang_disposeIndex( index );
+        return false;
+    }
+
+    m_translationUnit.reset( new TranslationUnit{ index, tu } );
+
+    return true;
+}
+
+bool Parser::ProcessTranslationUnit( const Config &config, const std::vector<std::string> &symbols,
+                                     EmittedFunctions &emittedFunctions, std::ostream &error )
+{
+    CXTranslationUnit tu = m_translationUnit->tu;
+
+    m_functions.clear();
+    m_functionIds.clear();
+    m_symbolsListed = !symbols.empty();
+    m_skipped = false;
+    m_statistics.modelDuration = std::chrono::nanoseconds( 0 );
+
+    std::chrono::steady_clock::time_point modelStart = std::chrono::steady_clock::now();
+
+    unsigned int numErrors = ReportDiagnostics( tu, m_singleFileParse, error );
+    ParseTarget target = { m_inputFilepath, m_functions, m_functionIds, 0 };
+    if( numErrors == 0 )
+    {
+        std::unordered_set<std::string> selectedSymbols( symbols.begin(), symbols.end() );
+
+        ParseTargetMap targets;
+        AddParseTarget( tu, m_inputFilepath, target, targets );
+
+        TraceSpan span( "traversal" );
+        span.AddArgument( "file", m_inputFilepath );
+
+        ::Parse( tu, config, selectedSymbols, emittedFunctions, error, targets );
+
+        span.AddArgument( "functions", m_functions.size() );
+
+        // An input file whose functions have all been mocked already for other input files is not an error
+        if( ( m_functions.size() == 0 ) && ( target.duplicateCount == 0 ) )
+        {
+            ReportNoMockableFunctions( error );
+        }
+    }
+
+    m_statistics.modelDuration = std::chrono::steady_clock::now() - modelStart;
+
+    // Memory used by the translation unit, which is used to schedule the parsing of input files in later runs
+    CollectMemoryUsage( tu, m_statistics );
+    m_statistics.functionCount = m_functions.size();
+
+    if( m_reparseEnabled || m_dependencyTrackingEnabled )
+    {
+        // Files included by the input file, excluding system headers which are not expected to change
+        struct InclusionData
+        {
+            CXTranslationUnit tu;
+            std::set<std::string> dependencies;
+        } inclusionData = { tu, {} };
+
+        clang_getInclusions(
+            tu,
+            []( CXFile includedFile, CXSourceLocation*, unsigned int includeLen, CXClientData clientData )
+            {
+                InclusionData *inclusionData = (InclusionData*) clientData;
+                if( ( includeLen > 0 ) &&
+                    ( clang_Location_isInSystemHeader( clang_getLocationForOffset( inclusionData->tu, includedFile, 0 ) ) == 0 ) )
+                {
+                    inclusionData->dependencies.insert( toString( clang_getFileName( includedFile ) ) );
+                }
+            },
+            (CXClientData) &inclusionData );
+
+        m_dependencies.assign( 1, m_inputFilepath );
+        m_dependencies.insert( m_dependencies.end(), inclusionData.dependencies.begin(), inclusionData.dependencies.end() );
+    }
+
+    if( !m_reparseEnabled )
+    {
+        m_translationUnit.reset();
+    }
+
+    return (numErrors == 0) && ( (m_functions.size() > 0) || (target.duplicateCount > 0) );
 }
 
-void Parser::GenerateMock( const std::string &genOpts, std::ostream &output ) const
+bool Parser::RemoveEmittedFunctions( EmittedFunctions &emittedFunctions, std::ostream &error )
 {
+    unsigned int duplicateCount = 0;
+
+    for( size_t i = 0; i < m_functions.size(); )
+    {
+        const std::string &usr = m_functionIds[i].first;
+
+        EmittedFunctions::const_iterator it = emittedFunctions.find( usr );
+        if( usr.empty() || ( it == emittedFunctions.end() ) )
+        {
+            if( !usr.empty() )
+            {
+                emittedFunctions[usr] = m_inputFilepath;
+            }
+            i++;
+            continue;
+        }
+
+        if( it->second != m_inputFilepath )
+        {
+            duplicateCount++;
+
+            cerrColorizer.SetColor( ConsoleColorizer::Color::YELLOW );
+            error << "INPUT WARNING: ";
+            cerrColorizer.SetColor( ConsoleColorizer::Color::RESET );
+            error << "Function '" << m_functionIds[i].second << "' declared in '" << m_inputFilepath <<
+                     "' has already been mocked for '" << it->second << "'." << std::endl;
+        }
+
+        m_functions.erase( m_functions.begin() + i );
+        m_functionIds.erase( m_functionIds.begin() + i );
+    }
+
+    m_statistics.functionCount = m_functions.size();
+
+    if( ( m_functions.size() == 0 ) && ( duplicateCount == 0 ) )
+    {
+        ReportNoMockableFunctions( error );
+        return false;
+    }
+
+    return true;
+}
+
+void Parser::GenerateMock( const std::string &genOpts, bool profiling, bool recordReplay, std::ostream &output ) const
+{
+    // Record & replay relies on wrapping the real functions with the linker, which is only supported for C functions
+    recordReplay = recordReplay && !m_interpretAsCpp;
+
     GenerateFileHeading( genOpts, output );
 
     if( !m_interpretAsCpp )
     {
         output << "extern \"C\" {" << std::endl;
     }
-    output << "#include \"" <<  GetFilenameFromPath( m_inputFilepath ) << "\"" << std::endl;
+    output << "#include \"" <<  GetIncludePath() << "\"" << std::endl;
     if( !m_interpretAsCpp )
     {
         output << "}" << std::endl;
@@ -212,13 +882,23 @@ void Parser::GenerateMock( const std::string &genOpts, std::ostream &output ) co
     output << "#include <CppUTestExt/MockSupport.h>" << std::endl;
     output << std::endl;
 
+    if( profiling )
+    {
+        GenerateProfilingSupport( output );
+    }
+
+    if( recordReplay )
+    {
+        GenerateTraceSupport( output );
+    }
+
     for( const std::unique_ptr<const Function> &function : m_functions )
     {
-        output << function->GenerateMock() << std::endl;
+        output << function->GenerateMock( profiling, recordReplay ) << std::endl;
     }
 }
 
-void Parser::GenerateExpectationHeader( const std::string &genOpts, std::ostream &output ) const
+void Parser::GenerateExpectationHeader( const std::string &genOpts, bool podComparators, std::ostream &output ) const
 {
     GenerateFileHeading( genOpts, output );
 
@@ -226,7 +906,7 @@ void Parser::GenerateExpectationHeader( const std::string &genOpts, std::ostream
     {
         output << "extern \"C\" {" << std::endl;
     }
-    output << "#include \"" <<  GetFilenameFromPath( m_inputFilepath ) << "\"" << std::endl;
+    output << "#include \"" <<  GetIncludePath() << "\"" << std::endl;
     if( !m_interpretAsCpp )
     {
         output << "}" << std::endl;
@@ -235,11 +915,20 @@ void Parser::GenerateExpectationHeader( const std::string &genOpts, std::ostream
 
     for( const std::unique_ptr<const Function> &function : m_functions )
     {
-        output << function->GenerateExpectation(true) << std::endl;
+        output << function->GenerateExpectation( true, false ) << std::endl;
+    }
+
+    if( podComparators )
+    {
+        output << "namespace expect {" << std::endl;
+        output << "void " << GetPodComparatorsInstallerName() << "();" << std::endl;
+        output << "}" << std::endl;
+        output << std::endl;
     }
 }
 
-void Parser::GenerateExpectationImpl( const std::string &genOpts, const std::string &headerFilepath, std::ostream &output ) const
+void Parser::GenerateExpectationImpl( const std::string &genOpts, const std::string &headerFilepath, bool profiling,
+                                      bool podComparators, std::ostream &output ) const
 {
     GenerateFileHeading( genOpts, output );
 
@@ -248,9 +937,37 @@ void Parser::GenerateExpectationImpl( const std::string &genOpts, const std::str
     output << "#include \"" <<  GetFilenameFromPath( headerFilepath ) << "\"" << std::endl;
     output << std::endl;
 
+    if( profiling )
+    {
+        GenerateProfilingSupport( output );
+    }
+
     for( const std::unique_ptr<const Function> &function : m_functions )
     {
-        output << function->GenerateExpectation(false) << std::endl;
+        output << function->GenerateExpectation( false, profiling ) << std::endl;
+    }
+
+    if( podComparators )
+    {
+        GeneratePodComparators( output );
+    }
+}
+
+void Parser::UpdateFingerprints( FingerprintStore &fingerprints, const std::string &genOpts, bool profiling,
+                                 bool recordReplay ) const
+{
+    fingerprints.AddInput( m_inputFilepath, m_statistics.memoryUsage );
+
+    recordReplay = recordReplay && !m_interpretAsCpp;
+
+    for( size_t i = 0; i < m_functions.size(); i++ )
+    {
+        // The generated code reflects the function signature, the resolved mocked types and the applied overrides
+        std::string generatedCode = genOpts + "\n" + m_functions[i]->GenerateMock( profiling, recordReplay ) +
+                                    m_functions[i]->GenerateExpectation( true, false ) +
+                                    m_functions[i]->GenerateExpectation( false, profiling );
+
+        fingerprints.Update( m_inputFilepath, m_functionIds[i].first, m_functionIds[i].second, generatedCode );
     }
 }
 
@@ -268,3 +985,463 @@ void Parser::GenerateFileHeading( const std::string &genOpts, std::ostream &outp
     output << " */" << std::endl;
     output << std::endl;
 }
+
+void Parser::GenerateProfilingSupport( std::ostream &output ) const
+{
+    // The support code is defined using inline functions, so that all the generated mocks and expectations
+    // linked into the same executable share a single profiling table.
+    output << "#include <chrono>" << std::endl;
+    output << "#include <cstdio>" << std::endl;
+    output << "#include <cstdlib>" << std::endl;
+    output << "#include <cstring>" << std::endl;
+    output << std::endl;
+    output << "#ifndef CPPUMOCKGEN_PROFILING_SUPPORT_" << std::endl;
+    output << "#define CPPUMOCKGEN_PROFILING_SUPPORT_" << std::endl;
+    output << std::endl;
+    output << "namespace cppumockgen { namespace profiling {" << std::endl;
+    output << std::endl;
+    output << "enum class Format { CSV, JSON };" << std::endl;
+    output << std::endl;
+    output << "struct Entry;" << std::endl;
+    output << std::endl;
+    output << "inline Entry*& Head()" << std::endl;
+    output << "{" << std::endl;
+    output << "    static Entry *head = nullptr;" << std::endl;
+    output << "    return head;" << std::endl;
+    output << "}" << std::endl;
+    output << std::endl;
+    output << "inline void DumpAtExit();" << std::endl;
+    output << std::endl;
+    output << "struct Entry" << std::endl;
+    output << "{" << std::endl;
+    output << "    Entry( const char *name_, const char *kind_ )" << std::endl;
+    output << "    : name( name_ ), kind( kind_ ), calls( 0 ), nanoseconds( 0 ), next( Head() )" << std::endl;
+    output << "    {" << std::endl;
+    output << "        if( Head() == nullptr )" << std::endl;
+    output << "        {" << std::endl;
+    output << "            std::atexit( DumpAtExit );" << std::endl;
+    output << "        }" << std::endl;
+    output << "        Head() = this;" << std::endl;
+    output << "    }" << std::endl;
+    output << std::endl;
+    output << "    const char *name;" << std::endl;
+    output << "    const char *kind;" << std::endl;
+    output << "    unsigned long calls;" << std::endl;
+    output << "    unsigned long long nanoseconds;" << std::endl;
+    output << "    Entry *next;" << std::endl;
+    output << "};" << std::endl;
+    output << std::endl;
+    output << "class Scope" << std::endl;
+    output << "{" << std::endl;
+    output << "public:" << std::endl;
+    output << "    explicit Scope( Entry &entry )" << std::endl;
+    output << "    : m_entry( entry ), m_start( std::chrono::steady_clock::now() )" << std::endl;
+    output << "    {}" << std::endl;
+    output << std::endl;
+    output << "    ~Scope()" << std::endl;
+    output << "    {" << std::endl;
+    output << "        m_entry.calls++;" << std::endl;
+    output << "        m_entry.nanoseconds += static_cast<unsigned long long>(" << std::endl;
+    output << "            std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - m_start ).count() );" << std::endl;
+    output << "    }" << std::endl;
+    output << std::endl;
+    output << "private:" << std::endl;
+    output << "    Entry &m_entry;" << std::endl;
+    output << "    std::chrono::steady_clock::time_point m_start;" << std::endl;
+    output << "};" << std::endl;
+    output << std::endl;
+    output << "inline void Dump( std::FILE *file, Format format )" << std::endl;
+    output << "{" << std::endl;
+    output << "    if( format == Format::JSON )" << std::endl;
+    output << "    {" << std::endl;
+    output << "        std::fprintf( file, \"[\\n\" );" << std::endl;
+    output << "    }" << std::endl;
+    output << "    else" << std::endl;
+    output << "    {" << std::endl;
+    output << "        std::fprintf( file, \"kind,function,calls,total_ns\\n\" );" << std::endl;
+    output << "    }" << std::endl;
+    output << "    for( const Entry *entry = Head(); entry != nullptr; entry = entry->next )" << std::endl;
+    output << "    {" << std::endl;
+    output << "        if( format == Format::JSON )" << std::endl;
+    output << "        {" << std::endl;
+    output << "            std::fprintf( file, \"  { \\\"kind\\\": \\\"%s\\\", \\\"function\\\": \\\"%s\\\", \\\"calls\\\": %lu, \\\"total_ns\\\": %llu }%s\\n\"," << std::endl;
+    output << "                          entry->kind, entry->name, entry->calls, entry->nanoseconds, ( entry->next ? \",\" : \"\" ) );" << std::endl;
+    output << "        }" << std::endl;
+    output << "        else" << std::endl;
+    output << "        {" << std::endl;
+    output << "            std::fprintf( file, \"%s,%s,%lu,%llu\\n\", entry->kind, entry->name, entry->calls, entry->nanoseconds );" << std::endl;
+    output << "        }" << std::endl;
+    output << "    }" << std::endl;
+    output << "    if( format == Format::JSON )" << std::endl;
+    output << "    {" << std::endl;
+    output << "        std::fprintf( file, \"]\\n\" );" << std::endl;
+    output << "    }" << std::endl;
+    output << "}" << std::endl;
+    output << std::endl;
+    output << "inline void DumpAtExit()" << std::endl;
+    output << "{" << std::endl;
+    output << "    const char *path = std::getenv( \"CPPUMOCKGEN_PROFILE_OUTPUT\" );" << std::endl;
+    output << "    if( path != nullptr )" << std::endl;
+    output << "    {" << std::endl;
+    output << "        std::FILE *file = std::fopen( path, \"w\" );" << std::endl;
+    output << "        if( file != nullptr )" << std::endl;
+    output << "        {" << std::endl;
+    output << "            size_t pathLength = std::strlen( path );" << std::endl;
+    output << "            bool isJson = ( pathLength >= 5 ) && ( std::strcmp( path + pathLength - 5, \".json\" ) == 0 );" << std::endl;
+    output << "            Dump( file, isJson ? Format::JSON : Format::CSV );" << std::endl;
+    output << "            std::fclose( file );" << std::endl;
+    output << "        }" << std::endl;
+    output << "    }" << std::endl;
+    output << "}" << std::endl;
+    output << std::endl;
+    output << "} }" << std::endl;
+    output << std::endl;
+    output << "#endif // CPPUMOCKGEN_PROFILING_SUPPORT_" << std::endl;
+    output << std::endl;
+}
+
+std::string Parser::GetIncludePath() const
+{
+    return m_includePath.empty() ? GetFilenameFromPath( m_inputFilepath ) : m_includePath;
+}
+
+std::string Parser::GetPodComparatorsInstallerName() const
+{
+    // The directories of the include path are kept, so that headers with the same filename get different installers
+    std::string includePath = GetIncludePath();
+    size_t dirLength = includePath.find_last_of( '/' ) + 1;
+    std::string name = "InstallPodComparatorsAndCopiers_" + includePath.substr( 0, dirLength ) +
+                       RemoveFilenameExtension( includePath.substr( dirLength ) );
+
+    for( char &c : name )
+    {
+        if( !std::isalnum( static_cast<unsigned char>( c ) ) )
+        {
+            c = '_';
+        }
+    }
+
+    return name;
+}
+
+void Parser::GenerateTraceSupport( std::ostream &output ) const
+{
+    // The support code is defined using inline functions, so that all the generated mocks linked into the same
+    // executable share a single trace, in which calls to the different functions are interleaved in call order.
+    output << "#include <cstdio>" << std::endl;
+    output << "#include <cstdlib>" << std::endl;
+    output << "#include <cstring>" << std::endl;
+    output << "#include <string>" << std::endl;
+    output << "#include <CppUTest/TestHarness.h>" << std::endl;
+    output << "#if !defined(CPPUMOCKGEN_RECORD) && !defined(_WIN32)" << std::endl;
+    output << "#include <fcntl.h>" << std::endl;
+    output << "#include <sys/mman.h>" << std::endl;
+    output << "#include <sys/stat.h>" << std::endl;
+    output << "#include <unistd.h>" << std::endl;
+    output << "#endif" << std::endl;
+    output << std::endl;
+    output << "#ifndef CPPUMOCKGEN_TRACE_SUPPORT_" << std::endl;
+    output << "#define CPPUMOCKGEN_TRACE_SUPPORT_" << std::endl;
+    output << std::endl;
+    output << "// Trace layout: \"CMGT\" magic, followed by one record per call made of a 32-bit function identifier, a 32-bit" << std::endl;
+    output << "// payload size and the payload (raw values of the arguments followed by the raw return value)." << std::endl;
+    output << "namespace cppumockgen { namespace trace {" << std::endl;
+    output << std::endl;
+    output << "#ifdef CPPUMOCKGEN_RECORD" << std::endl;
+    output << std::endl;
+    output << "inline std::FILE*& RecordFile()" << std::endl;
+    output << "{" << std::endl;
+    output << "    static std::FILE *file = nullptr;" << std::endl;
+    output << "    return file;" << std::endl;
+    output << "}" << std::endl;
+    output << std::endl;
+    output << "inline void CloseRecordFile()" << std::endl;
+    output << "{" << std::endl;
+    output << "    if( RecordFile() != nullptr )" << std::endl;
+    output << "    {" << std::endl;
+    output << "        std::fclose( RecordFile() );" << std::endl;
+    output << "        RecordFile() = nullptr;" << std::endl;
+    output << "    }" << std::endl;
+    output << "}" << std::endl;
+    output << std::endl;
+    output << "inline std::FILE* OpenRecordFile()" << std::endl;
+    output << "{" << std::endl;
+    output << "    if( RecordFile() == nullptr )" << std::endl;
+    output << "    {" << std::endl;
+    output << "        const char *path = std::getenv( \"CPPUMOCKGEN_TRACE\" );" << std::endl;
+    output << "        RecordFile() = std::fopen( ( path != nullptr ) ? path : \"cppumockgen.trace\", \"wb\" );" << std::endl;
+    output << "        if( RecordFile() != nullptr )" << std::endl;
+    output << "        {" << std::endl;
+    output << "            std::fwrite( \"CMGT\", 1, 4, RecordFile() );" << std::endl;
+    output << "            std::atexit( CloseRecordFile );" << std::endl;
+    output << "        }" << std::endl;
+    output << "    }" << std::endl;
+    output << "    return RecordFile();" << std::endl;
+    output << "}" << std::endl;
+    output << std::endl;
+    output << "class Record" << std::endl;
+    output << "{" << std::endl;
+    output << "public:" << std::endl;
+    output << "    explicit Record( unsigned int id ) : m_id( id ) {}" << std::endl;
+    output << std::endl;
+    output << "    template<typename T>" << std::endl;
+    output << "    void Put( T value )" << std::endl;
+    output << "    {" << std::endl;
+    output << "        m_payload.append( reinterpret_cast<const char*>( &value ), sizeof(T) );" << std::endl;
+    output << "    }" << std::endl;
+    output << std::endl;
+    output << "    void Commit()" << std::endl;
+    output << "    {" << std::endl;
+    output << "        std::FILE *file = OpenRecordFile();" << std::endl;
+    output << "        if( file != nullptr )" << std::endl;
+    output << "        {" << std::endl;
+    output << "            unsigned int header[2] = { m_id, static_cast<unsigned int>( m_payload.size() ) };" << std::endl;
+    output << "            std::fwrite( header, sizeof(header), 1, file );" << std::endl;
+    output << "            std::fwrite( m_payload.data(), 1, m_payload.size(), file );" << std::endl;
+    output << "        }" << std::endl;
+    output << "    }" << std::endl;
+    output << std::endl;
+    output << "private:" << std::endl;
+    output << "    unsigned int m_id;" << std::endl;
+    output << "    std::string m_payload;" << std::endl;
+    output << "};" << std::endl;
+    output << std::endl;
+    output << "#else // CPPUMOCKGEN_RECORD" << std::endl;
+    output << std::endl;
+    output << "struct Mapping" << std::endl;
+    output << "{" << std::endl;
+    output << "    const unsigned char *data;" << std::endl;
+    output << "    size_t size;" << std::endl;
+    output << "    size_t position;" << std::endl;
+    output << "    bool initialized;" << std::endl;
+    output << "};" << std::endl;
+    output << std::endl;
+    output << "inline Mapping& GetMapping()" << std::endl;
+    output << "{" << std::endl;
+    output << "    static Mapping mapping = { nullptr, 0, 0, false };" << std::endl;
+    output << "    return mapping;" << std::endl;
+    output << "}" << std::endl;
+    output << std::endl;
+    output << "inline void StopReplay()" << std::endl;
+    output << "{" << std::endl;
+    output << "    Mapping &mapping = GetMapping();" << std::endl;
+    output << "    if( mapping.data != nullptr )" << std::endl;
+    output << "    {" << std::endl;
+    output << "#ifdef _WIN32" << std::endl;
+    output << "        std::free( const_cast<unsigned char*>( mapping.data ) );" << std::endl;
+    output << "#else" << std::endl;
+    output << "        munmap( const_cast<unsigned char*>( mapping.data ), mapping.size );" << std::endl;
+    output << "#endif" << std::endl;
+    output << "    }" << std::endl;
+    output << "    mapping.data = nullptr;" << std::endl;
+    output << "    mapping.size = 0;" << std::endl;
+    output << "    mapping.position = 0;" << std::endl;
+    output << "    mapping.initialized = true;" << std::endl;
+    output << "}" << std::endl;
+    output << std::endl;
+    output << "inline bool StartReplay( const char *path )" << std::endl;
+    output << "{" << std::endl;
+    output << "    StopReplay();" << std::endl;
+    output << "    Mapping &mapping = GetMapping();" << std::endl;
+    output << "#ifdef _WIN32" << std::endl;
+    output << "    std::FILE *file = std::fopen( path, \"rb\" );" << std::endl;
+    output << "    if( file == nullptr )" << std::endl;
+    output << "    {" << std::endl;
+    output << "        return false;" << std::endl;
+    output << "    }" << std::endl;
+    output << "    std::fseek( file, 0, SEEK_END );" << std::endl;
+    output << "    long size = std::ftell( file );" << std::endl;
+    output << "    std::fseek( file, 0, SEEK_SET );" << std::endl;
+    output << "    unsigned char *data = static_cast<unsigned char*>( std::malloc( ( size > 0 ) ? size : 1 ) );" << std::endl;
+    output << "    if( ( size < 4 ) || ( std::fread( data, 1, size, file ) != static_cast<size_t>( size ) ) )" << std::endl;
+    output << "    {" << std::endl;
+    output << "        std::free( data );" << std::endl;
+    output << "        std::fclose( file );" << std::endl;
+    output << "        return false;" << std::endl;
+    output << "    }" << std::endl;
+    output << "    std::fclose( file );" << std::endl;
+    output << "#else" << std::endl;
+    output << "    int fd = open( path, O_RDONLY );" << std::endl;
+    output << "    if( fd < 0 )" << std::endl;
+    output << "    {" << std::endl;
+    output << "        return false;" << std::endl;
+    output << "    }" << std::endl;
+    output << "    struct stat fileStat;" << std::endl;
+    output << "    if( ( fstat( fd, &fileStat ) != 0 ) || ( fileStat.st_size < 4 ) )" << std::endl;
+    output << "    {" << std::endl;
+    output << "        close( fd );" << std::endl;
+    output << "        return false;" << std::endl;
+    output << "    }" << std::endl;
+    output << "    size_t size = static_cast<size_t>( fileStat.st_size );" << std::endl;
+    output << "    void *data = mmap( nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0 );" << std::endl;
+    output << "    close( fd );" << std::endl;
+    output << "    if( data == MAP_FAILED )" << std::endl;
+    output << "    {" << std::endl;
+    output << "        return false;" << std::endl;
+    output << "    }" << std::endl;
+    output << "#endif" << std::endl;
+    output << "    mapping.data = static_cast<const unsigned char*>( data );" << std::endl;
+    output << "    mapping.size = size;" << std::endl;
+    output << "    mapping.position = 4;" << std::endl;
+    output << "    if( std::memcmp( mapping.data, \"CMGT\", 4 ) != 0 )" << std::endl;
+    output << "    {" << std::endl;
+    output << "        StopReplay();" << std::endl;
+    output << "        return false;" << std::endl;
+    output << "    }" << std::endl;
+    output << "    return true;" << std::endl;
+    output << "}" << std::endl;
+    output << std::endl;
+    output << "inline bool Replaying()" << std::endl;
+    output << "{" << std::endl;
+    output << "    Mapping &mapping = GetMapping();" << std::endl;
+    output << "    if( !mapping.initialized )" << std::endl;
+    output << "    {" << std::endl;
+    output << "        mapping.initialized = true;" << std::endl;
+    output << "        const char *path = std::getenv( \"CPPUMOCKGEN_TRACE\" );" << std::endl;
+    output << "        if( path != nullptr )" << std::endl;
+    output << "        {" << std::endl;
+    output << "            StartReplay( path );" << std::endl;
+    output << "        }" << std::endl;
+    output << "    }" << std::endl;
+    output << "    return ( mapping.data != nullptr );" << std::endl;
+    output << "}" << std::endl;
+    output << std::endl;
+    output << "class Cursor" << std::endl;
+    output << "{" << std::endl;
+    output << "public:" << std::endl;
+    output << "    Cursor( unsigned int id, const char *name, size_t size )" << std::endl;
+    output << "    : m_name( name ), m_payload( nullptr )" << std::endl;
+    output << "    {" << std::endl;
+    output << "        Mapping &mapping = GetMapping();" << std::endl;
+    output << "        unsigned int header[2];" << std::endl;
+    output << "        if( ( mapping.size - mapping.position ) < sizeof(header) )" << std::endl;
+    output << "        {" << std::endl;
+    output << "            Fail( \"no more calls are recorded in the trace\" );" << std::endl;
+    output << "            return;" << std::endl;
+    output << "        }" << std::endl;
+    output << "        std::memcpy( header, mapping.data + mapping.position, sizeof(header) );" << std::endl;
+    output << "        if( ( header[0] != id ) || ( header[1] != size ) )" << std::endl;
+    output << "        {" << std::endl;
+    output << "            Fail( \"the next call recorded in the trace is for a different function\" );" << std::endl;
+    output << "            return;" << std::endl;
+    output << "        }" << std::endl;
+    output << "        if( ( mapping.size - mapping.position - sizeof(header) ) < size )" << std::endl;
+    output << "        {" << std::endl;
+    output << "            Fail( \"the trace is truncated\" );" << std::endl;
+    output << "            return;" << std::endl;
+    output << "        }" << std::endl;
+    output << "        m_payload = mapping.data + mapping.position + sizeof(header);" << std::endl;
+    output << "        mapping.position += sizeof(header) + size;" << std::endl;
+    output << "    }" << std::endl;
+    output << std::endl;
+    output << "    template<typename T>" << std::endl;
+    output << "    void Check( const char *argName, T value )" << std::endl;
+    output << "    {" << std::endl;
+    output << "        if( ( m_payload != nullptr ) && ( std::memcmp( m_payload, &value, sizeof(T) ) != 0 ) )" << std::endl;
+    output << "        {" << std::endl;
+    output << "            Fail( ( std::string( \"argument '\" ) + argName + \"' differs from the recorded value\" ).c_str() );" << std::endl;
+    output << "        }" << std::endl;
+    output << "        Skip( sizeof(T) );" << std::endl;
+    output << "    }" << std::endl;
+    output << std::endl;
+    output << "    template<typename T>" << std::endl;
+    output << "    T Get()" << std::endl;
+    output << "    {" << std::endl;
+    output << "        T value = T();" << std::endl;
+    output << "        if( m_payload != nullptr )" << std::endl;
+    output << "        {" << std::endl;
+    output << "            std::memcpy( &value, m_payload, sizeof(T) );" << std::endl;
+    output << "        }" << std::endl;
+    output << "        Skip( sizeof(T) );" << std::endl;
+    output << "        return value;" << std::endl;
+    output << "    }" << std::endl;
+    output << std::endl;
+    output << "private:" << std::endl;
+    output << "    void Skip( size_t size )" << std::endl;
+    output << "    {" << std::endl;
+    output << "        if( m_payload != nullptr )" << std::endl;
+    output << "        {" << std::endl;
+    output << "            m_payload += size;" << std::endl;
+    output << "        }" << std::endl;
+    output << "    }" << std::endl;
+    output << std::endl;
+    output << "    void Fail( const char *reason )" << std::endl;
+    output << "    {" << std::endl;
+    output << "        m_payload = nullptr;" << std::endl;
+    output << "        std::string message = std::string( \"Replay of call to '\" ) + m_name + \"' failed: \" + reason;" << std::endl;
+    output << "        FAIL( message.c_str() );" << std::endl;
+    output << "    }" << std::endl;
+    output << std::endl;
+    output << "    const char *m_name;" << std::endl;
+    output << "    const unsigned char *m_payload;" << std::endl;
+    output << "};" << std::endl;
+    output << std::endl;
+    output << "#endif // CPPUMOCKGEN_RECORD" << std::endl;
+    output << std::endl;
+    output << "} }" << std::endl;
+    output << std::endl;
+    output << "#endif // CPPUMOCKGEN_TRACE_SUPPORT_" << std::endl;
+    output << std::endl;
+}
+
+void Parser::GeneratePodComparators( std::ostream &output ) const
+{
+    std::set<std::string> podTypes;
+    for( const std::unique_ptr<const Function> &function : m_functions )
+    {
+        function->GetPodRecordTypes( podTypes );
+    }
+
+    // Comparators only build the string representation of the values when CppUMock reports a failure
+    output << "#include <cstring>" << std::endl;
+    output << std::endl;
+    output << "#ifndef CPPUMOCKGEN_POD_COMPARATORS_SUPPORT_" << std::endl;
+    output << "#define CPPUMOCKGEN_POD_COMPARATORS_SUPPORT_" << std::endl;
+    output << std::endl;
+    output << "namespace {" << std::endl;
+    output << std::endl;
+    output << "template<typename T>" << std::endl;
+    output << "class PodComparator : public MockNamedValueComparator" << std::endl;
+    output << "{" << std::endl;
+    output << "public:" << std::endl;
+    output << "    virtual bool isEqual( const void* object1, const void* object2 ) override" << std::endl;
+    output << "    {" << std::endl;
+    output << "        return std::memcmp( object1, object2, sizeof(T) ) == 0;" << std::endl;
+    output << "    }" << std::endl;
+    output << std::endl;
+    output << "    virtual SimpleString valueToString( const void* object ) override" << std::endl;
+    output << "    {" << std::endl;
+    output << "        return StringFromBinaryWithSize( static_cast<const unsigned char*>( object ), sizeof(T) );" << std::endl;
+    output << "    }" << std::endl;
+    output << "};" << std::endl;
+    output << std::endl;
+    output << "template<typename T>" << std::endl;
+    output << "class PodCopier : public MockNamedValueCopier" << std::endl;
+    output << "{" << std::endl;
+    output << "public:" << std::endl;
+    output << "    virtual void copy( void* out, const void* in ) override" << std::endl;
+    output << "    {" << std::endl;
+    output << "        std::memcpy( out, in, sizeof(T) );" << std::endl;
+    output << "    }" << std::endl;
+    output << "};" << std::endl;
+    output << std::endl;
+    output << "}" << std::endl;
+    output << std::endl;
+    output << "#endif // CPPUMOCKGEN_POD_COMPARATORS_SUPPORT_" << std::endl;
+    output << std::endl;
+    output << "namespace expect {" << std::endl;
+    output << "void " << GetPodComparatorsInstallerName() << "()" << std::endl;
+    output << "{" << std::endl;
+    for( const std::string &podType : podTypes )
+    {
+        output << "    {" << std::endl;
+        output << "        static PodComparator<" << podType << "> comparator;" << std::endl;
+        output << "        static PodCopier<" << podType << "> copier;" << std::endl;
+        output << "        mock().installComparator( \"" << podType << "\", comparator );" << std::endl;
+        output << "        mock().installCopier( \"" << podType << "\", copier );" << std::endl;
+        output << "    }" << std::endl;
+    }
+    output << "}" << std::endl;
+    output << "}" << std::endl;
+    output << std::endl;
+}
@@ -2,17 +2,42 @@
 #define CPPUMOCKGEN_MOCKGENERATOR_HPP_
 
 #include <vector>
+#include <map>
 #include <string>
 #include <sstream>
 #include <memory>
+#include <cstdint>
+#include <chrono>
 
 #include "Function.hpp"
 
 class Config;
+class FingerprintStore;
 
 class Parser
 {
 public:
+    /**
+     * Table of the functions already mocked during a run, indexed by their USR (Unified Symbol Resolution),
+     * holding the path of the input file for which each one was mocked.
+     */
+    typedef std::map<std::string, std::string> EmittedFunctions;
+
+    /**
+     * Statistics of the last parse of the input file.
+     */
+    struct Statistics
+    {
+        std::chrono::nanoseconds parseDuration{ 0 };  ///< Time spent by libclang parsing the translation unit
+        std::chrono::nanoseconds modelDuration{ 0 };  ///< Time spent building the mocked functions from it
+        uint64_t memoryUsage = 0;                     ///< Memory used by libclang for the translation unit, in bytes
+        uint64_t astMemoryUsage = 0;                  ///< Part of the memory used by the AST
+        uint64_t identifiersMemoryUsage = 0;          ///< Part of the memory used by the identifier and selector tables
+        uint64_t preprocessorMemoryUsage = 0;         ///< Part of the memory used by the preprocessor and header search
+        uint64_t sourceManagerMemoryUsage = 0;        ///< Part of the memory used by the source manager and file buffers
+        size_t functionCount = 0;                     ///< Number of functions to be mocked
+    };
+
     /**
      * Parses the C/C++ header located in @p inputFilename.
      *
@@ -21,44 +46,217 @@ public:
      * @param interpretAsCpp [in] Forces interpreting the header file as C++
      * @param includePaths [in] List of paths to search for included header files
      * @param preprocessorDefines [in] List of preprocessor macro definitions
+     * @param symbols [in] List of (mangled) symbol names of the functions to be mocked, or empty to mock all functions
+     * @param emittedFunctions [in/out] Functions already mocked for other input files, which will be skipped and
+     *                                  reported as duplicates; the functions parsed from this file are added to it
      * @param error [out] Stream where errors will be written
      * @return @c true if the input file could be parsed successfully, @c false otherwise
      */
     bool Parse( const std::string &inputFilepath, const Config &config, bool interpretAsCpp, bool useCpp11,
                 const std::vector<std::string> &includePaths, const std::vector<std::string> &includeFiles, 
-                std::ostream &error );
+                const std::vector<std::string> &symbols, EmittedFunctions &emittedFunctions, std::ostream &error );
+
+    /**
+     * Parses several C/C++ headers at once, in a single translation unit that includes all of them, so that the files
+     * included by several headers are only parsed once.
+     *
+     * The functions declared in each header are routed to the parser for that header, as if the header had been parsed
+     * by it with Parse().
+     *
+     * @param inputFilepaths [in] Filenames for the C/C++ header files
+     * @param config [in] Configuration to be used during mock generation
+     * @param interpretAsCpp [in] Forces interpreting the header files as C++
+     * @param includePaths [in] List of paths to search for included header files
+     * @param preprocessorDefines [in] List of preprocessor macro definitions
+     * @param symbols [in] List of (mangled) symbol names of the functions to be mocked, or empty to mock all functions
+     * @param emittedFunctions [in/out] Functions already mocked for other input files, which will be skipped and
+     *                                  reported as duplicates; the functions parsed from these files are added to it
+     * @param parsers [out] Parser for each header file, where @p parsers must have the same size as @p inputFilepaths
+     * @param error [out] Stream where errors will be written
+     * @return @c true if all the input files could be parsed successfully (or were skipped, see IsSkipped()),
+     *         @c false otherwise
+     */
+    static bool ParseUmbrella( const std::vector<std::string> &inputFilepaths, const Config &config, bool interpretAsCpp,
+                               bool useCpp11, const std::vector<std::string> &includePaths,
+                               const std::vector<std::string> &includeFiles, const std::vector<std::string> &symbols,
+                               EmittedFunctions &emittedFunctions, std::vector<Parser> &parsers, std::ostream &error );
+
+    /**
+     * Makes the following parse keep the translation unit, so that it can be reparsed later with Reparse().
+     */
+    void EnableReparse();
+
+    /**
+     * Makes the following parses keep track of the non-system files included by the input file, which are then
+     * returned by GetDependencies().
+     */
+    void EnableDependencyTracking();
+
+    /**
+     * Makes the following parses process only the input file, without expanding the files included by it.
+     *
+     * Parse errors (e.g. due to unknown types declared in the files not included) are reported as warnings, and
+     * parameter and return types that cannot be resolved are mocked as opaque pointers or records, unless they are
+     * overridden.
+     */
+    void EnableSingleFileParse();
+
+    /**
+     * Makes the following parses skip the input file if it does not contain any mockable function, reporting it with a
+     * warning instead of an error, so that IsSkipped() tells it apart from an input file that could not be parsed.
+     */
+    void EnableSkipWithoutFunctions();
+
+    /**
+     * Makes the following parses take the contents of the input file from memory instead of reading them from disk.
+     *
+     * The input file path passed to Parse() is then a virtual path, which is used to resolve the files included by the
+     * input file and is included by the generated expectations and mocks.
+     *
+     * @param contents [in] Contents of the C/C++ header file
+     */
+    void SetInputContents( const std::string &contents );
+
+    /**
+     * Sets the path by which the generated expectations and mocks include the input file, instead of its filename.
+     *
+     * @param includePath [in] Path of the input file relative to a directory in the include path of the generated files
+     */
+    void SetIncludePath( const std::string &includePath );
+
+    /**
+     * Parses again the C/C++ header parsed previously with the same options, reusing the translation unit kept from
+     * the previous parse so that only the files that changed since then are processed again.
+     *
+     * @param config [in] Configuration to be used during mock generation
+     * @param symbols [in] List of (mangled) symbol names of the functions to be mocked, or empty to mock all functions
+     * @param emittedFunctions [in/out] Functions already mocked for other input files, which will be skipped and
+     *                                  reported as duplicates; the functions parsed from this file are added to it
+     * @param error [out] Stream where errors will be written
+     * @return @c true if the input file could be parsed successfully, @c false otherwise
+     */
+    bool Reparse( const Config &config, const std::vector<std::string> &symbols, EmittedFunctions &emittedFunctions,
+                  std::ostream &error );
+
+    /**
+     * Returns the paths of the C/C++ header parsed previously and of the non-system files included by it.
+     *
+     * @note Included files are only known when reparsing or dependency tracking has been enabled before parsing.
+     */
+    std::vector<std::string> GetDependencies() const;
+
+    /**
+     * Returns the statistics of the last parse of the C/C++ header.
+     */
+    const Statistics& GetStatistics() const;
+
+    /**
+     * Returns whether the C/C++ header parsed previously has been skipped because it does not contain any mockable
+     * function (or any function that was not already mocked for itself when removing the emitted functions).
+     *
+     * @note Input files are only skipped when skipping has been enabled before parsing.
+     */
+    bool IsSkipped() const;
+
+    /**
+     * Removes the functions of the C/C++ header parsed previously that have already been mocked for other input files,
+     * reporting them as duplicates, and adds the remaining functions to @p emittedFunctions.
+     *
+     * This allows parsing several input files concurrently (each one with its own table of emitted functions) and then
+     * getting the same functions that would have been obtained parsing them sequentially.
+     *
+     * @param emittedFunctions [in/out] Functions already mocked for other input files
+     * @param error [out] Stream where errors will be written
+     * @return @c false if the input file does not contain any function that was not already mocked for itself,
+     *         @c true otherwise
+     */
+    bool RemoveEmittedFunctions( EmittedFunctions &emittedFunctions, std::ostream &error );
+
+    /**
+     * Reports that an input file does not contain any function to be mocked.
+     *
+     * @param inputFileDescription [in] Description of the input file that starts the message (e.g. "The input file")
+     * @param symbolsListed [in] Whether the functions to be mocked were restricted to a list of symbols
+     * @param error [out] Stream where the error will be written
+     * @param skipped [in] Report it as a warning, because the input file is skipped instead of failing
+     */
+    static void ReportNoMockableFunctions( const std::string &inputFileDescription, bool symbolsListed, std::ostream &error,
+                                           bool skipped = false );
 
     /**
      * Generates mocked functions for the C/C++ header parsed previously.
      *
      * @param genOpts [in] String containing the generation options
+     * @param profiling [in] Instrument the mocks with call-count and execution time profiling
+     * @param recordReplay [in] Generate record and replay paths for the mocks of C functions
      * @param output [out] Stream where the generated mocks will be written
      */
-    void GenerateMock( const std::string &genOpts, std::ostream &output ) const;
+    void GenerateMock( const std::string &genOpts, bool profiling, bool recordReplay, std::ostream &output ) const;
 
     /**
      * Generates expectation functions header for the C/C++ header parsed previously.
      *
      * @param genOpts [in] String containing the generation options
+     * @param podComparators [in] Declare the helper that installs comparators and copiers for POD record types
      * @param output [out] Stream where the generated expectations header will be written
      */
-    void GenerateExpectationHeader( const std::string &genOpts, std::ostream &output ) const;
+    void GenerateExpectationHeader( const std::string &genOpts, bool podComparators, std::ostream &output ) const;
 
     /**
      * Generates expectation functions implementation for the C/C++ header parsed previously.
      *
      * @param genOpts [in] String containing the generation options
      * @param headerFilepath [in] Filename for the expectation functions header file
+     * @param profiling [in] Instrument the expectation functions with call-count and execution time profiling
+     * @param podComparators [in] Generate memcmp / memcpy based comparators and copiers for POD record types,
+     *                            and the helper that installs them
      * @param output [out] Stream where the generated expectations implementation will be written
      */
-    void GenerateExpectationImpl( const std::string &genOpts, const std::string &headerFilepath, std::ostream &output ) const;
+    void GenerateExpectationImpl( const std::string &genOpts, const std::string &headerFilepath, bool profiling,
+                                  bool podComparators, std::ostream &output ) const;
+
+    /**
+     * Updates the fingerprints store with the code generated for each function of the C/C++ header parsed previously.
+     *
+     * @param fingerprints [in/out] Fingerprints store to be updated
+     * @param genOpts [in] String containing the generation options
+     * @param profiling [in] Instrument the mocks and expectations with call-count and execution time profiling
+     * @param recordReplay [in] Generate record and replay paths for the mocks of C functions
+     */
+    void UpdateFingerprints( FingerprintStore &fingerprints, const std::string &genOpts, bool profiling,
+                             bool recordReplay ) const;
 
 private:
+    struct TranslationUnit;
+
+    bool CreateTranslationUnit( std::ostream &error );
+    bool ProcessTranslationUnit( const Config &config, const std::vector<std::string> &symbols,
+                                 EmittedFunctions &emittedFunctions, std::ostream &error );
+    void ReportNoMockableFunctions( std::ostream &error );
     void GenerateFileHeading( const std::string &genOpts, std::ostream &output ) const;
+    void GenerateProfilingSupport( std::ostream &output ) const;
+    void GenerateTraceSupport( std::ostream &output ) const;
+    void GeneratePodComparators( std::ostream &output ) const;
+    std::string GetPodComparatorsInstallerName() const;
+    std::string GetIncludePath() const;
 
     std::vector<std::unique_ptr<const Function>> m_functions;
+    std::vector<std::pair<std::string, std::string>> m_functionIds; // USR and display name of each function
     std::string m_inputFilepath;
+    std::string m_includePath;
     bool m_interpretAsCpp;
+    bool m_symbolsListed = false;
+    Statistics m_statistics;
+    std::vector<std::string> m_clangOpts;
+    std::vector<std::string> m_dependencies;
+    bool m_reparseEnabled = false;
+    bool m_dependencyTrackingEnabled = false;
+    bool m_singleFileParse = false;
+    bool m_skipWithoutFunctions = false;
+    bool m_skipped = false;
+    bool m_hasInputContents = false;
+    std::string m_inputContents;
+    std::shared_ptr<TranslationUnit> m_translationUnit;
 };
 
 #endif // header guard
@@ -0,0 +1,141 @@
+#include "ResourceReport.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+#include "FileHelper.hpp"
+
+#ifdef WIN32
+#include <windows.h>
+#include <psapi.h>
+#ifdef _MSC_VER
+#pragma comment( lib, "psapi.lib" )
+#endif
+#else
+#include <sys/resource.h>
+#endif
+
+static const char* const COLUMN_NAMES[] = { "input", "functions", "parseSeconds", "modelSeconds", "tuMemoryBytes",
+                                            "astMemoryBytes", "identifiersMemoryBytes", "preprocessorMemoryBytes",
+                                            "sourceManagerMemoryBytes", "peakRssBytes" };
+
+static double ToSeconds( std::chrono::nanoseconds duration )
+{
+    return std::chrono::duration<double>( duration ).count();
+}
+
+static std::string EscapeCsv( const std::string &text )
+{
+    if( text.find_first_of( ",\"" ) == std::string::npos )
+    {
+        return text;
+    }
+
+    std::string ret = "\"";
+    for( char c : text )
+    {
+        if( c == '"' )
+        {
+            ret += '"';
+        }
+        ret += c;
+    }
+    return ret + "\"";
+}
+
+void ResourceReport::AddInput( const std::string &inputFilepath, const Parser::Statistics &statistics )
+{
+    m_entries.push_back( { inputFilepath, statistics, GetPeakRss() } );
+}
+
+void ResourceReport::Write( std::ostream &output, Format format ) const
+{
+    output << std::setprecision( 9 );
+
+    if( format == Format::JSON )
+    {
+        output << "[" << std::endl;
+    }
+    else
+    {
+        for( size_t i = 0; i < ( sizeof( COLUMN_NAMES ) / sizeof( COLUMN_NAMES[0] ) ); i++ )
+        {
+            output << ( ( i > 0 ) ? "," : "" ) << COLUMN_NAMES[i];
+        }
+        output << std::endl;
+    }
+
+    for( size_t i = 0; i < m_entries.size(); i++ )
+    {
+        const Entry &entry = m_entries[i];
+        const Parser::Statistics &statistics = entry.statistics;
+
+        if( format == Format::JSON )
+        {
+            output << "  { \"" << COLUMN_NAMES[0] << "\": \"" << EscapeJson( entry.inputFilepath ) << "\", " <<
+                      "\"" << COLUMN_NAMES[1] << "\": " << statistics.functionCount << ", " <<
+                      "\"" << COLUMN_NAMES[2] << "\": " << ToSeconds( statistics.parseDuration ) << ", " <<
+                      "\"" << COLUMN_NAMES[3] << "\": " << ToSeconds( statistics.modelDuration ) << ", " <<
+                      "\"" << COLUMN_NAMES[4] << "\": " << statistics.memoryUsage << ", " <<
+                      "\"" << COLUMN_NAMES[5] << "\": " << statistics.astMemoryUsage << ", " <<
+                      "\"" << COLUMN_NAMES[6] << "\": " << statistics.identifiersMemoryUsage << ", " <<
+                      "\"" << COLUMN_NAMES[7] << "\": " << statistics.preprocessorMemoryUsage << ", " <<
+                      "\"" << COLUMN_NAMES[8] << "\": " << statistics.sourceManagerMemoryUsage << ", " <<
+                      "\"" << COLUMN_NAMES[9] << "\": " << entry.peakRss << " }" <<
+                      ( ( i + 1 < m_entries.size() ) ? "," : "" ) << std::endl;
+        }
+        else
+        {
+            output << EscapeCsv( entry.inputFilepath ) << "," << statistics.functionCount << "," <<
+                      ToSeconds( statistics.parseDuration ) << "," << ToSeconds( statistics.modelDuration ) << "," <<
+                      statistics.memoryUsage << "," << statistics.astMemoryUsage << "," <<
+                      statistics.identifiersMemoryUsage << "," << statistics.preprocessorMemoryUsage << "," <<
+                      statistics.sourceManagerMemoryUsage << "," << entry.peakRss << std::endl;
+        }
+    }
+
+    if( format == Format::JSON )
+    {
+        output << "]" << std::endl;
+    }
+}
+
+void ResourceReport::Save( const std::string &filepath ) const
+{
+    std::ofstream file( filepath );
+    if( !file.is_open() )
+    {
+        std::string errorMsg = "Resource report file '" + filepath + "' could not be opened.";
+        throw std::runtime_error( errorMsg );
+    }
+
+    static const std::string JSON_EXTENSION = ".json";
+    bool json = ( filepath.size() >= JSON_EXTENSION.size() ) &&
+                ( filepath.compare( filepath.size() - JSON_EXTENSION.size(), JSON_EXTENSION.size(), JSON_EXTENSION ) == 0 );
+
+    Write( file, json ? Format::JSON : Format::CSV );
+}
+
+uint64_t ResourceReport::GetPeakRss()
+{
+#ifdef WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if( GetProcessMemoryInfo( GetCurrentProcess(), &counters, sizeof( counters ) ) )
+    {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if( getrusage( RUSAGE_SELF, &usage ) != 0 )
+    {
+        return 0;
+    }
+#ifdef __APPLE__
+    return (uint64_t) usage.ru_maxrss;
+#else
+    return (uint64_t) usage.ru_maxrss * 1024;
+#endif
+#endif
+}
@@ -0,0 +1,67 @@
+#ifndef CPPUMOCKGEN_RESOURCEREPORT_HPP_
+#define CPPUMOCKGEN_RESOURCEREPORT_HPP_
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstdint>
+
+#include "Parser.hpp"
+
+/**
+ * Report of the resources used to process each input file, intended to find the input files that are expensive to
+ * parse (e.g. because of large include closures).
+ */
+class ResourceReport
+{
+public:
+    /**
+     * Format of the report.
+     */
+    enum class Format
+    {
+        CSV,
+        JSON
+    };
+
+    /**
+     * Registers the resources used to process an input file, along with the current peak memory usage of the process.
+     *
+     * @param inputFilepath [in] Path of the input file
+     * @param statistics [in] Statistics of the parse of the input file
+     */
+    void AddInput( const std::string &inputFilepath, const Parser::Statistics &statistics );
+
+    /**
+     * Writes the report.
+     *
+     * @param output [out] Stream where the report will be written
+     * @param format [in] Format of the report
+     */
+    void Write( std::ostream &output, Format format ) const;
+
+    /**
+     * Saves the report, in JSON format if the extension of @p filepath is ".json", or in CSV format otherwise.
+     *
+     * @param filepath [in] Path of the report file
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    void Save( const std::string &filepath ) const;
+
+    /**
+     * Returns the peak physical memory (resident set size) used by the process, in bytes, or 0 if unknown.
+     */
+    static uint64_t GetPeakRss();
+
+private:
+    struct Entry
+    {
+        std::string inputFilepath;
+        Parser::Statistics statistics;
+        uint64_t peakRss;
+    };
+
+    std::vector<Entry> m_entries;
+};
+
+#endif // header guard
@@ -0,0 +1,171 @@
+#include "Trace.hpp"
+
+#include <fstream>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <stdexcept>
+
+#include "FileHelper.hpp"
+
+struct TraceEvent
+{
+    const char *name;
+    unsigned int threadIndex;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point end;
+    std::string args;
+};
+
+struct TraceState
+{
+    std::atomic<bool> enabled{ false };
+    std::mutex mutex;
+    std::chrono::steady_clock::time_point origin;
+    std::vector<TraceEvent> events;
+    std::map<std::thread::id, unsigned int> threadIndexes;
+};
+
+static TraceState& GetState()
+{
+    static TraceState state;
+    return state;
+}
+
+static long long ToMicroseconds( std::chrono::steady_clock::duration duration )
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>( duration ).count();
+}
+
+/*===========================================================================
+ *                          TRACE RECORDER
+ *===========================================================================*/
+
+void TraceRecorder::Start()
+{
+    TraceState &state = GetState();
+    std::lock_guard<std::mutex> lock( state.mutex );
+
+    state.events.clear();
+    state.threadIndexes.clear();
+    state.origin = std::chrono::steady_clock::now();
+    state.enabled = true;
+}
+
+void TraceRecorder::Stop()
+{
+    TraceState &state = GetState();
+    std::lock_guard<std::mutex> lock( state.mutex );
+
+    state.enabled = false;
+
+    // The storage is released (and not just cleared), so that it is not held for the rest of the process
+    std::vector<TraceEvent>().swap( state.events );
+    state.threadIndexes.clear();
+}
+
+bool TraceRecorder::IsEnabled()
+{
+    return GetState().enabled;
+}
+
+void TraceRecorder::AddSpan( const char *name, std::chrono::steady_clock::time_point start,
+                             std::chrono::steady_clock::time_point end, const std::string &args )
+{
+    TraceState &state = GetState();
+    std::lock_guard<std::mutex> lock( state.mutex );
+
+    // Spans started before recording was stopped are discarded, because the recorded spans have been released
+    if( !state.enabled )
+    {
+        return;
+    }
+
+    // Threads are numbered in order of appearance, so that the main thread is usually shown first
+    std::map<std::thread::id, unsigned int>::iterator it = state.threadIndexes.find( std::this_thread::get_id() );
+    if( it == state.threadIndexes.end() )
+    {
+        it = state.threadIndexes.insert( std::make_pair( std::this_thread::get_id(),
+                                                         (unsigned int) state.threadIndexes.size() + 1 ) ).first;
+    }
+
+    state.events.push_back( { name, it->second, start, end, args } );
+}
+
+void TraceRecorder::Write( std::ostream &output )
+{
+    TraceState &state = GetState();
+    std::lock_guard<std::mutex> lock( state.mutex );
+
+    output << "{\"traceEvents\":[" << std::endl;
+
+    bool first = true;
+    for( const std::map<std::thread::id, unsigned int>::value_type &thread : state.threadIndexes )
+    {
+        output << ( first ? "" : ",\n" ) << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.second <<
+                  ",\"args\":{\"name\":\"" << ( ( thread.second == 1 ) ? "main" : "worker " + std::to_string( thread.second - 1 ) ) <<
+                  "\"}}";
+        first = false;
+    }
+
+    for( const TraceEvent &event : state.events )
+    {
+        output << ( first ? "" : ",\n" ) << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" <<
+                  event.threadIndex << ",\"ts\":" << ToMicroseconds( event.start - state.origin ) <<
+                  ",\"dur\":" << ToMicroseconds( event.end - event.start ) << ",\"args\":{" << event.args << "}}";
+        first = false;
+    }
+
+    output << std::endl << "],\"displayTimeUnit\":\"ms\"}" << std::endl;
+}
+
+void TraceRecorder::Save( const std::string &filepath )
+{
+    std::ofstream file( filepath );
+    if( !file.is_open() )
+    {
+        std::string errorMsg = "Trace file '" + filepath + "' could not be opened.";
+        throw std::runtime_error( errorMsg );
+    }
+
+    Write( file );
+}
+
+/*===========================================================================
+ *                              TRACE SPAN
+ *===========================================================================*/
+
+TraceSpan::TraceSpan( const char *name )
+: m_name( name ), m_active( TraceRecorder::IsEnabled() )
+{
+    if( m_active )
+    {
+        m_start = std::chrono::steady_clock::now();
+    }
+}
+
+TraceSpan::~TraceSpan()
+{
+    if( m_active )
+    {
+        TraceRecorder::AddSpan( m_name, m_start, std::chrono::steady_clock::now(), m_args );
+    }
+}
+
+void TraceSpan::AddArgument( const char *name, const std::string &value )
+{
+    if( m_active )
+    {
+        m_args += ( m_args.empty() ? "\"" : ",\"" ) + std::string( name ) + "\":\"" + EscapeJson( value ) + "\"";
+    }
+}
+
+void TraceSpan::AddArgument( const char *name, uint64_t value )
+{
+    if( m_active )
+    {
+        m_args += ( m_args.empty() ? "\"" : ",\"" ) + std::string( name ) + "\":" + std::to_string( value );
+    }
+}
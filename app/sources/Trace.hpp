@@ -0,0 +1,105 @@
+#ifndef CPPUMOCKGEN_TRACE_HPP_
+#define CPPUMOCKGEN_TRACE_HPP_
+
+#include <string>
+#include <ostream>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * Recorder of the spans of the processing phases, which are written in the Chrome trace event format (which can be
+ * loaded in Perfetto or chrome://tracing).
+ *
+ * Spans can be recorded concurrently from several threads, each one being shown in its own track. Recording is
+ * disabled by default, and while it is disabled spans do nothing.
+ */
+class TraceRecorder
+{
+public:
+    /**
+     * Enables recording, discarding the spans recorded previously.
+     */
+    static void Start();
+
+    /**
+     * Disables recording, releasing the spans recorded (which must have been saved or written before).
+     */
+    static void Stop();
+
+    /**
+     * Indicates if recording is enabled.
+     */
+    static bool IsEnabled();
+
+    /**
+     * Writes the recorded spans as a JSON trace.
+     *
+     * @param output [out] Stream where the trace will be written
+     */
+    static void Write( std::ostream &output );
+
+    /**
+     * Saves the recorded spans as a JSON trace.
+     *
+     * @param filepath [in] Path of the trace file
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    static void Save( const std::string &filepath );
+
+private:
+    friend class TraceSpan;
+
+    static void AddSpan( const char *name, std::chrono::steady_clock::time_point start,
+                         std::chrono::steady_clock::time_point end, const std::string &args );
+};
+
+/**
+ * Span of a processing phase, which lasts from its construction until its destruction.
+ */
+class TraceSpan
+{
+public:
+    /**
+     * Starts a span.
+     *
+     * @param name [in] Name of the phase (must remain valid until the trace is written)
+     */
+    explicit TraceSpan( const char *name );
+
+    /**
+     * Ends the span, recording it if recording was enabled when it started.
+     */
+    ~TraceSpan();
+
+    TraceSpan( const TraceSpan& ) = delete;
+    TraceSpan& operator=( const TraceSpan& ) = delete;
+
+    /**
+     * Indicates if the span is being recorded, to avoid calculating arguments that will not be used.
+     */
+    bool IsActive() const
+    {
+        return m_active;
+    }
+
+    /**
+     * Attaches an argument to the span, shown when the span is selected.
+     *
+     * @param name [in] Name of the argument
+     * @param value [in] Value of the argument
+     */
+    void AddArgument( const char *name, const std::string &value );
+
+    /**
+     * @overload
+     */
+    void AddArgument( const char *name, uint64_t value );
+
+private:
+    const char *m_name;
+    bool m_active;
+    std::chrono::steady_clock::time_point m_start;
+    std::string m_args;
+};
+
+#endif // header guard
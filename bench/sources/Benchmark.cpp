@@ -0,0 +1,179 @@
+#include "Benchmark.hpp"
+
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <stdexcept>
+
+#include "Config.hpp"
+#include "Parser.hpp"
+#include "ResourceReport.hpp"
+#include "VersionInfo.h"
+
+template <typename T>
+static T Median( std::vector<T> samples )
+{
+    std::sort( samples.begin(), samples.end() );
+    return samples[ samples.size() / 2 ];
+}
+
+static double ToSeconds( std::chrono::steady_clock::duration duration )
+{
+    return std::chrono::duration<double>( duration ).count();
+}
+
+std::vector<BenchmarkScenario> GetDefaultBenchmarkSuite()
+{
+    std::vector<BenchmarkScenario> suite;
+
+    BenchmarkScenario baseline;
+    baseline.name = "baseline";
+    suite.push_back( baseline );
+
+    BenchmarkScenario scenario = baseline;
+    scenario.name = "functions-2000";
+    scenario.parameters.functionCount = 2000;
+    suite.push_back( scenario );
+
+    scenario = baseline;
+    scenario.name = "arguments-12";
+    scenario.parameters.argumentCount = 12;
+    suite.push_back( scenario );
+
+    scenario = baseline;
+    scenario.name = "typedef-depth-16";
+    scenario.parameters.typedefDepth = 16;
+    suite.push_back( scenario );
+
+    scenario = baseline;
+    scenario.name = "namespace-depth-8";
+    scenario.parameters.namespaceDepth = 8;
+    suite.push_back( scenario );
+
+    scenario = baseline;
+    scenario.name = "classes-50x20";
+    scenario.parameters.functionCount = 0;
+    scenario.parameters.classCount = 50;
+    scenario.parameters.methodCount = 20;
+    suite.push_back( scenario );
+
+    scenario = baseline;
+    scenario.name = "overrides-100";
+    scenario.parameters.overrideCount = 100;
+    suite.push_back( scenario );
+
+    return suite;
+}
+
+BenchmarkResult RunBenchmark( const BenchmarkScenario &scenario, unsigned int repetitions )
+{
+    const SyntheticHeaderParameters &parameters = scenario.parameters;
+
+    std::string contents = GenerateSyntheticHeader( parameters );
+    bool interpretAsCpp = IsSyntheticHeaderCpp( parameters );
+    std::string inputFilepath = "synthetic_" + scenario.name + ( interpretAsCpp ? ".hpp" : ".h" );
+    std::string expectHeaderFilepath = "synthetic_" + scenario.name + "_expect.hpp";
+
+    Config config( false, std::vector<std::string>(), GetSyntheticTypeOverrides( parameters ) );
+
+    std::vector<double> parseSamples;
+    std::vector<double> modelSamples;
+    std::vector<double> generateSamples;
+    std::vector<uint64_t> tuMemorySamples;
+
+    BenchmarkResult result;
+    result.scenario = scenario;
+    result.functionCount = GetSyntheticFunctionCount( parameters );
+    result.headerBytes = contents.size();
+
+    for( unsigned int i = 0; i < repetitions; i++ )
+    {
+        Parser parser;
+        Parser::EmittedFunctions emittedFunctions;
+        std::ostringstream error;
+
+        parser.SetInputContents( contents );
+        if( !parser.Parse( inputFilepath, config, interpretAsCpp, false, std::vector<std::string>(),
+                           std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error ) )
+        {
+            throw std::runtime_error( "The synthetic header of scenario '" + scenario.name + "' could not be parsed:\n" +
+                                      error.str() );
+        }
+
+        std::ostringstream mockOutput;
+        std::ostringstream expectHeaderOutput;
+        std::ostringstream expectImplOutput;
+
+        std::chrono::steady_clock::time_point generateStart = std::chrono::steady_clock::now();
+
+        parser.GenerateMock( "", false, false, mockOutput );
+        parser.GenerateExpectationHeader( "", false, expectHeaderOutput );
+        parser.GenerateExpectationImpl( "", expectHeaderFilepath, false, false, expectImplOutput );
+
+        generateSamples.push_back( ToSeconds( std::chrono::steady_clock::now() - generateStart ) );
+
+        const Parser::Statistics &statistics = parser.GetStatistics();
+        parseSamples.push_back( ToSeconds( statistics.parseDuration ) );
+        modelSamples.push_back( ToSeconds( statistics.modelDuration ) );
+        tuMemorySamples.push_back( statistics.memoryUsage );
+
+        result.outputBytes = mockOutput.str().size() + expectHeaderOutput.str().size() + expectImplOutput.str().size();
+    }
+
+    result.parseSeconds = Median( parseSamples );
+    result.modelSeconds = Median( modelSamples );
+    result.generateSeconds = Median( generateSamples );
+    result.tuMemoryBytes = Median( tuMemorySamples );
+    result.processPeakRssBytes = ResourceReport::GetPeakRss();
+
+    return result;
+}
+
+void WriteBenchmarkResults( const std::vector<BenchmarkResult> &results, unsigned int repetitions,
+                            std::ostream &output )
+{
+    output << std::setprecision( 9 );
+
+    output << "{" << std::endl;
+    output << "  \"version\": \"" << PRODUCT_VERSION_MAJOR << "." << PRODUCT_VERSION_MINOR << "." <<
+              PRODUCT_VERSION_PATCH << "\"," << std::endl;
+    output << "  \"repetitions\": " << repetitions << "," << std::endl;
+    output << "  \"notes\": \"processPeakRssBytes is the peak resident memory of the whole process up to the end of " <<
+              "each scenario, it is cumulative over the scenarios run before and never decreases\"," << std::endl;
+    output << "  \"results\": [" << std::endl;
+
+    for( size_t i = 0; i < results.size(); i++ )
+    {
+        const BenchmarkResult &result = results[i];
+        const SyntheticHeaderParameters &parameters = result.scenario.parameters;
+
+        double functionsPerSecond = ( result.generateSeconds > 0 ) ? ( result.functionCount / result.generateSeconds ) : 0;
+        double bytesPerSecond = ( result.generateSeconds > 0 ) ? ( result.outputBytes / result.generateSeconds ) : 0;
+
+        output << "    {" << std::endl;
+        output << "      \"scenario\": \"" << result.scenario.name << "\"," << std::endl;
+        output << "      \"parameters\": { " <<
+                  "\"functions\": " << parameters.functionCount << ", " <<
+                  "\"arguments\": " << parameters.argumentCount << ", " <<
+                  "\"typedefDepth\": " << parameters.typedefDepth << ", " <<
+                  "\"namespaceDepth\": " << parameters.namespaceDepth << ", " <<
+                  "\"classes\": " << parameters.classCount << ", " <<
+                  "\"methods\": " << parameters.methodCount << ", " <<
+                  "\"overrides\": " << parameters.overrideCount << " }," << std::endl;
+        output << "      \"mockableFunctions\": " << result.functionCount << "," << std::endl;
+        output << "      \"headerBytes\": " << result.headerBytes << "," << std::endl;
+        output << "      \"parseSeconds\": " << result.parseSeconds << "," << std::endl;
+        output << "      \"modelSeconds\": " << result.modelSeconds << "," << std::endl;
+        output << "      \"generateSeconds\": " << result.generateSeconds << "," << std::endl;
+        output << "      \"outputBytes\": " << result.outputBytes << "," << std::endl;
+        output << "      \"functionsPerSecond\": " << functionsPerSecond << "," << std::endl;
+        output << "      \"bytesPerSecond\": " << bytesPerSecond << "," << std::endl;
+        output << "      \"tuMemoryBytes\": " << result.tuMemoryBytes << "," << std::endl;
+        output << "      \"processPeakRssBytes\": " << result.processPeakRssBytes << std::endl;
+        output << "    }" << ( ( i + 1 < results.size() ) ? "," : "" ) << std::endl;
+    }
+
+    output << "  ]" << std::endl;
+    output << "}" << std::endl;
+}
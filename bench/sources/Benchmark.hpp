@@ -0,0 +1,62 @@
+#ifndef CPPUMOCKGEN_BENCH_BENCHMARK_HPP_
+#define CPPUMOCKGEN_BENCH_BENCHMARK_HPP_
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstdint>
+
+#include "SyntheticHeader.hpp"
+
+/**
+ * Benchmark scenario, i.e. a synthetic header to be processed.
+ */
+struct BenchmarkScenario
+{
+    std::string name;                       ///< Name of the scenario
+    SyntheticHeaderParameters parameters;   ///< Shape of the synthetic header
+};
+
+/**
+ * Measurements of a benchmark scenario (median of the repetitions).
+ */
+struct BenchmarkResult
+{
+    BenchmarkScenario scenario;
+    unsigned int functionCount = 0;     ///< Number of mockable functions in the header
+    size_t headerBytes = 0;             ///< Size of the header
+    double parseSeconds = 0;            ///< Time spent by libclang parsing the header
+    double modelSeconds = 0;            ///< Time spent building the mocked functions from the translation unit
+    double generateSeconds = 0;         ///< Time spent generating the mocks and expectation functions
+    size_t outputBytes = 0;             ///< Size of the generated mocks and expectation functions
+    uint64_t tuMemoryBytes = 0;         ///< Memory used by libclang for the translation unit
+    uint64_t processPeakRssBytes = 0;   ///< Peak resident memory of the whole process up to the end of this scenario
+                                        ///< (cumulative over the scenarios run before, it never decreases)
+};
+
+/**
+ * Returns the default benchmark suite, which varies each dimension of the synthetic headers from a baseline.
+ */
+std::vector<BenchmarkScenario> GetDefaultBenchmarkSuite();
+
+/**
+ * Runs a benchmark scenario.
+ *
+ * @param scenario [in] Scenario to be run
+ * @param repetitions [in] Number of times that the header is processed
+ * @return Measurements of the scenario
+ * @throws std::runtime_error if the synthetic header cannot be parsed
+ */
+BenchmarkResult RunBenchmark( const BenchmarkScenario &scenario, unsigned int repetitions );
+
+/**
+ * Writes benchmark results as JSON.
+ *
+ * @param results [in] Results to be written
+ * @param repetitions [in] Number of repetitions of each scenario
+ * @param output [out] Stream where the results will be written
+ */
+void WriteBenchmarkResults( const std::vector<BenchmarkResult> &results, unsigned int repetitions,
+                            std::ostream &output );
+
+#endif // header guard
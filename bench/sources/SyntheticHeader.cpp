@@ -0,0 +1,144 @@
+#include "SyntheticHeader.hpp"
+
+#include <sstream>
+
+static const std::vector<std::string> BASE_TYPES = { "int", "unsigned long", "double", "const char *", "Record *", "short" };
+
+static std::string GetTypeName( const SyntheticHeaderParameters &parameters, unsigned int typeIndex )
+{
+    if( parameters.typedefDepth == 0 )
+    {
+        return BASE_TYPES[ typeIndex ];
+    }
+    else
+    {
+        return "Alias" + std::to_string( typeIndex ) + "_" + std::to_string( parameters.typedefDepth );
+    }
+}
+
+static std::string GetReturnType( const SyntheticHeaderParameters &parameters, unsigned int functionIndex )
+{
+    if( ( functionIndex % 3 ) == 0 )
+    {
+        return "void";
+    }
+    else
+    {
+        return GetTypeName( parameters, functionIndex % BASE_TYPES.size() );
+    }
+}
+
+static std::string GetArguments( const SyntheticHeaderParameters &parameters, unsigned int functionIndex )
+{
+    std::string arguments;
+
+    for( unsigned int i = 0; i < parameters.argumentCount; i++ )
+    {
+        unsigned int argumentIndex = ( functionIndex * parameters.argumentCount ) + i;
+
+        if( i > 0 )
+        {
+            arguments += ", ";
+        }
+
+        // One of every four arguments is a handle, whose mocked type is overridden
+        if( ( parameters.overrideCount > 0 ) && ( ( argumentIndex % 4 ) == 0 ) )
+        {
+            arguments += "Handle" + std::to_string( ( argumentIndex / 4 ) % parameters.overrideCount );
+        }
+        else
+        {
+            arguments += GetTypeName( parameters, argumentIndex % BASE_TYPES.size() );
+        }
+
+        arguments += " p" + std::to_string( i );
+    }
+
+    return arguments;
+}
+
+std::string GenerateSyntheticHeader( const SyntheticHeaderParameters &parameters )
+{
+    std::ostringstream output;
+
+    output << "/* Synthetic header generated by CppUMockGen.Bench */" << std::endl;
+    output << std::endl;
+    output << "#ifndef SYNTHETIC_HEADER_H_" << std::endl;
+    output << "#define SYNTHETIC_HEADER_H_" << std::endl;
+    output << std::endl;
+    output << "typedef struct Record { int a; double b; } Record;" << std::endl;
+    output << std::endl;
+
+    for( unsigned int i = 0; ( parameters.typedefDepth > 0 ) && ( i < BASE_TYPES.size() ); i++ )
+    {
+        output << "typedef " << BASE_TYPES[i] << " Alias" << i << "_1;" << std::endl;
+        for( unsigned int j = 2; j <= parameters.typedefDepth; j++ )
+        {
+            output << "typedef Alias" << i << "_" << ( j - 1 ) << " Alias" << i << "_" << j << ";" << std::endl;
+        }
+    }
+
+    for( unsigned int i = 0; i < parameters.overrideCount; i++ )
+    {
+        output << "typedef struct Handle" << i << "_Struct *Handle" << i << ";" << std::endl;
+    }
+
+    output << std::endl;
+
+    for( unsigned int i = 0; i < parameters.namespaceDepth; i++ )
+    {
+        output << "namespace ns" << i << " {" << std::endl;
+    }
+
+    for( unsigned int i = 0; i < parameters.functionCount; i++ )
+    {
+        output << GetReturnType( parameters, i ) << " function" << i << "(" << GetArguments( parameters, i ) << ");" << std::endl;
+    }
+
+    for( unsigned int i = 0; i < parameters.classCount; i++ )
+    {
+        output << std::endl;
+        output << "class Class" << i << std::endl;
+        output << "{" << std::endl;
+        output << "public:" << std::endl;
+        for( unsigned int j = 0; j < parameters.methodCount; j++ )
+        {
+            unsigned int methodIndex = ( i * parameters.methodCount ) + j;
+            output << "    " << GetReturnType( parameters, methodIndex ) << " method" << j << "(" <<
+                      GetArguments( parameters, methodIndex ) << ");" << std::endl;
+        }
+        output << "};" << std::endl;
+    }
+
+    for( unsigned int i = 0; i < parameters.namespaceDepth; i++ )
+    {
+        output << "}" << std::endl;
+    }
+
+    output << std::endl;
+    output << "#endif" << std::endl;
+
+    return output.str();
+}
+
+std::vector<std::string> GetSyntheticTypeOverrides( const SyntheticHeaderParameters &parameters )
+{
+    std::vector<std::string> typeOverrides;
+
+    for( unsigned int i = 0; i < parameters.overrideCount; i++ )
+    {
+        typeOverrides.push_back( "#Handle" + std::to_string( i ) + "=ConstPointer" );
+    }
+
+    return typeOverrides;
+}
+
+bool IsSyntheticHeaderCpp( const SyntheticHeaderParameters &parameters )
+{
+    return ( parameters.namespaceDepth > 0 ) || ( parameters.classCount > 0 );
+}
+
+unsigned int GetSyntheticFunctionCount( const SyntheticHeaderParameters &parameters )
+{
+    return parameters.functionCount + ( parameters.classCount * parameters.methodCount );
+}
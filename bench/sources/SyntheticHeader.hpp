@@ -0,0 +1,53 @@
+#ifndef CPPUMOCKGEN_BENCH_SYNTHETICHEADER_HPP_
+#define CPPUMOCKGEN_BENCH_SYNTHETICHEADER_HPP_
+
+#include <string>
+#include <vector>
+
+/**
+ * Parameters that define the shape of a synthetic header.
+ */
+struct SyntheticHeaderParameters
+{
+    unsigned int functionCount = 200;   ///< Number of free functions
+    unsigned int argumentCount = 3;     ///< Number of arguments of each function and method
+    unsigned int typedefDepth = 0;      ///< Length of the typedef chains used for the argument and return types
+    unsigned int namespaceDepth = 0;    ///< Number of nested namespaces that enclose the functions and classes
+    unsigned int classCount = 0;        ///< Number of classes
+    unsigned int methodCount = 0;       ///< Number of methods of each class
+    unsigned int overrideCount = 0;     ///< Number of handle types used as arguments and overridden with -t options
+};
+
+/**
+ * Generates the contents of a synthetic header.
+ *
+ * @param parameters [in] Shape of the header
+ * @return Contents of the header
+ */
+std::string GenerateSyntheticHeader( const SyntheticHeaderParameters &parameters );
+
+/**
+ * Returns the generic type override options (as passed with -t) for the handle types of a synthetic header.
+ *
+ * @param parameters [in] Shape of the header
+ * @return Type override options
+ */
+std::vector<std::string> GetSyntheticTypeOverrides( const SyntheticHeaderParameters &parameters );
+
+/**
+ * Indicates if a synthetic header must be interpreted as C++ (i.e. it has namespaces or classes).
+ *
+ * @param parameters [in] Shape of the header
+ * @return @c true if the header is C++, @c false if it is C
+ */
+bool IsSyntheticHeaderCpp( const SyntheticHeaderParameters &parameters );
+
+/**
+ * Returns the number of mockable functions (free functions and methods) of a synthetic header.
+ *
+ * @param parameters [in] Shape of the header
+ * @return Number of mockable functions
+ */
+unsigned int GetSyntheticFunctionCount( const SyntheticHeaderParameters &parameters );
+
+#endif // header guard
@@ -0,0 +1,159 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <cxxopts.hpp>
+
+#include "Benchmark.hpp"
+#include "SyntheticHeader.hpp"
+#include "FileHelper.hpp"
+
+static const char* CUSTOM_OPTIONS[] = { "functions", "arguments", "typedef-depth", "namespace-depth", "classes",
+                                        "methods", "overrides" };
+
+static std::vector<BenchmarkScenario> GetScenarios( cxxopts::Options &options )
+{
+    std::vector<BenchmarkScenario> scenarios;
+
+    bool custom = false;
+    for( const char *customOption : CUSTOM_OPTIONS )
+    {
+        custom = custom || ( options.count( customOption ) > 0 );
+    }
+
+    if( custom )
+    {
+        // A single scenario varying the requested dimensions from the baseline
+        BenchmarkScenario scenario;
+        scenario.name = "custom";
+
+        SyntheticHeaderParameters &parameters = scenario.parameters;
+        unsigned int* values[] = { &parameters.functionCount, &parameters.argumentCount, &parameters.typedefDepth,
+                                   &parameters.namespaceDepth, &parameters.classCount, &parameters.methodCount,
+                                   &parameters.overrideCount };
+        for( size_t i = 0; i < ( sizeof( CUSTOM_OPTIONS ) / sizeof( CUSTOM_OPTIONS[0] ) ); i++ )
+        {
+            if( options.count( CUSTOM_OPTIONS[i] ) )
+            {
+                *values[i] = options[ CUSTOM_OPTIONS[i] ].as<unsigned int>();
+            }
+        }
+
+        scenarios.push_back( scenario );
+    }
+    else
+    {
+        scenarios = GetDefaultBenchmarkSuite();
+
+        if( options.count( "scenario" ) )
+        {
+            std::vector<std::string> names = options["scenario"].as<std::vector<std::string>>();
+            for( const std::string &name : names )
+            {
+                if( std::none_of( scenarios.begin(), scenarios.end(),
+                                  [&name]( const BenchmarkScenario &scenario ) { return scenario.name == name; } ) )
+                {
+                    throw std::runtime_error( "Unknown scenario '" + name + "'." );
+                }
+            }
+
+            scenarios.erase( std::remove_if( scenarios.begin(), scenarios.end(),
+                                             [&names]( const BenchmarkScenario &scenario )
+                                             { return std::find( names.begin(), names.end(), scenario.name ) == names.end(); } ),
+                             scenarios.end() );
+        }
+    }
+
+    return scenarios;
+}
+
+int main( int argc, const char* argv[] )
+{
+    cxxopts::Options options( "CppUMockGen.Bench", "Benchmark of CppUMockGen on synthetic headers" );
+
+    options.add_options()
+        ( "o,output", "Results file (JSON), by default the results are printed to the console", cxxopts::value<std::string>(), "<file>" )
+        ( "r,repeat", "Number of times that each scenario is run (the median is reported), by default 3", cxxopts::value<unsigned int>(), "<count>" )
+        ( "s,scenario", "Only run the given scenario of the default suite", cxxopts::value<std::vector<std::string>>(), "<name>" )
+        ( "l,list", "List the scenarios of the default suite" )
+        ( "write-headers", "Write the synthetic headers to the given directory", cxxopts::value<std::string>(), "<dir>" )
+        ( "functions", "Run a custom scenario with the given number of functions", cxxopts::value<unsigned int>(), "<count>" )
+        ( "arguments", "Run a custom scenario with the given number of arguments per function", cxxopts::value<unsigned int>(), "<count>" )
+        ( "typedef-depth", "Run a custom scenario with the given typedef chain depth", cxxopts::value<unsigned int>(), "<depth>" )
+        ( "namespace-depth", "Run a custom scenario with the given namespace depth", cxxopts::value<unsigned int>(), "<depth>" )
+        ( "classes", "Run a custom scenario with the given number of classes", cxxopts::value<unsigned int>(), "<count>" )
+        ( "methods", "Run a custom scenario with the given number of methods per class", cxxopts::value<unsigned int>(), "<count>" )
+        ( "overrides", "Run a custom scenario with the given number of type overrides", cxxopts::value<unsigned int>(), "<count>" )
+        ( "h,help", "Print help" );
+
+    try
+    {
+        options.parse( argc, const_cast<char**&>(argv) );
+
+        if( options.count( "help" ) )
+        {
+            std::cerr << options.help();
+            return 0;
+        }
+
+        std::vector<BenchmarkScenario> scenarios = GetScenarios( options );
+
+        if( options.count( "list" ) )
+        {
+            for( const BenchmarkScenario &scenario : scenarios )
+            {
+                std::cout << scenario.name << std::endl;
+            }
+            return 0;
+        }
+
+        unsigned int repetitions = options.count( "repeat" ) ? options["repeat"].as<unsigned int>() : 3;
+        if( repetitions == 0 )
+        {
+            throw std::runtime_error( "The number of repetitions must be greater than zero." );
+        }
+
+        std::vector<BenchmarkResult> results;
+        for( const BenchmarkScenario &scenario : scenarios )
+        {
+            if( options.count( "write-headers" ) )
+            {
+                std::string headerFilepath = options["write-headers"].as<std::string>() + PATH_SEPARATOR + "synthetic_" +
+                                             scenario.name + ( IsSyntheticHeaderCpp( scenario.parameters ) ? ".hpp" : ".h" );
+                std::ofstream headerFile( headerFilepath );
+                if( !headerFile.is_open() )
+                {
+                    throw std::runtime_error( "Synthetic header '" + headerFilepath + "' could not be written." );
+                }
+                headerFile << GenerateSyntheticHeader( scenario.parameters );
+            }
+
+            std::cerr << "Running scenario '" << scenario.name << "'..." << std::endl;
+            results.push_back( RunBenchmark( scenario, repetitions ) );
+        }
+
+        if( options.count( "output" ) )
+        {
+            std::string outputFilepath = options["output"].as<std::string>();
+            std::ofstream outputFile( outputFilepath );
+            if( !outputFile.is_open() )
+            {
+                throw std::runtime_error( "Results file '" + outputFilepath + "' could not be opened." );
+            }
+            WriteBenchmarkResults( results, repetitions, outputFile );
+        }
+        else
+        {
+            WriteBenchmarkResults( results, repetitions, std::cout );
+        }
+    }
+    catch( std::exception &e )
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
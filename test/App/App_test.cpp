@@ -18,10 +18,14 @@
 #include <vector>
 #include <sstream>
 #include <fstream>
+#include <algorithm>
 #include <direct.h>
 
 #include "App.hpp"
 #include "FileHelper.hpp"
+#include "DirectoryTree.hpp"
+#include "OutputVerifier.hpp"
+#include "Trace.hpp"
 
 /*===========================================================================
  *                      COMMON TEST DEFINES & MACROS
@@ -63,6 +67,45 @@ public:
 
 StdOstreamCopier stdOstreamCopier;
 
+class StdVectorOfStringsCopier : public MockNamedValueCopier
+{
+public:
+    virtual void copy(void* out, const void* in)
+    {
+        *(std::vector<std::string>*)out = *(const std::vector<std::string>*)in;
+    }
+};
+
+StdVectorOfStringsCopier stdVectorOfStringsCopier;
+
+class GeneratedFilesComparator : public MockNamedValueComparator
+{
+public:
+    bool isEqual(const void* object1, const void* object2)
+    {
+        const std::vector<OutputVerifier::GeneratedFile> *o1 = (const std::vector<OutputVerifier::GeneratedFile>*) object1;
+        const std::vector<OutputVerifier::GeneratedFile> *o2 = (const std::vector<OutputVerifier::GeneratedFile>*) object2;
+
+        return ( o1->size() == o2->size() ) &&
+               std::equal( o1->begin(), o1->end(), o2->begin(),
+                           []( const OutputVerifier::GeneratedFile &f1, const OutputVerifier::GeneratedFile &f2 )
+                           { return ( f1.filename == f2.filename ) && ( f1.contents == f2.contents ) && ( f1.compiled == f2.compiled ); } );
+    }
+
+    SimpleString valueToString(const void* object)
+    {
+        SimpleString ret;
+        const std::vector<OutputVerifier::GeneratedFile> *o = (const std::vector<OutputVerifier::GeneratedFile>*) object;
+        for( unsigned int i = 0; i < o->size(); i++ )
+        {
+            ret += StringFromFormat("<%u>%s%s\n", i, (*o)[i].filename.c_str(), (*o)[i].compiled ? "" : " (not compiled)" );
+        }
+        return ret;
+    }
+};
+
+GeneratedFilesComparator generatedFilesComparator;
+
 static const std::string tempDirPath = std::string(std::getenv("TEMP"));
 static const std::string outDirPath = tempDirPath + PATH_SEPARATOR;
 static const std::string inputFilename = "foo.h";
@@ -90,6 +133,7 @@ TEST_GROUP( App )
         {
             std::remove( outputFilepath.c_str() );
         }
+        TraceRecorder::Stop();
     }
 
     bool CheckFileContains( const std::string &filepath, const std::string &contents )
@@ -217,7 +261,7 @@ TEST( App, MockOutput_OutDir )
             .withParameterOfType("std::vector<std::string>", "includePaths", &includePaths)
 			.withParameterOfType("std::vector<std::string>", "defines", &defines).withPointerParameter("error", &error)
             .ignoreOtherParameters().andReturnValue(true);
-    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "")
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
             .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
     mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
 
@@ -269,7 +313,7 @@ TEST( App, MockOutput_CurrentDir )
             .withParameterOfType("std::vector<std::string>", "includePaths", &includePaths)
 			.withParameterOfType("std::vector<std::string>", "defines", &defines).withPointerParameter("error", &error)
             .ignoreOtherParameters().andReturnValue(true);
-    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "")
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
             .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
     mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
 
@@ -317,7 +361,7 @@ TEST( App, MockOutput_OutFile )
             .withParameterOfType("std::vector<std::string>", "includePaths", &includePaths)
 			.withParameterOfType("std::vector<std::string>", "defines", &defines).withPointerParameter("error", &error)
             .ignoreOtherParameters().andReturnValue(true);
-    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "")
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
             .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
     mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
 
@@ -362,7 +406,7 @@ TEST( App, MockOutput_ConsoleOutput )
             .withParameterOfType("std::vector<std::string>", "includePaths", &includePaths)
 			.withParameterOfType("std::vector<std::string>", "defines", &defines).withPointerParameter("error", &error)
             .ignoreOtherParameters().andReturnValue(true);
-    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "")
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
             .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
 
     // Exercise
@@ -377,9 +421,9 @@ TEST( App, MockOutput_ConsoleOutput )
 }
 
 /*
- * Check that if the output file cannot be opened, an error is displayed
+ * Check that mock generation is requested properly for multiple input files
  */
-TEST( App, MockOutput_CannotOpenFile )
+TEST( App, MockOutput_MultipleInputs )
 {
     // Prepare
     mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
@@ -389,28 +433,38 @@ TEST( App, MockOutput_CannotOpenFile )
     std::ostringstream error;
     App app( output, error );
 
-    std::string outputDir = outDirPath + "NonExistantDirectory123898876354874" + PATH_SEPARATOR;
+    std::string inputFilename2 = "bar.h";
 
-    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", outputDir.c_str() };
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-i", inputFilename2.c_str(), "-m", "@" };
 
-    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::string outputText = "#####TEXT5#####";
 
-   // Exercise
-   int ret = app.Execute( args.size(), args.data() );
+    mock().expectNCalls(2, "Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectNCalls(2, "Parser::EnableSkipWithoutFunctions");
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename2.c_str()).ignoreOtherParameters().andReturnValue(true);
+    mock().expectNCalls(2, "Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
 
-   // Verify
-   CHECK_EQUAL( 1, ret );
-   STRCMP_CONTAINS( "ERROR:", error.str().c_str() );
-   STRCMP_CONTAINS( ("Mock output file '" + outputDir + mockOutputFilename + "' could not be opened").c_str(), error.str().c_str() );
-   CHECK_EQUAL( 0, output.tellp() );
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_EQUAL( ( outputText + outputText ).c_str(), output.str().c_str() );
+    CHECK_EQUAL( 0, error.tellp() );
 
     // Cleanup
 }
 
 /*
- * Check that parsing in C++ mode is requested properly
+ * Check that multiple input files are processed properly by the batch executor
  */
-TEST( App, MockOutput_InterpretAsCpp )
+TEST( App, MockOutput_Jobs )
 {
     // Prepare
     mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
@@ -420,22 +474,23 @@ TEST( App, MockOutput_InterpretAsCpp )
     std::ostringstream error;
     App app( output, error );
 
-    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", "@", "-x" };
+    std::string inputFilename2 = "bar.h";
+
+    // A single job is used, because mocks are not thread-safe
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-i", inputFilename2.c_str(), "-m", "@", "-j", "1" };
 
     std::vector<std::string> paramOverrideOptions;
     std::vector<std::string> typeOverrideOptions;
-    std::vector<std::string> includePaths;
-    std::vector<std::string> defines;
-    std::string outputText = "#####FOO#####";
+    std::string outputText = "#####TEXT5#####";
 
-    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+    mock().expectNCalls(2, "Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
             .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
             .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
-    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).withParameter("interpretAsCpp", true)
-            .withParameterOfType("std::vector<std::string>", "includePaths", &includePaths)
-			.withParameterOfType("std::vector<std::string>", "defines", &defines).withPointerParameter("error", &error)
-            .ignoreOtherParameters().andReturnValue(true);
-    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "-x ")
+    mock().expectNCalls(2, "Parser::EnableSkipWithoutFunctions");
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename2.c_str()).ignoreOtherParameters().andReturnValue(true);
+    mock().expectNCalls(2, "Parser::RemoveEmittedFunctions").withPointerParameter("error", &error).ignoreOtherParameters().andReturnValue(true);
+    mock().expectNCalls(2, "Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
             .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
 
     // Exercise
@@ -443,142 +498,289 @@ TEST( App, MockOutput_InterpretAsCpp )
 
     // Verify
     CHECK_EQUAL( 0, ret );
-    STRCMP_EQUAL( outputText.c_str(), output.str().c_str() );
+    STRCMP_EQUAL( ( outputText + outputText ).c_str(), output.str().c_str() );
     CHECK_EQUAL( 0, error.tellp() );
 
     // Cleanup
 }
 
 /*
- * Check that using underlying typedef types is requested properly
+ * Check that an error is displayed if an input file cannot be parsed by the batch executor
  */
-TEST( App, MockOutput_UseUnderlyingTypedefType )
+TEST( App, MockOutput_JobsParseError )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::string inputFilename2 = "bar.h";
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-i", inputFilename2.c_str(), "-m", "@", "-j", "1" };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+
+    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectOneCall("Parser::EnableSkipWithoutFunctions");
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).ignoreOtherParameters().andReturnValue(false);
+    mock().expectOneCall("Parser::IsSkipped").andReturnValue(false);
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 2, ret );
+    STRCMP_CONTAINS( "ERROR:", error.str().c_str() );
+    STRCMP_CONTAINS( ( "Output could not be generated due to errors parsing the input file '" + inputFilename + "'." ).c_str(), error.str().c_str() );
+    CHECK_EQUAL( 0, output.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that an error is displayed if the memory budget is specified without the jobs option
+ */
+TEST( App, MockOutput_MemoryBudgetWithoutJobs )
+{
+    // Prepare
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", "@", "--memory-budget", "1024" };
+
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 1, ret );
+    STRCMP_CONTAINS( "ERROR:", error.str().c_str() );
+    STRCMP_CONTAINS( "The memory budget option (--memory-budget) requires the jobs option (-j).", error.str().c_str() );
+    CHECK_EQUAL( 0, output.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that in watch mode outputs are regenerated reparsing the input files that depend on the changed files
+ */
+TEST( App, MockOutput_Watch )
 {
     // Prepare
     mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
     mock().installCopier( "std::ostream", stdOstreamCopier );
+    mock().installCopier( "std::vector<std::string>", stdVectorOfStringsCopier );
 
     std::ostringstream output;
     std::ostringstream error;
     App app( output, error );
 
-    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", "@", "-u" };
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", "@", "--watch" };
 
     std::vector<std::string> paramOverrideOptions;
     std::vector<std::string> typeOverrideOptions;
-    std::vector<std::string> includePaths;
-    std::vector<std::string> defines;
-    std::string outputText = "#####FOO#####";
+    std::vector<std::string> dependencies = { inputFilename, "foo_types.h" };
+    std::vector<std::string> unrelatedChanges = { "bar.h" };
+    std::vector<std::string> changes = { "foo_types.h" };
+    std::string outputText1 = "#####TEXT1#####";
+    std::string outputText2 = "#####TEXT2#####";
 
-    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", true)
+    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
             .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
             .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
-    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).withParameter("interpretAsCpp", false)
-            .withParameterOfType("std::vector<std::string>", "includePaths", &includePaths)
-			.withParameterOfType("std::vector<std::string>", "defines", &defines).withPointerParameter("error", &error)
+    mock().expectOneCall("Parser::EnableReparse").ignoreOtherParameters();
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText1);
+    mock().expectOneCall("Parser::GetDependencies").ignoreOtherParameters().andReturnValue(&dependencies);
+    mock().expectOneCall("FileWatcher::SetWatchedFiles").withParameterOfType("std::vector<std::string>", "filepaths", &dependencies).ignoreOtherParameters();
+    mock().expectOneCall("FileWatcher::WaitForChanges").withOutputParameterOfTypeReturning("std::vector<std::string>", "changedFilepaths", &unrelatedChanges)
             .ignoreOtherParameters().andReturnValue(true);
-    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "-u ")
-            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+    mock().expectOneCall("Parser::GetDependencies").ignoreOtherParameters().andReturnValue(&dependencies);
+    mock().expectOneCall("FileWatcher::SetWatchedFiles").withParameterOfType("std::vector<std::string>", "filepaths", &dependencies).ignoreOtherParameters();
+    mock().expectOneCall("FileWatcher::WaitForChanges").withOutputParameterOfTypeReturning("std::vector<std::string>", "changedFilepaths", &changes)
+            .ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GetDependencies").ignoreOtherParameters().andReturnValue(&dependencies);
+    mock().expectOneCall("Parser::Reparse").withPointerParameter("error", &error).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText2);
+    mock().expectOneCall("Parser::GetDependencies").ignoreOtherParameters().andReturnValue(&dependencies);
+    mock().expectOneCall("FileWatcher::SetWatchedFiles").withParameterOfType("std::vector<std::string>", "filepaths", &dependencies).ignoreOtherParameters();
+    mock().expectOneCall("FileWatcher::WaitForChanges").ignoreOtherParameters().andReturnValue(false);
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
 
     // Exercise
     int ret = app.Execute( args.size(), args.data() );
 
     // Verify
-    CHECK_EQUAL( 0, ret );
-    STRCMP_EQUAL( outputText.c_str(), output.str().c_str() );
-    CHECK_EQUAL( 0, error.tellp() );
+    CHECK_EQUAL( 1, ret );
+    STRCMP_EQUAL( ( outputText1 + outputText2 ).c_str(), output.str().c_str() );
+    STRCMP_CONTAINS( "Changes to the input files could not be watched.", error.str().c_str() );
 
     // Cleanup
 }
 
 /*
- * Check that include paths are passed properly to the parser
+ * Check that in watch mode the input files following a changed input file are also parsed again, so that a function
+ * removed from the changed input file is then mocked for the next input file that declares it
  */
-TEST( App, MockOutput_IncludePaths )
+TEST( App, MockOutput_WatchOwnershipMoved )
 {
     // Prepare
     mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
     mock().installCopier( "std::ostream", stdOstreamCopier );
+    mock().installCopier( "std::vector<std::string>", stdVectorOfStringsCopier );
 
     std::ostringstream output;
     std::ostringstream error;
     App app( output, error );
 
-    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", "@", "-I", "IncludePath1", "-I", "IncludePath2" };
+    std::string inputFilename2 = "bar.h";
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-i", inputFilename2.c_str(), "-m", "@", "--watch" };
 
     std::vector<std::string> paramOverrideOptions;
     std::vector<std::string> typeOverrideOptions;
-    std::vector<std::string> includePaths = { "IncludePath1", "IncludePath2" };
-	std::vector<std::string> defines;
-    std::string outputText = "#####FOO#####";
+    std::vector<std::string> dependencies1 = { inputFilename };
+    std::vector<std::string> dependencies2 = { inputFilename2 };
+    std::vector<std::string> watchedFilepaths = { inputFilename, inputFilename2 };
+    std::vector<std::string> changes = { inputFilename };
+    std::string outputText1 = "#####FOO1#####";
+    std::string outputText2 = "#####BAR1#####";
+    std::string outputText3 = "#####FOO2#####";
+    std::string outputText4 = "#####BAR2#####";
 
     mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
             .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
             .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
-    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).withParameter("interpretAsCpp", false)
-            .withParameterOfType("std::vector<std::string>", "includePaths", &includePaths)
-			.withParameterOfType("std::vector<std::string>", "defines", &defines).withPointerParameter("error", &error)
+    mock().expectNCalls(2, "Parser::EnableReparse").ignoreOtherParameters();
+    mock().expectNCalls(2, "Parser::EnableSkipWithoutFunctions");
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText1);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename2.c_str()).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText2);
+    mock().expectOneCall("Parser::GetDependencies").ignoreOtherParameters().andReturnValue(&dependencies1);
+    mock().expectOneCall("Parser::GetDependencies").ignoreOtherParameters().andReturnValue(&dependencies2);
+    mock().expectOneCall("FileWatcher::SetWatchedFiles").withParameterOfType("std::vector<std::string>", "filepaths", &watchedFilepaths).ignoreOtherParameters();
+    mock().expectOneCall("FileWatcher::WaitForChanges").withOutputParameterOfTypeReturning("std::vector<std::string>", "changedFilepaths", &changes)
             .ignoreOtherParameters().andReturnValue(true);
-    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "")
-            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+    mock().expectOneCall("Parser::GetDependencies").ignoreOtherParameters().andReturnValue(&dependencies1);
+    mock().expectOneCall("Parser::Reparse").withPointerParameter("error", &error).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText3);
+    mock().expectOneCall("Parser::GetDependencies").ignoreOtherParameters().andReturnValue(&dependencies1);
+    mock().expectOneCall("Parser::GetDependencies").ignoreOtherParameters().andReturnValue(&dependencies2);
+    mock().expectOneCall("Parser::Reparse").withPointerParameter("error", &error).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText4);
+    mock().expectOneCall("Parser::GetDependencies").ignoreOtherParameters().andReturnValue(&dependencies2);
+    mock().expectOneCall("FileWatcher::SetWatchedFiles").withParameterOfType("std::vector<std::string>", "filepaths", &watchedFilepaths).ignoreOtherParameters();
+    mock().expectOneCall("FileWatcher::WaitForChanges").ignoreOtherParameters().andReturnValue(false);
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
 
     // Exercise
     int ret = app.Execute( args.size(), args.data() );
 
     // Verify
-    CHECK_EQUAL( 0, ret );
-    STRCMP_EQUAL( outputText.c_str(), output.str().c_str() );
-    CHECK_EQUAL( 0, error.tellp() );
+    CHECK_EQUAL( 1, ret );
+    STRCMP_EQUAL( ( outputText1 + outputText2 + outputText3 + outputText4 ).c_str(), output.str().c_str() );
+    STRCMP_CONTAINS( "Changes to the input files could not be watched.", error.str().c_str() );
 
     // Cleanup
 }
 
 /*
- * Check that preprocessor macro definitions are passed properly to the parser
+ * Check that in watch mode errors parsing the input files do not stop watching
  */
-TEST( App, MockOutput_Defines )
+TEST( App, MockOutput_WatchParseError )
 {
     // Prepare
     mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
     mock().installCopier( "std::ostream", stdOstreamCopier );
+    mock().installCopier( "std::vector<std::string>", stdVectorOfStringsCopier );
 
     std::ostringstream output;
     std::ostringstream error;
     App app( output, error );
 
-    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", "@", "-D", "DEFINE1", "-D", "DEFINE2" };
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", "@", "--watch" };
 
     std::vector<std::string> paramOverrideOptions;
     std::vector<std::string> typeOverrideOptions;
-	std::vector<std::string> includePaths;
-    std::vector<std::string> defines = { "DEFINE1", "DEFINE2" };
-    std::string outputText = "#####FOO#####";
+    std::vector<std::string> dependencies = { inputFilename };
+    std::string outputText = "#####TEXT1#####";
 
     mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
             .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
             .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
-    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).withParameter("interpretAsCpp", false)
-            .withParameterOfType("std::vector<std::string>", "includePaths", &includePaths)
-			.withParameterOfType("std::vector<std::string>", "defines", &defines).withPointerParameter("error", &error)
+    mock().expectOneCall("Parser::EnableReparse").ignoreOtherParameters();
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).ignoreOtherParameters().andReturnValue(false);
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+    mock().expectOneCall("Parser::GetDependencies").ignoreOtherParameters().andReturnValue(&dependencies);
+    mock().expectOneCall("FileWatcher::SetWatchedFiles").withParameterOfType("std::vector<std::string>", "filepaths", &dependencies).ignoreOtherParameters();
+    mock().expectOneCall("FileWatcher::WaitForChanges").withOutputParameterOfTypeReturning("std::vector<std::string>", "changedFilepaths", &dependencies)
             .ignoreOtherParameters().andReturnValue(true);
-    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "")
+    mock().expectOneCall("Parser::GetDependencies").ignoreOtherParameters().andReturnValue(&dependencies);
+    mock().expectOneCall("Parser::Reparse").withPointerParameter("error", &error).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
             .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+    mock().expectOneCall("Parser::GetDependencies").ignoreOtherParameters().andReturnValue(&dependencies);
+    mock().expectOneCall("FileWatcher::SetWatchedFiles").withParameterOfType("std::vector<std::string>", "filepaths", &dependencies).ignoreOtherParameters();
+    mock().expectOneCall("FileWatcher::WaitForChanges").ignoreOtherParameters().andReturnValue(false);
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
 
     // Exercise
     int ret = app.Execute( args.size(), args.data() );
 
     // Verify
-    CHECK_EQUAL( 0, ret );
+    CHECK_EQUAL( 1, ret );
     STRCMP_EQUAL( outputText.c_str(), output.str().c_str() );
-    CHECK_EQUAL( 0, error.tellp() );
+    STRCMP_CONTAINS( ( "Output could not be generated due to errors parsing the input file '" + inputFilename + "'." ).c_str(), error.str().c_str() );
+    STRCMP_CONTAINS( "Changes to the input files could not be watched.", error.str().c_str() );
 
     // Cleanup
 }
 
 /*
- * Check that include parameter override options are passed properly to the configuration
+ * Check that an error is displayed if the watch option is specified with the jobs option
  */
-TEST( App, MockOutput_paramOverrideOptions )
+TEST( App, MockOutput_WatchWithJobs )
+{
+    // Prepare
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", "@", "--watch", "-j", "2" };
+
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 1, ret );
+    STRCMP_CONTAINS( "ERROR:", error.str().c_str() );
+    STRCMP_CONTAINS( "The watch option (--watch) cannot be used with the jobs option (-j).", error.str().c_str() );
+    CHECK_EQUAL( 0, output.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that in umbrella mode the C and C++ input files are parsed in a single translation unit for each language
+ */
+TEST( App, MockOutput_Umbrella )
 {
     // Prepare
     mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
@@ -588,22 +790,28 @@ TEST( App, MockOutput_paramOverrideOptions )
     std::ostringstream error;
     App app( output, error );
 
-    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", "@", "-p", "foo#bar=String", "-p", "foo@=Int/&$" };
+    std::string inputFilename2 = "bar.hpp";
+    std::string inputFilename3 = "baz.h";
 
-    std::vector<std::string> paramOverrideOptions = { "foo#bar=String", "foo@=Int/&$" };
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-i", inputFilename2.c_str(),
+                                       "-i", inputFilename3.c_str(), "-m", "@", "--umbrella" };
+
+    std::vector<std::string> paramOverrideOptions;
     std::vector<std::string> typeOverrideOptions;
-    std::vector<std::string> includePaths;
-    std::vector<std::string> defines;
-    std::string outputText = "#####FOO#####";
+    std::vector<std::string> cInputFilenames = { inputFilename, inputFilename3 };
+    std::vector<std::string> cppInputFilenames = { inputFilename2 };
+    std::string outputText = "#####TEXT6#####";
 
     mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
             .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
             .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
-    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).withParameter("interpretAsCpp", false)
-            .withParameterOfType("std::vector<std::string>", "includePaths", &includePaths)
-			.withParameterOfType("std::vector<std::string>", "defines", &defines).withPointerParameter("error", &error)
-            .ignoreOtherParameters().andReturnValue(true);
-    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "-p foo#bar=String -p foo@=Int/&$ ")
+    mock().expectNCalls(3, "Parser::EnableSkipWithoutFunctions");
+    mock().expectOneCall("Parser::ParseUmbrella").withParameterOfType("std::vector<std::string>", "inputFilepaths", &cInputFilenames)
+            .withBoolParameter("interpretAsCpp", false).withPointerParameter("error", &error).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::ParseUmbrella").withParameterOfType("std::vector<std::string>", "inputFilepaths", &cppInputFilenames)
+            .withBoolParameter("interpretAsCpp", true).withPointerParameter("error", &error).ignoreOtherParameters().andReturnValue(true);
+    mock().expectNCalls(3, "Parser::IsSkipped").andReturnValue(false);
+    mock().expectNCalls(3, "Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
             .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
 
     // Exercise
@@ -611,16 +819,16 @@ TEST( App, MockOutput_paramOverrideOptions )
 
     // Verify
     CHECK_EQUAL( 0, ret );
-    STRCMP_EQUAL( outputText.c_str(), output.str().c_str() );
+    STRCMP_EQUAL( ( outputText + outputText + outputText ).c_str(), output.str().c_str() );
     CHECK_EQUAL( 0, error.tellp() );
 
     // Cleanup
 }
 
 /*
- * Check that type parameter override options are passed properly to the configuration
+ * Check that in umbrella mode the input files that do not contain any mockable function are skipped
  */
-TEST( App, MockOutput_typeOverrideOptions )
+TEST( App, MockOutput_UmbrellaSkipWithoutFunctions )
 {
     // Prepare
     mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
@@ -630,22 +838,24 @@ TEST( App, MockOutput_typeOverrideOptions )
     std::ostringstream error;
     App app( output, error );
 
-    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", "@", "-t", "#foo=String", "-t", "@const bar=Int/&$" };
+    std::string inputFilename2 = "bar.h";
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-i", inputFilename2.c_str(), "-m", "@", "--umbrella" };
 
     std::vector<std::string> paramOverrideOptions;
-    std::vector<std::string> typeOverrideOptions = { "#foo=String", "@const bar=Int/&$" };
-    std::vector<std::string> includePaths;
-    std::vector<std::string> defines;
+    std::vector<std::string> typeOverrideOptions;
+    std::vector<std::string> cInputFilenames = { inputFilename, inputFilename2 };
     std::string outputText = "#####FOO#####";
 
     mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
             .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
             .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
-    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).withParameter("interpretAsCpp", false)
-            .withParameterOfType("std::vector<std::string>", "includePaths", &includePaths)
-			.withParameterOfType("std::vector<std::string>", "defines", &defines).withPointerParameter("error", &error)
-            .ignoreOtherParameters().andReturnValue(true);
-    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "-t #foo=String -t \"@const bar=Int/&$\" ")
+    mock().expectNCalls(2, "Parser::EnableSkipWithoutFunctions");
+    mock().expectOneCall("Parser::ParseUmbrella").withParameterOfType("std::vector<std::string>", "inputFilepaths", &cInputFilenames)
+            .withBoolParameter("interpretAsCpp", false).withPointerParameter("error", &error).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::IsSkipped").andReturnValue(false);
+    mock().expectOneCall("Parser::IsSkipped").andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
             .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
 
     // Exercise
@@ -660,33 +870,26 @@ TEST( App, MockOutput_typeOverrideOptions )
 }
 
 /*
- * Check that mock generation is requested properly and printed to console
+ * Check that an error is displayed if the input files cannot be parsed in umbrella mode
  */
-TEST( App, MockOutput_ParseError )
+TEST( App, MockOutput_UmbrellaParseError )
 {
     // Prepare
     mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
-    mock().installCopier( "std::ostream", stdOstreamCopier );
 
     std::ostringstream output;
     std::ostringstream error;
     App app( output, error );
 
-    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", "@" };
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", "@", "--umbrella" };
 
     std::vector<std::string> paramOverrideOptions;
     std::vector<std::string> typeOverrideOptions;
-    std::vector<std::string> includePaths;
-    std::vector<std::string> defines;
-    std::string outputText = "#####TEXT4#####";
 
     mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
             .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
             .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
-    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).withParameter("interpretAsCpp", false)
-            .withParameterOfType("std::vector<std::string>", "includePaths", &includePaths)
-			.withParameterOfType("std::vector<std::string>", "defines", &defines).withPointerParameter("error", &error)
-            .ignoreOtherParameters().andReturnValue(false);
+    mock().expectOneCall("Parser::ParseUmbrella").ignoreOtherParameters().andReturnValue(false);
     mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
 
     // Exercise
@@ -695,7 +898,1677 @@ TEST( App, MockOutput_ParseError )
     // Verify
     CHECK_EQUAL( 2, ret );
     STRCMP_CONTAINS( "ERROR:", error.str().c_str() );
-    STRCMP_CONTAINS( ("Output could not be generated due to errors parsing the input file '" + inputFilename + "'").c_str(), error.str().c_str() );
+    STRCMP_CONTAINS( "Output could not be generated due to errors parsing the input files.", error.str().c_str() );
+    CHECK_EQUAL( 0, output.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that only the inputs assigned to the requested shard are processed
+ */
+TEST( App, MockOutput_Shard )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-i", "bar.h", "-i", "baz.h", "-i", "qux.h",
+                                       "-m", "@", "--shard", "2/2" };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::string outputText = "#####TEXT5#####";
+
+    mock().expectNCalls(2, "Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectNCalls(2, "Parser::EnableSkipWithoutFunctions");
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", "qux.h").ignoreOtherParameters().andReturnValue(true);
+    mock().expectNCalls(2, "Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_EQUAL( ( outputText + outputText ).c_str(), output.str().c_str() );
+    CHECK_EQUAL( 0, error.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that workers with different fingerprints files (each one holding only the inputs it processed) still get
+ * disjoint shards that together cover all the inputs
+ */
+TEST( App, MockOutput_ShardDifferentFingerprints )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    outputFilepath = outDirPath + "fingerprints1.txt";
+    std::string fingerprintsFilepath2 = outDirPath + "fingerprints2.txt";
+    std::ofstream( outputFilepath ) << "0000000000000001\tqux.h\tc:@F@f1\tf1()\n"
+                                       "0000000000000002\tqux.h\tc:@F@f2\tf2()\n"
+                                       "0000000000000003\tqux.h\tc:@F@f3\tf3()\n";
+    std::ofstream( fingerprintsFilepath2 ) << "0000000000000004\tbar.h\tc:@F@b1\tb1()\n"
+                                              "0000000000000005\tbar.h\tc:@F@b2\tb2()\n"
+                                              "0000000000000006\tbar.h\tc:@F@b3\tb3()\n";
+
+    std::ostringstream output1;
+    std::ostringstream error1;
+    App app1( output1, error1 );
+    std::ostringstream output2;
+    std::ostringstream error2;
+    App app2( output2, error2 );
+
+    std::vector<const char *> args1 = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-i", "bar.h", "-i", "baz.h", "-i", "qux.h",
+                                        "-m", "@", "--shard", "1/2", "--fingerprints", outputFilepath.c_str() };
+    std::vector<const char *> args2 = { "CppUMockGen.exe", "-i", "qux.h", "-i", "baz.h", "-i", "bar.h", "-i", inputFilename.c_str(),
+                                        "-m", "@", "--shard", "2/2", "--fingerprints", fingerprintsFilepath2.c_str() };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::string outputText = "#####TEXT5#####";
+
+    mock().expectNCalls(4, "Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectNCalls(4, "Parser::EnableSkipWithoutFunctions");
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", "bar.h").ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", "baz.h").ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", "qux.h").ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).ignoreOtherParameters().andReturnValue(true);
+    mock().expectNCalls(4, "Parser::UpdateFingerprints").ignoreOtherParameters();
+    mock().expectNCalls(4, "Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+
+    // Exercise
+    int ret1 = app1.Execute( args1.size(), args1.data() );
+    int ret2 = app2.Execute( args2.size(), args2.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret1 );
+    CHECK_EQUAL( 0, ret2 );
+    STRCMP_EQUAL( ( outputText + outputText ).c_str(), output1.str().c_str() );
+    STRCMP_EQUAL( ( outputText + outputText ).c_str(), output2.str().c_str() );
+
+    // Cleanup
+    std::remove( fingerprintsFilepath2.c_str() );
+}
+
+/*
+ * Check that an error is displayed if the shard option is invalid
+ */
+TEST( App, MockOutput_ShardInvalid )
+{
+    // Prepare
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", "@", "--shard", "3/2" };
+
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 1, ret );
+    STRCMP_CONTAINS( "ERROR:", error.str().c_str() );
+    STRCMP_CONTAINS( "Invalid shard '3/2'", error.str().c_str() );
+    CHECK_EQUAL( 0, output.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that an error is displayed if an output file path is specified for multiple input files
+ */
+TEST( App, MockOutput_MultipleInputsOutputFile )
+{
+    // Prepare
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-i", "bar.h", "-m", mockOutputFilePath.c_str() };
+
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 1, ret );
+    STRCMP_CONTAINS( "ERROR:", error.str().c_str() );
+    STRCMP_CONTAINS( "When multiple input files are specified, output paths must be directories.", error.str().c_str() );
+    CHECK_EQUAL( 0, output.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that if the output file cannot be opened, an error is displayed
+ */
+TEST( App, MockOutput_CannotOpenFile )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::string outputDir = outDirPath + "NonExistantDirectory123898876354874" + PATH_SEPARATOR;
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", outputDir.c_str() };
+
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+   // Exercise
+   int ret = app.Execute( args.size(), args.data() );
+
+   // Verify
+   CHECK_EQUAL( 1, ret );
+   STRCMP_CONTAINS( "ERROR:", error.str().c_str() );
+   STRCMP_CONTAINS( ("Mock output file '" + outputDir + mockOutputFilename + "' could not be opened").c_str(), error.str().c_str() );
+   CHECK_EQUAL( 0, output.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that parsing in C++ mode is requested properly
+ */
+TEST( App, MockOutput_InterpretAsCpp )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", "@", "-x" };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::vector<std::string> includePaths;
+    std::vector<std::string> defines;
+    std::string outputText = "#####FOO#####";
+
+    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).withParameter("interpretAsCpp", true)
+            .withParameterOfType("std::vector<std::string>", "includePaths", &includePaths)
+			.withParameterOfType("std::vector<std::string>", "defines", &defines).withPointerParameter("error", &error)
+            .ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "-x ").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_EQUAL( outputText.c_str(), output.str().c_str() );
+    CHECK_EQUAL( 0, error.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that using underlying typedef types is requested properly
+ */
+TEST( App, MockOutput_UseUnderlyingTypedefType )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", "@", "-u" };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::vector<std::string> includePaths;
+    std::vector<std::string> defines;
+    std::string outputText = "#####FOO#####";
+
+    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", true)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).withParameter("interpretAsCpp", false)
+            .withParameterOfType("std::vector<std::string>", "includePaths", &includePaths)
+			.withParameterOfType("std::vector<std::string>", "defines", &defines).withPointerParameter("error", &error)
+            .ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "-u ").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_EQUAL( outputText.c_str(), output.str().c_str() );
+    CHECK_EQUAL( 0, error.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that include paths are passed properly to the parser
+ */
+TEST( App, MockOutput_IncludePaths )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", "@", "-I", "IncludePath1", "-I", "IncludePath2" };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::vector<std::string> includePaths = { "IncludePath1", "IncludePath2" };
+	std::vector<std::string> defines;
+    std::string outputText = "#####FOO#####";
+
+    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).withParameter("interpretAsCpp", false)
+            .withParameterOfType("std::vector<std::string>", "includePaths", &includePaths)
+			.withParameterOfType("std::vector<std::string>", "defines", &defines).withPointerParameter("error", &error)
+            .ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_EQUAL( outputText.c_str(), output.str().c_str() );
+    CHECK_EQUAL( 0, error.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that preprocessor macro definitions are passed properly to the parser
+ */
+TEST( App, MockOutput_Defines )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", "@", "-D", "DEFINE1", "-D", "DEFINE2" };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+	std::vector<std::string> includePaths;
+    std::vector<std::string> defines = { "DEFINE1", "DEFINE2" };
+    std::string outputText = "#####FOO#####";
+
+    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).withParameter("interpretAsCpp", false)
+            .withParameterOfType("std::vector<std::string>", "includePaths", &includePaths)
+			.withParameterOfType("std::vector<std::string>", "defines", &defines).withPointerParameter("error", &error)
+            .ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_EQUAL( outputText.c_str(), output.str().c_str() );
+    CHECK_EQUAL( 0, error.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that include parameter override options are passed properly to the configuration
+ */
+TEST( App, MockOutput_paramOverrideOptions )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", "@", "-p", "foo#bar=String", "-p", "foo@=Int/&$" };
+
+    std::vector<std::string> paramOverrideOptions = { "foo#bar=String", "foo@=Int/&$" };
+    std::vector<std::string> typeOverrideOptions;
+    std::vector<std::string> includePaths;
+    std::vector<std::string> defines;
+    std::string outputText = "#####FOO#####";
+
+    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).withParameter("interpretAsCpp", false)
+            .withParameterOfType("std::vector<std::string>", "includePaths", &includePaths)
+			.withParameterOfType("std::vector<std::string>", "defines", &defines).withPointerParameter("error", &error)
+            .ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "-p foo#bar=String -p foo@=Int/&$ ").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_EQUAL( outputText.c_str(), output.str().c_str() );
+    CHECK_EQUAL( 0, error.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that type parameter override options are passed properly to the configuration
+ */
+TEST( App, MockOutput_typeOverrideOptions )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", "@", "-t", "#foo=String", "-t", "@const bar=Int/&$" };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions = { "#foo=String", "@const bar=Int/&$" };
+    std::vector<std::string> includePaths;
+    std::vector<std::string> defines;
+    std::string outputText = "#####FOO#####";
+
+    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).withParameter("interpretAsCpp", false)
+            .withParameterOfType("std::vector<std::string>", "includePaths", &includePaths)
+			.withParameterOfType("std::vector<std::string>", "defines", &defines).withPointerParameter("error", &error)
+            .ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "-t #foo=String -t \"@const bar=Int/&$\" ").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_EQUAL( outputText.c_str(), output.str().c_str() );
+    CHECK_EQUAL( 0, error.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that an output file that already has the generated contents is not rewritten
+ */
+TEST( App, MockOutput_Unchanged )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    outputFilepath = mockOutputFilePath;
+    std::string outputText = "#####TEXT1#####";
+    std::ofstream( outputFilepath ) << outputText;
+
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", outDirPath.c_str() };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+
+    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_CONTAINS( ("Mock generated into '" + outputFilepath + "' (unchanged)").c_str(), error.str().c_str() );
+    CHECK( CheckFileContains( outputFilepath, outputText ) );
+
+    // Cleanup
+}
+
+/*
+ * Check that function fingerprints are updated and saved when requested
+ */
+TEST( App, MockOutput_Fingerprints )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    outputFilepath = outDirPath + "fingerprints.txt";
+    std::remove( outputFilepath.c_str() );
+
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", "@", "--profile",
+                                       "--fingerprints", outputFilepath.c_str() };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::string outputText = "#####FOO#####";
+
+    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::UpdateFingerprints").withStringParameter("genOpts", "--profile ").withBoolParameter("profiling", true)
+            .withBoolParameter("recordReplay", false).ignoreOtherParameters();
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "--profile ").withBoolParameter("profiling", true).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_EQUAL( outputText.c_str(), output.str().c_str() );
+    CHECK_EQUAL( 0, error.tellp() );
+    CHECK( CheckFileContains( outputFilepath, "" ) );
+
+    // Cleanup
+}
+
+/*
+ * Check that profiling instrumentation is requested properly
+ */
+TEST( App, MockOutput_Profiling )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", "@", "--profile" };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::vector<std::string> includePaths;
+    std::vector<std::string> defines;
+    std::string outputText = "#####FOO#####";
+
+    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).withParameter("interpretAsCpp", false)
+            .withParameterOfType("std::vector<std::string>", "includePaths", &includePaths)
+            .withParameterOfType("std::vector<std::string>", "defines", &defines).withPointerParameter("error", &error)
+            .ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "--profile ").withBoolParameter("profiling", true).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_EQUAL( outputText.c_str(), output.str().c_str() );
+    CHECK_EQUAL( 0, error.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that record and replay paths are requested properly
+ */
+TEST( App, MockOutput_RecordReplay )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", "@", "--record-replay" };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::vector<std::string> includePaths;
+    std::vector<std::string> defines;
+    std::string outputText = "#####FOO#####";
+
+    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).withParameter("interpretAsCpp", false)
+            .withParameterOfType("std::vector<std::string>", "includePaths", &includePaths)
+            .withParameterOfType("std::vector<std::string>", "defines", &defines).withPointerParameter("error", &error)
+            .ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "--record-replay ").withBoolParameter("profiling", false).withBoolParameter("recordReplay", true)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_EQUAL( outputText.c_str(), output.str().c_str() );
+    CHECK_EQUAL( 0, error.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that comparators and copiers for POD record types are requested properly
+ */
+TEST( App, ExpectOutput_PodComparators )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-e", "@", "--pod-comparators" };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::string headerText = "#####HEADER#####";
+    std::string implText = "#####IMPL#####";
+
+    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).withParameter("interpretAsCpp", false)
+            .withPointerParameter("error", &error).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateExpectationHeader").withStringParameter("genOpts", "--pod-comparators ")
+            .withBoolParameter("podComparators", true).withOutputParameterOfTypeReturning("std::ostream", "output", &headerText)
+            .ignoreOtherParameters();
+    mock().expectOneCall("Parser::GenerateExpectationImpl").withStringParameter("genOpts", "--pod-comparators ")
+            .withBoolParameter("profiling", false).withBoolParameter("podComparators", true)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &implText).ignoreOtherParameters();
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_EQUAL( ( headerText + implText ).c_str(), output.str().c_str() );
+    CHECK_EQUAL( 0, error.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that parsing only the input file is requested properly
+ */
+TEST( App, MockOutput_SingleFile )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", "@", "--single-file" };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::vector<std::string> includePaths;
+    std::vector<std::string> defines;
+    std::string outputText = "#####FOO#####";
+
+    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectOneCall("Parser::EnableSingleFileParse");
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).withParameter("interpretAsCpp", false)
+            .withParameterOfType("std::vector<std::string>", "includePaths", &includePaths)
+            .withParameterOfType("std::vector<std::string>", "defines", &defines).withPointerParameter("error", &error)
+            .ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "--single-file ").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_EQUAL( outputText.c_str(), output.str().c_str() );
+    CHECK_EQUAL( 0, error.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that an error is displayed if parsing only the input files is requested in umbrella mode
+ */
+TEST( App, MockOutput_SingleFileWithUmbrella )
+{
+    // Prepare
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", "@", "--umbrella", "--single-file" };
+
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 1, ret );
+    STRCMP_CONTAINS( "ERROR:", error.str().c_str() );
+    STRCMP_CONTAINS( "The umbrella option (--umbrella) cannot be used with the single file option (--single-file).", error.str().c_str() );
+    CHECK_EQUAL( 0, output.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that the input file '-' is read from the standard input and given the requested virtual name
+ */
+TEST( App, MockOutput_Stdin )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::istringstream input( "void function1(int a);\n" );
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error, input );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", "-", "--stdin-name", "regmap.h", "-m", "@" };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::string outputText = "#####FOO#####";
+
+    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectOneCall("Parser::SetInputContents").withStringParameter("contents", "void function1(int a);\n");
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", "regmap.h").withParameter("interpretAsCpp", false)
+            .withPointerParameter("error", &error).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_EQUAL( outputText.c_str(), output.str().c_str() );
+    CHECK_EQUAL( 0, error.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that an error is displayed if the standard input is used as input file in watch mode
+ */
+TEST( App, MockOutput_StdinWithWatch )
+{
+    // Prepare
+    std::istringstream input( "void function1(int a);\n" );
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error, input );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", "-", "-m", "@", "--watch" };
+
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 1, ret );
+    STRCMP_CONTAINS( "ERROR:", error.str().c_str() );
+    STRCMP_CONTAINS( "The standard input (-) cannot be used as input file with the watch option (--watch) or the umbrella option (--umbrella).", error.str().c_str() );
+    CHECK_EQUAL( 0, output.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that the symbols list is read and passed properly
+ */
+TEST( App, MockOutput_Symbols )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    outputFilepath = outDirPath + "foo_symbols.txt";
+    std::ofstream symbolsFile( outputFilepath );
+    symbolsFile << "test.o:" << std::endl;
+    symbolsFile << "                 U function1" << std::endl;
+    symbolsFile << "                 U _ZN5Class7method1Ei" << std::endl;
+    symbolsFile << "                 U memcpy@GLIBC_2.14" << std::endl;
+    symbolsFile.close();
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", "@", "--symbols", outputFilepath.c_str() };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::vector<std::string> includePaths;
+    std::vector<std::string> defines;
+    std::vector<std::string> symbols = { "function1", "_ZN5Class7method1Ei", "memcpy" };
+    std::string outputText = "#####FOO#####";
+
+    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).withParameter("interpretAsCpp", false)
+            .withParameterOfType("std::vector<std::string>", "includePaths", &includePaths)
+            .withParameterOfType("std::vector<std::string>", "defines", &defines)
+            .withParameterOfType("std::vector<std::string>", "symbols", &symbols).withPointerParameter("error", &error)
+            .ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", ( "--symbols " + outputFilepath + " " ).c_str()).withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_EQUAL( outputText.c_str(), output.str().c_str() );
+    CHECK_EQUAL( 0, error.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that an error is reported if the symbols list file can't be opened
+ */
+TEST( App, MockOutput_SymbolsCannotOpenFile )
+{
+    // Prepare
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::string symbolsFilepath = outDirPath + "NonExistantSymbolsFile123898876354874.txt";
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", "@", "--symbols", symbolsFilepath.c_str() };
+
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 1, ret );
+    STRCMP_CONTAINS( "ERROR:", error.str().c_str() );
+    STRCMP_CONTAINS( ("Symbols file '" + symbolsFilepath + "' could not be opened").c_str(), error.str().c_str() );
+    CHECK_EQUAL( 0, output.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that mock generation is requested properly and printed to console
+ */
+TEST( App, MockOutput_ParseError )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-m", "@" };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::vector<std::string> includePaths;
+    std::vector<std::string> defines;
+    std::string outputText = "#####TEXT4#####";
+
+    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).withParameter("interpretAsCpp", false)
+            .withParameterOfType("std::vector<std::string>", "includePaths", &includePaths)
+			.withParameterOfType("std::vector<std::string>", "defines", &defines).withPointerParameter("error", &error)
+            .ignoreOtherParameters().andReturnValue(false);
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 2, ret );
+    STRCMP_CONTAINS( "ERROR:", error.str().c_str() );
+    STRCMP_CONTAINS( ("Output could not be generated due to errors parsing the input file '" + inputFilename + "'").c_str(), error.str().c_str() );
+    CHECK_EQUAL( 0, output.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that the libclang path option is passed properly
+ */
+TEST( App, LibClangPath )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", "foo.h", "-m", "@", "--libclang", "/opt/llvm/lib/libclang.so" };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::string outputText = "#####FOO#####";
+
+    mock().expectOneCall("SetLibClangPath").withStringParameter("libraryPath", "/opt/llvm/lib/libclang.so");
+    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", "foo.h").withParameter("interpretAsCpp", false)
+            .withPointerParameter("error", &error).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_EQUAL( outputText.c_str(), output.str().c_str() );
+    CHECK_EQUAL( 0, error.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that the generated outputs are verified when requested
+ */
+TEST( App, Verify )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installComparator( "std::vector<OutputVerifier::GeneratedFile>", generatedFilesComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", "foo.h", "-m", "@", "-I", "/cpputest/include", "--verify" };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::vector<std::string> includePaths = { "/cpputest/include" };
+    std::vector<std::string> includeFiles;
+    std::string outputText = "#####FOO#####";
+    std::vector<OutputVerifier::GeneratedFile> files = { { "foo_mock.cpp", outputText, true } };
+    std::string verifyError = "";
+
+    mock().expectOneCall("OutputVerifier::OutputVerifier")
+            .withParameterOfType("std::vector<std::string>", "includePaths", &includePaths)
+            .withParameterOfType("std::vector<std::string>", "includeFiles", &includeFiles);
+    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", "foo.h").withParameter("interpretAsCpp", false)
+            .withPointerParameter("error", &error).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+    mock().expectOneCall("OutputVerifier::Verify").withStringParameter("inputFilepath", "foo.h")
+            .withConstPointerParameter("inputContents", nullptr)
+            .withParameterOfType("std::vector<OutputVerifier::GeneratedFile>", "files", &files)
+            .withOutputParameterOfTypeReturning("std::ostream", "error", &verifyError).andReturnValue(true);
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_EQUAL( outputText.c_str(), output.str().c_str() );
+    STRCMP_CONTAINS( "SUCCESS:", error.str().c_str() );
+    STRCMP_CONTAINS( "Outputs generated for 'foo.h' verified", error.str().c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that an error is reported when the generated outputs do not compile
+ */
+TEST( App, Verify_Error )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installComparator( "std::vector<OutputVerifier::GeneratedFile>", generatedFilesComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", "foo.h", "-e", "@", "--verify" };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::string headerText = "#####HEADER#####";
+    std::string implText = "#####IMPL#####";
+    std::vector<OutputVerifier::GeneratedFile> files = { { "@", headerText, false }, { "foo_expect.cpp", implText, true } };
+    std::string verifyError = "VERIFY ERROR: foo_expect.cpp:10:5: error: bar\n";
+
+    mock().expectOneCall("OutputVerifier::OutputVerifier").ignoreOtherParameters();
+    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", "foo.h").withParameter("interpretAsCpp", false)
+            .withPointerParameter("error", &error).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateExpectationHeader").withStringParameter("genOpts", "").ignoreOtherParameters()
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &headerText);
+    mock().expectOneCall("Parser::GenerateExpectationImpl").withStringParameter("genOpts", "").ignoreOtherParameters()
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &implText);
+    mock().expectOneCall("OutputVerifier::Verify").withStringParameter("inputFilepath", "foo.h")
+            .withConstPointerParameter("inputContents", nullptr)
+            .withParameterOfType("std::vector<OutputVerifier::GeneratedFile>", "files", &files)
+            .withOutputParameterOfTypeReturning("std::ostream", "error", &verifyError).andReturnValue(false);
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 1, ret );
+    STRCMP_EQUAL( ( headerText + implText ).c_str(), output.str().c_str() );
+    STRCMP_CONTAINS( verifyError.c_str(), error.str().c_str() );
+    STRCMP_CONTAINS( "ERROR:", error.str().c_str() );
+    STRCMP_CONTAINS( "The outputs generated for the input file 'foo.h' do not compile.", error.str().c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that the resources used to parse each input file are reported
+ */
+TEST( App, ResourceReport )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    outputFilepath = outDirPath + "CppUMockGen_resources.csv";
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", "foo.h", "-m", "@", "--resource-report", outputFilepath.c_str() };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::string outputText = "#####FOO#####";
+
+    Parser::Statistics statistics;
+    statistics.functionCount = 3;
+    statistics.memoryUsage = 1000;
+    statistics.astMemoryUsage = 400;
+    statistics.identifiersMemoryUsage = 100;
+    statistics.preprocessorMemoryUsage = 200;
+    statistics.sourceManagerMemoryUsage = 300;
+
+    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", "foo.h").withParameter("interpretAsCpp", false)
+            .withPointerParameter("error", &error).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GetStatistics").ignoreOtherParameters().andReturnValue( (const void*) &statistics );
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_EQUAL( outputText.c_str(), output.str().c_str() );
+    CHECK_EQUAL( 0, error.tellp() );
+
+    std::ifstream reportFile( outputFilepath );
+    std::string header;
+    std::string line;
+    std::getline( reportFile, header );
+    std::getline( reportFile, line );
+    STRCMP_EQUAL( "input,functions,parseSeconds,modelSeconds,tuMemoryBytes,astMemoryBytes,identifiersMemoryBytes,"
+                  "preprocessorMemoryBytes,sourceManagerMemoryBytes,peakRssBytes", header.c_str() );
+    STRCMP_CONTAINS( "foo.h,3,0,0,1000,400,100,200,300,", line.c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that the generation phases are written to the trace file
+ */
+TEST( App, Trace )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    outputFilepath = outDirPath + "CppUMockGen_trace.json";
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", "foo.h", "-m", "@", "--trace", outputFilepath.c_str() };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::string outputText = "#####FOO#####";
+
+    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", "foo.h").withParameter("interpretAsCpp", false)
+            .withPointerParameter("error", &error).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_EQUAL( outputText.c_str(), output.str().c_str() );
+    CHECK_EQUAL( 0, error.tellp() );
+    CHECK_FALSE( TraceRecorder::IsEnabled() );
+
+    std::ifstream traceFile( outputFilepath );
+    std::ostringstream trace;
+    trace << traceFile.rdbuf();
+    STRCMP_CONTAINS( "{\"name\":\"emission\",", trace.str().c_str() );
+    STRCMP_CONTAINS( "\"args\":{\"file\":\"foo.h\",\"output\":\"mock\",\"bytes\":13}", trace.str().c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that an input file that cannot declare any mockable function is not parsed
+ */
+TEST( App, MockOutput_Prefilter )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+
+    std::istringstream input( "#define FOO(x) bar(x)\ntypedef int baz;\nstatic inline int qux(void) { return 0; }\n" );
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error, input );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", "-", "-m", "@" };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+
+    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectOneCall("Parser::SetInputContents").ignoreOtherParameters();
+    mock().expectOneCall("Parser::ReportNoMockableFunctions").withStringParameter("inputFileDescription", "The input file")
+            .withBoolParameter("symbolsListed", false).withPointerParameter("error", &error).withBoolParameter("skipped", false);
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 2, ret );
+    STRCMP_CONTAINS( "Output could not be generated due to errors parsing the input file 'stdin.h'", error.str().c_str() );
+    CHECK_EQUAL( 0, output.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that input files are always parsed if the pre-filter is disabled
+ */
+TEST( App, MockOutput_NoPrefilter )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::istringstream input( "#define FUNCTION_DECLARATION void function1(int a)\n" );
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error, input );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", "-", "-m", "@", "--no-prefilter" };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::string outputText = "#####FOO#####";
+
+    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectOneCall("Parser::SetInputContents").ignoreOtherParameters();
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", "stdin.h").withParameter("interpretAsCpp", false)
+            .withPointerParameter("error", &error).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_EQUAL( outputText.c_str(), output.str().c_str() );
+    CHECK_EQUAL( 0, error.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that when several input files are specified, those that cannot declare any mockable function are skipped
+ */
+TEST( App, MockOutput_PrefilterMultipleInputs )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::istringstream input( "#define FOO(x) bar(x)\ntypedef int baz;\n" );
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error, input );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", "-", "-i", inputFilename.c_str(), "-m", "@" };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::string outputText = "#####FOO#####";
+
+    mock().expectNCalls(2, "Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectOneCall("Parser::SetInputContents").ignoreOtherParameters();
+    mock().expectOneCall("Parser::ReportNoMockableFunctions").withStringParameter("inputFileDescription", "The input file 'stdin.h'")
+            .withBoolParameter("symbolsListed", false).withPointerParameter("error", &error).withBoolParameter("skipped", true);
+    mock().expectOneCall("Parser::EnableSkipWithoutFunctions");
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).withParameter("interpretAsCpp", false)
+            .withPointerParameter("error", &error).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_EQUAL( outputText.c_str(), output.str().c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that when several input files are processed by the batch executor, those that cannot declare any mockable
+ * function are skipped
+ */
+TEST( App, MockOutput_PrefilterJobs )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::istringstream input( "#define FOO(x) bar(x)\ntypedef int baz;\n" );
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error, input );
+
+    // A single job is used, because mocks are not thread-safe
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", "-", "-i", inputFilename.c_str(), "-m", "@", "-j", "1" };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::string outputText = "#####FOO#####";
+
+    mock().expectNCalls(2, "Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectOneCall("Parser::SetInputContents").ignoreOtherParameters();
+    mock().expectOneCall("Parser::ReportNoMockableFunctions").withStringParameter("inputFileDescription", "The input file 'stdin.h'")
+            .withBoolParameter("symbolsListed", false).withBoolParameter("skipped", true).ignoreOtherParameters();
+    mock().expectOneCall("Parser::EnableSkipWithoutFunctions");
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::RemoveEmittedFunctions").withPointerParameter("error", &error).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_EQUAL( outputText.c_str(), output.str().c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that when several input files are specified, those that pass the pre-filter but do not contain any mockable
+ * function once parsed are skipped
+ */
+TEST( App, MockOutput_SkipWithoutFunctions )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::string inputFilename2 = "bar.h";
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-i", inputFilename2.c_str(), "-m", "@" };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::string outputText = "#####BAR#####";
+
+    mock().expectNCalls(2, "Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectNCalls(2, "Parser::EnableSkipWithoutFunctions");
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).ignoreOtherParameters().andReturnValue(false);
+    mock().expectOneCall("Parser::IsSkipped").andReturnValue(true);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename2.c_str()).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_EQUAL( outputText.c_str(), output.str().c_str() );
+    CHECK_EQUAL( 0, error.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that when several input files are processed by the batch executor, those whose functions have all been
+ * removed are skipped
+ */
+TEST( App, MockOutput_SkipWithoutFunctionsJobs )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::string inputFilename2 = "bar.h";
+
+    // A single job is used, because mocks are not thread-safe
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilename.c_str(), "-i", inputFilename2.c_str(), "-m", "@", "-j", "1" };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::string outputText = "#####BAR#####";
+
+    mock().expectNCalls(2, "Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectNCalls(2, "Parser::EnableSkipWithoutFunctions");
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename2.c_str()).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::RemoveEmittedFunctions").withPointerParameter("error", &error).ignoreOtherParameters().andReturnValue(false);
+    mock().expectOneCall("Parser::IsSkipped").andReturnValue(true);
+    mock().expectOneCall("Parser::RemoveEmittedFunctions").withPointerParameter("error", &error).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_EQUAL( outputText.c_str(), output.str().c_str() );
+    CHECK_EQUAL( 0, error.tellp() );
+
+    // Cleanup
+}
+
+/*
+ * Check that when several input files are specified without pre-filtering, those that only define types are parsed
+ * and then skipped
+ */
+TEST( App, MockOutput_NoPrefilterMultipleInputs )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::istringstream input( "typedef int baz;\nenum qux { QUX1, QUX2 };\n" );
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error, input );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", "-", "-i", inputFilename.c_str(), "-m", "@", "--no-prefilter" };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::string outputText = "#####FOO#####";
+
+    mock().expectNCalls(2, "Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectOneCall("Parser::SetInputContents").ignoreOtherParameters();
+    mock().expectNCalls(2, "Parser::EnableSkipWithoutFunctions");
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", "stdin.h").ignoreOtherParameters().andReturnValue(false);
+    mock().expectOneCall("Parser::IsSkipped").andReturnValue(true);
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilename.c_str()).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_EQUAL( outputText.c_str(), output.str().c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that the outputs of an input file are not regenerated if only its comments or whitespace changed
+ */
+TEST( App, MockOutput_SkipUnchanged )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::string inputFilepath = outDirPath + inputFilename;
+    std::string stampFilepath = mockOutputFilePath + ".stamp";
+    std::ofstream( inputFilepath ) << "int function1(int a);\n";
+    outputFilepath = mockOutputFilePath;
+    std::remove( outputFilepath.c_str() );
+    std::remove( stampFilepath.c_str() );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilepath.c_str(), "-m", outDirPath.c_str(), "--skip-unchanged" };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::vector<std::string> dependencies = { inputFilepath };
+    std::string outputText = "#####FOO#####";
+
+    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectOneCall("Parser::EnableDependencyTracking").ignoreOtherParameters();
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilepath.c_str()).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText);
+    mock().expectOneCall("Parser::GetDependencies").ignoreOtherParameters().andReturnValue(&dependencies);
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    std::ostringstream output1;
+    std::ostringstream error1;
+    App app1( output1, error1 );
+    int ret1 = app1.Execute( args.size(), args.data() );
+
+    CHECK_EQUAL( 0, ret1 );
+    STRCMP_CONTAINS( ("Mock generated into '" + outputFilepath + "'").c_str(), error1.str().c_str() );
+    mock().checkExpectations();
+
+    std::ofstream( inputFilepath ) << "/* Function 1 */\nint  function1( int a );\n";
+
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_CONTAINS( ("Outputs for '" + inputFilepath + "' are up to date").c_str(), error.str().c_str() );
+    CHECK( CheckFileContains( outputFilepath, outputText ) );
+
+    // Cleanup
+    std::remove( inputFilepath.c_str() );
+    std::remove( stampFilepath.c_str() );
+}
+
+/*
+ * Check that the outputs of an input file are regenerated if its tokens changed
+ */
+TEST( App, MockOutput_SkipUnchangedModified )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::string inputFilepath = outDirPath + inputFilename;
+    std::string stampFilepath = mockOutputFilePath + ".stamp";
+    std::ofstream( inputFilepath ) << "int function1(int a);\n";
+    outputFilepath = mockOutputFilePath;
+    std::remove( outputFilepath.c_str() );
+    std::remove( stampFilepath.c_str() );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "-i", inputFilepath.c_str(), "-m", outDirPath.c_str(), "--skip-unchanged" };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::vector<std::string> dependencies = { inputFilepath };
+    std::string outputText1 = "#####FOO#####";
+    std::string outputText2 = "#####BAR#####";
+
+    mock().expectNCalls(2, "Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectNCalls(2, "Parser::EnableDependencyTracking").ignoreOtherParameters();
+    mock().expectNCalls(2, "Parser::Parse").withParameter("inputFilepath", inputFilepath.c_str()).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText1);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText2);
+    mock().expectNCalls(2, "Parser::GetDependencies").ignoreOtherParameters().andReturnValue(&dependencies);
+    mock().expectNCalls(4, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    std::ostringstream output1;
+    std::ostringstream error1;
+    App app1( output1, error1 );
+    CHECK_EQUAL( 0, app1.Execute( args.size(), args.data() ) );
+
+    std::ofstream( inputFilepath ) << "int function1(long a);\n";
+
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    STRCMP_CONTAINS( ("Mock generated into '" + outputFilepath + "'").c_str(), error.str().c_str() );
+    CHECK( CheckFileContains( outputFilepath, outputText2 ) );
+
+    // Cleanup
+    std::remove( inputFilepath.c_str() );
+    std::remove( stampFilepath.c_str() );
+}
+
+/*
+ * Check that the headers found in an input directory tree are processed, mirroring its layout in the output directory
+ * and including them by their path relative to its root, and that those that cannot declare any mockable function are
+ * skipped
+ */
+TEST( App, MockOutput_InputDir )
+{
+    // Prepare
+    mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+    mock().installCopier( "std::ostream", stdOstreamCopier );
+
+    std::string inputDirPath = outDirPath + "include";
+    std::string inputSubdirPath = inputDirPath + PATH_SEPARATOR + "sub";
+    std::string inputFilepath1 = inputDirPath + PATH_SEPARATOR + "foo.h";
+    std::string inputFilepath2 = inputSubdirPath + PATH_SEPARATOR + "bar.h";
+    std::string ignoredFilepath = inputSubdirPath + PATH_SEPARATOR + "bar.c";
+    std::string typesFilepath = inputSubdirPath + PATH_SEPARATOR + "types.h";
+    std::string typesDescription = "The input file '" + typesFilepath + "'";
+    std::string mockDirPath = outDirPath + "mocks" + PATH_SEPARATOR;
+    std::string mockFilepath1 = mockDirPath + "foo_mock.cpp";
+    std::string mockFilepath2 = mockDirPath + "sub" + PATH_SEPARATOR + "bar_mock.cpp";
+
+    CreateDirectories( inputSubdirPath );
+    std::ofstream( inputFilepath1 ) << "void function1(int a);\n";
+    std::ofstream( inputFilepath2 ) << "void function2(int a);\n";
+    std::ofstream( ignoredFilepath ) << "void function2(int a) {}\n";
+    std::ofstream( typesFilepath ) << "typedef int baz;\nenum qux { QUX1, QUX2 };\n";
+
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "--input-dir", inputDirPath.c_str(), "-m", mockDirPath.c_str() };
+
+    std::vector<std::string> paramOverrideOptions;
+    std::vector<std::string> typeOverrideOptions;
+    std::string outputText1 = "#####FOO#####";
+    std::string outputText2 = "#####BAR#####";
+
+    mock().expectNCalls(3, "Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &typeOverrideOptions);
+    mock().expectNCalls(2, "Parser::EnableSkipWithoutFunctions");
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilepath1.c_str()).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText1);
+    mock().expectOneCall("Parser::SetIncludePath").withStringParameter("includePath", "sub/bar.h").ignoreOtherParameters();
+    mock().expectOneCall("Parser::Parse").withParameter("inputFilepath", inputFilepath2.c_str()).ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &outputText2);
+    mock().expectOneCall("Parser::ReportNoMockableFunctions").withStringParameter("inputFileDescription", typesDescription.c_str())
+            .withBoolParameter("symbolsListed", false).withPointerParameter("error", &error).withBoolParameter("skipped", true);
+    mock().expectNCalls(4, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 0, ret );
+    CHECK( CheckFileContains( mockFilepath1, outputText1 ) );
+    CHECK( CheckFileContains( mockFilepath2, outputText2 ) );
+    CHECK( !std::ifstream( mockDirPath + "sub" + PATH_SEPARATOR + "types_mock.cpp" ).is_open() );
+
+    // Cleanup
+    std::remove( mockFilepath1.c_str() );
+    std::remove( mockFilepath2.c_str() );
+    rmdir( ( mockDirPath + "sub" ).c_str() );
+    rmdir( mockDirPath.c_str() );
+    std::remove( inputFilepath1.c_str() );
+    std::remove( inputFilepath2.c_str() );
+    std::remove( ignoredFilepath.c_str() );
+    std::remove( typesFilepath.c_str() );
+    rmdir( inputSubdirPath.c_str() );
+    rmdir( inputDirPath.c_str() );
+}
+
+/*
+ * Check that output paths must be directories when an input directory is specified
+ */
+TEST( App, MockOutput_InputDirOutputFile )
+{
+    // Prepare
+    std::ostringstream output;
+    std::ostringstream error;
+    App app( output, error );
+
+    std::vector<const char *> args = { "CppUMockGen.exe", "--input-dir", outDirPath.c_str(), "-m", "foo_mock.cpp" };
+
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    // Exercise
+    int ret = app.Execute( args.size(), args.data() );
+
+    // Verify
+    CHECK_EQUAL( 1, ret );
+    STRCMP_CONTAINS( "When an input directory is specified, output paths must be directories.", error.str().c_str() );
     CHECK_EQUAL( 0, output.tellp() );
 
     // Cleanup
@@ -0,0 +1 @@
+#define PRODUCT_VERSION_MAJOR_MINOR_PATCH_STR  "F.O.O"
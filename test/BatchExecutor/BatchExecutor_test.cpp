@@ -0,0 +1,323 @@
+/**
+ * @file
+ * @brief      Unit tests for the "BatchExecutor" class
+ * @project    CppUMockGen
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2018 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef WIN32
+#include <unistd.h>
+#endif
+
+#include "BatchExecutor.hpp"
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+static const size_t JOB_COUNT = 20;
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( BatchExecutor )
+{
+    std::atomic<int> runningJobs;
+    std::atomic<int> maxRunningJobs;
+    std::vector<size_t> orderedJobs;
+
+    TEST_SETUP()
+    {
+        runningJobs = 0;
+        maxRunningJobs = 0;
+    }
+
+    void RunJob( size_t job )
+    {
+        int running = ++runningJobs;
+        int maxRunning = maxRunningJobs;
+        while( ( running > maxRunning ) && !maxRunningJobs.compare_exchange_weak( maxRunning, running ) )
+        {
+        }
+
+        // Jobs take different times to finish, so that they do not finish in order
+        std::this_thread::sleep_for( std::chrono::milliseconds( 5 + ( ( job * 7 ) % 20 ) ) );
+
+        runningJobs--;
+    }
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+/*
+ * Check that the maximum number of jobs is taken from the number of hardware threads when not given.
+ */
+TEST( BatchExecutor, MaxJobs )
+{
+    // Exercise
+    BatchExecutor executor1( 3, 0, nullptr );
+    BatchExecutor executor2( 0, 0, nullptr );
+
+    // Verify
+    UNSIGNED_LONGS_EQUAL( 3, executor1.GetMaxJobs() );
+    UNSIGNED_LONGS_EQUAL( 0, executor1.GetMemoryBudget() );
+    CHECK_TRUE( executor2.GetMaxJobs() >= 1 );
+    CHECK_FALSE( executor1.IsUsingJobServer() );
+    CHECK_FALSE( executor2.IsUsingJobServer() );
+
+    // Cleanup
+}
+
+/*
+ * Check that jobs are executed concurrently, and that their ordered steps are executed in order.
+ */
+TEST( BatchExecutor, ConcurrentExecution )
+{
+    // Prepare
+    BatchExecutor executor( 4, 0, "-j4" );
+
+    // Exercise
+    executor.Execute( JOB_COUNT, std::vector<uint64_t>(), [&]( size_t job ) { RunJob( job ); }, [&]( size_t job ) { orderedJobs.push_back( job ); } );
+
+    // Verify
+    CHECK_FALSE( executor.IsUsingJobServer() );
+    CHECK_TRUE( maxRunningJobs > 1 );
+    CHECK_TRUE( maxRunningJobs <= 4 );
+    UNSIGNED_LONGS_EQUAL( JOB_COUNT, orderedJobs.size() );
+    for( size_t i = 0; i < orderedJobs.size(); i++ )
+    {
+        UNSIGNED_LONGS_EQUAL( i, orderedJobs[i] );
+    }
+
+    // Cleanup
+}
+
+/*
+ * Check that jobs are executed one at a time when the maximum number of jobs is 1.
+ */
+TEST( BatchExecutor, SequentialExecution )
+{
+    // Prepare
+    BatchExecutor executor( 1, 0, nullptr );
+
+    // Exercise
+    executor.Execute( JOB_COUNT, std::vector<uint64_t>(), [&]( size_t job ) { RunJob( job ); }, [&]( size_t job ) { orderedJobs.push_back( job ); } );
+
+    // Verify
+    LONGS_EQUAL( 1, maxRunningJobs );
+    UNSIGNED_LONGS_EQUAL( JOB_COUNT, orderedJobs.size() );
+
+    // Cleanup
+}
+
+/*
+ * Check that the largest jobs are started first, and that the memory cost of the jobs running concurrently does not
+ * exceed the memory budget.
+ */
+TEST( BatchExecutor, MemoryBudget )
+{
+    // Prepare
+    BatchExecutor executor( 8, 500, nullptr );
+
+    std::vector<uint64_t> costs;
+    for( size_t i = 0; i < JOB_COUNT; i++ )
+    {
+        costs.push_back( ( ( i % 5 ) + 1 ) * 100 );
+    }
+
+    std::mutex mutex;
+    uint64_t runningCost = 0;
+    uint64_t maxRunningCost = 0;
+    std::vector<size_t> startedJobs;
+
+    // Exercise
+    executor.Execute( JOB_COUNT, costs,
+                      [&]( size_t job )
+                      {
+                          {
+                              std::lock_guard<std::mutex> lock( mutex );
+                              startedJobs.push_back( job );
+                              runningCost += costs[job];
+                              maxRunningCost = std::max( maxRunningCost, runningCost );
+                          }
+                          RunJob( job );
+                          {
+                              std::lock_guard<std::mutex> lock( mutex );
+                              runningCost -= costs[job];
+                          }
+                      },
+                      [&]( size_t job ) { orderedJobs.push_back( job ); } );
+
+    // Verify
+    UNSIGNED_LONGS_EQUAL( 500, executor.GetMemoryBudget() );
+    CHECK_TRUE( maxRunningCost <= 500 );
+    UNSIGNED_LONGS_EQUAL( JOB_COUNT, startedJobs.size() );
+    UNSIGNED_LONGS_EQUAL( 500, costs[ startedJobs[0] ] );
+    UNSIGNED_LONGS_EQUAL( JOB_COUNT, orderedJobs.size() );
+    for( size_t i = 0; i < orderedJobs.size(); i++ )
+    {
+        UNSIGNED_LONGS_EQUAL( i, orderedJobs[i] );
+    }
+
+    // Cleanup
+}
+
+/*
+ * Check that jobs whose memory cost exceeds the memory budget are executed alone.
+ */
+TEST( BatchExecutor, MemoryBudgetExceeded )
+{
+    // Prepare
+    BatchExecutor executor( 4, 100, nullptr );
+    std::vector<uint64_t> costs = { 1000, 1000, 1000 };
+
+    // Exercise
+    executor.Execute( costs.size(), costs, [&]( size_t job ) { RunJob( job ); }, [&]( size_t job ) { orderedJobs.push_back( job ); } );
+
+    // Verify
+    LONGS_EQUAL( 1, maxRunningJobs );
+    UNSIGNED_LONGS_EQUAL( 3, orderedJobs.size() );
+
+    // Cleanup
+}
+
+/*
+ * Check that an exception thrown by an ordered step stops the execution of the following jobs, while the ordered
+ * steps of the previous jobs are executed.
+ */
+TEST( BatchExecutor, OrderedStepFailure )
+{
+    // Prepare
+    BatchExecutor executor( 4, 0, nullptr );
+
+    // Exercise & Verify
+    CHECK_THROWS( std::runtime_error,
+                  executor.Execute( JOB_COUNT, std::vector<uint64_t>(), [&]( size_t job ) { RunJob( job ); },
+                                    [&]( size_t job )
+                                    {
+                                        if( job == 7 )
+                                        {
+                                            throw std::runtime_error( "Failure" );
+                                        }
+                                        orderedJobs.push_back( job );
+                                    } ) );
+    UNSIGNED_LONGS_EQUAL( 7, orderedJobs.size() );
+
+    // Cleanup
+}
+
+/*
+ * Check that the exception of the first failed job is rethrown when several jobs fail.
+ */
+TEST( BatchExecutor, FirstFailureRethrown )
+{
+    // Prepare
+    BatchExecutor executor( 4, 0, nullptr );
+    std::string failureMessage;
+
+    // Exercise
+    try
+    {
+        executor.Execute( JOB_COUNT, std::vector<uint64_t>(),
+                          [&]( size_t job )
+                          {
+                              RunJob( job );
+                              if( job == 9 )
+                              {
+                                  throw std::runtime_error( "Parallel failure" );
+                              }
+                          },
+                          [&]( size_t job )
+                          {
+                              if( job == 5 )
+                              {
+                                  throw std::runtime_error( "Ordered failure" );
+                              }
+                              orderedJobs.push_back( job );
+                          } );
+    }
+    catch( std::exception &e )
+    {
+        failureMessage = e.what();
+    }
+
+    // Verify
+    STRCMP_EQUAL( "Ordered failure", failureMessage.c_str() );
+    UNSIGNED_LONGS_EQUAL( 5, orderedJobs.size() );
+
+    // Cleanup
+}
+
+#ifndef WIN32
+
+/*
+ * Check that an invalid jobserver is ignored.
+ */
+TEST( BatchExecutor, JobServer_Invalid )
+{
+    // Exercise
+    BatchExecutor executor1( 4, 0, "-j4 --jobserver-auth=1000,1001" );
+    BatchExecutor executor2( 4, 0, "-j4 --jobserver-auth=fifo:/nonexistent/fifo" );
+
+    // Verify
+    CHECK_FALSE( executor1.IsUsingJobServer() );
+    CHECK_FALSE( executor2.IsUsingJobServer() );
+
+    // Cleanup
+}
+
+/*
+ * Check that the number of concurrent jobs is limited by the slots available in the jobserver.
+ */
+TEST( BatchExecutor, JobServer_Pipe )
+{
+    // Prepare
+    int pipeFds[2];
+    CHECK_EQUAL( 0, pipe( pipeFds ) );
+
+    // Two slots available besides the implicit one
+    CHECK_EQUAL( 2, write( pipeFds[1], "++", 2 ) );
+
+    std::string makeFlags = "-j3 --jobserver-auth=" + std::to_string( pipeFds[0] ) + "," + std::to_string( pipeFds[1] );
+    BatchExecutor executor( 8, 0, makeFlags.c_str() );
+
+    // Exercise
+    executor.Execute( JOB_COUNT, std::vector<uint64_t>(), [&]( size_t job ) { RunJob( job ); }, [&]( size_t job ) { orderedJobs.push_back( job ); } );
+
+    // Verify
+    CHECK_TRUE( executor.IsUsingJobServer() );
+    CHECK_TRUE( maxRunningJobs > 1 );
+    CHECK_TRUE( maxRunningJobs <= 3 );
+    UNSIGNED_LONGS_EQUAL( JOB_COUNT, orderedJobs.size() );
+
+    // All slots must have been returned to the jobserver
+    char tokens[3];
+    CHECK_EQUAL( 2, read( pipeFds[0], tokens, sizeof(tokens) ) );
+
+    // Cleanup
+    close( pipeFds[0] );
+    close( pipeFds[1] );
+}
+
+#endif
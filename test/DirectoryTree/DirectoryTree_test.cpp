@@ -0,0 +1,167 @@
+/**
+ * @file
+ * @brief      Unit tests for the directory tree helpers
+ * @project    CppUMockGen
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2018 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <direct.h>
+
+#include "DirectoryTree.hpp"
+#include "FileHelper.hpp"
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+static const std::string tempDirPath = std::string(std::getenv("TEMP"));
+static const std::string treeDirPath = tempDirPath + PATH_SEPARATOR + "tree";
+
+static std::string NativePath( std::string path )
+{
+    for( char &c : path )
+    {
+        if( c == '/' )
+        {
+            c = PATH_SEPARATOR;
+        }
+    }
+    return path;
+}
+
+static std::string TreePath( const std::string &relativePath )
+{
+    return treeDirPath + PATH_SEPARATOR + NativePath( relativePath );
+}
+
+static const std::vector<std::string> treeDirs = { "a", "a/b", "c", "internal" };
+static const std::vector<std::string> treeFiles = { "x.h", "a/y.hpp", "a/b/z.h", "a/b/z.c", "c/w.h", "internal/i.h" };
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( DirectoryTree )
+{
+};
+
+TEST_GROUP( DirectoryTree_Files )
+{
+    TEST_SETUP()
+    {
+        for( const std::string &dir : treeDirs )
+        {
+            CreateDirectories( TreePath( dir ) );
+        }
+        for( const std::string &file : treeFiles )
+        {
+            std::ofstream( TreePath( file ) ) << "";
+        }
+    }
+
+    TEST_TEARDOWN()
+    {
+        for( const std::string &file : treeFiles )
+        {
+            std::remove( TreePath( file ).c_str() );
+        }
+        for( auto dir = treeDirs.rbegin(); dir != treeDirs.rend(); dir++ )
+        {
+            rmdir( TreePath( *dir ).c_str() );
+        }
+        rmdir( treeDirPath.c_str() );
+    }
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+/*
+ * Check that globs without separators are matched against the filename
+ */
+TEST( DirectoryTree, MatchGlob_Filename )
+{
+    // Exercise & Verify
+    CHECK_TRUE( MatchGlob( "*.h", "foo.h" ) );
+    CHECK_TRUE( MatchGlob( "*.h", "a/b/foo.h" ) );
+    CHECK_TRUE( MatchGlob( "f?o.h", "a/foo.h" ) );
+    CHECK_FALSE( MatchGlob( "*.h", "foo.hpp" ) );
+    CHECK_FALSE( MatchGlob( "*.h", "foo.h/bar" ) );
+}
+
+/*
+ * Check that globs with separators are matched against the whole path
+ */
+TEST( DirectoryTree, MatchGlob_Path )
+{
+    // Exercise & Verify
+    CHECK_TRUE( MatchGlob( "a/*.h", "a/foo.h" ) );
+    CHECK_FALSE( MatchGlob( "a/*.h", "a/b/foo.h" ) );
+    CHECK_FALSE( MatchGlob( "a/?/foo.h", "a//foo.h" ) );
+    CHECK_TRUE( MatchGlob( "a/**", "a/b/foo.h" ) );
+    CHECK_TRUE( MatchGlob( "**/*.h", "foo.h" ) );
+    CHECK_TRUE( MatchGlob( "**/*.h", "a/b/foo.h" ) );
+    CHECK_TRUE( MatchGlob( "a/**/foo.h", "a/foo.h" ) );
+    CHECK_TRUE( MatchGlob( "a/**/foo.h", "a/b/c/foo.h" ) );
+    CHECK_FALSE( MatchGlob( "a/**/foo.h", "b/foo.h" ) );
+}
+
+/*
+ * Check that the files matching the include globs are found in lexicographical order
+ */
+TEST( DirectoryTree_Files, FindFiles )
+{
+    // Exercise
+    std::vector<std::string> files = FindFilesInTree( treeDirPath, { "*.h", "*.hpp" }, {} );
+
+    // Verify
+    std::vector<std::string> expectedFiles = { NativePath( "a/b/z.h" ), NativePath( "a/y.hpp" ), NativePath( "c/w.h" ),
+                                               NativePath( "internal/i.h" ), "x.h" };
+    CHECK( expectedFiles == files );
+}
+
+/*
+ * Check that files and subdirectories matching the exclude globs are skipped
+ */
+TEST( DirectoryTree_Files, FindFiles_Exclude )
+{
+    // Exercise
+    std::vector<std::string> files = FindFilesInTree( treeDirPath + PATH_SEPARATOR, { "**" }, { "internal", "*.c", "a/*.hpp" } );
+
+    // Verify
+    std::vector<std::string> expectedFiles = { NativePath( "a/b/z.h" ), NativePath( "c/w.h" ), "x.h" };
+    CHECK( expectedFiles == files );
+}
+
+/*
+ * Check that an exception is thrown if the root directory cannot be read
+ */
+TEST( DirectoryTree, FindFiles_NonExistingDirectory )
+{
+    // Exercise & Verify
+    CHECK_THROWS( std::runtime_error, FindFilesInTree( tempDirPath + PATH_SEPARATOR + "nonexistent_dir", { "*" }, {} ) );
+}
+
+/*
+ * Check that an exception is thrown if a directory cannot be created
+ */
+TEST( DirectoryTree_Files, CreateDirectories_Error )
+{
+    // Exercise & Verify
+    CHECK_THROWS( std::runtime_error, CreateDirectories( TreePath( "x.h/d" ) ) );
+}
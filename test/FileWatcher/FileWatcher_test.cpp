@@ -0,0 +1,153 @@
+/**
+ * @file
+ * @brief      Unit tests for the "FileWatcher" class
+ * @project    CppUMockGen
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2018 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "FileWatcher.hpp"
+#include "FileHelper.hpp"
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+static const std::string tempDirPath = std::string(std::getenv("TEMP"));
+static const std::string watchedFilepath1 = tempDirPath + PATH_SEPARATOR + "CppUMockGen_Watched1.h";
+static const std::string watchedFilepath2 = tempDirPath + PATH_SEPARATOR + "CppUMockGen_Watched2.h";
+static const std::string unwatchedFilepath = tempDirPath + PATH_SEPARATOR + "CppUMockGen_Unwatched.h";
+
+static void WriteFile( const std::string &filepath, const std::string &contents )
+{
+    std::ofstream file( filepath );
+    file << contents;
+}
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( FileWatcher )
+{
+    TEST_SETUP()
+    {
+        WriteFile( watchedFilepath1, "void f1();" );
+        WriteFile( watchedFilepath2, "void f2();" );
+    }
+
+    TEST_TEARDOWN()
+    {
+        std::remove( watchedFilepath1.c_str() );
+        std::remove( watchedFilepath2.c_str() );
+        std::remove( unwatchedFilepath.c_str() );
+    }
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+/*
+ * Check that changes to watched files are reported, and changes to other files in the same directory are not.
+ */
+TEST( FileWatcher, ChangedFiles )
+{
+    // Prepare
+    FileWatcher watcher;
+    watcher.SetWatchedFiles( { watchedFilepath1, watchedFilepath2 } );
+    std::vector<std::string> changedFilepaths;
+
+    std::thread writer( []()
+                        {
+                            std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+                            WriteFile( unwatchedFilepath, "void f3();" );
+                            WriteFile( watchedFilepath2, "void f2(int);" );
+                        } );
+
+    // Exercise
+    bool result = watcher.WaitForChanges( changedFilepaths );
+    writer.join();
+
+    // Verify
+    CHECK_TRUE( result );
+    UNSIGNED_LONGS_EQUAL( 1, changedFilepaths.size() );
+    STRCMP_EQUAL( watchedFilepath2.c_str(), changedFilepaths[0].c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that changes to several watched files in quick succession are reported together.
+ */
+TEST( FileWatcher, SeveralChangedFiles )
+{
+    // Prepare
+    FileWatcher watcher;
+    watcher.SetWatchedFiles( { watchedFilepath1, watchedFilepath2 } );
+    std::vector<std::string> changedFilepaths;
+
+    std::thread writer( []()
+                        {
+                            std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+                            WriteFile( watchedFilepath1, "void f1(int);" );
+                            WriteFile( watchedFilepath2, "void f2(int);" );
+                        } );
+
+    // Exercise
+    bool result = watcher.WaitForChanges( changedFilepaths );
+    writer.join();
+
+    // Verify
+    CHECK_TRUE( result );
+    UNSIGNED_LONGS_EQUAL( 2, changedFilepaths.size() );
+    STRCMP_EQUAL( watchedFilepath1.c_str(), changedFilepaths[0].c_str() );
+    STRCMP_EQUAL( watchedFilepath2.c_str(), changedFilepaths[1].c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that watched files replaced by renaming another file are reported as changed.
+ */
+TEST( FileWatcher, ReplacedFile )
+{
+    // Prepare
+    FileWatcher watcher;
+    watcher.SetWatchedFiles( { watchedFilepath1 } );
+    std::vector<std::string> changedFilepaths;
+
+    std::thread writer( []()
+                        {
+                            std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+                            WriteFile( unwatchedFilepath, "void f1(double);" );
+                            std::remove( watchedFilepath1.c_str() );
+                            std::rename( unwatchedFilepath.c_str(), watchedFilepath1.c_str() );
+                        } );
+
+    // Exercise
+    bool result = watcher.WaitForChanges( changedFilepaths );
+    writer.join();
+
+    // Verify
+    CHECK_TRUE( result );
+    UNSIGNED_LONGS_EQUAL( 1, changedFilepaths.size() );
+    STRCMP_EQUAL( watchedFilepath1.c_str(), changedFilepaths[0].c_str() );
+
+    // Cleanup
+}
@@ -0,0 +1,347 @@
+/**
+ * @file
+ * @brief      Unit tests for the "FingerprintStore" class
+ * @project    CppUMockGen
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2018 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "FingerprintStore.hpp"
+#include "FileHelper.hpp"
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+static const std::string tempDirPath = std::string(std::getenv("TEMP"));
+static const std::string fingerprintsFilepath = tempDirPath + PATH_SEPARATOR + "fingerprints.txt";
+
+static std::string ReadFile( const std::string &filepath )
+{
+    std::ifstream file( filepath );
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+static void WriteFile( const std::string &filepath, const std::string &contents )
+{
+    std::ofstream file( filepath );
+    file << contents;
+}
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( FingerprintStore )
+{
+    TEST_TEARDOWN()
+    {
+        std::remove( fingerprintsFilepath.c_str() );
+    }
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+/*
+ * Check that all functions are reported as added when there are no previous fingerprints.
+ */
+TEST( FingerprintStore, FirstRun )
+{
+    // Prepare
+    FingerprintStore store;
+
+    // Exercise
+    store.Load( fingerprintsFilepath );
+    store.Update( "foo.h", "c:@F@f1", "f1", "code1" );
+    store.Update( "foo.h", "c:@F@f2", "f2", "code2" );
+    std::vector<FingerprintStore::Difference> differences = store.GetDifferences();
+
+    // Verify
+    UNSIGNED_LONGS_EQUAL( 2, differences.size() );
+    CHECK( differences[0].change == FingerprintStore::Change::Added );
+    STRCMP_EQUAL( "f1", differences[0].name.c_str() );
+    STRCMP_EQUAL( "foo.h", differences[0].inputFilepath.c_str() );
+    CHECK( differences[1].change == FingerprintStore::Change::Added );
+    STRCMP_EQUAL( "f2", differences[1].name.c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that added, removed and changed functions are detected with respect to a previous run.
+ */
+TEST( FingerprintStore, Differences )
+{
+    // Prepare
+    FingerprintStore previousStore;
+    previousStore.Update( "foo.h", "c:@F@f1", "f1", "code1" );
+    previousStore.Update( "foo.h", "c:@F@f2", "f2", "code2" );
+    previousStore.Update( "foo.h", "c:@F@f3", "f3", "code3" );
+    previousStore.Save( fingerprintsFilepath );
+
+    FingerprintStore store;
+
+    // Exercise
+    store.Load( fingerprintsFilepath );
+    store.Update( "foo.h", "c:@F@f1", "f1", "code1" );
+    store.Update( "foo.h", "c:@F@f3", "f3", "code3_modified" );
+    store.Update( "foo.h", "c:@F@f4", "f4", "code4" );
+    std::vector<FingerprintStore::Difference> differences = store.GetDifferences();
+
+    // Verify
+    UNSIGNED_LONGS_EQUAL( 3, differences.size() );
+    CHECK( differences[0].change == FingerprintStore::Change::Changed );
+    STRCMP_EQUAL( "f3", differences[0].name.c_str() );
+    CHECK( differences[1].change == FingerprintStore::Change::Added );
+    STRCMP_EQUAL( "f4", differences[1].name.c_str() );
+    CHECK( differences[2].change == FingerprintStore::Change::Removed );
+    STRCMP_EQUAL( "f2", differences[2].name.c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that a processed input file without functions reports all its previous functions as removed.
+ */
+TEST( FingerprintStore, AllFunctionsRemoved )
+{
+    // Prepare
+    FingerprintStore previousStore;
+    previousStore.Update( "foo.h", "c:@F@f1", "f1", "code1" );
+    previousStore.Save( fingerprintsFilepath );
+
+    FingerprintStore store;
+
+    // Exercise
+    store.Load( fingerprintsFilepath );
+    store.AddInput( "foo.h", 0 );
+    std::vector<FingerprintStore::Difference> differences = store.GetDifferences();
+
+    // Verify
+    UNSIGNED_LONGS_EQUAL( 1, differences.size() );
+    CHECK( differences[0].change == FingerprintStore::Change::Removed );
+    STRCMP_EQUAL( "f1", differences[0].name.c_str() );
+    STRCMP_EQUAL( "foo.h", differences[0].inputFilepath.c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that fingerprints of input files not processed in the current run are neither reported nor discarded.
+ */
+TEST( FingerprintStore, UnprocessedInputsPreserved )
+{
+    // Prepare
+    FingerprintStore previousStore;
+    previousStore.Update( "foo.h", "c:@F@f1", "f1", "code1" );
+    previousStore.Update( "bar.h", "c:@F@b1", "b1", "codeb1" );
+    previousStore.Save( fingerprintsFilepath );
+
+    FingerprintStore store;
+    store.Load( fingerprintsFilepath );
+    store.Update( "foo.h", "c:@F@f1", "f1", "code1" );
+
+    // Exercise
+    std::vector<FingerprintStore::Difference> differences = store.GetDifferences();
+    store.Save( fingerprintsFilepath );
+
+    // Verify
+    UNSIGNED_LONGS_EQUAL( 0, differences.size() );
+
+    FingerprintStore nextStore;
+    nextStore.Load( fingerprintsFilepath );
+    nextStore.AddInput( "bar.h", 0 );
+    std::vector<FingerprintStore::Difference> nextDifferences = nextStore.GetDifferences();
+    UNSIGNED_LONGS_EQUAL( 1, nextDifferences.size() );
+    CHECK( nextDifferences[0].change == FingerprintStore::Change::Removed );
+    STRCMP_EQUAL( "b1", nextDifferences[0].name.c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that the memory used to parse each input file is stored and preserved for input files not processed.
+ */
+TEST( FingerprintStore, MemoryUsage )
+{
+    // Prepare
+    FingerprintStore previousStore;
+    previousStore.AddInput( "foo.h", 1000 );
+    previousStore.AddInput( "bar.h", 2000 );
+    previousStore.Save( fingerprintsFilepath );
+
+    FingerprintStore store;
+    store.Load( fingerprintsFilepath );
+    store.AddInput( "foo.h", 3000 );
+    store.Save( fingerprintsFilepath );
+
+    FingerprintStore nextStore;
+
+    // Exercise
+    nextStore.Load( fingerprintsFilepath );
+
+    // Verify
+    UNSIGNED_LONGS_EQUAL( 1000, store.GetPreviousMemoryUsage( "foo.h" ) );
+    UNSIGNED_LONGS_EQUAL( 3000, nextStore.GetPreviousMemoryUsage( "foo.h" ) );
+    UNSIGNED_LONGS_EQUAL( 2000, nextStore.GetPreviousMemoryUsage( "bar.h" ) );
+    UNSIGNED_LONGS_EQUAL( 0, nextStore.GetPreviousMemoryUsage( "baz.h" ) );
+    STRCMP_EQUAL( "memory\tbar.h\t2000\n"
+                  "memory\tfoo.h\t3000\n",
+                  ReadFile( fingerprintsFilepath ).c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that malformed lines in the fingerprints file are ignored.
+ */
+TEST( FingerprintStore, MalformedLinesIgnored )
+{
+    // Prepare
+    std::string expectedLine = "00000000000000ab\tfoo.h\tc:@F@f1\tf1";
+    WriteFile( fingerprintsFilepath, "garbage\n" + expectedLine + "\nxyz\tfoo.h\tc:@F@f2\tf2\n\n" );
+
+    FingerprintStore store;
+
+    // Exercise
+    store.Load( fingerprintsFilepath );
+    store.AddInput( "foo.h", 0 );
+    std::vector<FingerprintStore::Difference> differences = store.GetDifferences();
+
+    // Verify
+    UNSIGNED_LONGS_EQUAL( 1, differences.size() );
+    CHECK( differences[0].change == FingerprintStore::Change::Removed );
+    STRCMP_EQUAL( "f1", differences[0].name.c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that the fingerprints file is written with a stable format.
+ */
+TEST( FingerprintStore, SaveFormat )
+{
+    // Prepare
+    FingerprintStore store;
+    store.Update( "foo.h", "c:@F@f2", "f2(int)", "" );
+    store.Update( "foo.h", "c:@F@f1", "f1(void)", "a" );
+
+    // Exercise
+    store.Save( fingerprintsFilepath );
+
+    // Verify
+    STRCMP_EQUAL( "af63dc4c8601ec8c\tfoo.h\tc:@F@f1\tf1(void)\n"
+                  "cbf29ce484222325\tfoo.h\tc:@F@f2\tf2(int)\n",
+                  ReadFile( fingerprintsFilepath ).c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that an exception is thrown if the fingerprints file cannot be written.
+ */
+TEST( FingerprintStore, SaveError )
+{
+    // Prepare
+    FingerprintStore store;
+    std::string invalidFilepath = tempDirPath + PATH_SEPARATOR + "nonexistent_dir" + PATH_SEPARATOR + "fingerprints.txt";
+
+    // Exercise & Verify
+    CHECK_THROWS( std::runtime_error, store.Save( invalidFilepath ) );
+
+    // Cleanup
+}
+
+/*
+ * Check that the token fingerprint does not change when only comments or whitespace are changed.
+ */
+TEST( FingerprintStore, TokenFingerprintIgnoresCommentsAndWhitespace )
+{
+    // Prepare
+    std::string source =
+            "#define FOO( x ) ( x + 1 )\n"
+            "int function1(int a, const char *b);\n";
+    std::string reformattedSource =
+            "/* Header comment */\n"
+            "#  define FOO( x ) \\\n"
+            "      ( x + 1 ) // Trailing comment\n"
+            "\n"
+            "int  function1( int a,\n"
+            "                const char* b ) ;\r\n";
+
+    // Exercise & Verify
+    CHECK( FingerprintStore::CalculateTokenFingerprint( source ) ==
+           FingerprintStore::CalculateTokenFingerprint( reformattedSource ) );
+}
+
+/*
+ * Check that the token fingerprint changes when the tokens are changed.
+ */
+TEST( FingerprintStore, TokenFingerprintDetectsTokenChanges )
+{
+    // Prepare
+    uint64_t fingerprint = FingerprintStore::CalculateTokenFingerprint( "int function1(int a); const char *b = \"x y\";" );
+
+    // Exercise & Verify
+    CHECK( fingerprint != FingerprintStore::CalculateTokenFingerprint( "int function1(inta); const char *b = \"x y\";" ) );
+    CHECK( fingerprint != FingerprintStore::CalculateTokenFingerprint( "int function1(int a); const char *b = \"x  y\";" ) );
+    CHECK( fingerprint != FingerprintStore::CalculateTokenFingerprint( "int function1(int a); const char *b = \"x /**/ y\";" ) );
+    CHECK( fingerprint != FingerprintStore::CalculateTokenFingerprint( "long function1(int a); const char *b = \"x y\";" ) );
+}
+
+/*
+ * Check that the token fingerprint takes into account the end of preprocessor directives.
+ */
+TEST( FingerprintStore, TokenFingerprintDirectiveEnd )
+{
+    // Exercise & Verify
+    CHECK( FingerprintStore::CalculateTokenFingerprint( "#define FOO\nint a;" ) !=
+           FingerprintStore::CalculateTokenFingerprint( "#define FOO int a;" ) );
+    CHECK( FingerprintStore::CalculateTokenFingerprint( "#define FOO int \\\na;" ) ==
+           FingerprintStore::CalculateTokenFingerprint( "#define FOO int a;" ) );
+}
+
+/*
+ * Check that the token fingerprint tells apart the definitions of object-like and function-like macros.
+ */
+TEST( FingerprintStore, TokenFingerprintFunctionLikeMacro )
+{
+    // Exercise & Verify
+    CHECK( FingerprintStore::CalculateTokenFingerprint( "#define F(x) (x + 1)\n" ) !=
+           FingerprintStore::CalculateTokenFingerprint( "#define F (x) (x + 1)\n" ) );
+    CHECK( FingerprintStore::CalculateTokenFingerprint( "#define F(x) (x + 1)\n" ) ==
+           FingerprintStore::CalculateTokenFingerprint( "#define F(x)(x + 1)\n" ) );
+    CHECK( FingerprintStore::CalculateTokenFingerprint( "int function1(int a);" ) ==
+           FingerprintStore::CalculateTokenFingerprint( "int function1 (int a);" ) );
+}
+
+/*
+ * Check that the token fingerprint of a source truncated after a backslash inside a literal is calculated.
+ */
+TEST( FingerprintStore, TokenFingerprintTruncatedLiteral )
+{
+    // Exercise & Verify
+    CHECK( FingerprintStore::CalculateTokenFingerprint( std::string( "const char *b = \"x\\" ) ) !=
+           FingerprintStore::CalculateTokenFingerprint( std::string( "const char *b = \"x" ) ) );
+    CHECK( FingerprintStore::CalculateTokenFingerprint( std::string( "char c = '\\" ) ) !=
+           FingerprintStore::CalculateTokenFingerprint( std::string( "char c = '\\;" ) ) );
+}
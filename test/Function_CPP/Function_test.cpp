@@ -148,7 +148,7 @@ TEST_GROUP_EX( TEST_GROUP_NAME )
             Function function;
             if( function.Parse( cursor, config ) )
             {
-                results.push_back( function.GenerateMock() );
+                results.push_back( function.GenerateMock( false, false ) );
             }
         } );
 
@@ -5584,3 +5584,279 @@ TEST_EX( TEST_GROUP_NAME, ParameterOverride_Skip )
 }
 
 
+
+//*************************************************************************************************
+//
+//                                           PROFILING
+//
+//*************************************************************************************************
+
+/*
+ * Check mock generation of a function with profiling instrumentation.
+ */
+TEST_EX( TEST_GROUP_NAME, Profiling )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    mock().expectOneCall("Config::GetParameterOverride").onObject(config).withStringParameter("key", "function1@").andReturnValue((const void*)0);
+    mock().expectOneCall("Config::GetParameterOverride").onObject(config).withStringParameter("key", "function1#p").andReturnValue((const void*)0);
+    mock().expectOneCall("Config::GetTypeOverride").onObject(config).withStringParameter("key", "@int").andReturnValue((const void*)0);
+    mock().expectOneCall("Config::GetTypeOverride").onObject(config).withStringParameter("key", "#int").andReturnValue((const void*)0);
+
+    SimpleString testHeader = "int function1(int p);";
+
+    // Exercise
+    std::vector<std::string> results;
+    ClangParseHelper::ParseHeader( testHeader.asCharString(), [&]( CXCursor cursor )
+    {
+        Function function;
+        if( function.Parse( cursor, *config ) )
+        {
+            results.push_back( function.GenerateMock( true, false ) );
+        }
+    } );
+
+    // Verify
+    mock().checkExpectations();
+    CHECK_EQUAL( 1, results.size() );
+    STRCMP_EQUAL( "int function1(int p)\n{\n"
+                  "    static cppumockgen::profiling::Entry cppumockgen_profile_entry( \"function1\", \"mock\" );\n"
+                  "    cppumockgen::profiling::Scope cppumockgen_profile_scope( cppumockgen_profile_entry );\n"
+                  "    return mock().actualCall(\"function1\").withIntParameter(\"p\", p).returnIntValue();\n"
+                  "}\n", results[0].c_str() );
+
+    // Cleanup
+}
+
+//*************************************************************************************************
+//
+//                                        POD RECORD TYPES
+//
+//*************************************************************************************************
+
+/*
+ * Check that a tightly packed POD struct parameter is reported as memory-comparable.
+ */
+TEST_EX( TEST_GROUP_NAME, PodRecordTypes_Packed )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    mock().expectOneCall("Config::GetParameterOverride").onObject(config).withStringParameter("key", "function1#p").andReturnValue((const void*)0);
+    mock().expectOneCall("Config::UseUnderlyingTypedefType").onObject(config).andReturnValue(false);
+    mock().expectOneCall("Config::GetTypeOverride").onObject(config).withStringParameter("key", "#" STRUCT_TAG "Struct1").andReturnValue((const void*)0);
+
+    SimpleString testHeader =
+            "struct Struct1 { int member1; unsigned int member2[4]; };\n"
+            "void function1(" STRUCT_TAG "Struct1 p);";
+
+    // Exercise
+    std::set<std::string> types;
+    ClangParseHelper::ParseHeader( testHeader.asCharString(), [&]( CXCursor cursor )
+    {
+        Function function;
+        if( function.Parse( cursor, *config ) )
+        {
+            function.GetPodRecordTypes( types );
+        }
+    } );
+
+    // Verify
+    mock().checkExpectations();
+    CHECK_EQUAL( 1, types.size() );
+    STRCMP_EQUAL( "Struct1", types.begin()->c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that POD struct parameters with padding or floating point members are not reported as memory-comparable.
+ */
+TEST_EX( TEST_GROUP_NAME, PodRecordTypes_NotComparable )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    mock().expectOneCall("Config::GetParameterOverride").onObject(config).withStringParameter("key", "function1#p1").andReturnValue((const void*)0);
+    mock().expectOneCall("Config::GetParameterOverride").onObject(config).withStringParameter("key", "function1#p2").andReturnValue((const void*)0);
+    mock().expectNCalls(2, "Config::UseUnderlyingTypedefType").onObject(config).andReturnValue(false);
+    mock().expectOneCall("Config::GetTypeOverride").onObject(config).withStringParameter("key", "#" STRUCT_TAG "Struct1").andReturnValue((const void*)0);
+    mock().expectOneCall("Config::GetTypeOverride").onObject(config).withStringParameter("key", "#" STRUCT_TAG "Struct2").andReturnValue((const void*)0);
+
+    SimpleString testHeader =
+            "struct Struct1 { char member1; int member2; };\n"
+            "struct Struct2 { int member1; float member2; };\n"
+            "void function1(" STRUCT_TAG "Struct1 p1, " STRUCT_TAG "Struct2 p2);";
+
+    // Exercise
+    std::set<std::string> types;
+    ClangParseHelper::ParseHeader( testHeader.asCharString(), [&]( CXCursor cursor )
+    {
+        Function function;
+        if( function.Parse( cursor, *config ) )
+        {
+            function.GetPodRecordTypes( types );
+        }
+    } );
+
+    // Verify
+    mock().checkExpectations();
+    CHECK_EQUAL( 0, types.size() );
+
+    // Cleanup
+}
+
+//*************************************************************************************************
+//
+//                                         RECORD & REPLAY
+//
+//*************************************************************************************************
+
+/*
+ * Check mock generation of a function with scalar parameters and return with record and replay paths.
+ */
+TEST_EX( TEST_GROUP_NAME, RecordReplay_Traceable )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    mock().expectOneCall("Config::GetParameterOverride").onObject(config).withStringParameter("key", "function1@").andReturnValue((const void*)0);
+    mock().expectOneCall("Config::GetParameterOverride").onObject(config).withStringParameter("key", "function1#p").andReturnValue((const void*)0);
+    mock().expectOneCall("Config::GetTypeOverride").onObject(config).withStringParameter("key", "@int").andReturnValue((const void*)0);
+    mock().expectOneCall("Config::GetTypeOverride").onObject(config).withStringParameter("key", "#double").andReturnValue((const void*)0);
+
+    SimpleString testHeader = "int function1(double p);";
+
+    // Exercise
+    std::vector<std::string> results;
+    ClangParseHelper::ParseHeader( testHeader.asCharString(), [&]( CXCursor cursor )
+    {
+        Function function;
+        if( function.Parse( cursor, *config ) )
+        {
+            results.push_back( function.GenerateMock( false, true ) );
+        }
+    } );
+
+    // Verify
+    mock().checkExpectations();
+    CHECK_EQUAL( 1, results.size() );
+    STRCMP_EQUAL( "#ifdef CPPUMOCKGEN_RECORD\n"
+                  "extern \"C\" int __real_function1(double p);\n"
+                  "extern \"C\" int __wrap_function1(double p)\n{\n"
+                  "    cppumockgen::trace::Record cppumockgen_trace_record( 0x834AA2E8u );\n"
+                  "    cppumockgen_trace_record.Put<double>( p );\n"
+                  "    int cppumockgen_trace_ret = __real_function1(p);\n"
+                  "    cppumockgen_trace_record.Put<int>( cppumockgen_trace_ret );\n"
+                  "    cppumockgen_trace_record.Commit();\n"
+                  "    return cppumockgen_trace_ret;\n"
+                  "}\n"
+                  "#else\n"
+                  "int function1(double p)\n{\n"
+                  "    if( cppumockgen::trace::Replaying() )\n    {\n"
+                  "        cppumockgen::trace::Cursor cppumockgen_trace_cursor( 0x834AA2E8u, \"function1\", sizeof(double) + sizeof(int) );\n"
+                  "        cppumockgen_trace_cursor.Check<double>( \"p\", p );\n"
+                  "        return cppumockgen_trace_cursor.Get<int>();\n"
+                  "    }\n"
+                  "    return mock().actualCall(\"function1\").withDoubleParameter(\"p\", p).returnIntValue();\n"
+                  "}\n"
+                  "#endif\n", results[0].c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check mock generation of a function with a non-scalar parameter when record and replay paths are requested.
+ */
+TEST_EX( TEST_GROUP_NAME, RecordReplay_NotTraceable )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    mock().expectOneCall("Config::GetParameterOverride").onObject(config).withStringParameter("key", "function1#p").andReturnValue((const void*)0);
+    mock().expectOneCall("Config::GetTypeOverride").onObject(config).withStringParameter("key", "#const char *").andReturnValue((const void*)0);
+
+    SimpleString testHeader = "void function1(const char* p);";
+
+    // Exercise
+    std::vector<std::string> results;
+    ClangParseHelper::ParseHeader( testHeader.asCharString(), [&]( CXCursor cursor )
+    {
+        Function function;
+        if( function.Parse( cursor, *config ) )
+        {
+            results.push_back( function.GenerateMock( false, true ) );
+        }
+    } );
+
+    // Verify
+    mock().checkExpectations();
+    CHECK_EQUAL( 1, results.size() );
+    STRCMP_EQUAL( "#ifndef CPPUMOCKGEN_RECORD\n"
+                  "void function1(const char * p)\n{\n"
+                  "    mock().actualCall(\"function1\").withStringParameter(\"p\", p);\n"
+                  "}\n"
+                  "#endif\n", results[0].c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check mock generation of a function whose parameter and return types cannot be resolved (e.g. because they are
+ * declared in files not included when parsing only the input file).
+ */
+TEST_EX( TEST_GROUP_NAME, UnresolvedTypes )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    mock().expectOneCall("Config::GetParameterOverride").onObject(config).withStringParameter("key", "function1@").andReturnValue((const void*)0);
+    mock().expectOneCall("Config::GetTypeOverride").onObject(config).withStringParameter("key", "@Type1").andReturnValue((const void*)0);
+    mock().expectOneCall("Config::GetParameterOverride").onObject(config).withStringParameter("key", "function1#p1").andReturnValue((const void*)0);
+    mock().expectOneCall("Config::GetTypeOverride").onObject(config).withStringParameter("key", "#const Type2 *").andReturnValue((const void*)0);
+    mock().expectOneCall("Config::GetParameterOverride").onObject(config).withStringParameter("key", "function1#p2").andReturnValue((const void*)0);
+    mock().expectOneCall("Config::GetTypeOverride").onObject(config).withStringParameter("key", "#Type3 **").andReturnValue((const void*)0);
+    mock().expectOneCall("Config::GetParameterOverride").onObject(config).withStringParameter("key", "function1#p3").andReturnValue((const void*)0);
+    mock().expectOneCall("Config::GetTypeOverride").onObject(config).withStringParameter("key", "#Type4").andReturnValue((const void*)0);
+
+    SimpleString testHeader =
+            "Type1 function1(const Type2* p1, Type3 **p2, Type4 p3);";
+
+    // Exercise
+    std::vector<std::string> results;
+    unsigned int functionCount = ParseHeader( testHeader, *config, results );
+
+    // Verify
+    mock().checkExpectations();
+    CHECK_EQUAL( 1, functionCount );
+    CHECK_EQUAL( 1, results.size() );
+    STRCMP_EQUAL( "Type1 function1(const Type2 * p1, Type3 ** p2, Type4 p3)\n{\n"
+                  "    return * static_cast<const Type1 *>( mock().actualCall(\"function1\").withConstPointerParameter(\"p1\", p1)"
+                  ".withPointerParameter(\"p2\", p2).withParameterOfType(\"Type4\", \"p3\", &p3).returnConstPointerValue() );\n"
+                  "}\n", results[0].c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check mock generation of a function returning a pointer to a type that cannot be resolved.
+ */
+TEST_EX( TEST_GROUP_NAME, UnresolvedTypes_PointerReturn )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    mock().expectOneCall("Config::GetParameterOverride").onObject(config).withStringParameter("key", "function1@").andReturnValue((const void*)0);
+    mock().expectOneCall("Config::GetTypeOverride").onObject(config).withStringParameter("key", "@Type1 *").andReturnValue((const void*)0);
+
+    SimpleString testHeader =
+            "Type1 *function1();";
+
+    // Exercise
+    std::vector<std::string> results;
+    unsigned int functionCount = ParseHeader( testHeader, *config, results );
+
+    // Verify
+    mock().checkExpectations();
+    CHECK_EQUAL( 1, functionCount );
+    CHECK_EQUAL( 1, results.size() );
+    STRCMP_EQUAL( "Type1 * function1()\n{\n"
+                  "    return static_cast<Type1 *>( mock().actualCall(\"function1\").returnPointerValue() );\n"
+                  "}\n", results[0].c_str() );
+
+    // Cleanup
+}
@@ -0,0 +1,232 @@
+/**
+ * @file
+ * @brief      Unit tests for the "GenerationStamp" class
+ * @project    CppUMockGen
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2018 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "GenerationStamp.hpp"
+#include "FileHelper.hpp"
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+static const std::string tempDirPath = std::string(std::getenv("TEMP"));
+static const std::string stampFilepath = tempDirPath + PATH_SEPARATOR + "foo_mock.cpp.stamp";
+static const std::string inputFilepath = tempDirPath + PATH_SEPARATOR + "foo.h";
+static const std::string includedFilepath = tempDirPath + PATH_SEPARATOR + "bar.h";
+static const std::string outputFilepath = tempDirPath + PATH_SEPARATOR + "foo_mock.cpp";
+
+static void WriteFile( const std::string &filepath, const std::string &contents )
+{
+    std::ofstream file( filepath );
+    file << contents;
+}
+
+static void SaveStamp( uint64_t optionsFingerprint, uint64_t contextFingerprint )
+{
+    GenerationStamp stamp( optionsFingerprint, contextFingerprint );
+    CHECK_TRUE( stamp.AddDependency( inputFilepath ) );
+    CHECK_TRUE( stamp.AddDependency( includedFilepath ) );
+    CHECK_TRUE( stamp.AddOutput( outputFilepath ) );
+    stamp.AddFunction( "c:@F@function1" );
+    stamp.AddFunction( "c:@F@function2" );
+    stamp.Save( stampFilepath );
+}
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( GenerationStamp )
+{
+    TEST_SETUP()
+    {
+        WriteFile( inputFilepath, "#include \"bar.h\"\nint function1(int a);\nint function2(bar_t b);\n" );
+        WriteFile( includedFilepath, "typedef int bar_t;\n" );
+        WriteFile( outputFilepath, "// Mock\n" );
+    }
+
+    TEST_TEARDOWN()
+    {
+        std::remove( stampFilepath.c_str() );
+        std::remove( inputFilepath.c_str() );
+        std::remove( includedFilepath.c_str() );
+        std::remove( outputFilepath.c_str() );
+    }
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+/*
+ * Check that a saved stamp is loaded back and found up to date while nothing changes.
+ */
+TEST( GenerationStamp, SaveAndLoad )
+{
+    // Prepare
+    SaveStamp( 0x1234, 0x5678 );
+
+    GenerationStamp stamp;
+
+    // Exercise
+    bool loaded = stamp.Load( stampFilepath );
+
+    // Verify
+    CHECK_TRUE( loaded );
+    CHECK_TRUE( stamp.IsUpToDate( 0x1234 ) );
+    CHECK( stamp.GetContextFingerprint() == 0x5678 );
+    UNSIGNED_LONGS_EQUAL( 2, stamp.GetFunctions().size() );
+    STRCMP_EQUAL( "c:@F@function1", stamp.GetFunctions()[0].c_str() );
+    STRCMP_EQUAL( "c:@F@function2", stamp.GetFunctions()[1].c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that loading a non-existing or malformed stamp fails.
+ */
+TEST( GenerationStamp, LoadInvalid )
+{
+    // Prepare
+    GenerationStamp stamp;
+
+    // Exercise & Verify
+    CHECK_FALSE( stamp.Load( stampFilepath ) );
+
+    WriteFile( stampFilepath, "options\t0000000000001234\ncontext\t0000000000005678\n" );
+    CHECK_FALSE( stamp.Load( stampFilepath ) );
+
+    WriteFile( stampFilepath, "options\t0000000000001234\ncontext\txyz\ndependency\t0000000000000001\tfoo.h\n" );
+    CHECK_FALSE( stamp.Load( stampFilepath ) );
+
+    WriteFile( stampFilepath, "options\t0000000000001234\ncontext\t0000000000005678\nfoo\t0000000000000001\tfoo.h\n" );
+    CHECK_FALSE( stamp.Load( stampFilepath ) );
+
+    // Cleanup
+}
+
+/*
+ * Check that a stamp is not up to date if the options are different.
+ */
+TEST( GenerationStamp, OptionsChanged )
+{
+    // Prepare
+    SaveStamp( 0x1234, 0x5678 );
+
+    GenerationStamp stamp;
+    CHECK_TRUE( stamp.Load( stampFilepath ) );
+
+    // Exercise & Verify
+    CHECK_FALSE( stamp.IsUpToDate( 0x1235 ) );
+
+    // Cleanup
+}
+
+/*
+ * Check that a stamp is still up to date if only comments or whitespace of the dependencies are changed.
+ */
+TEST( GenerationStamp, DependencyCommentsChanged )
+{
+    // Prepare
+    SaveStamp( 0x1234, 0x5678 );
+    WriteFile( includedFilepath, "/* Types */\ntypedef  int bar_t; // Bar\n" );
+
+    GenerationStamp stamp;
+    CHECK_TRUE( stamp.Load( stampFilepath ) );
+
+    // Exercise & Verify
+    CHECK_TRUE( stamp.IsUpToDate( 0x1234 ) );
+
+    // Cleanup
+}
+
+/*
+ * Check that a stamp is not up to date if the tokens of a dependency are changed or it is removed.
+ */
+TEST( GenerationStamp, DependencyTokensChanged )
+{
+    // Prepare
+    SaveStamp( 0x1234, 0x5678 );
+
+    GenerationStamp stamp;
+    CHECK_TRUE( stamp.Load( stampFilepath ) );
+
+    // Exercise & Verify
+    WriteFile( includedFilepath, "typedef long bar_t;\n" );
+    CHECK_FALSE( stamp.IsUpToDate( 0x1234 ) );
+
+    std::remove( includedFilepath.c_str() );
+    CHECK_FALSE( stamp.IsUpToDate( 0x1234 ) );
+
+    // Cleanup
+}
+
+/*
+ * Check that a stamp is not up to date if an output has been modified or removed.
+ */
+TEST( GenerationStamp, OutputModified )
+{
+    // Prepare
+    SaveStamp( 0x1234, 0x5678 );
+
+    GenerationStamp stamp;
+    CHECK_TRUE( stamp.Load( stampFilepath ) );
+
+    // Exercise & Verify
+    WriteFile( outputFilepath, "// Mock \n" );
+    CHECK_FALSE( stamp.IsUpToDate( 0x1234 ) );
+
+    std::remove( outputFilepath.c_str() );
+    CHECK_FALSE( stamp.IsUpToDate( 0x1234 ) );
+
+    // Cleanup
+}
+
+/*
+ * Check that non-existing files cannot be registered.
+ */
+TEST( GenerationStamp, NonExistingFiles )
+{
+    // Prepare
+    GenerationStamp stamp;
+    std::string nonExistingFilepath = tempDirPath + PATH_SEPARATOR + "nonexistent.h";
+
+    // Exercise & Verify
+    CHECK_FALSE( stamp.AddDependency( nonExistingFilepath ) );
+    CHECK_FALSE( stamp.AddOutput( nonExistingFilepath ) );
+
+    // Cleanup
+}
+
+/*
+ * Check that an exception is thrown if the stamp file cannot be written.
+ */
+TEST( GenerationStamp, SaveError )
+{
+    // Prepare
+    GenerationStamp stamp;
+    std::string invalidFilepath = tempDirPath + PATH_SEPARATOR + "nonexistent_dir" + PATH_SEPARATOR + "foo.stamp";
+
+    // Exercise & Verify
+    CHECK_THROWS( std::runtime_error, stamp.Save( invalidFilepath ) );
+
+    // Cleanup
+}
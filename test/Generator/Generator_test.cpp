@@ -0,0 +1,198 @@
+/**
+ * @file
+ * @brief      Unit tests for the "Generator" class
+ * @project    CppUMockGen
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2018 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include <string>
+#include <vector>
+#include <ostream>
+
+#include "Generator.hpp"
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+class StdVectorOfStringsComparator : public MockNamedValueComparator
+{
+public:
+    bool isEqual(const void* object1, const void* object2)
+    {
+        const std::vector<std::string> *o1 = (const std::vector<std::string>*) object1;
+        const std::vector<std::string> *o2 = (const std::vector<std::string>*) object2;
+
+        return (*o1) == (*o2);
+    }
+
+    SimpleString valueToString(const void* object)
+    {
+        SimpleString ret;
+        const std::vector<std::string> *o = (const std::vector<std::string>*) object;
+        for( unsigned int i = 0; i < o->size(); i++ )
+        {
+            ret += StringFromFormat("<%u>%s\n", i, (*o)[i].c_str() );
+        }
+        return ret;
+    }
+};
+
+StdVectorOfStringsComparator stdVectorOfStringsComparator;
+
+class StdOstreamCopier : public MockNamedValueCopier
+{
+public:
+    virtual void copy(void* out, const void* in)
+    {
+        *(std::ostream*)out << *(const std::string*)in;
+    }
+};
+
+StdOstreamCopier stdOstreamCopier;
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( Generator )
+{
+    TEST_SETUP()
+    {
+        mock().installComparator( "std::vector<std::string>", stdVectorOfStringsComparator );
+        mock().installCopier( "std::ostream", stdOstreamCopier );
+    }
+
+    TEST_TEARDOWN()
+    {
+        mock().removeAllComparatorsAndCopiers();
+    }
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+/*
+ * Check that the mocks and expectations generated for a header are returned.
+ */
+TEST( Generator, Generate )
+{
+    // Prepare
+    Generator::Options options;
+    options.interpretAsCpp = true;
+    options.includePaths = { "include" };
+    options.typeOverrideOptions = { "#Foo=Int" };
+    options.profiling = true;
+    options.generationOptions = "-x ";
+
+    std::vector<std::string> paramOverrideOptions;
+    std::string mockText = "#####MOCK#####";
+    std::string expectHeaderText = "#####EXPECT_HEADER#####";
+    std::string expectImplText = "#####EXPECT_IMPL#####";
+
+    mock().expectOneCall("Config::Config").withBoolParameter("useUnderlyingTypedefType", false)
+            .withParameterOfType("std::vector<std::string>", "paramOverrideOptions", &paramOverrideOptions)
+            .withParameterOfType("std::vector<std::string>", "typeOverrideOptions", &options.typeOverrideOptions);
+    mock().expectOneCall("Parser::Parse").withStringParameter("inputFilepath", "dir/foo.hpp").withBoolParameter("interpretAsCpp", true)
+            .withParameterOfType("std::vector<std::string>", "includePaths", &options.includePaths)
+            .ignoreOtherParameters().andReturnValue(true);
+    mock().expectOneCall("Parser::GenerateMock").withStringParameter("genOpts", "-x ").withBoolParameter("profiling", true).withBoolParameter("recordReplay", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &mockText);
+    mock().expectOneCall("Parser::GenerateExpectationHeader").withStringParameter("genOpts", "-x ").withBoolParameter("podComparators", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &expectHeaderText).ignoreOtherParameters();
+    mock().expectOneCall("Parser::GenerateExpectationImpl").withStringParameter("genOpts", "-x ").withStringParameter("headerFilepath", "foo_expect.hpp")
+            .withBoolParameter("profiling", true).withBoolParameter("podComparators", false)
+            .withOutputParameterOfTypeReturning("std::ostream", "output", &expectImplText).ignoreOtherParameters();
+
+    Generator generator( options );
+
+    Generator::Input input;
+    input.filepath = "dir/foo.hpp";
+
+    // Exercise
+    Generator::Output output = generator.Generate( input );
+
+    // Verify
+    mock().checkExpectations();
+    CHECK_TRUE( output.success );
+    STRCMP_EQUAL( mockText.c_str(), output.mock.c_str() );
+    STRCMP_EQUAL( expectHeaderText.c_str(), output.expectHeader.c_str() );
+    STRCMP_EQUAL( expectImplText.c_str(), output.expectImpl.c_str() );
+    STRCMP_EQUAL( "", output.diagnostics.c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that headers given in memory are parsed from their contents, and that no outputs are generated if they
+ * cannot be parsed.
+ */
+TEST( Generator, Generate_InputContentsParseError )
+{
+    // Prepare
+    Generator::Options options;
+    options.singleFileParse = true;
+
+    mock().expectOneCall("Config::Config").ignoreOtherParameters();
+    mock().expectOneCall("Parser::EnableSingleFileParse");
+    mock().expectOneCall("Parser::SetInputContents").withStringParameter("contents", "void function1(;");
+    mock().expectOneCall("Parser::Parse").withStringParameter("inputFilepath", "foo.h").withBoolParameter("interpretAsCpp", false)
+            .ignoreOtherParameters().andReturnValue(false);
+
+    Generator generator( options );
+
+    Generator::Input input;
+    input.filepath = "foo.h";
+    input.hasContents = true;
+    input.contents = "void function1(;";
+
+    // Exercise
+    Generator::Output output = generator.Generate( input );
+
+    // Verify
+    mock().checkExpectations();
+    CHECK_FALSE( output.success );
+    STRCMP_EQUAL( "", output.mock.c_str() );
+    STRCMP_EQUAL( "", output.expectHeader.c_str() );
+    STRCMP_EQUAL( "", output.expectImpl.c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that the functions mocked for a header are remembered for the following headers until forgotten.
+ */
+TEST( Generator, ForgetEmittedFunctions )
+{
+    // Prepare
+    Generator::Options options;
+
+    mock().expectOneCall("Config::Config").ignoreOtherParameters();
+    mock().expectNCalls(2, "Parser::Parse").ignoreOtherParameters().andReturnValue(false);
+
+    Generator generator( options );
+
+    Generator::Input input;
+    input.filepath = "foo.h";
+
+    // Exercise
+    generator.Generate( input );
+    generator.ForgetEmittedFunctions();
+    Generator::Output output = generator.Generate( input );
+
+    // Verify
+    mock().checkExpectations();
+    CHECK_FALSE( output.success );
+
+    // Cleanup
+}
@@ -0,0 +1,174 @@
+/**
+ * @file
+ * @brief      Unit tests for the header pre-filter
+ * @project    CppUMockGen
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2018 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+
+#include <string>
+
+#include "HeaderPrefilter.hpp"
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( HeaderPrefilter )
+{
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+/*
+ * Check that headers that only define macros, types and variables are ruled out
+ */
+TEST( HeaderPrefilter, TypesAndVariables )
+{
+    // Prepare
+    std::string contents =
+            "#ifndef FOO_H\n"
+            "#define FOO_H\n"
+            "#define FOO(x) foo_impl(x)\n"
+            "#define BAR \\\n"
+            "        ( 1 << 2 )\n"
+            "typedef int foo_t;\n"
+            "typedef void (*callback_t)( int a );\n"
+            "struct bar { int a; void (*f)( void ); };\n"
+            "enum baz { BAZ1 = ( 1 << 2 ), BAZ2 = sizeof( long ) };\n"
+            "extern int qux[ sizeof( struct bar ) ];\n"
+            "extern const callback_t *callbacks;\n"
+            "static int counter = get_default( 1 ), limit = max( 2, 3 );\n"
+            "__attribute__(( deprecated )) extern int quux;\n"
+            "_Static_assert( sizeof( int ) == 4, \"int(x)\" );\n"
+            "#endif\n";
+
+    // Exercise & Verify
+    CHECK_FALSE( MayDeclareMockableFunctions( contents, false ) );
+}
+
+/*
+ * Check that headers that declare a function are not ruled out
+ */
+TEST( HeaderPrefilter, FunctionDeclaration )
+{
+    // Exercise & Verify
+    CHECK_TRUE( MayDeclareMockableFunctions( "void function1(void);", false ) );
+    CHECK_TRUE( MayDeclareMockableFunctions( "int x; const char* function2(int a, int b)", false ) );
+    CHECK_TRUE( MayDeclareMockableFunctions( "typedef int foo_t;\nextern \"C\" foo_t (*function3(void))[4];", true ) );
+    CHECK_TRUE( MayDeclareMockableFunctions( "DECLARE_FUNCTION( function4 )", false ) );
+    CHECK_TRUE( MayDeclareMockableFunctions( "int counter = 0, function5(void);", false ) );
+    CHECK_TRUE( MayDeclareMockableFunctions( "int counter = max( 1, 2 ), *function6(int a);", false ) );
+}
+
+/*
+ * Check that comments, literals and preprocessor directives are ignored
+ */
+TEST( HeaderPrefilter, CommentsLiteralsAndDirectives )
+{
+    // Prepare
+    std::string contents =
+            "// void function1(void);\n"
+            "/* void function2(void); */\n"
+            "#pragma message(\"void function3(void);\")\n"
+            "#if defined(FOO) \\\n"
+            "    && defined(BAR)\n"
+            "#endif\n"
+            "extern const char *foo; // = \"void function4(void);\"\n"
+            "extern const char bar = ';';\n"
+            "static const char *baz = R\"x(void function5(void);)x\";\n"
+            "static const int qux = 1'000;\n";
+
+    // Exercise & Verify
+    CHECK_FALSE( MayDeclareMockableFunctions( contents, true ) );
+}
+
+/*
+ * Check that inline function definitions are ruled out
+ */
+TEST( HeaderPrefilter, InlineFunctions )
+{
+    // Prepare
+    std::string cContents =
+            "static inline int function1(void) { return function2(); }\n"
+            "inline void function3(int a) { if( a ) { function4(a); } }\n";
+    std::string cppContents =
+            "namespace ns1 {\n"
+            "class Class1 : public Base<int, 2>\n"
+            "{\n"
+            "public:\n"
+            "    Class1() : m_a( 1 ), m_b{ 2 } { method1(); }\n"
+            "    int method2() const { return m_a; }\n"
+            "    Class1& operator=( const Class1 &other ) { m_a = other.m_a; return *this; }\n"
+            "private:\n"
+            "    int m_a;\n"
+            "    int m_b = 3;\n"
+            "    int m_c{ 4 };\n"
+            "};\n"
+            "template<typename T> T function5(T a) { return a; }\n"
+            "}\n";
+
+    // Exercise & Verify
+    CHECK_FALSE( MayDeclareMockableFunctions( cContents, false ) );
+    CHECK_FALSE( MayDeclareMockableFunctions( cppContents, true ) );
+}
+
+/*
+ * Check that function declarations inside namespaces, linkage specifications and classes are found
+ */
+TEST( HeaderPrefilter, NestedDeclarations )
+{
+    // Prepare
+    std::string cContents =
+            "#ifdef __cplusplus\n"
+            "extern \"C\" {\n"
+            "#endif\n"
+            "int function1(int a);\n"
+            "#ifdef __cplusplus\n"
+            "}\n"
+            "#endif\n";
+    std::string cppContents =
+            "namespace ns1 { inline namespace ns2 {\n"
+            "class Class1\n"
+            "{\n"
+            "public:\n"
+            "    bool operator==( const Class1 &other ) const;\n"
+            "};\n"
+            "} }\n";
+
+    // Exercise & Verify
+    CHECK_TRUE( MayDeclareMockableFunctions( cContents, false ) );
+    CHECK_TRUE( MayDeclareMockableFunctions( cppContents, true ) );
+}
+
+/*
+ * Check that functions declared through macros or type aliases defined in the header are found
+ */
+TEST( HeaderPrefilter, MacrosAndTypeAliases )
+{
+    // Exercise & Verify
+    CHECK_TRUE( MayDeclareMockableFunctions( "#define DECLARATION int function1(void)\nDECLARATION;", false ) );
+    CHECK_TRUE( MayDeclareMockableFunctions( "#define FOO BAR\n#define BAR function1(void)\nint FOO;", false ) );
+    CHECK_TRUE( MayDeclareMockableFunctions( "typedef int function_t(int *a);\nfunction_t function1;", false ) );
+    CHECK_TRUE( MayDeclareMockableFunctions( "typedef int (function_t)(int a);\nfunction_t function1;", false ) );
+    CHECK_TRUE( MayDeclareMockableFunctions( "typedef int function_t(int a);\ntypedef function_t foo_t;\nfoo_t function1;", false ) );
+    CHECK_TRUE( MayDeclareMockableFunctions( "using function_t = int(int a);\nfunction_t function1;", true ) );
+}
+
+/*
+ * Check that default values of template parameters are not taken as initializers
+ */
+TEST( HeaderPrefilter, TemplateDefaultParameters )
+{
+    // Exercise & Verify
+    CHECK_TRUE( MayDeclareMockableFunctions( "template<typename T = int, int N = (1 > 0)> void function1(T a);", true ) );
+}
@@ -50,7 +50,7 @@ TEST_GROUP( Method )
             Method method;
             if( method.Parse( cursor, config ) )
             {
-                results.push_back( method.GenerateMock() );
+                results.push_back( method.GenerateMock( false, false ) );
             }
         } );
 
@@ -0,0 +1,27 @@
+/*
+ * This file has been auto-generated by CppUTestMock v0.1.0.
+ *
+ * Contents will NOT be preserved if it is regenerated!!!
+ */
+
+#include "FileWatcher.hpp"
+
+#include <CppUTestExt/MockSupport.h>
+
+FileWatcher::FileWatcher()
+{
+}
+
+FileWatcher::~FileWatcher()
+{
+}
+
+void FileWatcher::SetWatchedFiles(const std::vector<std::string> & filepaths)
+{
+    mock().actualCall("FileWatcher::SetWatchedFiles").onObject(this).withParameterOfType("std::vector<std::string>", "filepaths", &filepaths);
+}
+
+bool FileWatcher::WaitForChanges(std::vector<std::string> & changedFilepaths)
+{
+    return mock().actualCall("FileWatcher::WaitForChanges").onObject(this).withOutputParameterOfType("std::vector<std::string>", "changedFilepaths", &changedFilepaths).returnBoolValue();
+}
@@ -8,12 +8,6 @@
 
 #include <CppUTestExt/MockSupport.h>
 
-class Function::Argument
-{};
-
-class Function::Return
-{};
-
 Function::Function()
 : m_isConst( false )
 {}
@@ -26,14 +20,19 @@ bool Function::Parse(const CXCursor & cursor, const Config & config)
     return mock().actualCall("Function::Parse").withConstPointerParameter("cursor", &cursor).withConstPointerParameter("config", &config).returnBoolValue();
 }
 
-std::string Function::GenerateMock() const
+std::string Function::GenerateMock(bool profiling, bool recordReplay) const
+{
+    return mock().actualCall("Function::GenerateMock").withBoolParameter("profiling", profiling).withBoolParameter("recordReplay", recordReplay).returnStringValue();
+}
+
+std::string Function::GenerateExpectation(bool proto, bool profiling) const
 {
-    return mock().actualCall("Function::GenerateMock").returnStringValue();
+    return mock().actualCall("Function::GenerateExpectation").withBoolParameter("proto", proto).withBoolParameter("profiling", profiling).returnStringValue();
 }
 
-std::string Function::GenerateExpectation(bool proto) const
+void Function::GetPodRecordTypes(std::set<std::string> & types) const
 {
-    return mock().actualCall("Function::GenerateExpectation").withBoolParameter("proto", proto).returnStringValue();
+    mock().actualCall("Function::GetPodRecordTypes").withOutputParameterOfType("std::set<std::string>", "types", &types);
 }
 
 bool Function::IsMockable(const CXCursor & cursor) const
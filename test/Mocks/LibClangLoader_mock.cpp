@@ -0,0 +1,19 @@
+/*
+ * This file has been auto-generated by CppUTestMock v0.1.0.
+ *
+ * Contents will NOT be preserved if it is regenerated!!!
+ */
+
+#include "LibClangLoader.hpp"
+
+#include <CppUTestExt/MockSupport.h>
+
+void SetLibClangPath(const std::string & libraryPath)
+{
+    mock().actualCall("SetLibClangPath").withStringParameter("libraryPath", libraryPath.c_str());
+}
+
+void LoadLibClang()
+{
+    mock().actualCall("LoadLibClang");
+}
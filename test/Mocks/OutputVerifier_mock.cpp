@@ -0,0 +1,23 @@
+/*
+ * This file has been auto-generated by CppUTestMock v0.1.0.
+ *
+ * Contents will NOT be preserved if it is regenerated!!!
+ */
+
+#include "OutputVerifier.hpp"
+
+#include <CppUTestExt/MockSupport.h>
+
+OutputVerifier::OutputVerifier(const std::vector<std::string> & includePaths, const std::vector<std::string> & includeFiles)
+{
+    mock().actualCall("OutputVerifier::OutputVerifier").withParameterOfType("std::vector<std::string>", "includePaths", &includePaths).withParameterOfType("std::vector<std::string>", "includeFiles", &includeFiles);
+}
+
+OutputVerifier::~OutputVerifier()
+{
+}
+
+bool OutputVerifier::Verify(const std::string & inputFilepath, const std::string * inputContents, const std::vector<GeneratedFile> & files, std::ostream & error)
+{
+    return mock().actualCall("OutputVerifier::Verify").onObject(this).withStringParameter("inputFilepath", inputFilepath.c_str()).withConstPointerParameter("inputContents", inputContents).withParameterOfType("std::vector<OutputVerifier::GeneratedFile>", "files", &files).withOutputParameterOfType("std::ostream", "error", &error).returnBoolValue();
+}
@@ -11,22 +11,93 @@
 #include <CppUTestExt/MockSupport.h>
 
 bool Parser::Parse(const std::string & inputFilepath, const Config & config, bool interpretAsCpp, bool useCpp11, const std::vector<std::string> & includePaths, 
-                   const std::vector<std::string> & preprocessorDefines, std::ostream & error)
+                   const std::vector<std::string> & preprocessorDefines, const std::vector<std::string> & symbols, EmittedFunctions & emittedFunctions, std::ostream & error)
 {
-    return mock().actualCall("Parser::Parse").withStringParameter("inputFilepath", inputFilepath.c_str()).withConstPointerParameter("config", &config).withBoolParameter("interpretAsCpp", interpretAsCpp).withBoolParameter("useCpp11", useCpp11).withParameterOfType("std::vector<std::string>", "includePaths", &includePaths).withParameterOfType("std::vector<std::string>", "preprocessorDefines", &preprocessorDefines).withPointerParameter("error", &error).returnBoolValue();
+    return mock().actualCall("Parser::Parse").withStringParameter("inputFilepath", inputFilepath.c_str()).withConstPointerParameter("config", &config).withBoolParameter("interpretAsCpp", interpretAsCpp).withBoolParameter("useCpp11", useCpp11).withParameterOfType("std::vector<std::string>", "includePaths", &includePaths).withParameterOfType("std::vector<std::string>", "preprocessorDefines", &preprocessorDefines).withParameterOfType("std::vector<std::string>", "symbols", &symbols).withPointerParameter("emittedFunctions", &emittedFunctions).withPointerParameter("error", &error).returnBoolValue();
 }
 
-void Parser::GenerateMock(const std::string & genOpts, std::ostream & output) const
+bool Parser::ParseUmbrella(const std::vector<std::string> & inputFilepaths, const Config & config, bool interpretAsCpp, bool useCpp11, const std::vector<std::string> & includePaths,
+                           const std::vector<std::string> & includeFiles, const std::vector<std::string> & symbols, EmittedFunctions & emittedFunctions, std::vector<Parser> & parsers, std::ostream & error)
 {
-    mock().actualCall("Parser::GenerateMock").withStringParameter("genOpts", genOpts.c_str()).withOutputParameterOfType("std::ostream", "output", &output);
+    return mock().actualCall("Parser::ParseUmbrella").withParameterOfType("std::vector<std::string>", "inputFilepaths", &inputFilepaths).withConstPointerParameter("config", &config).withBoolParameter("interpretAsCpp", interpretAsCpp).withBoolParameter("useCpp11", useCpp11).withParameterOfType("std::vector<std::string>", "includePaths", &includePaths).withParameterOfType("std::vector<std::string>", "includeFiles", &includeFiles).withParameterOfType("std::vector<std::string>", "symbols", &symbols).withPointerParameter("emittedFunctions", &emittedFunctions).withPointerParameter("parsers", &parsers).withPointerParameter("error", &error).returnBoolValue();
 }
 
-void Parser::GenerateExpectationHeader(const std::string & genOpts, std::ostream & output) const
+void Parser::EnableReparse()
 {
-    mock().actualCall("Parser::GenerateExpectationHeader").onObject(this).withStringParameter("genOpts", genOpts.c_str()).withOutputParameterOfType("std::ostream", "output", &output);
+    mock().actualCall("Parser::EnableReparse").onObject(this);
 }
 
-void Parser::GenerateExpectationImpl(const std::string & genOpts, const std::string & headerFilepath, std::ostream & output) const
+void Parser::EnableDependencyTracking()
 {
-    mock().actualCall("Parser::GenerateExpectationImpl").onObject(this).withStringParameter("genOpts", genOpts.c_str()).withStringParameter("headerFilepath", headerFilepath.c_str()).withOutputParameterOfType("std::ostream", "output", &output);
+    mock().actualCall("Parser::EnableDependencyTracking").onObject(this);
+}
+
+void Parser::EnableSingleFileParse()
+{
+    mock().actualCall("Parser::EnableSingleFileParse").onObject(this);
+}
+
+void Parser::EnableSkipWithoutFunctions()
+{
+    mock().actualCall("Parser::EnableSkipWithoutFunctions").onObject(this);
+}
+
+void Parser::SetInputContents(const std::string & contents)
+{
+    mock().actualCall("Parser::SetInputContents").onObject(this).withStringParameter("contents", contents.c_str());
+}
+
+void Parser::SetIncludePath(const std::string & includePath)
+{
+    mock().actualCall("Parser::SetIncludePath").onObject(this).withStringParameter("includePath", includePath.c_str());
+}
+
+bool Parser::Reparse(const Config & config, const std::vector<std::string> & symbols, EmittedFunctions & emittedFunctions, std::ostream & error)
+{
+    return mock().actualCall("Parser::Reparse").onObject(this).withConstPointerParameter("config", &config).withParameterOfType("std::vector<std::string>", "symbols", &symbols).withPointerParameter("emittedFunctions", &emittedFunctions).withPointerParameter("error", &error).returnBoolValue();
+}
+
+std::vector<std::string> Parser::GetDependencies() const
+{
+    return * static_cast<const std::vector<std::string> *>( mock().actualCall("Parser::GetDependencies").onObject(this).returnConstPointerValue() );
+}
+
+const Parser::Statistics& Parser::GetStatistics() const
+{
+    return * static_cast<const Parser::Statistics *>( mock().actualCall("Parser::GetStatistics").onObject(this).returnConstPointerValue() );
+}
+
+bool Parser::IsSkipped() const
+{
+    return mock().actualCall("Parser::IsSkipped").onObject(this).returnBoolValue();
+}
+
+bool Parser::RemoveEmittedFunctions(EmittedFunctions & emittedFunctions, std::ostream & error)
+{
+    return mock().actualCall("Parser::RemoveEmittedFunctions").onObject(this).withPointerParameter("emittedFunctions", &emittedFunctions).withPointerParameter("error", &error).returnBoolValue();
+}
+
+void Parser::ReportNoMockableFunctions(const std::string & inputFileDescription, bool symbolsListed, std::ostream & error, bool skipped)
+{
+    mock().actualCall("Parser::ReportNoMockableFunctions").withStringParameter("inputFileDescription", inputFileDescription.c_str()).withBoolParameter("symbolsListed", symbolsListed).withPointerParameter("error", &error).withBoolParameter("skipped", skipped);
+}
+
+void Parser::GenerateMock(const std::string & genOpts, bool profiling, bool recordReplay, std::ostream & output) const
+{
+    mock().actualCall("Parser::GenerateMock").withStringParameter("genOpts", genOpts.c_str()).withBoolParameter("profiling", profiling).withBoolParameter("recordReplay", recordReplay).withOutputParameterOfType("std::ostream", "output", &output);
+}
+
+void Parser::GenerateExpectationHeader(const std::string & genOpts, bool podComparators, std::ostream & output) const
+{
+    mock().actualCall("Parser::GenerateExpectationHeader").onObject(this).withStringParameter("genOpts", genOpts.c_str()).withBoolParameter("podComparators", podComparators).withOutputParameterOfType("std::ostream", "output", &output);
+}
+
+void Parser::GenerateExpectationImpl(const std::string & genOpts, const std::string & headerFilepath, bool profiling, bool podComparators, std::ostream & output) const
+{
+    mock().actualCall("Parser::GenerateExpectationImpl").onObject(this).withStringParameter("genOpts", genOpts.c_str()).withStringParameter("headerFilepath", headerFilepath.c_str()).withBoolParameter("profiling", profiling).withBoolParameter("podComparators", podComparators).withOutputParameterOfType("std::ostream", "output", &output);
+}
+
+void Parser::UpdateFingerprints(FingerprintStore & fingerprints, const std::string & genOpts, bool profiling, bool recordReplay) const
+{
+    mock().actualCall("Parser::UpdateFingerprints").onObject(this).withPointerParameter("fingerprints", &fingerprints).withStringParameter("genOpts", genOpts.c_str()).withBoolParameter("profiling", profiling).withBoolParameter("recordReplay", recordReplay);
 }
@@ -0,0 +1,174 @@
+/**
+ * @file
+ * @brief      Unit tests for the "OutputVerifier" class
+ * @project    CppUMockGen
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include <string>
+#include <vector>
+#include <sstream>
+
+#include "OutputVerifier.hpp"
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+static const std::string inputFilepath = "CppUMockGen_OutputVerifier.h";
+static const std::string inputContents = "int foo( int a );\n";
+static const std::vector<std::string> includePaths = { CPPUTEST_INCLUDE_DIR };
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( OutputVerifier )
+{
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+/*
+ * Check that valid outputs are verified
+ */
+TEST( OutputVerifier, Verify_Valid )
+{
+    // Prepare
+    std::ostringstream error;
+    OutputVerifier verifier( includePaths, std::vector<std::string>() );
+
+    std::vector<OutputVerifier::GeneratedFile> files = {
+        { "CppUMockGen_OutputVerifier_mock.cpp",
+          "#include \"CppUMockGen_OutputVerifier.h\"\n"
+          "#include <CppUTestExt/MockSupport.h>\n"
+          "int foo( int a )\n"
+          "{\n"
+          "    return mock().actualCall(\"foo\").withIntParameter(\"a\", a).returnIntValue();\n"
+          "}\n", true } };
+
+    // Exercise
+    bool result = verifier.Verify( inputFilepath, &inputContents, files, error );
+
+    // Verify
+    CHECK_TRUE( result );
+    STRCMP_EQUAL( "", error.str().c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that errors are reported indicating the function for which the code was generated
+ */
+TEST( OutputVerifier, Verify_Error )
+{
+    // Prepare
+    std::ostringstream error;
+    OutputVerifier verifier( includePaths, std::vector<std::string>() );
+
+    std::vector<OutputVerifier::GeneratedFile> files = {
+        { "CppUMockGen_OutputVerifier_mock.cpp",
+          "#include \"CppUMockGen_OutputVerifier.h\"\n"
+          "#include <CppUTestExt/MockSupport.h>\n"
+          "int foo( int a )\n"
+          "{\n"
+          "    return mock().actualCall(\"foo\").withIntParameter(\"a\", b).returnIntValue();\n"
+          "}\n", true } };
+
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    // Exercise
+    bool result = verifier.Verify( inputFilepath, &inputContents, files, error );
+
+    // Verify
+    mock().checkExpectations();
+    CHECK_FALSE( result );
+    STRCMP_CONTAINS( "VERIFY ERROR:", error.str().c_str() );
+    STRCMP_CONTAINS( "CppUMockGen_OutputVerifier_mock.cpp:5:", error.str().c_str() );
+    STRCMP_CONTAINS( "(in the code generated for function 'foo(int)')", error.str().c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that errors in expectation functions are reported indicating the function for which they were generated
+ */
+TEST( OutputVerifier, Verify_ExpectationError )
+{
+    // Prepare
+    std::ostringstream error;
+    OutputVerifier verifier( includePaths, std::vector<std::string>() );
+
+    std::vector<OutputVerifier::GeneratedFile> files = {
+        { "CppUMockGen_OutputVerifier_expect.hpp",
+          "#include \"CppUMockGen_OutputVerifier.h\"\n"
+          "#include <CppUTestExt/MockSupport.h>\n"
+          "namespace expect {\n"
+          "MockExpectedCall& foo( int a );\n"
+          "}\n", false },
+        { "CppUMockGen_OutputVerifier_expect.cpp",
+          "#include \"CppUMockGen_OutputVerifier_expect.hpp\"\n"
+          "namespace expect {\n"
+          "MockExpectedCall& foo( int a )\n"
+          "{\n"
+          "    return mock().expectOneCall(\"foo\").withIntParameter(\"a\", a).andReturnValue(undefined);\n"
+          "}\n"
+          "}\n", true } };
+
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    // Exercise
+    bool result = verifier.Verify( inputFilepath, &inputContents, files, error );
+
+    // Verify
+    mock().checkExpectations();
+    CHECK_FALSE( result );
+    STRCMP_CONTAINS( "VERIFY ERROR:", error.str().c_str() );
+    STRCMP_CONTAINS( "CppUMockGen_OutputVerifier_expect.cpp:5:", error.str().c_str() );
+    STRCMP_CONTAINS( "(in the code generated for function 'foo')", error.str().c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that the precompiled CppUTest headers are reused by later verifiers
+ */
+TEST( OutputVerifier, Verify_CachedPrefix )
+{
+    // Prepare
+    std::ostringstream error1;
+    std::ostringstream error2;
+    OutputVerifier verifier1( includePaths, std::vector<std::string>() );
+    OutputVerifier verifier2( includePaths, std::vector<std::string>() );
+
+    std::vector<OutputVerifier::GeneratedFile> files = {
+        { "CppUMockGen_OutputVerifier_mock.cpp",
+          "#include \"CppUMockGen_OutputVerifier.h\"\n"
+          "#include <CppUTestExt/MockSupport.h>\n"
+          "int foo( int a )\n"
+          "{\n"
+          "    return mock().actualCall(\"foo\").withIntParameter(\"a\", a).returnIntValue();\n"
+          "}\n", true } };
+
+    // Exercise
+    bool result1 = verifier1.Verify( inputFilepath, &inputContents, files, error1 );
+    bool result2 = verifier2.Verify( inputFilepath, &inputContents, files, error2 );
+
+    // Verify
+    CHECK_TRUE( result1 );
+    CHECK_TRUE( result2 );
+    STRCMP_EQUAL( "", error2.str().c_str() );
+
+    // Cleanup
+}
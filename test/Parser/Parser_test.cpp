@@ -18,6 +18,7 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <set>
 #include <cstdlib>
 #include <direct.h>
 
@@ -29,6 +30,8 @@
 
 #include "Parser.hpp"
 #include "FileHelper.hpp"
+#include "FingerprintStore.hpp"
+#include "Trace.hpp"
 
 #ifdef _MSC_VER
 #pragma warning( disable : 4996 )
@@ -43,6 +46,34 @@ Config* GetMockConfig()
     return (Config*) (void*) 836487567;
 }
 
+class StdSetOfStringsCopier : public MockNamedValueCopier
+{
+public:
+    virtual void copy(void* out, const void* in)
+    {
+        const std::set<std::string> *i = (const std::set<std::string>*) in;
+        ((std::set<std::string>*) out)->insert( i->begin(), i->end() );
+    }
+};
+
+StdSetOfStringsCopier stdSetOfStringsCopier;
+
+// Removes the inclusions of local files from the generated code, which cannot be found when compiling it in memory
+static std::string RemoveLocalIncludes( const std::string &code )
+{
+    std::istringstream input( code );
+    std::string ret;
+    std::string line;
+    while( std::getline( input, line ) )
+    {
+        if( line.compare( 0, 10, "#include \"" ) != 0 )
+        {
+            ret += line + "\n";
+        }
+    }
+    return ret;
+}
+
 /*===========================================================================
  *                          TEST GROUP DEFINITION
  *===========================================================================*/
@@ -66,6 +97,7 @@ TEST_GROUP( MockGenerator )
     {
         chdir( initialDir.c_str() );
         std::remove( tempFilePath.c_str() );
+        TraceRecorder::Stop();
     }
 
     void SetupTempFile( const SimpleString& contents )
@@ -97,7 +129,8 @@ TEST( MockGenerator, MockedFunction )
 
    // Exercise
    Parser parser;
-   bool result = parser.Parse( tempFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), error );
+   Parser::EmittedFunctions emittedFunctions;
+   bool result = parser.Parse( tempFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
 
    // Verify
    CHECK_EQUAL( true, result );
@@ -108,10 +141,10 @@ TEST( MockGenerator, MockedFunction )
    std::ostringstream output;
    const char* testMock = "###MOCK###";
 
-   mock().expectOneCall("Function::GenerateMock").andReturnValue(testMock);
+   mock().expectOneCall("Function::GenerateMock").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false).andReturnValue(testMock);
 
    // Exercise
-   parser.GenerateMock( "", output );
+   parser.GenerateMock( "", false, false, output );
 
    // Verify
    STRCMP_CONTAINS( testMock, output.str().c_str() );
@@ -140,7 +173,8 @@ TEST( MockGenerator, MockedMethod )
 
     // Exercise
     Parser parser;
-    bool result = parser.Parse( tempFilePath, *config, true, false, std::vector<std::string>(), std::vector<std::string>(), error );
+    Parser::EmittedFunctions emittedFunctions;
+    bool result = parser.Parse( tempFilePath, *config, true, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
 
     // Verify
     CHECK_EQUAL( true, result );
@@ -151,10 +185,10 @@ TEST( MockGenerator, MockedMethod )
     std::ostringstream output;
     const char* testMock = "###MOCK###";
 
-    mock().expectOneCall("Function::GenerateMock").andReturnValue(testMock);
+    mock().expectOneCall("Function::GenerateMock").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false).andReturnValue(testMock);
 
     // Exercise
-    parser.GenerateMock( "", output );
+    parser.GenerateMock( "", false, false, output );
 
     // Verify
     STRCMP_CONTAINS( testMock, output.str().c_str() );
@@ -185,7 +219,8 @@ TEST( MockGenerator, MultipleMockableFunctionsAndMethods )
 
     // Exercise
     Parser parser;
-    bool result = parser.Parse( tempFilePath, *config, true, false, std::vector<std::string>(), std::vector<std::string>(), error );
+    Parser::EmittedFunctions emittedFunctions;
+    bool result = parser.Parse( tempFilePath, *config, true, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
 
     // Verify
     CHECK_EQUAL( true, result );
@@ -196,13 +231,13 @@ TEST( MockGenerator, MultipleMockableFunctionsAndMethods )
     std::ostringstream output;
     const char* testMock[] = { "### MOCK 1 ###\n", "### MOCK 2 ###\n", "### MOCK 3 ###\n", "### MOCK 4 ###\n" };
 
-    mock().expectOneCall("Function::GenerateMock").andReturnValue(testMock[0]);
-    mock().expectOneCall("Function::GenerateMock").andReturnValue(testMock[1]);
-    mock().expectOneCall("Function::GenerateMock").andReturnValue(testMock[2]);
-    mock().expectOneCall("Function::GenerateMock").andReturnValue(testMock[3]);
+    mock().expectOneCall("Function::GenerateMock").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false).andReturnValue(testMock[0]);
+    mock().expectOneCall("Function::GenerateMock").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false).andReturnValue(testMock[1]);
+    mock().expectOneCall("Function::GenerateMock").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false).andReturnValue(testMock[2]);
+    mock().expectOneCall("Function::GenerateMock").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false).andReturnValue(testMock[3]);
 
     // Exercise
-    parser.GenerateMock( "", output );
+    parser.GenerateMock( "", false, false, output );
 
     // Verify
     STRCMP_CONTAINS( testMock[0], output.str().c_str() );
@@ -231,7 +266,8 @@ TEST( MockGenerator, FunctionNonMockable )
 
    // Exercise
    Parser parser;
-   bool result = parser.Parse( tempFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), error );
+   Parser::EmittedFunctions emittedFunctions;
+   bool result = parser.Parse( tempFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
 
    // Verify
    CHECK_EQUAL( false, result );
@@ -241,6 +277,67 @@ TEST( MockGenerator, FunctionNonMockable )
    // Cleanup
 }
 
+/*
+ * Check that an input file without mockable functions is reported as skipped, and not as an error, when skipping is
+ * enabled.
+ */
+TEST( MockGenerator, FunctionNonMockable_Skipped )
+{
+   // Prepare
+   Config* config = GetMockConfig();
+   std::ostringstream error;
+
+   SimpleString testHeader =
+           "void function1(int a);";
+   SetupTempFile( testHeader );
+
+   mock().expectOneCall("Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(false);
+   mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+   // Exercise
+   Parser parser;
+   parser.EnableSkipWithoutFunctions();
+   Parser::EmittedFunctions emittedFunctions;
+   bool result = parser.Parse( tempFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
+
+   // Verify
+   CHECK_EQUAL( false, result );
+   CHECK_EQUAL( true, parser.IsSkipped() );
+   STRCMP_CONTAINS( "INPUT WARNING:", error.str().c_str() );
+   STRCMP_CONTAINS( ( "The input file '" + tempFilePath + "' does not contain any mockable function, it has been skipped." ).c_str(), error.str().c_str() );
+
+   // Cleanup
+}
+
+/*
+ * Check that an input file with errors is not reported as skipped even if skipping is enabled.
+ */
+TEST( MockGenerator, ParseError_NotSkipped )
+{
+   // Prepare
+   Config* config = GetMockConfig();
+   std::ostringstream error;
+
+   SimpleString testHeader =
+           "foo function1(int a);";
+   SetupTempFile( testHeader );
+
+   mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+   // Exercise
+   Parser parser;
+   parser.EnableSkipWithoutFunctions();
+   Parser::EmittedFunctions emittedFunctions;
+   bool result = parser.Parse( tempFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
+
+   // Verify
+   CHECK_EQUAL( false, result );
+   CHECK_EQUAL( false, parser.IsSkipped() );
+   STRCMP_CONTAINS( "PARSE ERROR:", error.str().c_str() );
+
+   // Cleanup
+}
+
 /*
  * Check that mocking a non-mockable method works as expected.
  */
@@ -262,7 +359,8 @@ TEST( MockGenerator, MethodNonMockable )
 
    // Exercise
    Parser parser;
-   bool result = parser.Parse( tempFilePath, *config, true, false, std::vector<std::string>(), std::vector<std::string>(), error );
+   Parser::EmittedFunctions emittedFunctions;
+   bool result = parser.Parse( tempFilePath, *config, true, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
 
    // Verify
    CHECK_EQUAL( false, result );
@@ -298,7 +396,8 @@ TEST( MockGenerator, MixedMockableNonMockableFunctionsAndMethods )
 
     // Exercise
     Parser parser;
-    bool result = parser.Parse( tempFilePath, *config, true, false, std::vector<std::string>(), std::vector<std::string>(), error );
+    Parser::EmittedFunctions emittedFunctions;
+    bool result = parser.Parse( tempFilePath, *config, true, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
 
     // Verify
     CHECK_EQUAL( true, result );
@@ -309,11 +408,11 @@ TEST( MockGenerator, MixedMockableNonMockableFunctionsAndMethods )
     std::ostringstream output;
     const char* testMock[] = { "### MOCK 1 ###\n", "### MOCK 2 ###\n" };
 
-    mock().expectOneCall("Function::GenerateMock").andReturnValue(testMock[0]);
-    mock().expectOneCall("Function::GenerateMock").andReturnValue(testMock[1]);
+    mock().expectOneCall("Function::GenerateMock").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false).andReturnValue(testMock[0]);
+    mock().expectOneCall("Function::GenerateMock").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false).andReturnValue(testMock[1]);
 
     // Exercise
-    parser.GenerateMock( "", output );
+    parser.GenerateMock( "", false, false, output );
 
     // Verify
     STRCMP_CONTAINS( testMock[0], output.str().c_str() );
@@ -339,7 +438,8 @@ TEST( MockGenerator, SyntaxError )
 
    // Exercise
    Parser parser;
-   bool result = parser.Parse( tempFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), error );
+   Parser::EmittedFunctions emittedFunctions;
+   bool result = parser.Parse( tempFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
 
    // Verify
    CHECK_EQUAL( false, result );
@@ -367,13 +467,14 @@ TEST( MockGenerator, Warning )
 
    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
    mock().expectOneCall("Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(true);
-   mock().expectOneCall("Function::GenerateMock").andReturnValue(testMock);
+   mock().expectOneCall("Function::GenerateMock").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false).andReturnValue(testMock);
 
    // Exercise
    std::vector<std::string> results;
    Parser parser;
-   bool result = parser.Parse( tempFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), error );
-   parser.GenerateMock( "", output );
+   Parser::EmittedFunctions emittedFunctions;
+   bool result = parser.Parse( tempFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
+   parser.GenerateMock( "", false, false, output );
 
    // Verify
    CHECK_EQUAL( true, result );
@@ -385,6 +486,111 @@ TEST( MockGenerator, Warning )
    // Cleanup
 }
 
+/*
+ * Check that in single file mode the included files are not expanded, and errors due to unknown types are handled
+ * as warnings without aborting mock generation.
+ */
+TEST( MockGenerator, SingleFileParse )
+{
+   // Prepare
+   Config* config = GetMockConfig();
+   std::ostringstream error;
+
+   SimpleString testHeader =
+           "#include \"CppUMockGen_NotExisting.h\"\n"
+           "void function1(Type1 *p);";
+   SetupTempFile( testHeader );
+
+   mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+   mock().expectOneCall("Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(true);
+
+   // Exercise
+   Parser parser;
+   Parser::EmittedFunctions emittedFunctions;
+   parser.EnableSingleFileParse();
+   bool result = parser.Parse( tempFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
+
+   // Verify
+   CHECK_EQUAL( true, result );
+   STRCMP_CONTAINS( "PARSE WARNING:", error.str().c_str() );
+   STRCMP_CONTAINS( "unknown type name 'Type1'", error.str().c_str() );
+   CHECK_FALSE( error.str().find( "CppUMockGen_NotExisting.h" ) != std::string::npos );
+   mock().checkExpectations();
+
+   // Cleanup
+}
+
+/*
+ * Check that the contents of the input file can be taken from memory, using the input file path as a virtual path.
+ */
+TEST( MockGenerator, InputContents )
+{
+   // Prepare
+   Config* config = GetMockConfig();
+   std::ostringstream error;
+
+   mock().expectOneCall("Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(true);
+
+   // Exercise
+   Parser parser;
+   Parser::EmittedFunctions emittedFunctions;
+   parser.SetInputContents( "void function1(int a);" );
+   bool result = parser.Parse( nonexistingFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
+
+   // Verify
+   CHECK_EQUAL( true, result );
+   CHECK_EQUAL( 0, error.tellp() );
+   mock().checkExpectations();
+
+   // Prepare
+   std::ostringstream output;
+   const char* testMock = "###MOCK###";
+
+   mock().expectOneCall("Function::GenerateMock").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false).andReturnValue(testMock);
+
+   // Exercise
+   parser.GenerateMock( "", false, false, output );
+
+   // Verify
+   STRCMP_CONTAINS( testMock, output.str().c_str() );
+   STRCMP_CONTAINS( "#include \"CppUMockGen_MockGenerator_NotExisting.h\"", output.str().c_str() );
+
+   // Cleanup
+}
+
+/*
+ * Check that the generated expectations and mocks include the input file by the include path set, if any.
+ */
+TEST( MockGenerator, IncludePath )
+{
+   // Prepare
+   Config* config = GetMockConfig();
+   std::ostringstream error;
+   std::ostringstream output;
+   std::ostringstream outputHeader;
+
+   mock().expectOneCall("Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(true);
+   mock().expectOneCall("Function::GenerateMock").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false).andReturnValue("");
+   mock().expectOneCall("Function::GenerateExpectation").withBoolParameter("proto", true).withBoolParameter("profiling", false).andReturnValue("");
+
+   // Exercise
+   Parser parser;
+   Parser::EmittedFunctions emittedFunctions;
+   parser.SetInputContents( "void function1(int a);" );
+   parser.SetIncludePath( "sub/CppUMockGen_MockGenerator_NotExisting.h" );
+   bool result = parser.Parse( nonexistingFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
+   parser.GenerateMock( "", false, false, output );
+   parser.GenerateExpectationHeader( "", false, outputHeader );
+
+   // Verify
+   mock().checkExpectations();
+   CHECK_EQUAL( true, result );
+   STRCMP_CONTAINS( "#include \"sub/CppUMockGen_MockGenerator_NotExisting.h\"", output.str().c_str() );
+   STRCMP_CONTAINS( "#include \"sub/CppUMockGen_MockGenerator_NotExisting.h\"", outputHeader.str().c_str() );
+
+   // Cleanup
+}
+
 /*
  * Check that an error is issued when the input file does not exist.
  */
@@ -400,7 +606,8 @@ TEST( MockGenerator, NonExistingInputFile )
 
    // Exercise
    Parser parser;
-   bool result = parser.Parse( nonexistingFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), error );
+   Parser::EmittedFunctions emittedFunctions;
+   bool result = parser.Parse( nonexistingFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
 
    // Verify
    CHECK_EQUAL( false, result );
@@ -432,7 +639,8 @@ TEST( MockGenerator, IncludePaths )
 
    // Exercise
    Parser parser;
-   bool result = parser.Parse( tempFilename, *config, true, false, std::vector<std::string>{includePath}, std::vector<std::string>(), error );
+   Parser::EmittedFunctions emittedFunctions;
+   bool result = parser.Parse( tempFilename, *config, true, false, std::vector<std::string>{includePath}, std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
 
    // Verify
    CHECK_EQUAL( true, result );
@@ -464,7 +672,8 @@ IGNORE_TEST( MockGenerator, PreprocessorMacroDefinitions )
 
    // Exercise
    Parser parser;
-   bool result = parser.Parse( tempFilename, *config, true, false, std::vector<std::string>(), std::vector<std::string>{define}, error );
+   Parser::EmittedFunctions emittedFunctions;
+   bool result = parser.Parse( tempFilename, *config, true, false, std::vector<std::string>(), std::vector<std::string>{define}, std::vector<std::string>(), emittedFunctions, error );
 
    // Verify
    CHECK_EQUAL( true, result );
@@ -485,10 +694,971 @@ TEST( MockGenerator, WithRegenOpts )
 
    // Exercise
    Parser parser;
-   parser.GenerateMock( testRegenOpts, output );
+   parser.GenerateMock( testRegenOpts, false, false, output );
 
    // Verify
    STRCMP_CONTAINS( StringFromFormat( "Generation options: %s", testRegenOpts ).asCharString(), output.str().c_str() );
 
    // Cleanup
 }
+
+/*
+ * Check that only the functions and methods whose symbols are listed are mocked.
+ */
+TEST( MockGenerator, SymbolsFilter )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    std::ostringstream error;
+
+    SimpleString testHeader =
+            "void function1(int a);\n"
+            "int function2();\n"
+            "class class1 {\n"
+            "public:\n"
+            "    void method1();\n"
+            "    double method2(int*);\n"
+            "};";
+    SetupTempFile( testHeader );
+
+    std::vector<std::string> symbols = { "_Z9function2v", "_ZN6class17method1Ev", "_Z9function3v" };
+
+    mock().expectNCalls(2, "Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(true);
+
+    // Exercise
+    Parser parser;
+    Parser::EmittedFunctions emittedFunctions;
+    bool result = parser.Parse( tempFilePath, *config, true, false, std::vector<std::string>(), std::vector<std::string>(), symbols, emittedFunctions, error );
+
+    // Verify
+    CHECK_EQUAL( true, result );
+    CHECK_EQUAL( 0, error.tellp() );
+    mock().checkExpectations();
+
+    // Cleanup
+}
+
+/*
+ * Check that an error is reported when none of the functions has its symbol listed.
+ */
+TEST( MockGenerator, SymbolsFilter_NoneSelected )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    std::ostringstream error;
+
+    SimpleString testHeader =
+            "void function1(int a);\n"
+            "int function2();";
+    SetupTempFile( testHeader );
+
+    std::vector<std::string> symbols = { "function3" };
+
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    // Exercise
+    Parser parser;
+    Parser::EmittedFunctions emittedFunctions;
+    bool result = parser.Parse( tempFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), symbols, emittedFunctions, error );
+
+    // Verify
+    CHECK_EQUAL( false, result );
+    STRCMP_CONTAINS( "INPUT ERROR:", error.str().c_str() );
+    STRCMP_CONTAINS( "The input file does not contain any mockable function referenced in the symbols list.", error.str().c_str() );
+    mock().checkExpectations();
+
+    // Cleanup
+}
+
+/*
+ * Check that symbols listed with the leading underscore added by platforms that decorate symbols select the functions
+ * on platforms that do not decorate them.
+ */
+TEST( MockGenerator, SymbolsFilter_DecoratedSymbols )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    std::ostringstream error;
+
+    SimpleString testHeader =
+            "extern \"C\" void function1(int a);\n"
+            "int function2();\n"
+            "void function3();";
+    SetupTempFile( testHeader );
+
+    std::vector<std::string> symbols = { "_function1", "__Z9function2v" };
+
+    mock().expectNCalls(2, "Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(true);
+
+    // Exercise
+    Parser parser;
+    Parser::EmittedFunctions emittedFunctions;
+    bool result = parser.Parse( tempFilePath, *config, true, false, std::vector<std::string>(), std::vector<std::string>(), symbols, emittedFunctions, error );
+
+    // Verify
+    CHECK_EQUAL( true, result );
+    CHECK_EQUAL( 0, error.tellp() );
+    mock().checkExpectations();
+
+    // Cleanup
+}
+
+/*
+ * Check that on platforms that do not decorate symbols, functions whose names start with an underscore are not
+ * selected by the symbols listed without it.
+ */
+TEST( MockGenerator, SymbolsFilter_UndecoratedSymbols )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    std::ostringstream error;
+
+    SimpleString testHeader =
+            "void _function1(int a);\n"
+            "void function2();";
+    SetupTempFile( testHeader );
+
+    std::vector<std::string> symbols = { "function1", "function2" };
+
+    mock().expectOneCall("Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(true);
+
+    // Exercise
+    Parser parser;
+    Parser::EmittedFunctions emittedFunctions;
+    bool result = parser.Parse( tempFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), symbols, emittedFunctions, error );
+
+    // Verify
+    CHECK_EQUAL( true, result );
+    CHECK_EQUAL( 0, error.tellp() );
+    mock().checkExpectations();
+    CHECK_EQUAL( 1, emittedFunctions.size() );
+    CHECK_EQUAL( 1, emittedFunctions.count( "c:@F@function2" ) );
+
+    // Cleanup
+}
+
+/*
+ * Check that functions already mocked for other input files are skipped and reported.
+ */
+TEST( MockGenerator, DuplicateFunctions )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    std::ostringstream error;
+
+    SimpleString testHeader =
+            "void function1(int a);\n"
+            "int function2();";
+    SetupTempFile( testHeader );
+
+    Parser::EmittedFunctions emittedFunctions = { { "c:@F@function1", "other.h" } };
+
+    mock().expectOneCall("Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(true);
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    // Exercise
+    Parser parser;
+    bool result = parser.Parse( tempFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
+
+    // Verify
+    CHECK_EQUAL( true, result );
+    STRCMP_CONTAINS( "INPUT WARNING:", error.str().c_str() );
+    STRCMP_CONTAINS( "Function 'function1(int)' declared in '", error.str().c_str() );
+    STRCMP_CONTAINS( "' has already been mocked for 'other.h'.", error.str().c_str() );
+    CHECK_EQUAL( 2, emittedFunctions.size() );
+    STRCMP_EQUAL( "other.h", emittedFunctions["c:@F@function1"].c_str() );
+    STRCMP_EQUAL( tempFilePath.c_str(), emittedFunctions["c:@F@function2"].c_str() );
+    mock().checkExpectations();
+
+    // Cleanup
+}
+
+/*
+ * Check that parsing succeeds when all the functions have already been mocked for other input files.
+ */
+TEST( MockGenerator, DuplicateFunctions_AllDuplicated )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    std::ostringstream error;
+
+    SimpleString testHeader =
+            "void function1(int a);";
+    SetupTempFile( testHeader );
+
+    Parser::EmittedFunctions emittedFunctions = { { "c:@F@function1", "other.h" } };
+
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    // Exercise
+    Parser parser;
+    bool result = parser.Parse( tempFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
+
+    // Verify
+    CHECK_EQUAL( true, result );
+    STRCMP_CONTAINS( "has already been mocked for 'other.h'.", error.str().c_str() );
+    mock().checkExpectations();
+
+    // Cleanup
+}
+
+/*
+ * Check that redeclarations of a function in the same input file are mocked only once.
+ */
+TEST( MockGenerator, Redeclarations )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    std::ostringstream error;
+
+    SimpleString testHeader =
+            "void function1(int a);\n"
+            "void function1(int b);";
+    SetupTempFile( testHeader );
+
+    mock().expectOneCall("Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(true);
+
+    // Exercise
+    Parser parser;
+    Parser::EmittedFunctions emittedFunctions;
+    bool result = parser.Parse( tempFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
+
+    // Verify
+    CHECK_EQUAL( true, result );
+    CHECK_EQUAL( 0, error.tellp() );
+    mock().checkExpectations();
+
+    // Cleanup
+}
+
+/*
+ * Check that functions and methods declared inside namespaces, linkage specifications and classes are mocked, while
+ * functions declared in included files are not.
+ */
+TEST( MockGenerator, NestedDeclarations )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    std::ostringstream error;
+
+    SimpleString testHeader =
+            "#include <cstdlib>\n"
+            "namespace ns1 {\n"
+            "extern \"C\" {\n"
+            "void function1(int a);\n"
+            "}\n"
+            "class class1 {\n"
+            "public:\n"
+            "    void method1();\n"
+            "};\n"
+            "}\n"
+            "void function2(int a);";
+    SetupTempFile( testHeader );
+
+    mock().expectNCalls(3, "Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(true);
+
+    // Exercise
+    Parser parser;
+    Parser::EmittedFunctions emittedFunctions;
+    bool result = parser.Parse( tempFilePath, *config, true, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
+
+    // Verify
+    CHECK_EQUAL( true, result );
+    CHECK_EQUAL( 0, error.tellp() );
+    mock().checkExpectations();
+
+    // Cleanup
+}
+
+/*
+ * Check that profiling support code is generated when profiling is requested.
+ */
+TEST( MockGenerator, Profiling )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    std::ostringstream error;
+
+    SimpleString testHeader =
+            "void function1(int a);";
+    SetupTempFile( testHeader );
+
+    mock().expectOneCall("Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(true);
+
+    Parser parser;
+    Parser::EmittedFunctions emittedFunctions;
+    bool result = parser.Parse( tempFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
+    CHECK_EQUAL( true, result );
+    mock().checkExpectations();
+
+    std::ostringstream output;
+    const char* testMock = "###MOCK###";
+
+    mock().expectOneCall("Function::GenerateMock").withBoolParameter("profiling", true).withBoolParameter("recordReplay", false).andReturnValue(testMock);
+
+    // Exercise
+    parser.GenerateMock( "", true, false, output );
+
+    // Verify
+    STRCMP_CONTAINS( testMock, output.str().c_str() );
+    STRCMP_CONTAINS( "namespace cppumockgen { namespace profiling {", output.str().c_str() );
+    STRCMP_CONTAINS( "CPPUMOCKGEN_PROFILE_OUTPUT", output.str().c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that trace support code is generated when record and replay paths are requested for a C header.
+ */
+TEST( MockGenerator, RecordReplay )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    std::ostringstream error;
+
+    SimpleString testHeader =
+            "void function1(int a);";
+    SetupTempFile( testHeader );
+
+    mock().expectOneCall("Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(true);
+
+    Parser parser;
+    Parser::EmittedFunctions emittedFunctions;
+    bool result = parser.Parse( tempFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
+    CHECK_EQUAL( true, result );
+    mock().checkExpectations();
+
+    std::ostringstream output;
+    const char* testMock = "###MOCK###";
+
+    mock().expectOneCall("Function::GenerateMock").withBoolParameter("profiling", false).withBoolParameter("recordReplay", true).andReturnValue(testMock);
+
+    // Exercise
+    parser.GenerateMock( "", false, true, output );
+
+    // Verify
+    STRCMP_CONTAINS( testMock, output.str().c_str() );
+    STRCMP_CONTAINS( "namespace cppumockgen { namespace trace {", output.str().c_str() );
+    STRCMP_CONTAINS( "CPPUMOCKGEN_TRACE", output.str().c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that record and replay paths are not generated for a C++ header.
+ */
+TEST( MockGenerator, RecordReplay_Cpp )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    std::ostringstream error;
+
+    SimpleString testHeader =
+            "void function1(int a);";
+    SetupTempFile( testHeader );
+
+    mock().expectOneCall("Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(true);
+
+    Parser parser;
+    Parser::EmittedFunctions emittedFunctions;
+    bool result = parser.Parse( tempFilePath, *config, true, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
+    CHECK_EQUAL( true, result );
+    mock().checkExpectations();
+
+    std::ostringstream output;
+    const char* testMock = "###MOCK###";
+
+    mock().expectOneCall("Function::GenerateMock").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false).andReturnValue(testMock);
+
+    // Exercise
+    parser.GenerateMock( "", false, true, output );
+
+    // Verify
+    STRCMP_CONTAINS( testMock, output.str().c_str() );
+    CHECK_TRUE( output.str().find( "cppumockgen::trace" ) == std::string::npos );
+
+    // Cleanup
+}
+
+/*
+ * Check that function fingerprints are calculated from the generated code.
+ */
+TEST( MockGenerator, UpdateFingerprints )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    std::ostringstream error;
+
+    SimpleString testHeader =
+            "void function1(int a);";
+    SetupTempFile( testHeader );
+
+    mock().expectOneCall("Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(true);
+
+    Parser parser;
+    Parser::EmittedFunctions emittedFunctions;
+    bool result = parser.Parse( tempFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
+    CHECK_EQUAL( true, result );
+    mock().checkExpectations();
+
+    FingerprintStore fingerprints;
+
+    mock().expectOneCall("Function::GenerateMock").withBoolParameter("profiling", true).withBoolParameter("recordReplay", true).andReturnValue("###MOCK###");
+    mock().expectOneCall("Function::GenerateExpectation").withBoolParameter("proto", true).withBoolParameter("profiling", false).andReturnValue("###PROTO###");
+    mock().expectOneCall("Function::GenerateExpectation").withBoolParameter("proto", false).withBoolParameter("profiling", true).andReturnValue("###IMPL###");
+
+    // Exercise
+    parser.UpdateFingerprints( fingerprints, "--foo ", true, true );
+
+    // Verify
+    mock().checkExpectations();
+    std::vector<FingerprintStore::Difference> differences = fingerprints.GetDifferences();
+    UNSIGNED_LONGS_EQUAL( 1, differences.size() );
+    CHECK( differences[0].change == FingerprintStore::Change::Added );
+    STRCMP_EQUAL( "function1(int)", differences[0].name.c_str() );
+    STRCMP_EQUAL( tempFilePath.c_str(), differences[0].inputFilepath.c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that comparators and copiers are generated for the POD record types of the functions, along with the helper
+ * that installs them.
+ */
+TEST( MockGenerator, PodComparators )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    std::ostringstream error;
+
+    SimpleString testHeader =
+            "struct struct1 { int a; char b[4]; };\n"
+            "struct struct2 { double c; };\n"
+            "void function1(const struct1 &a, struct2 *b);\n"
+            "void function2(struct1 c);";
+    SetupTempFile( testHeader );
+
+    mock().expectNCalls(2, "Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(true);
+
+    Parser parser;
+    Parser::EmittedFunctions emittedFunctions;
+    bool result = parser.Parse( tempFilePath, *config, true, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
+    CHECK_EQUAL( true, result );
+    mock().checkExpectations();
+
+    std::set<std::string> podTypes1 = { "struct1", "struct2" };
+    std::set<std::string> podTypes2 = { "struct1" };
+    std::ostringstream outputHeader;
+    std::ostringstream outputImpl;
+
+    mock().installCopier( "std::set<std::string>", stdSetOfStringsCopier );
+    mock().expectNCalls(2, "Function::GenerateExpectation").withBoolParameter("proto", true).withBoolParameter("profiling", false).andReturnValue("");
+    mock().expectNCalls(2, "Function::GenerateExpectation").withBoolParameter("proto", false).withBoolParameter("profiling", false).andReturnValue("");
+    mock().expectOneCall("Function::GetPodRecordTypes").withOutputParameterOfTypeReturning("std::set<std::string>", "types", &podTypes1);
+    mock().expectOneCall("Function::GetPodRecordTypes").withOutputParameterOfTypeReturning("std::set<std::string>", "types", &podTypes2);
+
+    // Exercise
+    parser.GenerateExpectationHeader( "", true, outputHeader );
+    parser.GenerateExpectationImpl( "", "CppUMockGen_MockGenerator_expect.hpp", false, true, outputImpl );
+
+    // Verify
+    mock().checkExpectations();
+    STRCMP_CONTAINS( "namespace expect {\nvoid InstallPodComparatorsAndCopiers_CppUMockGen_MockGenerator();\n}\n",
+                     outputHeader.str().c_str() );
+    STRCMP_CONTAINS( "class PodComparator : public MockNamedValueComparator", outputImpl.str().c_str() );
+    STRCMP_CONTAINS( "class PodCopier : public MockNamedValueCopier", outputImpl.str().c_str() );
+    STRCMP_CONTAINS( "namespace expect {\nvoid InstallPodComparatorsAndCopiers_CppUMockGen_MockGenerator()\n{\n"
+                     "    {\n"
+                     "        static PodComparator<struct1> comparator;\n"
+                     "        static PodCopier<struct1> copier;\n"
+                     "        mock().installComparator( \"struct1\", comparator );\n"
+                     "        mock().installCopier( \"struct1\", copier );\n"
+                     "    }\n"
+                     "    {\n"
+                     "        static PodComparator<struct2> comparator;\n"
+                     "        static PodCopier<struct2> copier;\n"
+                     "        mock().installComparator( \"struct2\", comparator );\n"
+                     "        mock().installCopier( \"struct2\", copier );\n"
+                     "    }\n"
+                     "}\n}\n", outputImpl.str().c_str() );
+    CHECK_TRUE( ClangCompileHelper::CheckCompilation( testHeader.asCharString(),
+                                                      RemoveLocalIncludes( outputHeader.str() + outputImpl.str() ) ) );
+
+    // Cleanup
+}
+
+/*
+ * Check that neither comparators and copiers nor the helper that installs them are generated unless requested.
+ */
+TEST( MockGenerator, PodComparators_NotRequested )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    std::ostringstream error;
+
+    SimpleString testHeader =
+            "struct struct1 { int a; };\n"
+            "void function1(struct1 a);";
+    SetupTempFile( testHeader );
+
+    mock().expectOneCall("Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(true);
+
+    Parser parser;
+    Parser::EmittedFunctions emittedFunctions;
+    bool result = parser.Parse( tempFilePath, *config, true, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
+    CHECK_EQUAL( true, result );
+    mock().checkExpectations();
+
+    std::ostringstream outputHeader;
+    std::ostringstream outputImpl;
+
+    mock().expectOneCall("Function::GenerateExpectation").withBoolParameter("proto", true).withBoolParameter("profiling", false).andReturnValue("");
+    mock().expectOneCall("Function::GenerateExpectation").withBoolParameter("proto", false).withBoolParameter("profiling", false).andReturnValue("");
+
+    // Exercise
+    parser.GenerateExpectationHeader( "", false, outputHeader );
+    parser.GenerateExpectationImpl( "", "CppUMockGen_MockGenerator_expect.hpp", false, false, outputImpl );
+
+    // Verify
+    mock().checkExpectations();
+    CHECK( outputHeader.str().find( "InstallPodComparatorsAndCopiers" ) == std::string::npos );
+    CHECK( outputImpl.str().find( "InstallPodComparatorsAndCopiers" ) == std::string::npos );
+    CHECK( outputImpl.str().find( "PodComparator" ) == std::string::npos );
+
+    // Cleanup
+}
+
+/*
+ * Check that the durations of the parse phases, the memory used by the translation unit and the number of functions
+ * are measured.
+ */
+TEST( MockGenerator, Statistics )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    std::ostringstream error;
+
+    SimpleString testHeader =
+            "void function1(int a);";
+    SetupTempFile( testHeader );
+
+    mock().expectOneCall("Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(true);
+
+    // Exercise
+    Parser parser;
+    Parser::EmittedFunctions emittedFunctions;
+    bool result = parser.Parse( tempFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
+
+    // Verify
+    CHECK_EQUAL( true, result );
+    mock().checkExpectations();
+    const Parser::Statistics &statistics = parser.GetStatistics();
+    CHECK_TRUE( statistics.parseDuration.count() > 0 );
+    CHECK_TRUE( statistics.modelDuration.count() > 0 );
+    CHECK_TRUE( statistics.memoryUsage > 0 );
+    CHECK_TRUE( statistics.astMemoryUsage > 0 );
+    CHECK_TRUE( statistics.sourceManagerMemoryUsage > 0 );
+    CHECK_TRUE( ( statistics.astMemoryUsage + statistics.identifiersMemoryUsage + statistics.preprocessorMemoryUsage +
+                  statistics.sourceManagerMemoryUsage ) <= statistics.memoryUsage );
+    CHECK_EQUAL( 1, statistics.functionCount );
+
+    // Cleanup
+}
+
+/*
+ * Check that the parse phases are recorded in the trace.
+ */
+TEST( MockGenerator, Trace )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    std::ostringstream error;
+    std::ostringstream trace;
+
+    SimpleString testHeader =
+            "void function1(int a);";
+    SetupTempFile( testHeader );
+
+    mock().expectOneCall("Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(true);
+
+    TraceRecorder::Start();
+
+    // Exercise
+    Parser parser;
+    Parser::EmittedFunctions emittedFunctions;
+    bool result = parser.Parse( tempFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
+
+    // Verify
+    CHECK_EQUAL( true, result );
+    mock().checkExpectations();
+    TraceRecorder::Write( trace );
+    STRCMP_CONTAINS( "{\"name\":\"parse\",", trace.str().c_str() );
+    STRCMP_CONTAINS( "{\"name\":\"diagnostics\",", trace.str().c_str() );
+    STRCMP_CONTAINS( "\"args\":{\"diagnostics\":0,\"errors\":0}", trace.str().c_str() );
+    STRCMP_CONTAINS( "{\"name\":\"traversal\",", trace.str().c_str() );
+    STRCMP_CONTAINS( "\"functions\":1}", trace.str().c_str() );
+    STRCMP_CONTAINS( "{\"name\":\"type processing\",", trace.str().c_str() );
+    STRCMP_CONTAINS( "\"args\":{\"function\":\"function1(int)\"}", trace.str().c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that functions already mocked for other input files are removed after parsing.
+ */
+TEST( MockGenerator, RemoveEmittedFunctions )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    std::ostringstream error;
+
+    SimpleString testHeader =
+            "void function1(int a);\n"
+            "void function2(int a);\n";
+    SetupTempFile( testHeader );
+
+    mock().expectNCalls(2, "Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(true);
+
+    Parser parser;
+    Parser::EmittedFunctions inputEmittedFunctions;
+    bool result = parser.Parse( tempFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), inputEmittedFunctions, error );
+    CHECK_EQUAL( true, result );
+    mock().checkExpectations();
+
+    Parser::EmittedFunctions emittedFunctions;
+    emittedFunctions["c:@F@function2"] = "other.h";
+
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    // Exercise
+    result = parser.RemoveEmittedFunctions( emittedFunctions, error );
+
+    // Verify
+    CHECK_EQUAL( true, result );
+    STRCMP_CONTAINS( "INPUT WARNING:", error.str().c_str() );
+    STRCMP_CONTAINS( ( "Function 'function2(int)' declared in '" + tempFilePath + "' has already been mocked for 'other.h'." ).c_str(),
+                     error.str().c_str() );
+    UNSIGNED_LONGS_EQUAL( 2, emittedFunctions.size() );
+    STRCMP_EQUAL( tempFilePath.c_str(), emittedFunctions["c:@F@function1"].c_str() );
+    mock().checkExpectations();
+
+    // Prepare
+    std::ostringstream output;
+    const char* testMock = "###MOCK###";
+
+    mock().expectOneCall("Function::GenerateMock").withBoolParameter("profiling", false).withBoolParameter("recordReplay", false).andReturnValue(testMock);
+
+    // Exercise
+    parser.GenerateMock( "", false, false, output );
+
+    // Verify
+    STRCMP_CONTAINS( testMock, output.str().c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that an error is reported when all the functions were already mocked for the same input file.
+ */
+TEST( MockGenerator, RemoveEmittedFunctions_SameInput )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    std::ostringstream error;
+
+    SimpleString testHeader =
+            "void function1(int a);";
+    SetupTempFile( testHeader );
+
+    mock().expectOneCall("Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(true);
+
+    Parser parser;
+    Parser::EmittedFunctions inputEmittedFunctions;
+    bool result = parser.Parse( tempFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), inputEmittedFunctions, error );
+    CHECK_EQUAL( true, result );
+    mock().checkExpectations();
+
+    Parser::EmittedFunctions emittedFunctions;
+    emittedFunctions["c:@F@function1"] = tempFilePath;
+
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    // Exercise
+    result = parser.RemoveEmittedFunctions( emittedFunctions, error );
+
+    // Verify
+    CHECK_EQUAL( false, result );
+    STRCMP_CONTAINS( "INPUT ERROR:", error.str().c_str() );
+    STRCMP_CONTAINS( "The input file does not contain any mockable function.", error.str().c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that the error reported when all the functions were already mocked for the same input file mentions the
+ * symbols list if the functions were selected from it.
+ */
+TEST( MockGenerator, RemoveEmittedFunctions_SameInputWithSymbols )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    std::ostringstream error;
+
+    SimpleString testHeader =
+            "void function1(int a);";
+    SetupTempFile( testHeader );
+
+    std::vector<std::string> symbols = { "function1" };
+
+    mock().expectOneCall("Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(true);
+
+    Parser parser;
+    Parser::EmittedFunctions inputEmittedFunctions;
+    bool result = parser.Parse( tempFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), symbols, inputEmittedFunctions, error );
+    CHECK_EQUAL( true, result );
+    mock().checkExpectations();
+
+    Parser::EmittedFunctions emittedFunctions;
+    emittedFunctions["c:@F@function1"] = tempFilePath;
+
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    // Exercise
+    result = parser.RemoveEmittedFunctions( emittedFunctions, error );
+
+    // Verify
+    CHECK_EQUAL( false, result );
+    STRCMP_CONTAINS( "INPUT ERROR:", error.str().c_str() );
+    STRCMP_CONTAINS( "The input file does not contain any mockable function referenced in the symbols list.", error.str().c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that an input file whose functions were all mocked already for itself is reported as skipped when skipping is
+ * enabled.
+ */
+TEST( MockGenerator, RemoveEmittedFunctions_Skipped )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    std::ostringstream error;
+
+    SimpleString testHeader =
+            "void function1(int a);";
+    SetupTempFile( testHeader );
+
+    mock().expectOneCall("Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(true);
+
+    Parser parser;
+    parser.EnableSkipWithoutFunctions();
+    Parser::EmittedFunctions inputEmittedFunctions;
+    bool result = parser.Parse( tempFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), inputEmittedFunctions, error );
+    CHECK_EQUAL( true, result );
+    CHECK_EQUAL( false, parser.IsSkipped() );
+    mock().checkExpectations();
+
+    Parser::EmittedFunctions emittedFunctions;
+    emittedFunctions["c:@F@function1"] = tempFilePath;
+
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    // Exercise
+    result = parser.RemoveEmittedFunctions( emittedFunctions, error );
+
+    // Verify
+    CHECK_EQUAL( false, result );
+    CHECK_EQUAL( true, parser.IsSkipped() );
+    STRCMP_CONTAINS( "INPUT WARNING:", error.str().c_str() );
+    STRCMP_CONTAINS( "does not contain any mockable function, it has been skipped.", error.str().c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that a kept translation unit is reparsed after the input file changes, and that the files included by the
+ * input file are reported as dependencies.
+ */
+TEST( MockGenerator, Reparse )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    std::ostringstream error;
+
+    std::string includedFilename = "CppUMockGen_MockGenerator_Included.h";
+    std::string includedFilePath = tempDirPath + PATH_SEPARATOR + includedFilename;
+    std::ofstream includedFile( includedFilePath );
+    includedFile << "typedef int type1;";
+    includedFile.close();
+
+    SimpleString testHeader =
+            "#include \"CppUMockGen_MockGenerator_Included.h\"\n"
+            "void function1(type1 a);\n";
+    SetupTempFile( testHeader );
+
+    mock().expectOneCall("Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(true);
+
+    Parser parser;
+    Parser::EmittedFunctions emittedFunctions;
+    parser.EnableReparse();
+    bool result = parser.Parse( tempFilePath, *config, false, false, std::vector<std::string>(), std::vector<std::string>(), std::vector<std::string>(), emittedFunctions, error );
+    CHECK_EQUAL( true, result );
+    mock().checkExpectations();
+
+    std::vector<std::string> dependencies = parser.GetDependencies();
+    UNSIGNED_LONGS_EQUAL( 2, dependencies.size() );
+    STRCMP_EQUAL( tempFilePath.c_str(), dependencies[0].c_str() );
+    STRCMP_CONTAINS( includedFilename.c_str(), dependencies[1].c_str() );
+
+    testHeader =
+            "#include \"CppUMockGen_MockGenerator_Included.h\"\n"
+            "void function1(type1 a);\n"
+            "void function2(type1 a);\n";
+    SetupTempFile( testHeader );
+    emittedFunctions.clear();
+
+    mock().expectNCalls(2, "Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(true);
+
+    // Exercise
+    result = parser.Reparse( *config, std::vector<std::string>(), emittedFunctions, error );
+
+    // Verify
+    CHECK_EQUAL( true, result );
+    CHECK_EQUAL( 0, error.tellp() );
+    mock().checkExpectations();
+    UNSIGNED_LONGS_EQUAL( 2, emittedFunctions.size() );
+    UNSIGNED_LONGS_EQUAL( 2, parser.GetDependencies().size() );
+
+    // Cleanup
+    std::remove( includedFilePath.c_str() );
+}
+
+/*
+ * Check that several input files are parsed in a single translation unit, routing each function to the input file
+ * where it is declared.
+ */
+TEST( MockGenerator, ParseUmbrella )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    std::ostringstream error;
+
+    std::string tempFilePath2 = tempDirPath + PATH_SEPARATOR + "CppUMockGen_MockGenerator2.h";
+    std::ofstream tempFile2( tempFilePath2 );
+    tempFile2 << "#include \"" << tempFilename << "\"\n"
+                 "void function2(type1 a);\n";
+    tempFile2.close();
+
+    SimpleString testHeader =
+            "#ifndef TEMP_FILE_H\n"
+            "#define TEMP_FILE_H\n"
+            "typedef int type1;\n"
+            "void function1(type1 a);\n"
+            "#endif\n";
+    SetupTempFile( testHeader );
+
+    mock().expectNCalls(2, "Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(true);
+
+    std::vector<std::string> inputFilepaths = { tempFilePath2, tempFilePath };
+    std::vector<Parser> parsers( inputFilepaths.size() );
+    Parser::EmittedFunctions emittedFunctions;
+
+    // Exercise
+    bool result = Parser::ParseUmbrella( inputFilepaths, *config, false, false, std::vector<std::string>(), std::vector<std::string>(),
+                                         std::vector<std::string>(), emittedFunctions, parsers, error );
+
+    // Verify
+    CHECK_EQUAL( true, result );
+    CHECK_EQUAL( 0, error.tellp() );
+    mock().checkExpectations();
+    UNSIGNED_LONGS_EQUAL( 2, emittedFunctions.size() );
+    STRCMP_EQUAL( tempFilePath.c_str(), emittedFunctions["c:@F@function1"].c_str() );
+    STRCMP_EQUAL( tempFilePath2.c_str(), emittedFunctions["c:@F@function2"].c_str() );
+
+    // Cleanup
+    std::remove( tempFilePath2.c_str() );
+}
+
+/*
+ * Check that an error is reported if any of the input files parsed in a single translation unit does not contain
+ * any mockable function.
+ */
+TEST( MockGenerator, ParseUmbrella_NoFunctions )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    std::ostringstream error;
+
+    std::string tempFilePath2 = tempDirPath + PATH_SEPARATOR + "CppUMockGen_MockGenerator2.h";
+    std::ofstream tempFile2( tempFilePath2 );
+    tempFile2 << "typedef int type2;\n";
+    tempFile2.close();
+
+    SimpleString testHeader =
+            "void function1(int a);\n";
+    SetupTempFile( testHeader );
+
+    mock().expectOneCall("Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(true);
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    std::vector<std::string> inputFilepaths = { tempFilePath, tempFilePath2 };
+    std::vector<Parser> parsers( inputFilepaths.size() );
+    Parser::EmittedFunctions emittedFunctions;
+
+    // Exercise
+    bool result = Parser::ParseUmbrella( inputFilepaths, *config, false, false, std::vector<std::string>(), std::vector<std::string>(),
+                                         std::vector<std::string>(), emittedFunctions, parsers, error );
+
+    // Verify
+    CHECK_EQUAL( false, result );
+    STRCMP_CONTAINS( ( "The input file '" + tempFilePath2 + "' does not contain any mockable function." ).c_str(), error.str().c_str() );
+
+    // Cleanup
+    std::remove( tempFilePath2.c_str() );
+}
+
+/*
+ * Check that the input files parsed in a single translation unit that do not contain any mockable function are
+ * skipped when skipping is enabled, without failing the parse of the other input files.
+ */
+TEST( MockGenerator, ParseUmbrella_NoFunctions_Skipped )
+{
+    // Prepare
+    Config* config = GetMockConfig();
+    std::ostringstream error;
+
+    std::string tempFilePath2 = tempDirPath + PATH_SEPARATOR + "CppUMockGen_MockGenerator2.h";
+    std::ofstream tempFile2( tempFilePath2 );
+    tempFile2 << "typedef int type2;\n";
+    tempFile2.close();
+
+    SimpleString testHeader =
+            "void function1(int a);\n";
+    SetupTempFile( testHeader );
+
+    mock().expectOneCall("Function::Parse").withConstPointerParameter("config", config).ignoreOtherParameters().andReturnValue(true);
+    mock().expectNCalls(2, "ConsoleColorizer::SetColor").ignoreOtherParameters();
+
+    std::vector<std::string> inputFilepaths = { tempFilePath, tempFilePath2 };
+    std::vector<Parser> parsers( inputFilepaths.size() );
+    for( Parser &parser : parsers )
+    {
+        parser.EnableSkipWithoutFunctions();
+    }
+    Parser::EmittedFunctions emittedFunctions;
+
+    // Exercise
+    bool result = Parser::ParseUmbrella( inputFilepaths, *config, false, false, std::vector<std::string>(), std::vector<std::string>(),
+                                         std::vector<std::string>(), emittedFunctions, parsers, error );
+
+    // Verify
+    CHECK_EQUAL( true, result );
+    CHECK_EQUAL( false, parsers[0].IsSkipped() );
+    CHECK_EQUAL( true, parsers[1].IsSkipped() );
+    STRCMP_CONTAINS( "INPUT WARNING:", error.str().c_str() );
+    STRCMP_CONTAINS( ( "The input file '" + tempFilePath2 + "' does not contain any mockable function, it has been skipped." ).c_str(), error.str().c_str() );
+    UNSIGNED_LONGS_EQUAL( 1, emittedFunctions.size() );
+
+    // Cleanup
+    std::remove( tempFilePath2.c_str() );
+}
@@ -0,0 +1,162 @@
+/**
+ * @file
+ * @brief      Unit tests for the "ResourceReport" class
+ * @project    CppUMockGen
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2018 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "ResourceReport.hpp"
+#include "FileHelper.hpp"
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+static const std::string tempDirPath = std::string(std::getenv("TEMP"));
+static const std::string reportFilepath = tempDirPath + PATH_SEPARATOR + "CppUMockGen_resources.json";
+
+static Parser::Statistics GetStatistics( size_t functionCount, uint64_t memoryUsage )
+{
+    Parser::Statistics statistics;
+    statistics.parseDuration = std::chrono::milliseconds( 1500 );
+    statistics.modelDuration = std::chrono::milliseconds( 250 );
+    statistics.memoryUsage = memoryUsage;
+    statistics.astMemoryUsage = memoryUsage / 2;
+    statistics.identifiersMemoryUsage = memoryUsage / 8;
+    statistics.preprocessorMemoryUsage = memoryUsage / 8;
+    statistics.sourceManagerMemoryUsage = memoryUsage / 4;
+    statistics.functionCount = functionCount;
+    return statistics;
+}
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( ResourceReport )
+{
+    TEST_TEARDOWN()
+    {
+        std::remove( reportFilepath.c_str() );
+    }
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+/*
+ * Check that the report is written in CSV format
+ */
+TEST( ResourceReport, Write_CSV )
+{
+    // Prepare
+    ResourceReport report;
+    std::ostringstream output;
+
+    report.AddInput( "foo.h", GetStatistics( 3, 8000 ) );
+    report.AddInput( "dir,name/bar.h", GetStatistics( 10, 16000 ) );
+
+    // Exercise
+    report.Write( output, ResourceReport::Format::CSV );
+
+    // Verify
+    std::istringstream lines( output.str() );
+    std::string line;
+    std::getline( lines, line );
+    STRCMP_EQUAL( "input,functions,parseSeconds,modelSeconds,tuMemoryBytes,astMemoryBytes,identifiersMemoryBytes,"
+                  "preprocessorMemoryBytes,sourceManagerMemoryBytes,peakRssBytes", line.c_str() );
+    std::getline( lines, line );
+    STRCMP_CONTAINS( "foo.h,3,1.5,0.25,8000,4000,1000,1000,2000,", line.c_str() );
+    std::getline( lines, line );
+    STRCMP_CONTAINS( "\"dir,name/bar.h\",10,1.5,0.25,16000,8000,2000,2000,4000,", line.c_str() );
+    CHECK_FALSE( std::getline( lines, line ) );
+
+    // Cleanup
+}
+
+/*
+ * Check that the report is saved in JSON format when the file extension is .json
+ */
+TEST( ResourceReport, Save_JSON )
+{
+    // Prepare
+    ResourceReport report;
+
+    report.AddInput( "foo.h", GetStatistics( 3, 8000 ) );
+
+    // Exercise
+    report.Save( reportFilepath );
+
+    // Verify
+    std::ifstream file( reportFilepath );
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    STRCMP_CONTAINS( "[\n  { \"input\": \"foo.h\", \"functions\": 3, \"parseSeconds\": 1.5, \"modelSeconds\": 0.25, "
+                     "\"tuMemoryBytes\": 8000, \"astMemoryBytes\": 4000, \"identifiersMemoryBytes\": 1000, "
+                     "\"preprocessorMemoryBytes\": 1000, \"sourceManagerMemoryBytes\": 2000, \"peakRssBytes\": ",
+                     contents.str().c_str() );
+    STRCMP_CONTAINS( " }\n]\n", contents.str().c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that the input file paths are escaped in JSON format
+ */
+TEST( ResourceReport, Save_JSON_Escaped )
+{
+    // Prepare
+    ResourceReport report;
+
+    report.AddInput( "dir\\\"foo\"\r.h", GetStatistics( 3, 8000 ) );
+
+    // Exercise
+    report.Save( reportFilepath );
+
+    // Verify
+    std::ifstream file( reportFilepath );
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    STRCMP_CONTAINS( "{ \"input\": \"dir\\\\\\\"foo\\\"\\u000D.h\", ", contents.str().c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that an exception is thrown if the report file cannot be opened
+ */
+TEST( ResourceReport, Save_CannotOpenFile )
+{
+    // Prepare
+    ResourceReport report;
+
+    // Exercise & Verify
+    CHECK_THROWS( std::runtime_error, report.Save( tempDirPath + PATH_SEPARATOR + "NonExistingDir" + PATH_SEPARATOR + "report.csv" ) );
+
+    // Cleanup
+}
+
+/*
+ * Check that the peak memory usage of the process is obtained
+ */
+TEST( ResourceReport, GetPeakRss )
+{
+    // Exercise & Verify
+    CHECK_TRUE( ResourceReport::GetPeakRss() > 0 );
+}
@@ -1,19 +1,116 @@
 #include "ClangCompileHelper.hpp"
 #include "ClangHelper.hpp"
 #include <iostream>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+#ifndef DISABLE_COMPILATION_CHECK
+
+static const char CPPUTEST_PREFIX[] =
+        "#include <CppUTest/TestHarness.h>\n"
+        "#include <CppUTestExt/MockSupport.h>\n";
+
+/*
+ * Index and precompiled CppUTest prefix shared by all the compilation checks of a test executable, so that the
+ * CppUTest headers are parsed only once instead of once per check.
+ */
+class CompilationContext
+{
+public:
+    CompilationContext()
+    : m_index( clang_createIndex( 0, 0 ) )
+    {
+        BuildPrefixPch();
+    }
+
+    ~CompilationContext()
+    {
+        clang_disposeIndex( m_index );
+
+        if( !m_pchPath.empty() )
+        {
+            std::remove( m_pchPath.c_str() );
+        }
+    }
+
+    CXIndex GetIndex() const
+    {
+        return m_index;
+    }
+
+    // Returns the path of the precompiled prefix, or an empty string if it could not be built
+    const std::string& GetPchPath() const
+    {
+        return m_pchPath;
+    }
+
+private:
+    void BuildPrefixPch()
+    {
+        const char* clangOpts[] = { "-xc++", "-I" CPPUTEST_INCLUDE_DIR };
+
+        CXUnsavedFile unsavedFiles[] = { { "CppUMockGen_prefix.hpp", CPPUTEST_PREFIX, (unsigned long) ( sizeof( CPPUTEST_PREFIX ) - 1 ) } };
+
+        CXTranslationUnit tu = clang_parseTranslationUnit( m_index, "CppUMockGen_prefix.hpp",
+                                                           clangOpts, std::extent<decltype(clangOpts)>::value,
+                                                           unsavedFiles, std::extent<decltype(unsavedFiles)>::value,
+                                                           CXTranslationUnit_Incomplete | CXTranslationUnit_ForSerialization );
+        if( tu == nullptr )
+        {
+            return;
+        }
+
+        // Each test executable uses its own file, as test executables may be run concurrently
+        const char *tempDirPath = std::getenv( "TEMP" );
+        std::string pchPath = std::string( tempDirPath ? tempDirPath : "." ) + "/CppUMockGen_prefix_" +
+                              std::to_string( getpid() ) + ".pch";
+
+        if( ( clang_getNumDiagnostics( tu ) == 0 ) &&
+            ( clang_saveTranslationUnit( tu, pchPath.c_str(), clang_defaultSaveOptions( tu ) ) == CXSaveError_None ) )
+        {
+            m_pchPath = pchPath;
+        }
+
+        clang_disposeTranslationUnit( tu );
+    }
+
+    CXIndex m_index;
+    std::string m_pchPath;
+};
+
+// The context is created before running the tests (and not by the first check), otherwise the memory it holds would
+// be reported as leaked by the test that did the first check
+static CompilationContext compilationContext;
+
+#endif
 
 bool ClangCompileHelper::CheckCompilation( const std::string &testedHeader, const std::string &testedSource )
 {
 #ifdef DISABLE_COMPILATION_CHECK
     return true;
 #else
-    CXIndex index = clang_createIndex( 0, 0 );
+    std::vector<const char*> clangOpts = { "-xc++", "-I" CPPUTEST_INCLUDE_DIR };
 
-    const char* clangOpts[] = { "-xc++", "-I" CPPUTEST_INCLUDE_DIR };
+    // The CppUTest prefix is only parsed if it could not be precompiled
+    std::string compiledCode;
+    if( compilationContext.GetPchPath().empty() )
+    {
+        compiledCode = CPPUTEST_PREFIX;
+    }
+    else
+    {
+        clangOpts.push_back( "-include-pch" );
+        clangOpts.push_back( compilationContext.GetPchPath().c_str() );
+    }
 
-    std::string compiledCode =
-            "#include <CppUTest/TestHarness.h>\n"
-            "#include <CppUTestExt/MockSupport.h>\n";
 #ifdef INTERPRET_C
     compiledCode += "extern \"C\" {";
 #endif
@@ -25,13 +122,12 @@ bool ClangCompileHelper::CheckCompilation( const std::string &testedHeader, cons
 
     CXUnsavedFile unsavedFiles[] = { { "test_mock.cpp", compiledCode.c_str(), (unsigned long) compiledCode.length() }  };
 
-    CXTranslationUnit tu = clang_parseTranslationUnit( index, "test_mock.cpp",
-                                                       clangOpts, std::extent<decltype(clangOpts)>::value,
+    CXTranslationUnit tu = clang_parseTranslationUnit( compilationContext.GetIndex(), "test_mock.cpp",
+                                                       clangOpts.data(), (int) clangOpts.size(),
                                                        unsavedFiles, std::extent<decltype(unsavedFiles)>::value,
                                                        CXTranslationUnit_None );
     if( tu == nullptr )
     {
-        clang_disposeIndex( index );
         throw std::runtime_error( "Error creating translation unit" );
     }
 
@@ -53,7 +149,6 @@ bool ClangCompileHelper::CheckCompilation( const std::string &testedHeader, cons
     }
 
     clang_disposeTranslationUnit( tu );
-    clang_disposeIndex( index );
 
     return ( numDiags == 0 );
 #endif
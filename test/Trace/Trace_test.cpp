@@ -0,0 +1,246 @@
+/**
+ * @file
+ * @brief      Unit tests for the "TraceRecorder" and "TraceSpan" classes
+ * @project    CppUMockGen
+ * @authors    Jesus Gonzalez <jgonzalez@gdr-sistemas.com>
+ * @copyright  Copyright (c) 2017-2018 Jesus Gonzalez. All rights reserved.
+ * @license    See LICENSE.txt
+ */
+
+/*===========================================================================
+ *                              INCLUDES
+ *===========================================================================*/
+
+#include <CppUTest/TestHarness.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "Trace.hpp"
+#include "FileHelper.hpp"
+
+/*===========================================================================
+ *                      COMMON TEST DEFINES & MACROS
+ *===========================================================================*/
+
+static const std::string tempDirPath = std::string(std::getenv("TEMP"));
+static const std::string traceFilepath = tempDirPath + PATH_SEPARATOR + "CppUMockGen_trace.json";
+
+static unsigned int CountOccurrences( const std::string &text, const std::string &pattern )
+{
+    unsigned int count = 0;
+    for( size_t pos = text.find( pattern ); pos != std::string::npos; pos = text.find( pattern, pos + 1 ) )
+    {
+        count++;
+    }
+    return count;
+}
+
+/*===========================================================================
+ *                          TEST GROUP DEFINITION
+ *===========================================================================*/
+
+TEST_GROUP( Trace )
+{
+    TEST_TEARDOWN()
+    {
+        TraceRecorder::Stop();
+        std::remove( traceFilepath.c_str() );
+    }
+};
+
+/*===========================================================================
+ *                    TEST CASES IMPLEMENTATION
+ *===========================================================================*/
+
+/*
+ * Check that spans are not recorded while recording is disabled
+ */
+TEST( Trace, Disabled )
+{
+    // Prepare
+    TraceRecorder::Start();
+    TraceRecorder::Stop();
+    std::ostringstream output;
+
+    // Exercise
+    {
+        TraceSpan span( "parse" );
+        span.AddArgument( "file", "foo.h" );
+        CHECK_FALSE( span.IsActive() );
+    }
+    TraceRecorder::Write( output );
+
+    // Verify
+    CHECK_FALSE( TraceRecorder::IsEnabled() );
+    STRCMP_EQUAL( "{\"traceEvents\":[\n\n],\"displayTimeUnit\":\"ms\"}\n", output.str().c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that the recorded spans are released when recording is stopped, including those ended afterwards
+ */
+TEST( Trace, Stop )
+{
+    // Prepare
+    TraceRecorder::Start();
+    std::ostringstream output;
+
+    // Exercise
+    {
+        TraceSpan span( "parse" );
+    }
+    {
+        TraceSpan span( "write" );
+        TraceRecorder::Stop();
+    }
+    TraceRecorder::Write( output );
+
+    // Verify
+    CHECK_FALSE( TraceRecorder::IsEnabled() );
+    STRCMP_EQUAL( "{\"traceEvents\":[\n\n],\"displayTimeUnit\":\"ms\"}\n", output.str().c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that spans are recorded with their arguments
+ */
+TEST( Trace, Spans )
+{
+    // Prepare
+    TraceRecorder::Start();
+    std::ostringstream output;
+
+    // Exercise
+    {
+        TraceSpan span( "parse" );
+        CHECK_TRUE( span.IsActive() );
+        span.AddArgument( "file", "dir\\\\foo \"1\".h" );
+        span.AddArgument( "functions", 12 );
+    }
+    {
+        TraceSpan span( "write" );
+    }
+    TraceRecorder::Write( output );
+
+    // Verify
+    STRCMP_CONTAINS( "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"main\"}}", output.str().c_str() );
+    STRCMP_CONTAINS( "{\"name\":\"parse\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":", output.str().c_str() );
+    STRCMP_CONTAINS( ",\"args\":{\"file\":\"dir\\\\\\\\foo \\\"1\\\".h\",\"functions\":12}}", output.str().c_str() );
+    STRCMP_CONTAINS( "{\"name\":\"write\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":", output.str().c_str() );
+    STRCMP_CONTAINS( ",\"args\":{}}", output.str().c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that control characters in the arguments of spans are escaped
+ */
+TEST( Trace, Spans_ControlCharacters )
+{
+    // Prepare
+    TraceRecorder::Start();
+    std::ostringstream output;
+
+    // Exercise
+    {
+        TraceSpan span( "parse" );
+        span.AddArgument( "file", "foo\tbar\n\x1f.h" );
+    }
+    TraceRecorder::Write( output );
+
+    // Verify
+    STRCMP_CONTAINS( ",\"args\":{\"file\":\"foo\\u0009bar\\u000A\\u001F.h\"}}", output.str().c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that spans recorded from different threads are shown in different tracks
+ */
+TEST( Trace, Threads )
+{
+    // Prepare
+    TraceRecorder::Start();
+    std::ostringstream output;
+
+    // Exercise
+    {
+        TraceSpan span( "parse" );
+    }
+    std::thread worker( []() { TraceSpan span( "parse" ); } );
+    worker.join();
+    TraceRecorder::Write( output );
+
+    // Verify
+    STRCMP_CONTAINS( "\"tid\":1,\"args\":{\"name\":\"main\"}", output.str().c_str() );
+    STRCMP_CONTAINS( "\"tid\":2,\"args\":{\"name\":\"worker 1\"}", output.str().c_str() );
+    CHECK_EQUAL( 2, CountOccurrences( output.str(), "\"name\":\"parse\"" ) );
+
+    // Cleanup
+}
+
+/*
+ * Check that starting again discards the spans recorded previously
+ */
+TEST( Trace, Restart )
+{
+    // Prepare
+    TraceRecorder::Start();
+    {
+        TraceSpan span( "parse" );
+    }
+    std::ostringstream output;
+
+    // Exercise
+    TraceRecorder::Start();
+    {
+        TraceSpan span( "write" );
+    }
+    TraceRecorder::Write( output );
+
+    // Verify
+    CHECK_EQUAL( 0, CountOccurrences( output.str(), "\"name\":\"parse\"" ) );
+    CHECK_EQUAL( 1, CountOccurrences( output.str(), "\"name\":\"write\"" ) );
+
+    // Cleanup
+}
+
+/*
+ * Check that the trace is saved to a file
+ */
+TEST( Trace, Save )
+{
+    // Prepare
+    TraceRecorder::Start();
+    {
+        TraceSpan span( "parse" );
+    }
+
+    // Exercise
+    TraceRecorder::Save( traceFilepath );
+
+    // Verify
+    std::ifstream file( traceFilepath );
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    STRCMP_CONTAINS( "{\"name\":\"parse\",\"ph\":\"X\"", contents.str().c_str() );
+
+    // Cleanup
+}
+
+/*
+ * Check that an exception is thrown if the trace file cannot be opened
+ */
+TEST( Trace, Save_CannotOpenFile )
+{
+    // Exercise & Verify
+    CHECK_THROWS( std::runtime_error, TraceRecorder::Save( tempDirPath + PATH_SEPARATOR + "NonExistingDir" + PATH_SEPARATOR + "trace.json" ) );
+}